@@ -129,6 +129,16 @@ public:
   static uint32 atomic_add(uint32 &value, int32 increment);
   static int32 atomic_add(int32 &value, int32 increment);
 
+/**
+ * atomically sets value to new_value, if it is equal to expected
+ *
+ * @param &value Reference to value
+ * @param expected the value value has to have
+ * @param new_value to set value to
+ * @returns old value of value (the swap took place if it equals expected)
+ */
+  static uint32 compareAndSwap(uint32 &value, uint32 expected, uint32 new_value);
+
 /**
  *
  * @param thread
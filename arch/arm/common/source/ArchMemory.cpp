@@ -23,6 +23,14 @@
 //extern "C" uint32 kernel_page_directory_start;
 extern "C" page_directory_entry kernel_page_directory_start;
 
+/**
+ * removes a page of the current address space from the TLB
+ */
+static void invalidateTLBEntry(uint32 virtual_page)
+{
+  asm volatile("mcr p15, 0, %0, c8, c7, 1" : : "r"(virtual_page * PAGE_SIZE) : "memory");
+}
+
 ArchMemory::ArchMemory()
 {
   page_dir_page_ = PageManager::instance()->getFreePhysicalPage(PAGE_4_PAGES_16K_ALIGNED);
@@ -71,12 +79,43 @@ void ArchMemory::unmapPage(uint32 virtual_page)
     if (pte_base[pte_vpn].size == 2)
     {
       pte_base[pte_vpn].size = 0;
+      invalidateTLBEntry(virtual_page);
       PageManager::instance()->freePage(pte_base[pte_vpn].page_ppn - PHYS_OFFSET_4K);
     }
     checkAndRemovePT(pde_vpn);
   }
 }
 
+void ArchMemory::setPageWriteable(uint32 virtual_page, uint32 writeable)
+{
+  page_directory_entry *page_directory = (page_directory_entry *) getIdentAddressOfPPN(page_dir_page_);
+  uint32 pde_vpn = virtual_page / PAGE_TABLE_ENTRIES;
+  uint32 pte_vpn = virtual_page % PAGE_TABLE_ENTRIES;
+  assert(page_directory[pde_vpn].pde4k.size == PDE_SIZE_PT);
+
+  page_table_entry *pte_base = (page_table_entry *) getIdentAddressOfPPN(page_directory[pde_vpn].pde4k.pt_ppn - PHYS_OFFSET_4K);
+  assert(pte_base[pte_vpn].size == 2);
+
+  // 3: user read/write, 2: user read-only (kernel pages stay kernel read/write)
+  if (pte_base[pte_vpn].permissions != 1)
+    pte_base[pte_vpn].permissions = writeable ? 3 : 2;
+  invalidateTLBEntry(virtual_page);
+}
+
+bool ArchMemory::checkAndClearDirty(uint32 virtual_page)
+{
+  page_directory_entry *page_directory = (page_directory_entry *) getIdentAddressOfPPN(page_dir_page_);
+  uint32 pde_vpn = virtual_page / PAGE_TABLE_ENTRIES;
+  uint32 pte_vpn = virtual_page % PAGE_TABLE_ENTRIES;
+  if (page_directory[pde_vpn].pde4k.size != PDE_SIZE_PT)
+    return false;
+
+  page_table_entry *pte_base = (page_table_entry *) getIdentAddressOfPPN(page_directory[pde_vpn].pde4k.pt_ppn - PHYS_OFFSET_4K);
+
+  // the page tables have no dirty flag, so every writeable page counts as dirty
+  return pte_base[pte_vpn].size == 2 && pte_base[pte_vpn].permissions != 2;
+}
+
 void ArchMemory::insertPT(uint32 pde_vpn, uint32 physical_page_table_page)
 {
   page_directory_entry *page_directory = (page_directory_entry *) getIdentAddressOfPPN(page_dir_page_);
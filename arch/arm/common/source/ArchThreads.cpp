@@ -111,6 +111,16 @@ int32 ArchThreads::atomic_add(int32 &value, int32 increment)
   return (int32) ArchThreads::atomic_add((uint32 &) value, increment);
 }
 
+uint32 ArchThreads::compareAndSwap(uint32 &value, uint32 expected, uint32 new_value)
+{
+  global_atomic_add_lock.acquire("before compareAndSwap");
+  uint32 result = value;
+  if (result == expected)
+    value = new_value;
+  global_atomic_add_lock.release("after compareAndSwap");
+  return result;
+}
+
 void ArchThreads::printThreadRegisters(Thread *thread, uint32 userspace_registers)
 {
   ArchThreadInfo *info = userspace_registers?thread->user_arch_thread_info_:thread->kernel_arch_thread_info_;
@@ -6,15 +6,10 @@
  *
  * Create the BDRequest object with the proper parameters,
  * pass the instance of that object to the pleaseProcessRequest
- * method of the BDManager and go to sleep.
- * The calling thread will be awaken when the command is
- * processed. No timeouts are implemented so if there is some
- * communication error between the BDManager and the drivers,
- * the thread will be sleeping for a looooong looong time.
- * Possible solution is to implement timeout in sleep in
- * scheduler.
- * The second option is to make a busy wait and check the
- * getStatus() method.
+ * method of the BDManager and call waitForCompletion().
+ * The calling thread sleeps until the driver calls complete()
+ * (usually from its interrupt handler) or until the timeout
+ * expired, in which case the status is still BD_QUEUED.
  * Look at the BD_CMD enum for the list of possible commands.
  *
  */
@@ -40,6 +35,7 @@ class BDRequest
     {
       BD_READ            = 0x00,
       BD_WRITE           = 0x10,
+      BD_FLUSH           = 0x11,
       BD_GET_NUM_DEVICES = 0x20,
       BD_GET_BLK_SIZE    = 0x21,
       BD_GET_NUM_BLOCKS  = 0x22,
@@ -86,6 +82,7 @@ class BDRequest
       requesting_thread_ = currentThread;
       blocks_done_ = 0;
       next_request_ = 0;
+      waiting_thread_ = 0;
     };
 
     /**
@@ -185,6 +182,26 @@ class BDRequest
      */
     void setNumBlocks(uint32 num_block){ num_block_ = num_block; };
 
+    /**
+     * sets the final status of the request and wakes up the thread
+     * waiting for it, may be called from an interrupt handler
+     * @param status BD_DONE or BD_ERROR
+     *
+     */
+    void complete( BD_RESULT status );
+
+    /**
+     * lets the current thread sleep until the request is completed or
+     * until the timeout expired
+     * @param timeout_ticks the timeout in timer ticks
+     * @return the status of the request (BD_QUEUED on timeout)
+     *
+     */
+    BD_RESULT waitForCompletion( uint32 timeout_ticks = TIMEOUT_TICKS );
+
+    /// the default timeout of a request (~10s at 18.2 Hz)
+    static const uint32 TIMEOUT_TICKS = 182;
+
   private:
 
     /**
@@ -204,8 +221,10 @@ class BDRequest
     uint32 start_block_;
     /// result of the operation, zB. the number of blocks in a device
     uint32 result_;
-    /// status of the operation \sa BD_RESULT
-    BD_RESULT status_;
+    /// status of the operation \sa BD_RESULT, changed by interrupt handlers
+    volatile BD_RESULT status_;
+    /// the thread sleeping in waitForCompletion(), 0 if there is none
+    Thread * volatile waiting_thread_;
     /// how many blocks have been processed by interrupt handler
     uint32 blocks_done_;
     /// Name says it all
@@ -83,6 +83,14 @@ class BDVirtualDevice
      */
     virtual int32 writeData(uint32 offset, uint32 size, char *buffer);
 
+    /**
+     * writes the volatile write cache of the drive to the disk, has to be
+     * called for sync barriers only, not after every write
+     * @return 0 on success, -1 otherwise
+     *
+     */
+    virtual int32 flushCache();
+
     /**
      * the PartitionType is a 8bit field in the PartitionTable of a MBR
      * it specifies the FileSystem which is installed on the partition
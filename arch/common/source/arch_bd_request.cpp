@@ -0,0 +1,55 @@
+/**
+ * @file arch_bd_request.cpp
+ *
+ */
+
+#include "arch_bd_request.h"
+#include "ArchInterrupts.h"
+#include "Scheduler.h"
+
+void BDRequest::complete( BD_RESULT status )
+{
+  status_ = status;
+
+  Thread *waiter = waiting_thread_;
+  if( waiter )
+    Scheduler::instance()->wake( waiter );
+}
+
+BDRequest::BD_RESULT BDRequest::waitForCompletion( uint32 timeout_ticks )
+{
+  bool interrupts_enabled = ArchInterrupts::disableInterrupts();
+
+  if( !currentThread || !Scheduler::instance()->isSchedulingEnabled() )
+  {
+    // nobody to put to sleep, the request has to be polled (with the
+    // interrupts as the caller had them)
+    if( interrupts_enabled )
+      ArchInterrupts::enableInterrupts();
+
+    uint32 jiffies = 0;
+    while( status_ == BD_QUEUED && jiffies++ < IO_TIMEOUT )
+      ArchInterrupts::yieldIfIFSet();
+  }
+  else
+  {
+    uint32 deadline = Scheduler::instance()->getTicks() + timeout_ticks;
+
+    // the status is checked with interrupts disabled, so complete() can
+    // not slip in between the check and going to sleep
+    while( status_ == BD_QUEUED && (int32)(deadline - Scheduler::instance()->getTicks()) > 0 )
+    {
+      waiting_thread_ = currentThread;
+      Scheduler::instance()->sleepAndRestoreInterrupts( true, deadline - Scheduler::instance()->getTicks() );
+      ArchInterrupts::disableInterrupts();
+      waiting_thread_ = 0;
+    }
+  }
+
+  if( interrupts_enabled )
+    ArchInterrupts::enableInterrupts();
+  else
+    ArchInterrupts::disableInterrupts();
+
+  return status_;
+}
@@ -52,6 +52,23 @@ public:
  */
   void unmapPage(uint32 virtual_page);
 
+/**
+ * sets or clears the write permission of a mapped 4 KiB page
+ *
+ * @param virtual_page the mapped page
+ * @param writeable 1 to allow writing, 0 to make the page read-only
+ */
+  void setPageWriteable(uint32 virtual_page, uint32 writeable);
+
+/**
+ * checks if a mapped 4 KiB page has been written to since it was mapped
+ * (or since the last call) and clears the dirty flag
+ *
+ * @param virtual_page the mapped page
+ * @return true if the page is dirty, false if it is clean or not mapped
+ */
+  bool checkAndClearDirty(uint32 virtual_page);
+
 /**
  * Destructor. Recursively deletes the page directory and all page tables
  *
@@ -121,6 +138,13 @@ private:
  */
   void checkAndRemovePT(uint32 pde_vpn);
 
+/**
+ * finds the page table entry of a virtual page
+ *
+ * @return the entry or 0 if there is no page table for the page
+ */
+  PageTableEntry* getPageTableEntry(uint32 virtual_page);
+
 };
 
 #endif
@@ -53,6 +53,23 @@ public:
  */
   void unmapPage(uint32 virtual_page);
 
+/**
+ * sets or clears the write permission of a mapped 4 KiB page
+ *
+ * @param virtual_page the mapped page
+ * @param writeable 1 to allow writing, 0 to make the page read-only
+ */
+  void setPageWriteable(uint32 virtual_page, uint32 writeable);
+
+/**
+ * checks if a mapped 4 KiB page has been written to since it was mapped
+ * (or since the last call) and clears the dirty flag
+ *
+ * @param virtual_page the mapped page
+ * @return true if the page is dirty, false if it is clean or not mapped
+ */
+  bool checkAndClearDirty(uint32 virtual_page);
+
   /**
    * Destructor. Recursively deletes the page directory and all page tables
    *
@@ -133,6 +150,13 @@ private:
  */
   void checkAndRemovePT(uint32 physical_page_directory_page, uint32 pde_vpn);
 
+/**
+ * finds the page table entry of a virtual page
+ *
+ * @return the entry or 0 if there is no page table for the page
+ */
+  PageTableEntry* getPageTableEntry(uint32 virtual_page);
+
   PageDirPointerTableEntry page_dir_pointer_table_space_[2 * PAGE_DIRECTORY_POINTER_TABLE_ENTRIES];
   // why 2* ? this is a hack because this table has to be aligned to its own
   // size 0x20... this way we allow to set an aligned pointer in the constructor.
@@ -12,6 +12,14 @@
 //extern "C" uint32 kernel_page_directory_start;
 extern "C" PageDirPointerTableEntry kernel_page_directory_pointer_table;
 
+/**
+ * removes a page of the current address space from the TLB
+ */
+static void invalidateTLBEntry(uint32 virtual_page)
+{
+  asm volatile("invlpg (%0)" : : "r"(virtual_page * PAGE_SIZE) : "memory");
+}
+
 ArchMemory::ArchMemory() : page_dir_pointer_table_((PageDirPointerTableEntry*) (((uint32) page_dir_pointer_table_space_ + 0x20) & (~0x1F)))
 {
 
@@ -59,6 +67,7 @@ void ArchMemory::unmapPage(uint32 virtual_page)
       if (pte_base[pte_vpn].present)
       {
         pte_base[pte_vpn].present = 0;
+        invalidateTLBEntry(virtual_page);
         PageManager::instance()->freePage(pte_base[pte_vpn].page_ppn);
       }
       checkAndRemovePT(page_dir_pointer_table_[pdpte_vpn].page_directory_ppn, pde_vpn);
@@ -66,6 +75,40 @@ void ArchMemory::unmapPage(uint32 virtual_page)
   }
 }
 
+PageTableEntry* ArchMemory::getPageTableEntry(uint32 virtual_page)
+{
+  if (!page_dir_pointer_table_[virtual_page / (PAGE_TABLE_ENTRIES * PAGE_DIRECTORY_ENTRIES)].present)
+    return 0;
+
+  RESOLVEMAPPING(page_dir_pointer_table_,virtual_page);
+  if (!page_directory[pde_vpn].pt.present || page_directory[pde_vpn].page.size)
+    return 0;
+
+  PageTableEntry *pte_base = (PageTableEntry *) getIdentAddressOfPPN(page_directory[pde_vpn].pt.page_table_ppn);
+  return &pte_base[pte_vpn];
+}
+
+void ArchMemory::setPageWriteable(uint32 virtual_page, uint32 writeable)
+{
+  PageTableEntry *pte = getPageTableEntry(virtual_page);
+  assert(pte && pte->present);
+
+  pte->writeable = writeable;
+  invalidateTLBEntry(virtual_page);
+}
+
+bool ArchMemory::checkAndClearDirty(uint32 virtual_page)
+{
+  PageTableEntry *pte = getPageTableEntry(virtual_page);
+  if (!pte || !pte->present || !pte->dirty)
+    return false;
+
+  // the TLB caches the dirty flag, the next write has to set it again
+  pte->dirty = 0;
+  invalidateTLBEntry(virtual_page);
+  return true;
+}
+
 void ArchMemory::insertPD(uint32 pdpt_vpn, uint32 physical_page_directory_page)
 {
   kprintfd("insertPD: pdpt %x pdpt_vpn %x physical_page_table_page %x\n",page_dir_pointer_table_,pdpt_vpn,physical_page_directory_page);
@@ -12,6 +12,14 @@
 //extern "C" uint32 kernel_page_directory_start;
 extern "C" PageDirEntry kernel_page_directory_start;
 
+/**
+ * removes a page of the current address space from the TLB
+ */
+static void invalidateTLBEntry(uint32 virtual_page)
+{
+  asm volatile("invlpg (%0)" : : "r"(virtual_page * PAGE_SIZE) : "memory");
+}
+
 ArchMemory::ArchMemory()
 {
   page_dir_page_ = PageManager::instance()->getFreePhysicalPage();
@@ -55,11 +63,46 @@ void ArchMemory::unmapPage(uint32 virtual_page)
   if (pte_base[pte_vpn].present)
   {
     pte_base[pte_vpn].present = 0;
+    invalidateTLBEntry(virtual_page);
     PageManager::instance()->freePage(pte_base[pte_vpn].page_ppn);
   }
   checkAndRemovePT(pde_vpn);
 }
 
+PageTableEntry* ArchMemory::getPageTableEntry(uint32 virtual_page)
+{
+  PageDirEntry *page_directory = (PageDirEntry *) getIdentAddressOfPPN(page_dir_page_);
+  uint32 pde_vpn = virtual_page / PAGE_TABLE_ENTRIES;
+  uint32 pte_vpn = virtual_page % PAGE_TABLE_ENTRIES;
+
+  if (!page_directory[pde_vpn].pt.present || page_directory[pde_vpn].page.size)
+    return 0;
+
+  PageTableEntry *pte_base = (PageTableEntry *) getIdentAddressOfPPN(page_directory[pde_vpn].pt.page_table_ppn);
+  return &pte_base[pte_vpn];
+}
+
+void ArchMemory::setPageWriteable(uint32 virtual_page, uint32 writeable)
+{
+  PageTableEntry *pte = getPageTableEntry(virtual_page);
+  assert(pte && pte->present);
+
+  pte->writeable = writeable;
+  invalidateTLBEntry(virtual_page);
+}
+
+bool ArchMemory::checkAndClearDirty(uint32 virtual_page)
+{
+  PageTableEntry *pte = getPageTableEntry(virtual_page);
+  if (!pte || !pte->present || !pte->dirty)
+    return false;
+
+  // the TLB caches the dirty flag, the next write has to set it again
+  pte->dirty = 0;
+  invalidateTLBEntry(virtual_page);
+  return true;
+}
+
 void ArchMemory::insertPT(uint32 pde_vpn, uint32 physical_page_table_page)
 {
   PageDirEntry *page_directory = (PageDirEntry *) getIdentAddressOfPPN(page_dir_page_);
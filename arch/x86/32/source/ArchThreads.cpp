@@ -141,6 +141,17 @@ int32 ArchThreads::atomic_add(int32 &value, int32 increment)
   return (int32) ArchThreads::atomic_add((uint32 &) value, increment);
 }
 
+uint32 ArchThreads::compareAndSwap(uint32 &value, uint32 expected, uint32 new_value)
+{
+  uint32 ret=expected;
+  __asm__ __volatile__(
+  "lock; cmpxchgl %2, %1;"
+  :"=a" (ret), "+m" (value)
+  :"r" (new_value), "a" (ret)
+  :"memory");
+  return ret;
+}
+
 void ArchThreads::printThreadRegisters(Thread *thread, uint32 userspace_registers)
 {
   ArchThreadInfo *info = userspace_registers?thread->user_arch_thread_info_:thread->kernel_arch_thread_info_;
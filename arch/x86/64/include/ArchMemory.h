@@ -70,6 +70,24 @@ public:
  * @param virtual_page which will be invalidated
  */
   bool unmapPage(uint64 virtual_page);
+
+/**
+ * sets or clears the write permission of a mapped 4 KiB page
+ *
+ * @param virtual_page the mapped page
+ * @param writeable 1 to allow writing, 0 to make the page read-only
+ */
+  void setPageWriteable(uint64 virtual_page, uint64 writeable);
+
+/**
+ * checks if a mapped 4 KiB page has been written to since it was mapped
+ * (or since the last call) and clears the dirty flag
+ *
+ * @param virtual_page the mapped page
+ * @return true if the page is dirty, false if it is clean or not mapped
+ */
+  bool checkAndClearDirty(uint64 virtual_page);
+
 /**
  * Destructor. Recursively deletes the pml4
  *
@@ -10,6 +10,14 @@
 #include "ArchCommon.h"
 #include "PageManager.h"
 
+/**
+ * removes a page of the current address space from the TLB
+ */
+static void invalidateTLBEntry(uint64 virtual_page)
+{
+  asm volatile("invlpg (%0)" : : "r"(virtual_page * PAGE_SIZE) : "memory");
+}
+
 ArchMemory::ArchMemory()
 {
   page_map_level_4_ = PageManager::instance()->getFreePhysicalPage();
@@ -26,7 +34,7 @@ bool ArchMemory::checkAndRemove(pointer map_ptr, uint64 index)
   ((uint64*)map)[index] = 0;
   for (uint64 i = 0; i < PAGE_DIR_ENTRIES; i++)
   {
-    if (map[index].present != 0)
+    if (map[i].present != 0)
       return false;
   }
   return true;
@@ -38,6 +46,8 @@ bool ArchMemory::unmapPage(uint64 virtual_page)
 
   assert(m.page_ppn != 0 && m.page_size == PAGE_SIZE);
   bool empty = checkAndRemove<PageTableEntry>(getIdentAddressOfPPN(m.pt_ppn), m.pti);
+  invalidateTLBEntry(virtual_page);
+  PageManager::instance()->freePage(m.page_ppn);
   if (empty)
     empty = checkAndRemove<PageDirPageEntry>(getIdentAddressOfPPN(m.pd_ppn), m.pdi);
   if (empty)
@@ -47,6 +57,27 @@ bool ArchMemory::unmapPage(uint64 virtual_page)
   return true;
 }
 
+void ArchMemory::setPageWriteable(uint64 virtual_page, uint64 writeable)
+{
+  ArchMemoryMapping m = resolveMapping(page_map_level_4_, virtual_page);
+  assert(m.page_ppn != 0 && m.page_size == PAGE_SIZE);
+
+  m.pt[m.pti].writeable = writeable;
+  invalidateTLBEntry(virtual_page);
+}
+
+bool ArchMemory::checkAndClearDirty(uint64 virtual_page)
+{
+  ArchMemoryMapping m = resolveMapping(page_map_level_4_, virtual_page);
+  if (m.page_ppn == 0 || m.page_size != PAGE_SIZE || !m.pt[m.pti].dirty)
+    return false;
+
+  // the TLB caches the dirty flag, the next write has to set it again
+  m.pt[m.pti].dirty = 0;
+  invalidateTLBEntry(virtual_page);
+  return true;
+}
+
 
 template<typename T>
 bool ArchMemory::insert(pointer map_ptr, uint64 index, uint64 ppn, uint64 bzero, uint64 size, uint64 user_access, uint64 writeable)
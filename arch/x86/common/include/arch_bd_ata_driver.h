@@ -9,8 +9,7 @@
 #include "arch_bd_driver.h"
 #include "arch_bd_io.h"
 #include "Mutex.h"
-
-class BDRequest;
+#include "arch_bd_request.h"
 
 class ATADriver : public BDDriver, bdio
 {
@@ -33,9 +32,12 @@ class ATADriver : public BDDriver, bdio
 
     /**
      * Constructor
+     * @param channel_lock the lock of the IDE channel, master and slave
+     * share the task file and the bus-master registers of the channel and
+     * have to use the same lock
      *
      */
-    ATADriver( uint16 baseport, uint16 getdrive, uint16 irqnum );
+    ATADriver( uint16 baseport, uint16 getdrive, uint16 irqnum, Mutex &channel_lock );
 
     /**
      * Destructor
@@ -66,6 +68,24 @@ class ATADriver : public BDDriver, bdio
      */
     int32 writeSector( uint32, uint32, void * );
 
+    /**
+     * writes the volatile write cache of the drive to the disk
+     * (FLUSH CACHE), it is only issued on sync barriers and no longer
+     * after every write
+     *
+     */
+    int32 flushCache();
+
+    /**
+     * switches the driver to bus-master DMA (BD_DMA), if the drive supports
+     * DMA and the driver runs interrupt driven
+     * @param bus_master_port the I/O base of the channel's bus-master
+     * registers (BAR4 of the PCI IDE controller, +8 for the secondary channel)
+     * @return true if the driver uses DMA from now on
+     *
+     */
+    bool enableDMA( uint16 bus_master_port );
+
     /**
      * @return number of sectors
      *
@@ -101,6 +121,100 @@ class ATADriver : public BDDriver, bdio
 
   private:
 
+    /**
+     * the ATA commands used by the driver
+     *
+     */
+    typedef enum ATA_COMMAND_ {
+      ATA_READ_SECTORS       = 0x20,
+      ATA_READ_SECTORS_EXT   = 0x24,
+      ATA_READ_DMA_EXT       = 0x25,
+      ATA_READ_MULTIPLE_EXT  = 0x29,
+      ATA_WRITE_SECTORS      = 0x30,
+      ATA_WRITE_SECTORS_EXT  = 0x34,
+      ATA_WRITE_DMA_EXT      = 0x35,
+      ATA_WRITE_MULTIPLE_EXT = 0x39,
+      ATA_READ_MULTIPLE      = 0xC4,
+      ATA_WRITE_MULTIPLE     = 0xC5,
+      ATA_SET_MULTIPLE_MODE  = 0xC6,
+      ATA_READ_DMA           = 0xC8,
+      ATA_WRITE_DMA          = 0xCA,
+      ATA_FLUSH_CACHE        = 0xE7,
+      ATA_FLUSH_CACHE_EXT    = 0xEA,
+      ATA_IDENTIFY           = 0xEC
+    } ATA_COMMAND;
+
+    /**
+     * selects the drive and writes the address and the sector count
+     * of a request to the task file (LBA48, LBA28 or CHS, depending on
+     * the drive and the request)
+     * @return the read or write command to issue for the request or 0
+     * if the request can not be addressed
+     *
+     */
+    uint8 selectSectors( uint32 start_sector, uint32 num_sectors, bool write, bool dma = false );
+
+    /**
+     * fills the PRD table for the given buffer and starts a DMA transfer,
+     * the transfer is finished by serviceIRQ()
+     * @return 0 if the transfer was started, -1 on error and 1 if the
+     * buffer can not be used for DMA (the caller falls back to PIO)
+     *
+     */
+    int32 startDMA( uint32 start_sector, uint32 num_sectors, void *buffer, bool write );
+
+    /**
+     * finishes the running DMA transfer of the given request (IRQ context)
+     *
+     */
+    void finishDMA( BDRequest *br );
+
+    /**
+     * takes the request out of the request list (interrupts have to be off)
+     *
+     */
+    void removeRequest( BDRequest *br );
+
+    /**
+     * takes the request out of the request list and wakes up the waiting
+     * thread (IRQ context)
+     *
+     */
+    void finishRequest( BDRequest *br, BDRequest::BD_RESULT status );
+
+    /**
+     * gives up a request that was not completed in time, the controller
+     * is reset
+     *
+     */
+    void cancelRequest( BDRequest *br );
+
+    /**
+     * turns READ/WRITE MULTIPLE on, with the largest block the drive supports
+     *
+     */
+    void setMultipleMode();
+
+    /**
+     * waits for the drive to clear BUSY
+     * @return false on timeout
+     *
+     */
+    bool waitNotBusy();
+
+    /**
+     * waits for the drive to request the next data block (DRQ)
+     * @return false on timeout or if the drive reports an error
+     *
+     */
+    bool waitForData();
+
+    /**
+     * @return the number of sectors transferred per data block (and IRQ)
+     *
+     */
+    uint32 getSectorsPerBlock() { return multiple_sectors_ ? multiple_sectors_ : 1; };
+
     uint16 dd [256];    // read buffer if we need one
     uint32 dd_off;      // read buffer counter
 
@@ -113,10 +227,40 @@ class ATADriver : public BDDriver, bdio
 
     BD_ATA_MODES mode; // mode see enum BD_ATA_MODES
 
+    bool lba_;          // drive supports LBA28 addressing
+    bool lba48_;        // drive supports LBA48 addressing
+
+    // sectors per data block of READ/WRITE MULTIPLE, 0 if not used
+    uint32 multiple_sectors_;
+
+    // the controller was reset, the multiple mode has to be set again
+    bool multiple_mode_lost_;
+
+    /**
+     * a Physical Region Descriptor, the PRD table describes the memory
+     * regions of a DMA transfer (64K at most, not crossing a 64K boundary)
+     *
+     */
+    typedef struct PRD_
+    {
+      uint32 phys_addr;
+      uint16 byte_count;  // 0 means 64K
+      uint16 flags;       // 0x8000 marks the last entry
+    } __attribute__((packed)) PRD;
+
+    static const uint32 MAX_PRDS = 4096 / sizeof(PRD);
+
+    uint16 bus_master_port_;  // bus-master registers of the channel
+    PRD *prd_table_;          // one physical page, accessed via the ident mapping
+    uint32 prd_table_phys_;
+    bool dma_active_;         // a DMA transfer is running
+
     BDRequest *request_list_;
     BDRequest *request_list_tail_;
 
-    Mutex lock_;
+    // held from issuing a request until it is completed, shared with the
+    // other drive of the channel
+    Mutex &channel_lock_;
 };
 
 #endif
@@ -65,6 +65,27 @@ public:
    */
   uint32 doDeviceDetection ( );
 
+  /**
+   * searches the PCI bus 0 for an IDE controller capable of bus-master DMA
+   * (e.g. the PIIX of QEMU) and enables it as bus-master
+   * @return the I/O base of the primary channel's bus-master registers
+   * (the secondary channel's are at +8) or 0 if there is none
+   *
+   */
+  uint16 findBusMasterPort ( );
+
+  /**
+   * reads a double word from the PCI configuration space
+   *
+   */
+  uint32 readPCIConfig ( uint8 bus, uint8 device, uint8 function, uint8 reg );
+
+  /**
+   * writes a double word to the PCI configuration space
+   *
+   */
+  void writePCIConfig ( uint8 bus, uint8 device, uint8 function, uint8 reg, uint32 value );
+
 };
 
 #endif
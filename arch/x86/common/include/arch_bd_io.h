@@ -123,6 +123,29 @@ class bdio {
     return _res;
   };
 
+  /**
+   *
+   * writes a double word to the IO port
+   *
+   */
+  static void outl( uint16 port, uint32 value)
+  {
+    asm volatile ( "outl %0, %w1" : : "a" (value), "Nd" (port) );
+  };
+
+  /**
+   *
+   * reads a double word from the IO port
+   *
+   */
+  static uint32 inl ( uint16 port)
+  {
+    uint32 _res;
+    asm volatile ( "inl %w1, %0" : "=a" (_res) : "Nd" (port)  );
+
+    return _res;
+  };
+
 };
 
 #endif
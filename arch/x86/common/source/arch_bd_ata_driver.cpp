@@ -12,10 +12,13 @@
 
 #include "Scheduler.h"
 #include "kprintf.h"
+#include "ArchMemory.h"
+#include "PageManager.h"
 
 #define TIMEOUT_WARNING() do { kprintfd("%s:%d: timeout. THIS MIGHT CAUSE SERIOUS TROUBLE!\n", __PRETTY_FUNCTION__, __LINE__); } while (0)
 
-ATADriver::ATADriver( uint16 baseport, uint16 getdrive, uint16 irqnum ) : lock_("ATADriver::lock_")
+ATADriver::ATADriver( uint16 baseport, uint16 getdrive, uint16 irqnum, Mutex &channel_lock ) :
+    channel_lock_(channel_lock)
 {
   debug(ATA_DRIVER, "ctor: Entered with irgnum %d and baseport %d!!\n", irqnum, baseport);
 
@@ -25,8 +28,17 @@ ATADriver::ATADriver( uint16 baseport, uint16 getdrive, uint16 irqnum ) : lock_(
 
   debug(ATA_DRIVER, "ctor: Requesting disk geometry !!\n");
 
+  lba_ = false;
+  lba48_ = false;
+  multiple_sectors_ = 0;
+  multiple_mode_lost_ = false;
+  bus_master_port_ = 0;
+  prd_table_ = 0;
+  prd_table_phys_ = 0;
+  dma_active_ = false;
+
   outbp (port + 6, drive);  // Get first drive
-  outbp (port + 7, 0xEC);   // Get drive info data
+  outbp (port + 7, ATA_IDENTIFY);   // Get drive info data
   while (  inbp(port + 7) != 0x58 && jiffies++ < IO_TIMEOUT )
     ArchInterrupts::yieldIfIFSet();
 
@@ -48,6 +60,20 @@ ATADriver::ATADriver( uint16 baseport, uint16 getdrive, uint16 irqnum ) : lock_(
   uint32 CYLS = dd[1];
   numsec = CYLS * HPC * SPT;
 
+  // the CHS geometry is limited to ~8GB, larger drives have to be
+  // addressed by LBA (capacity in words 60-61, resp. 100-103 for LBA48)
+  lba_ = (dd[49] & (1 << 9)) != 0;
+  lba48_ = lba_ && (dd[83] & (1 << 10)) != 0;
+
+  if( lba48_ )
+    numsec = (dd[102] || dd[103]) ? 0xFFFFFFFF : (dd[100] | ((uint32)dd[101] << 16));
+  else if( lba_ )
+    numsec = dd[60] | ((uint32)dd[61] << 16);
+
+  debug(ATA_DRIVER, "ctor: LBA28: %d, LBA48: %d, %d sectors\n", lba_, lba48_, numsec);
+
+  setMultipleMode();
+
   bool interrupt_context = ArchInterrupts::disableInterrupts();
   ArchInterrupts::enableInterrupts();
 
@@ -97,98 +123,229 @@ int32 ATADriver::rawReadSector ( uint32 start_sector, uint32 num_sectors, void *
   return result;
 }
 
-int32 ATADriver::readSector ( uint32 start_sector, uint32 num_sectors, void *buffer )
+bool ATADriver::waitNotBusy()
 {
-  assert(buffer || (start_sector == 0 && num_sectors == 1));
-  //MutexLock mlock(lock_);
-  /* Wait for drive to clear BUSY */
   jiffies = 0;
   while((inbp(port+7) & 0x80) && jiffies++ < IO_TIMEOUT)
     ArchInterrupts::yieldIfIFSet();
   if(jiffies >= IO_TIMEOUT)
   {
     TIMEOUT_WARNING();
-    return -1;
+    return false;
   }
+  return true;
+}
 
-  //The equations to convert from LBA to CHS follow:
-  //CYL = LBA / (HPC * SPT)
-  //TEMP = LBA % (HPC * SPT)
-  //HEAD = TEMP / SPT
-  //SECT = TEMP % SPT + 1
-  //Where:
-  //LBA: linear base address of the block
-  //CYL: value of the cylinder CHS coordinate
-  //HPC: number of heads per cylinder for the disk
-  //HEAD: value of the head CHS coordinate
-  //SPT: number of sectors per track for the disk
-  //SECT: value of the sector CHS coordinate
-  //TEMP: buffer to hold a temporary value
-  //
-  // This equation is used very often by operating systems such as DOS 
-  // (or SWEB) to calculate the CHS values it needs to send to the disk 
-  // controller or INT13h in order to read or write data.
-
-  uint32 LBA = start_sector;
-  uint32 cyls = LBA / (HPC * SPT);
-  uint32 TEMP = LBA % (HPC * SPT);
-  uint32 head = TEMP / SPT;
-  uint32 sect = TEMP % SPT + 1;
-
-  uint8 high = cyls >> 8;
-  uint8 lo = cyls & 0x00FF;
-
-  //debug(ATA_DRIVER, "readSector:(drive | head): %d, num_sectors: %d, sect: %d, lo: %d, high: %d!!\n",(drive | head),num_sectors,sect,lo,high);
-
-  outbp(port + 6, (drive | head)); // drive and head selection
-  outbp(port + 2, num_sectors); // number of sectors to read
-  outbp(port + 3, sect); // starting sector
-  outbp(port + 4, lo); // cylinder low
-  outbp(port + 5, high); // cylinder high
-
-  /* Wait for drive to set DRDY */
+bool ATADriver::waitForData()
+{
   jiffies = 0;
-  while (!(inbp(port + 7) & 0x40) && jiffies++ < IO_TIMEOUT)
+  uint8 status;
+  // the other status bits are only valid as soon as BUSY is cleared
+  while((((status = inbp(port + 7)) & 0x80) || !(status & 0x09)) && jiffies++ < IO_TIMEOUT)
     ArchInterrupts::yieldIfIFSet();
-  if (jiffies >= IO_TIMEOUT)
+
+  if(jiffies >= IO_TIMEOUT)
   {
     TIMEOUT_WARNING();
-    return -1;
+    return false;
   }
+  if(status & 0x01)
+  {
+    debug(ATA_DRIVER, "waitForData: drive reported error %x\n", inbp(port + 1));
+    return false;
+  }
+  return true;
+}
 
+void ATADriver::setMultipleMode()
+{
+  multiple_mode_lost_ = false;
 
-  for (int i = 0;; ++i)
-  {
+  // word 47: maximal number of sectors per block of READ/WRITE MULTIPLE
+  uint32 max_multiple = dd[47] & 0xFF;
+  multiple_sectors_ = 0;
+  if( max_multiple == 0 )
+    return;
+
+  // the command's IRQ is not wanted here (nIEN)
+  outbp( port + 0x206, 0x02 );
 
-    /* Write the command code to the command register */
-    outbp(port + 7, 0x20); // command
+  outbp( port + 6, drive );
+  outbp( port + 2, max_multiple );
+  outbp( port + 7, ATA_SET_MULTIPLE_MODE );
 
-    if (mode != BD_PIO_NO_IRQ)
+  if( waitNotBusy() && !(inbp(port + 7) & 0x01) )
+    multiple_sectors_ = max_multiple;
+
+  outbp( port + 0x206, 0x00 );
+
+  debug(ATA_DRIVER, "setMultipleMode: %d sectors per block\n", multiple_sectors_);
+}
+
+uint8 ATADriver::selectSectors( uint32 start_sector, uint32 num_sectors, bool write, bool dma )
+{
+  if( num_sectors == 0 )
+    return 0;
+
+  bool multiple = multiple_sectors_ != 0;
+
+  if( lba48_ && (num_sectors > 256 || start_sector + num_sectors > 0x0FFFFFFF) )
+  {
+    if( num_sectors > 65536 )
       return 0;
 
-    jiffies = 0;
-    while (inbp(port + 7) != 0x58 && jiffies++ < IO_TIMEOUT)
-      ArchInterrupts::yieldIfIFSet();
-    if (jiffies >= IO_TIMEOUT)
-    {
-      if (i == 3)
-      {
-        TIMEOUT_WARNING();
-        return -1;
-      }
-    }
-    else
-      break;
+    // the high order bytes go first, a count of 0 means 65536 sectors
+    outbp(port + 6, drive | 0x40);
+    outbp(port + 2, (num_sectors >> 8) & 0xFF);
+    outbp(port + 3, start_sector >> 24);
+    outbp(port + 4, 0);
+    outbp(port + 5, 0);
+    outbp(port + 2, num_sectors & 0xFF);
+    outbp(port + 3, start_sector & 0xFF);
+    outbp(port + 4, (start_sector >> 8) & 0xFF);
+    outbp(port + 5, (start_sector >> 16) & 0xFF);
+
+    if( dma )
+      return write ? ATA_WRITE_DMA_EXT : ATA_READ_DMA_EXT;
+    if( write )
+      return multiple ? ATA_WRITE_MULTIPLE_EXT : ATA_WRITE_SECTORS_EXT;
+    return multiple ? ATA_READ_MULTIPLE_EXT : ATA_READ_SECTORS_EXT;
   }
 
-  uint32 counter;
-  uint16 *word_buff = (uint16 *) buffer;
-  for (counter = 0; counter != (256*num_sectors); counter++)  // read sector
-      word_buff [counter] = inw ( port );
- 
+  // a count of 0 means 256 sectors
+  if( num_sectors > 256 )
+    return 0;
+
+  if( lba_ )
+  {
+    outbp(port + 6, drive | 0x40 | ((start_sector >> 24) & 0x0F)); // LBA bits 24-27
+    outbp(port + 2, num_sectors & 0xFF);
+    outbp(port + 3, start_sector & 0xFF);
+    outbp(port + 4, (start_sector >> 8) & 0xFF);
+    outbp(port + 5, (start_sector >> 16) & 0xFF);
+  }
+  else
+  {
+    //The equations to convert from LBA to CHS follow:
+    //CYL = LBA / (HPC * SPT)
+    //TEMP = LBA % (HPC * SPT)
+    //HEAD = TEMP / SPT
+    //SECT = TEMP % SPT + 1
+    //Where:
+    //LBA: linear base address of the block
+    //CYL: value of the cylinder CHS coordinate
+    //HPC: number of heads per cylinder for the disk
+    //HEAD: value of the head CHS coordinate
+    //SPT: number of sectors per track for the disk
+    //SECT: value of the sector CHS coordinate
+    //TEMP: buffer to hold a temporary value
+    //
+    // This equation is used very often by operating systems such as DOS
+    // (or SWEB) to calculate the CHS values it needs to send to the disk
+    // controller or INT13h in order to read or write data.
+    // It is only used for old drives without LBA support.
+
+    uint32 LBA = start_sector;
+    uint32 cyls = LBA / (HPC * SPT);
+    uint32 TEMP = LBA % (HPC * SPT);
+    uint32 head = TEMP / SPT;
+    uint32 sect = TEMP % SPT + 1;
+
+    uint8 high = cyls >> 8;
+    uint8 lo = cyls & 0x00FF;
+
+    outbp(port + 6, (drive | head)); // drive and head selection
+    outbp(port + 2, num_sectors & 0xFF); // number of sectors
+    outbp(port + 3, sect); // starting sector
+    outbp(port + 4, lo); // cylinder low
+    outbp(port + 5, high); // cylinder high
+  }
+
+  if( dma )
+    return write ? ATA_WRITE_DMA : ATA_READ_DMA;
+  if( write )
+    return multiple ? ATA_WRITE_MULTIPLE : ATA_WRITE_SECTORS;
+  return multiple ? ATA_READ_MULTIPLE : ATA_READ_SECTORS;
+}
+
+bool ATADriver::enableDMA( uint16 bus_master_port )
+{
+  // word 49 bit 8: DMA supported, the completion of a DMA transfer is
+  // signaled by an IRQ only
+  if( bus_master_port == 0 || mode != BD_PIO || !(dd[49] & (1 << 8)) )
+    return false;
+
+  if( prd_table_ == 0 )
+  {
+    uint32 ppn = PageManager::instance()->getFreePhysicalPage( PAGE_KERNEL );
+    prd_table_ = (PRD *) ArchMemory::getIdentAddressOfPPN( ppn );
+    prd_table_phys_ = ppn * PAGE_SIZE;
+  }
+
+  bus_master_port_ = bus_master_port;
+  mode = BD_DMA;
+
+  debug(ATA_DRIVER, "enableDMA: bus-master port %x, PRD table at %x\n", bus_master_port_, prd_table_phys_);
+  return true;
+}
+
+int32 ATADriver::startDMA( uint32 start_sector, uint32 num_sectors, void *buffer, bool write )
+{
+  // the PRD byte counts have to be even
+  if( ((pointer) buffer) & 0x1 )
+    return 1;
+
+  // describe the (virtually contiguous) buffer page by page
+  pointer vaddr = (pointer) buffer;
+  uint32 bytes_left = num_sectors * getSectorSize();
+  uint32 num_prds = 0;
+
+  while( bytes_left > 0 )
+  {
+    if( num_prds == MAX_PRDS )
+      return 1;
+
+    pointer ppn = 0;
+    pointer page_size = ArchMemory::get_PPN_Of_VPN_In_KernelMapping( vaddr / PAGE_SIZE, &ppn );
+    if( page_size == 0 )
+      return 1;
+
+    uint32 phys_addr = ppn * page_size + (vaddr % page_size);
+    uint32 len = page_size - (vaddr % page_size);
+    uint32 to_boundary = 0x10000 - (phys_addr & 0xFFFF);
+    if( len > to_boundary )
+      len = to_boundary;
+    if( len > bytes_left )
+      len = bytes_left;
+
+    prd_table_[num_prds].phys_addr = phys_addr;
+    prd_table_[num_prds].byte_count = len & 0xFFFF;
+    prd_table_[num_prds].flags = 0;
+    num_prds++;
+
+    vaddr += len;
+    bytes_left -= len;
+  }
+  prd_table_[num_prds - 1].flags = 0x8000;
+
   /* Wait for drive to clear BUSY */
+  if(!waitNotBusy())
+    return -1;
+
+  uint8 command = selectSectors( start_sector, num_sectors, write, true );
+  if( command == 0 )
+    return -1;
+
+  // stop the engine, load the PRD table, clear the IRQ and error bits
+  // and set the direction (bit 3 set: the controller writes to memory)
+  outbp( bus_master_port_, 0x00 );
+  outl( bus_master_port_ + 4, prd_table_phys_ );
+  outbp( bus_master_port_ + 2, inbp( bus_master_port_ + 2 ) | 0x06 );
+  outbp( bus_master_port_, write ? 0x00 : 0x08 );
+
+  /* Wait for drive to set DRDY */
   jiffies = 0;
-  while((inbp(port+7) & 0x80) && jiffies++ < IO_TIMEOUT)
+  while(!(inbp(port+7) & 0x40) && jiffies++ < IO_TIMEOUT)
     ArchInterrupts::yieldIfIFSet();
   if(jiffies >= IO_TIMEOUT)
   {
@@ -196,44 +353,134 @@ int32 ATADriver::readSector ( uint32 start_sector, uint32 num_sectors, void *buf
     return -1;
   }
 
-  //debug(ATA_DRIVER, "readSector:Read successfull !!\n");
-  return 0;  
+  dma_active_ = true;
+
+  outbp( port + 7, command );
+  outbp( bus_master_port_, (write ? 0x00 : 0x08) | 0x01 ); // start
+
+  return 0;
 }
 
-int32 ATADriver::writeSector ( uint32 start_sector, uint32 num_sectors, void * buffer )
+void ATADriver::finishDMA( BDRequest *br )
 {
-  assert(buffer);
+  uint8 bm_status = inbp( bus_master_port_ + 2 );
+  outbp( bus_master_port_, 0x00 ); // stop the engine
+  outbp( bus_master_port_ + 2, bm_status | 0x06 );
+
+  // reading the status register acknowledges the drive's IRQ
+  uint8 status = inbp( port + 7 );
+
+  dma_active_ = false;
+
+  if( (bm_status & 0x02) || (status & 0x01) )
+  {
+    debug(ATA_DRIVER, "finishDMA: DMA transfer failed (bus-master status %x, status %x)\n", bm_status, status);
+    finishRequest( br, BDRequest::BD_ERROR );
+  }
+  else
+  {
+    br->setBlocksDone( br->getNumBlocks() );
+    finishRequest( br, BDRequest::BD_DONE );
+  }
+}
+
+int32 ATADriver::readSector ( uint32 start_sector, uint32 num_sectors, void *buffer )
+{
+  assert(buffer || (start_sector == 0 && num_sectors == 1));
   //MutexLock mlock(lock_);
   /* Wait for drive to clear BUSY */
+  if(!waitNotBusy())
+    return -1;
+
+  if(multiple_mode_lost_)
+    setMultipleMode();
+
+  if(mode == BD_DMA)
+  {
+    int32 res = startDMA(start_sector, num_sectors, buffer, false);
+    if(res <= 0)
+      return res;
+  }
+
+  uint8 command = selectSectors(start_sector, num_sectors, false);
+  if(command == 0)
+  {
+    debug(ATA_DRIVER, "readSector: can not address %d sectors at %d\n", num_sectors, start_sector);
+    return -1;
+  }
+
+  //debug(ATA_DRIVER, "readSector: command: %x, start_sector: %d, num_sectors: %d\n", command, start_sector, num_sectors);
+
+  /* Wait for drive to set DRDY */
   jiffies = 0;
-  while((inbp(port+7) & 0x80) && jiffies++ < IO_TIMEOUT)
+  while (!(inbp(port + 7) & 0x40) && jiffies++ < IO_TIMEOUT)
     ArchInterrupts::yieldIfIFSet();
-  if(jiffies >= IO_TIMEOUT)
+  if (jiffies >= IO_TIMEOUT)
   {
     TIMEOUT_WARNING();
     return -1;
   }
 
+  /* Write the command code to the command register */
+  outbp(port + 7, command);
+
+  if (mode != BD_PIO_NO_IRQ)
+    return 0;
+
+  // the drive requests one data block (of getSectorsPerBlock() sectors)
+  // after the other
   uint16 *word_buff = (uint16 *) buffer;
+  uint32 sectors_done = 0;
+  while (sectors_done < num_sectors)
+  {
+    if (!waitForData())
+      return -1;
 
-  // This equation is used very often by operating systems such as DOS 
-  // (or SWEB) to calculate the CHS values it needs to send to the disk 
-  // controller or INT13h in order to read or write data.
+    uint32 block = getSectorsPerBlock();
+    if (block > num_sectors - sectors_done)
+      block = num_sectors - sectors_done;
+
+    uint32 counter;
+    for (counter = sectors_done * 256; counter != (sectors_done + block) * 256; counter++)  // read block
+      word_buff [counter] = inw ( port );
 
-  uint32 LBA = start_sector;
-  uint32 cyls = LBA / (HPC * SPT);
-  uint32 TEMP = LBA % (HPC * SPT);
-  uint32 head = TEMP / SPT;
-  uint32 sect = TEMP % SPT + 1;
+    sectors_done += block;
+  }
 
+  /* Wait for drive to clear BUSY */
+  if(!waitNotBusy())
+    return -1;
 
-  uint8 high = cyls >> 8;
-  uint8 lo = cyls & 0x00FF;
-  outbp( port + 6, (drive | head) ); // drive and head selection
-  outbp( port + 2, num_sectors );    // number of sectors to write
-  outbp( port + 3, sect );           // starting sector
-  outbp( port + 4, lo );             // cylinder low
-  outbp( port + 5, high );           // cylinder high
+  //debug(ATA_DRIVER, "readSector:Read successfull !!\n");
+  return 0;
+}
+
+int32 ATADriver::writeSector ( uint32 start_sector, uint32 num_sectors, void * buffer )
+{
+  assert(buffer);
+  //MutexLock mlock(lock_);
+  /* Wait for drive to clear BUSY */
+  if(!waitNotBusy())
+    return -1;
+
+  if(multiple_mode_lost_)
+    setMultipleMode();
+
+  if(mode == BD_DMA)
+  {
+    int32 res = startDMA(start_sector, num_sectors, buffer, true);
+    if(res <= 0)
+      return res;
+  }
+
+  uint16 *word_buff = (uint16 *) buffer;
+
+  uint8 command = selectSectors(start_sector, num_sectors, true);
+  if(command == 0)
+  {
+    debug(ATA_DRIVER, "writeSector: can not address %d sectors at %d\n", num_sectors, start_sector);
+    return -1;
+  }
 
   /* Wait for drive to set DRDY */
   jiffies = 0;
@@ -245,58 +492,66 @@ int32 ATADriver::writeSector ( uint32 start_sector, uint32 num_sectors, void * b
     return -1;
   }
 
-
   /* Write the command code to the command register */
-  outbp( port + 7, 0x30 );           // command
+  outbp( port + 7, command );
 
-  jiffies = 0;
-  while( inbp( port + 7 ) != 0x58  && jiffies++ < IO_TIMEOUT)
-    ArchInterrupts::yieldIfIFSet();
-
-  if(jiffies >= IO_TIMEOUT )
+  // the drive requests one data block (of getSectorsPerBlock() sectors)
+  // after the other, with IRQs all but the first one are written by
+  // serviceIRQ()
+  uint32 sectors_done = 0;
+  while( sectors_done < num_sectors )
   {
-    TIMEOUT_WARNING();
-    return -1;
-  }
+    if( !waitForData() )
+      return -1;
 
+    uint32 block = getSectorsPerBlock();
+    if( block > num_sectors - sectors_done )
+      block = num_sectors - sectors_done;
 
-  uint32 count2 = (256*num_sectors);
-  if( mode != BD_PIO_NO_IRQ )
-    count2 = 256;
+    uint32 counter;
+    for (counter = sectors_done * 256; counter != (sectors_done + block) * 256; counter++)
+        outw ( port, word_buff [counter] );
+
+    sectors_done += block;
+
+    if( mode != BD_PIO_NO_IRQ )
+      return 0;
+  }
 
-  uint32 counter;
-  for (counter = 0; counter != count2; counter++) 
-      outw ( port, word_buff [counter] );
- 
   /* Wait for drive to clear BUSY */
-  jiffies = 0;
-  while((inbp(port+7) & 0x80) && jiffies++ < IO_TIMEOUT)
-    ArchInterrupts::yieldIfIFSet();
-  if(jiffies >= IO_TIMEOUT)
-  {
-    TIMEOUT_WARNING();
+  if(!waitNotBusy())
+    return -1;
+
+  // NOTE: the data may still be in the drive's write cache, it is
+  // written to the disk by flushCache() on sync barriers
+  return 0;
+}
+
+int32 ATADriver::flushCache()
+{
+  if(!waitNotBusy())
     return -1;
-  }
 
   /* Write flush code to the command register */
-  outbp (port + 7, 0xE7);
-    
+  outbp( port + 6, drive );
+  outbp( port + 7, lba48_ ? ATA_FLUSH_CACHE_EXT : ATA_FLUSH_CACHE );
+
+  if( mode != BD_PIO_NO_IRQ )
+    return 0;
+
   /* Wait for drive to clear BUSY */
-  jiffies = 0;
-  while((inbp(port+7) & 0x80) && jiffies++ < IO_TIMEOUT)
-    ArchInterrupts::yieldIfIFSet();
-  if(jiffies >= IO_TIMEOUT)
-  {
-    TIMEOUT_WARNING();
+  if(!waitNotBusy())
+    return -1;
+
+  if( inbp(port + 7) & 0x01 )
     return -1;
-  }
 
   return 0;
 }
 
 uint32 ATADriver::addRequest( BDRequest *br )
 {
-  MutexLock lock(lock_);
+  MutexLock lock(channel_lock_);
   bool interrupt_context = false;
   debug(ATA_DRIVER, "addRequest %d!\n", br->getCmd() );
   if( mode != BD_PIO_NO_IRQ )
@@ -323,6 +578,9 @@ uint32 ATADriver::addRequest( BDRequest *br )
     case BDRequest::BD_WRITE:
       res = writeSector( br->getStartBlock(), br->getNumBlocks(), br->getBuffer() );
       break;
+    case BDRequest::BD_FLUSH:
+      res = flushCache();
+      break;
     default:
       res = -1;
       break;
@@ -330,10 +588,12 @@ uint32 ATADriver::addRequest( BDRequest *br )
   
   if( res != 0 )
   {
-    br->setStatus( BDRequest::BD_ERROR );
     debug(ATA_DRIVER, "Got out on error !!\n");
-      if( interrupt_context )
-        ArchInterrupts::enableInterrupts();
+    if( mode != BD_PIO_NO_IRQ )
+      removeRequest( br );
+    br->setStatus( BDRequest::BD_ERROR );
+    if( interrupt_context )
+      ArchInterrupts::enableInterrupts();
     return 0;
   }
 
@@ -344,12 +604,77 @@ uint32 ATADriver::addRequest( BDRequest *br )
     return 0;
   }
 
-  if( currentThread )
-    Scheduler::instance()->sleepAndRestoreInterrupts(interrupt_context);
+  if( interrupt_context )
+    ArchInterrupts::enableInterrupts();
+
+  // sleep until serviceIRQ() completes the request, the channel lock stays
+  // held, so neither this drive nor the other drive of the channel is
+  // disturbed by the next request meanwhile
+  if( br->waitForCompletion() == BDRequest::BD_QUEUED )
+    cancelRequest( br );
 
   return 0;
 }
 
+void ATADriver::removeRequest( BDRequest *br )
+{
+  BDRequest *prev = 0;
+  BDRequest *cur = request_list_;
+  while( cur && cur != br )
+  {
+    prev = cur;
+    cur = cur->getNextRequest();
+  }
+
+  if( cur == 0 )
+    return;
+
+  if( prev )
+    prev->setNextRequest( br->getNextRequest() );
+  else
+    request_list_ = br->getNextRequest();
+
+  if( request_list_tail_ == br )
+    request_list_tail_ = prev;
+
+  br->setNextRequest( 0 );
+}
+
+void ATADriver::finishRequest( BDRequest *br, BDRequest::BD_RESULT status )
+{
+  removeRequest( br );
+  br->complete( status );
+}
+
+void ATADriver::cancelRequest( BDRequest *br )
+{
+  bool interrupt_context = ArchInterrupts::disableInterrupts();
+
+  // the IRQ could have arrived in the meantime
+  if( br->getStatus() == BDRequest::BD_QUEUED )
+  {
+    debug(ATA_DRIVER, "cancelRequest: request timed out, resetting the controller\n");
+    TIMEOUT_WARNING();
+
+    removeRequest( br );
+
+    if( dma_active_ )
+    {
+      outbp( bus_master_port_, 0x00 );
+      dma_active_ = false;
+    }
+
+    outbp( port + 0x206, 0x04 );
+    outbp( port + 0x206, 0x00 ); // RESET
+    multiple_mode_lost_ = true;
+
+    br->setStatus( BDRequest::BD_ERROR );
+  }
+
+  if( interrupt_context )
+    ArchInterrupts::enableInterrupts();
+}
+
 bool ATADriver::waitForController( bool resetIfFailed = true )
 {
   uint32 jiffies = 0;
@@ -364,6 +689,7 @@ bool ATADriver::waitForController( bool resetIfFailed = true )
       debug(ATA_DRIVER, "waitForController: reseting\n");
       outbp( port + 0x206, 0x04 );
       outbp( port + 0x206, 0x00 ); // RESET
+      multiple_mode_lost_ = true;
     }
     return false;
   }
@@ -380,6 +706,7 @@ void ATADriver::serviceIRQ()
     debug(ATA_DRIVER, "serviceIRQ: IRQ without request!!\n");
     outbp( port + 0x206, 0x04 );
     outbp( port + 0x206, 0x00 ); // RESET COTROLLER
+    multiple_mode_lost_ = true;
     debug(ATA_DRIVER, "serviceIRQ: Reset controller!!\n");
     return; // not my interrupt
   }
@@ -387,73 +714,72 @@ void ATADriver::serviceIRQ()
   BDRequest *br = request_list_;
   debug(ATA_DRIVER, "serviceIRQ: Found active request!!\n");
 
+  if( dma_active_ )
+  {
+    finishDMA( br );
+    return;
+  }
+
   uint16 *word_buff = (uint16 *) br->getBuffer();
   uint32 counter;
   uint32 blocks_done = br->getBlocksDone();
 
+  // every IRQ stands for one data block of up to getSectorsPerBlock() sectors
+  uint32 block = getSectorsPerBlock();
+  if( block > br->getNumBlocks() - blocks_done )
+    block = br->getNumBlocks() - blocks_done;
+
   if( br->getCmd() == BDRequest::BD_READ )
   {
     if( !waitForController() )
     {
-      br->setStatus( BDRequest::BD_ERROR );
-      if( br->getThread() )		
-        Scheduler::instance()->wake( br->getThread() );
-      request_list_ = br->getNextRequest();
+      finishRequest( br, BDRequest::BD_ERROR );
       return;
     }
 
-    for(counter = blocks_done * 256; counter!=(blocks_done + 1) * 256; counter++ )
+    for(counter = blocks_done * 256; counter!=(blocks_done + block) * 256; counter++ )
       word_buff [counter] = inw ( port );
 
-    blocks_done++;
+    blocks_done += block;
     br->setBlocksDone( blocks_done );
 
     if( blocks_done == br->getNumBlocks() )
-    {
-      br->setStatus( BDRequest::BD_DONE );
-      request_list_ = br->getNextRequest();
-      if( br->getThread() )
-        Scheduler::instance()->wake( br->getThread() );
-    }
+      finishRequest( br, BDRequest::BD_DONE );
   }
   else if( br->getCmd() == BDRequest::BD_WRITE )
   {
-    blocks_done++;
+    // the block written by the last IRQ (or by writeSector()) is done
+    blocks_done += block;
     if( blocks_done == br->getNumBlocks() )
     {
       debug(ATA_DRIVER, "serviceIRQ:All done!!\n");
-      br->setStatus( BDRequest::BD_DONE );
-      debug(ATA_DRIVER, "serviceIRQ:Waking up thread!!\n");
-      request_list_ = br->getNextRequest();
-
-      if( br->getThread() )
-        Scheduler::instance()->wake( br->getThread() );
-
+      finishRequest( br, BDRequest::BD_DONE );
     }
     else
     {
       if( !waitForController() )
       {
-        br->setStatus( BDRequest::BD_ERROR );
-        if( br->getThread() )
-           Scheduler::instance()->wake( br->getThread() );
-        request_list_ = br->getNextRequest();
+        finishRequest( br, BDRequest::BD_ERROR );
         return;
       }
-	
-      for(counter = blocks_done*256; counter != (blocks_done + 1) * 256; counter++ )
+
+      block = getSectorsPerBlock();
+      if( block > br->getNumBlocks() - blocks_done )
+        block = br->getNumBlocks() - blocks_done;
+
+      for(counter = blocks_done*256; counter != (blocks_done + block) * 256; counter++ )
         outw ( port, word_buff [counter] );
 
       br->setBlocksDone( blocks_done );
     }
   }
+  else if( br->getCmd() == BDRequest::BD_FLUSH )
+  {
+    finishRequest( br, (inbp( port + 7 ) & 0x01) ? BDRequest::BD_ERROR : BDRequest::BD_DONE );
+  }
   else
   {
-    blocks_done = br->getNumBlocks();
-    br->setStatus( BDRequest::BD_ERROR );
-    request_list_ = br->getNextRequest();
-    if( br->getThread() )
-      Scheduler::instance()->wake( br->getThread() );
+    finishRequest( br, BDRequest::BD_ERROR );
   }
 
   debug(ATA_DRIVER, "serviceIRQ:Request handled!!\n");
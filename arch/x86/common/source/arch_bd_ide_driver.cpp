@@ -12,6 +12,7 @@
 #include "string.h"
 #include "ArchInterrupts.h"
 #include "kprintf.h"
+#include "Mutex.h"
 
 uint32 IDEDriver::doDeviceDetection()
 {
@@ -25,6 +26,12 @@ uint32 IDEDriver::doDeviceDetection()
 
    uint8 ata_irqs[4] = { 14, 15, 11, 9 };
 
+   uint16 bus_master_port = findBusMasterPort();
+
+   // master and slave share the registers of their channel (including the
+   // bus-master registers), so their requests are serialized per channel
+   Mutex *channel_locks[2] = { 0, 0 };
+
    // setup register values
    devCtrl = 0x00; // please use interrupts
 
@@ -129,7 +136,13 @@ uint32 IDEDriver::doDeviceDetection()
                   debug(IDE_DRIVER, "doDetection: Found PATA ! \n");
                   debug(IDE_DRIVER, "doDetection: port: %4X, drive: %d \n", base_port, cs%2);
 
-                  ATADriver *drv = new ATADriver( base_port, cs % 2, ata_irqs[cs] );
+                  if( channel_locks[cs / 2] == 0 )
+                    channel_locks[cs / 2] = new Mutex( "IDEDriver::channel_lock" );
+
+                  ATADriver *drv = new ATADriver( base_port, cs % 2, ata_irqs[cs], *channel_locks[cs / 2] );
+                  if( bus_master_port != 0 && cs < 2 )
+                    drv->enableDMA( bus_master_port );
+
                   BDVirtualDevice *bdv = new BDVirtualDevice( drv, 0, drv->getNumSectors(),
                   drv->getSectorSize(), name, true);
 
@@ -146,8 +159,13 @@ uint32 IDEDriver::doDeviceDetection()
 
                   debug(IDE_DRIVER, "doDetection: Running SATA device as PATA in compatibility mode! \n");
 
+                  if( channel_locks[cs / 2] == 0 )
+                    channel_locks[cs / 2] = new Mutex( "IDEDriver::channel_lock" );
+
                   ATADriver *drv = new
-                  ATADriver( base_port, cs % 2, ata_irqs[cs] );
+                  ATADriver( base_port, cs % 2, ata_irqs[cs], *channel_locks[cs / 2] );
+                  if( bus_master_port != 0 && cs < 2 )
+                    drv->enableDMA( bus_master_port );
 
                   BDVirtualDevice *bdv = new
                   BDVirtualDevice( drv, 0, drv->getNumSectors(),                     drv->getSectorSize(), name, true);
@@ -246,3 +264,48 @@ int32 IDEDriver::processMBR  ( ATADriver * drv, uint32 sector, uint32 SPT, char
   debug(IDE_DRIVER, "processMBR:, done with partitions \n");
   return 0;
 }
+
+uint32 IDEDriver::readPCIConfig( uint8 bus, uint8 device, uint8 function, uint8 reg )
+{
+  outl( 0xCF8, 0x80000000 | (bus << 16) | (device << 11) | (function << 8) | (reg & 0xFC) );
+  return inl( 0xCFC );
+}
+
+void IDEDriver::writePCIConfig( uint8 bus, uint8 device, uint8 function, uint8 reg, uint32 value )
+{
+  outl( 0xCF8, 0x80000000 | (bus << 16) | (device << 11) | (function << 8) | (reg & 0xFC) );
+  outl( 0xCFC, value );
+}
+
+uint16 IDEDriver::findBusMasterPort()
+{
+  for( uint8 device = 0; device < 32; device++ )
+  {
+    for( uint8 function = 0; function < 8; function++ )
+    {
+      uint32 id = readPCIConfig( 0, device, function, 0x00 );
+      if( (id & 0xFFFF) == 0xFFFF )
+        continue;
+
+      // class 0x01 (mass storage), subclass 0x01 (IDE), prog-if bit 7: bus-master capable
+      uint32 class_code = readPCIConfig( 0, device, function, 0x08 );
+      if( (class_code >> 16) != 0x0101 || !(class_code & 0x8000) )
+        continue;
+
+      // BAR4 holds the I/O base of the bus-master registers
+      uint32 bar4 = readPCIConfig( 0, device, function, 0x20 );
+      if( !(bar4 & 0x1) || (bar4 & 0xFFFC) == 0 )
+        continue;
+
+      // enable I/O space access and bus-mastering
+      uint32 command = readPCIConfig( 0, device, function, 0x04 );
+      writePCIConfig( 0, device, function, 0x04, command | 0x05 );
+
+      debug(IDE_DRIVER, "findBusMasterPort: IDE controller %x at %d:%d, bus-master port %x\n", id, device, function, bar4 & 0xFFFC);
+      return bar4 & 0xFFFC;
+    }
+  }
+
+  debug(IDE_DRIVER, "findBusMasterPort: no bus-master IDE controller found\n");
+  return 0;
+}
@@ -65,21 +65,15 @@ int32 BDVirtualDevice::readData(uint32 offset, uint32 size, char *buffer)
    assert(offset % block_size_ == 0);
    assert(size % block_size_ == 0);
    debug(BD_VIRT_DEVICE, "readData\n");
-   uint32 blocks2read = size/block_size_, jiffies = 0;
+   uint32 blocks2read = size/block_size_;
    uint32 blockoffset = offset/block_size_;	
 
    debug(BD_VIRT_DEVICE, "blocks2read %d\n", blocks2read );
    BDRequest bd(dev_number_, BDRequest::BD_READ, blockoffset, blocks2read, buffer);
    addRequest ( &bd );
 
-   bool interrupt_context = ArchInterrupts::disableInterrupts();
-   ArchInterrupts::enableInterrupts();
-
-   while( bd.getStatus() == BDRequest::BD_QUEUED && jiffies++ < IO_TIMEOUT )
-     ArchInterrupts::yieldIfIFSet();
-
-   if( !interrupt_context )
-     ArchInterrupts::disableInterrupts();
+   // sleeps until the driver has completed the request
+   bd.waitForCompletion();
 
    if( bd.getStatus() != BDRequest::BD_DONE )
    {
@@ -93,25 +87,34 @@ int32 BDVirtualDevice::writeData(uint32 offset, uint32 size, char *buffer)
    assert(offset % block_size_ == 0);
    assert(size % block_size_ == 0);
    debug(BD_VIRT_DEVICE, "writeData\n");
-   uint32 blocks2write = size/block_size_, jiffies = 0;
+   uint32 blocks2write = size/block_size_;
    uint32 blockoffset = offset/block_size_;
 
    BDRequest bd(dev_number_ ,BDRequest::BD_WRITE, blockoffset, blocks2write, buffer);
    addRequest ( &bd );
 
-   bool interrupt_context = ArchInterrupts::disableInterrupts();
-   ArchInterrupts::enableInterrupts();
+   // sleeps until the driver has completed the request
+   bd.waitForCompletion();
 
-   while( bd.getStatus() == BDRequest::BD_QUEUED && jiffies++ < IO_TIMEOUT )
-     ArchInterrupts::yieldIfIFSet();
+   if( bd.getStatus() != BDRequest::BD_DONE )
+     return -1;
+   else
+     return size;
+};
 
-   if( !interrupt_context )
-     ArchInterrupts::disableInterrupts();
+int32 BDVirtualDevice::flushCache()
+{
+   debug(BD_VIRT_DEVICE, "flushCache\n");
+   BDRequest bd(dev_number_, BDRequest::BD_FLUSH);
+   addRequest ( &bd );
+
+   // sleeps until the driver has completed the request
+   bd.waitForCompletion();
 
    if( bd.getStatus() != BDRequest::BD_DONE )
      return -1;
    else
-     return size;
+     return 0;
 };
 
 void BDVirtualDevice::setPartitionType(uint8 part_type)
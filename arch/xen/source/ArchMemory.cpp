@@ -34,6 +34,7 @@
 
 #include "ArchMemory.h"
 #include "kprintf.h"
+#include "assert.h"
 #include "hypervisor.h"
 #include "xen_memory.h"
 #include "ArchCommon.h"
@@ -83,6 +84,35 @@ void ArchMemory::unmapPage(uint32 linear_page)
   checkAndRemovePT(pde_vpn);
 }
 
+void ArchMemory::setPageWriteable(uint32 linear_page, uint32 writeable)
+{
+  page_directory_entry *page_directory = (page_directory_entry *) getIdentAddressOfPPN(page_dir_page_);
+  uint32 pde_vpn = linear_page / PAGE_TABLE_ENTRIES;
+  uint32 pte_vpn = linear_page % PAGE_TABLE_ENTRIES;
+
+  page_table_entry *pte_base = (page_table_entry *) (PAGE_SIZE * mfn_to_pfn(
+                       page_directory[pde_vpn].pde4k.page_table_base_address));
+  assert(pte_base[pte_vpn].present);
+  pte_base[pte_vpn].writeable = writeable;
+}
+
+bool ArchMemory::checkAndClearDirty(uint32 linear_page)
+{
+  page_directory_entry *page_directory = (page_directory_entry *) getIdentAddressOfPPN(page_dir_page_);
+  uint32 pde_vpn = linear_page / PAGE_TABLE_ENTRIES;
+  uint32 pte_vpn = linear_page % PAGE_TABLE_ENTRIES;
+  if (!page_directory[pde_vpn].pde4k.present)
+    return false;
+
+  page_table_entry *pte_base = (page_table_entry *) (PAGE_SIZE * mfn_to_pfn(
+                       page_directory[pde_vpn].pde4k.page_table_base_address));
+  if (!pte_base[pte_vpn].present || !pte_base[pte_vpn].dirty)
+    return false;
+
+  pte_base[pte_vpn].dirty = 0;
+  return true;
+}
+
 void ArchMemory::insertPT(uint32 pde_vpn, uint32 physical_page_table_page)
 {
   page_directory_entry *page_directory = (page_directory_entry *) getIdentAddressOfPPN(page_dir_page_);
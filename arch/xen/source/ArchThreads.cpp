@@ -156,3 +156,14 @@ int32 ArchThreads::atomic_add(int32 &value, int32 increment)
   :);
   return ret;
 }
+
+uint32 ArchThreads::compareAndSwap(uint32 &value, uint32 expected, uint32 new_value)
+{
+  uint32 ret=expected;
+  __asm__ __volatile__(
+  "lock; cmpxchgl %2, %1;"
+  :"=a" (ret), "+m" (value)
+  :"r" (new_value), "a" (ret)
+  :"memory");
+  return ret;
+}
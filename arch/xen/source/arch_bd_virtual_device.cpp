@@ -18,3 +18,9 @@ void BDVirtualDevice::addRequest(BDRequest * command)
   return;
 };
 
+
+int32 BDVirtualDevice::flushCache()
+{
+  // there is no block device on xen yet, so there is no write cache either
+  return 0;
+};
@@ -30,9 +30,12 @@ public:
    * factory method
    * @param device the Device associated with the Cache, can be NULL if not wanted!
    * @param max_items maximal allowed items in the cache
+   * @param soft_limit number of pending writes that are written back in
+   * the background (see GeneralCache), by default there is no limit
    * @return a new instance of a GeneralCache
    */
-  virtual GeneralCache* getNewCache(DeviceAdapter* device, num_items_t max_items) const;
+  virtual GeneralCache* getNewCache(DeviceAdapter* device, num_items_t max_items,
+                                    num_items_t soft_limit = 0) const;
 
 protected:
 
@@ -9,6 +9,8 @@
 #ifndef CACHEITEM_H_
 #define CACHEITEM_H_
 
+#include "types.h"
+
 namespace Cache
 {
 
@@ -28,6 +30,20 @@ public:
   //virtual bool equals(const ItemIdentity& cmp) = 0;
   virtual bool operator==(const ItemIdentity& cmp) = 0;
 
+  /**
+   * hash value of the identity, used by hash-indexed read strategies
+   * two identities that compare equal have to return the same hash value
+   * @return the hash value of this identity
+   */
+  virtual uint32 hash(void) const = 0;
+
+  /**
+   * position of the item on the device, used to write back pending items
+   * in device order; neighbouring items should have neighbouring keys
+   * @return the order key, by default the hash value
+   */
+  virtual uint32 getOrderKey(void) const { return hash(); }
+
   /**
    * clones this object and returns a new instance of it
    * Located on the heap
@@ -51,6 +51,23 @@ public:
    */
   virtual bool add(const ItemIdentity& ident, Item* item) = 0;
 
+  /**
+   * adds an item that was read ahead and was not requested yet
+   * by default it is treated like any other new item
+   * @param ident the identity of the new item
+   * @param item the item's data
+   * @return true / false
+   */
+  virtual bool addPrefetched(const ItemIdentity& ident, Item* item) { return add(ident, item); }
+
+  /**
+   * checks whether an item with the given identity is in the cache,
+   * unlike get() this is not treated as an access to the item
+   * @param ident
+   * @return true if the item is present
+   */
+  virtual bool contains(const ItemIdentity& ident) { return get(ident) != NULL; }
+
   /**
    * removes an item from the read-cache pool
    *
@@ -59,9 +76,16 @@ public:
   virtual void removeItem(const ItemIdentity& ident) = 0;
 
   /**
-   * evicts an item according to the cache-strategy from the cache
+   * takes the item to evict according to the cache-strategy out of the
+   * cache, without writing it back. The victim is locked in the
+   * GeneralCache (see GeneralCache::lockFreeItem()), so it can't be read
+   * from the device again until the caller has written it back.
+   *
+   * @param[out] ident the identity of the victim, to be deleted by the caller
+   * @return the victim's data, to be deleted by the caller; NULL if no item
+   * is free
    */
-  virtual void evictItem(void) = 0;
+  virtual Item* evictItem(ItemIdentity*& ident) = 0;
 
   /**
    * clears all currently free items from the cache
@@ -98,6 +122,17 @@ public:
    */
   virtual void setCacheDevice(DeviceAdapter* cache_device) = 0;
 
+  /**
+   * applies the dirty thresholds of the cache, by default they are ignored
+   *
+   * @param soft_limit number of pending writes above which the writing back
+   * in the background is started
+   * @param hard_limit number of pending writes at which writers are
+   * throttled (0 for no limits at all)
+   */
+  virtual void setDirtyThresholds(num_items_t soft_limit __attribute__((unused)),
+                                  num_items_t hard_limit __attribute__((unused))) {}
+
   /**
    * queues a new write operation for the given item
    * the CacheWriteStrategy implementation will decide when the Item
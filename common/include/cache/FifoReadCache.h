@@ -53,9 +53,11 @@ public:
   virtual void removeItem(const ItemIdentity& ident);
 
   /**
-   * evicts an item according to the cache-strategy from the cache
+   * takes the item to evict according to the cache-strategy out of the cache
+   * @param[out] ident the identity of the victim
+   * @return the victim's data; NULL if no item is free
    */
-  virtual void evictItem(void);
+  virtual Item* evictItem(ItemIdentity*& ident);
 
   /**
    * clears all currently free items from the cache
@@ -9,10 +9,8 @@
 #define GENERALCACHE_H_
 
 #ifdef USE_FILE_SYSTEM_ON_GUEST_OS
-#include <map>
 #include "types.h"
 #else
-#include "ustl/umap.h"
 #include "Mutex.h"
 #endif
 
@@ -67,6 +65,42 @@ public:
 	 * @return true if the Item was successfully removed, false if not
 	 */
 	virtual bool remove(const ItemIdentity& ident, Item* item = NULL) = 0;
+
+	/**
+	 * reads several Items at once, a Device may merge the requests to
+	 * neighbouring Items into a single one. By default the Items are read
+	 * one after the other.
+	 *
+	 * @param idents the identities of the Items to read
+	 * @param[out] items filled with the read Items (NULL in case of an error)
+	 * @param num_items number of Items to read
+	 */
+	virtual void readItems(const ItemIdentity* const* idents, Item** items, uint32 num_items)
+	{
+	  for(uint32 i = 0; i < num_items; i++)
+	    items[i] = read(*idents[i]);
+	}
+
+	/**
+	 * writes several Items at once, the Items are sorted by their order
+	 * key, so a Device may merge the writes of neighbouring Items into a
+	 * single request. By default the Items are written one after the other.
+	 *
+	 * @param idents the identities of the Items to write
+	 * @param items the Items to write
+	 * @param num_items number of Items to write
+	 * @return true if all Items were written successfully
+	 */
+	virtual bool writeItems(const ItemIdentity* const* idents, Item* const* items, uint32 num_items)
+	{
+	  bool success = true;
+	  for(uint32 i = 0; i < num_items; i++)
+	  {
+	    if(!write(*idents[i], items[i]))
+	      success = false;
+	  }
+	  return success;
+	}
 };
 
 /**
@@ -109,7 +143,9 @@ public:
 	 * provided the Cache will be treated like a Read cache, write method will always
 	 * return with error codes
 	 *
-	 * @param soft_limit currently unused, ignored
+	 * @param soft_limit the number of pending (dirty) writes of the write strategy
+	 * above which they are written back in the background, 0 for no limit.
+	 * At half the hard limit writers are throttled.
 	 * @param hard_limit the maximal allowed elements in the cache
 	 */
 	GeneralCache(DeviceAdapter* cache_device,
@@ -171,6 +207,19 @@ public:
 	 */
 	virtual void addItem(const ItemIdentity& ident, Item* item);
 
+	/**
+	 * ReadCache: reads the given Items ahead of time from the Device and adds
+	 * them to the read-cache, without taking any reference to them.
+	 * Items that are already cached or that are currently in use are skipped.
+	 * The Device is asked for all remaining Items with a single readItems()
+	 * call, so it can merge neighbouring requests.
+	 *
+	 * @param idents the identities of the Items to read ahead
+	 * @param num_items the number of identities
+	 * @return the number of Items added to the cache
+	 */
+	virtual uint32 prefetchItems(const ItemIdentity* const* idents, uint32 num_items);
+
 	/**
 	 * WriteCache - tells the Write cache to write the Item to the Device
 	 * NOTE: this does not add the Item into the *Read-Cache* (call addItem()
@@ -197,6 +246,16 @@ public:
 	 */
 	virtual bool isItemFree(const ItemIdentity& ident);
 
+	/**
+	 * locks the Item if it is free (neither referenced nor locked), the read
+	 * strategies use it to pick the victim of an eviction. The GeneralCache
+	 * unlocks the victim after it was written back.
+	 *
+	 * @param ident the identity for the Item
+	 * @return true if the item was free and is locked now; false otherwise
+	 */
+	bool lockFreeItem(const ItemIdentity& ident);
+
 	/**
 	 * removes an Item from Cache and it's underling resource
 	 *
@@ -227,6 +286,14 @@ public:
 	 */
 	void getStats(CacheStat& stats) const;
 
+	/**
+	 * getting the maximal allowed number of elements in the cache
+	 * (read strategies use it to size their internal queues)
+	 *
+	 * @return the hard limit of the cache
+	 */
+	num_items_t getHardLimit(void) const;
+
 protected:
 
 	// the adapted device the cache communicates with
@@ -248,6 +315,13 @@ private:
 	 * @param ident
 	 */
 	void incrRefCount(const ItemIdentity& ident);
+
+	/**
+	 * counts a getItem() request in the statistics of the Item's stripe
+	 * @param ident
+	 * @param cache_hit true if the Item was found in the read-cache
+	 */
+	void countRequest(const ItemIdentity& ident, bool cache_hit);
 	void decrRefCount(const ItemIdentity& ident);
 
 	/**
@@ -257,27 +331,122 @@ private:
 	 */
 	void deleteItem(const ItemIdentity& ident);
 
+	/**
+	 * adds a new Item to the read-cache and evicts an Item before if the
+	 * cache is full
+	 *
+	 * @param ident
+	 * @param item
+	 * @param prefetched true if the Item was read ahead and not requested yet
+	 */
+	void insertItem(const ItemIdentity& ident, Item* item, bool prefetched);
+
+	/**
+	 * takes an Item out of the read-cache, writes it back and deletes it
+	 * @return true if an Item was evicted
+	 */
+	bool evictItem(void);
+
+	/**
+	 * atomically adds increment to the counter
+	 * @return the value of the counter before
+	 */
+	static uint32 atomicAdd(uint32& counter, int32 increment);
+
 	// should the cache operate in blocking or real-time (non-blocking mode)?
 	bool non_blocking_cache_;
 
-#ifdef USE_FILE_SYSTEM_ON_GUEST_OS
-	typedef std::map<ItemIdentity*, unsigned int>::iterator lock_list_iterator;
-	std::map<ItemIdentity*, unsigned int> borrowed_items_;
-#else
-  // the borrowed data-items
-  typedef ustl::map<ItemIdentity*, uint32>::iterator lock_list_iterator;
-  ustl::map<ItemIdentity*, uint32> borrowed_items_;
-  Mutex map_lock_;
+	// the number of items in the read-cache, including the ones about to be
+	// inserted by insertItem(), so that concurrent inserts can not exceed
+	// the hard limit (updated with atomicAdd())
+	uint32 num_items_;
+
+	// the number of items evicted by insertItem() (updated with atomicAdd())
+	uint32 evicted_items_;
+
+  /**
+   * the per-item book keeping of the cache: the lock-state and the
+   * number of references of an Item. A slot only exists as long as the
+   * Item is locked or referenced by somebody.
+   */
+  struct CacheSlot
+  {
+    ItemIdentity* ident; // a clone of the Item's identity
+    uint32 hash;
+    uint32 ref_count;
+    bool locked;
+
+    // next slot in the same stripe
+    CacheSlot* next;
+  };
+
+  /**
+   * the slots are sharded by the identity's hash into independently
+   * locked stripes, so that requests to unrelated Items do not have to
+   * wait for each other
+   */
+  struct CacheStripe
+  {
+    CacheStripe();
+
+    CacheSlot* slots;
+
+    // the request statistics of the stripe's Items (evicted_items unused)
+    CacheStat stats;
+#ifndef NO_USE_OF_MULTITHREADING
+    Mutex mutex;
 #endif
+  };
+
+  // the number of stripes, has to be a power of 2
+  static const uint32 NUM_STRIPES = 16;
+
+  CacheStripe* stripes_[NUM_STRIPES];
+
+  /**
+   * getting the stripe the given identity belongs to
+   * @param ident
+   * @return the stripe
+   */
+  CacheStripe& getStripe(const ItemIdentity& ident);
 
-  // the Cache's statistics
-  CacheStat stats_;
+  /**
+   * locks / unlocks the given stripe
+   * @param stripe
+   * @param blocking if false, the call returns false if the stripe
+   * is currently locked by someone else
+   * @return true if the stripe was locked
+   */
+  bool lockStripe(CacheStripe& stripe, bool blocking) const;
+  void unlockStripe(CacheStripe& stripe) const;
 
   /**
-   * searches the map of borrowed cache items for the ItemIdentity
-   * object that compares to the given one
-   * this method is used to determine whether the deleteAfterRelease
-   * flag is set in the original object
+   * searches the stripe for the slot of the given identity
+   * @param stripe the (locked) stripe
+   * @param ident
+   * @return the slot or NULL if there is no slot for the identity
+   */
+  CacheSlot* findSlotUnprotected(CacheStripe& stripe, const ItemIdentity& ident);
+
+  /**
+   * searches the stripe for the slot of the given identity, if there is
+   * none a new one is created
+   * @param stripe the (locked) stripe
+   * @param ident
+   * @return the slot
+   */
+  CacheSlot* getSlotUnprotected(CacheStripe& stripe, const ItemIdentity& ident);
+
+  /**
+   * destroys the slot if it is neither locked nor referenced any more
+   * @param stripe the (locked) stripe
+   * @param slot
+   */
+  void putSlotUnprotected(CacheStripe& stripe, CacheSlot* slot);
+
+  /**
+   * checks whether the deleteAfterRelease flag is set in the slot of
+   * the given ItemIdentity
    *
    * @param ident
    * @return
@@ -321,22 +490,6 @@ private:
    */
   bool unlockItem(const ItemIdentity& ident);
 
-#ifndef NO_USE_OF_MULTITHREADING
-
-  /**
-   * searches the map for an item with the given identity and returns
-   * true if the item was found in the map or false otherwise
-   *
-   * @param ident
-   * @return true / false
-   */
-  bool isInVectorUnprotected(const ItemIdentity& ident);
-
-  // a slot-specific locking-aid
-  Mutex item_locks_mutex_;
-  ustl::vector<ItemIdentity*> item_locks_;
-#endif // NO_USE_OF_MULTITHREADING
-
 };
 
 } // end of namespace "Cache"
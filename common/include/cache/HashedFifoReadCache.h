@@ -0,0 +1,125 @@
+/**
+ * Filename: HashedFifoReadCache.h
+ * Description:
+ *
+ * Created on: 18.10.2026
+ */
+
+#ifndef HASHEDFIFOREADCACHE_H_
+#define HASHEDFIFOREADCACHE_H_
+
+#include "GeneralCache.h"
+
+namespace Cache
+{
+
+/**
+ * @class a Read Cache Strategy realization with the same FIFO eviction
+ * order as FifoReadCache, but the items are additionally indexed by a
+ * hash table (keyed by ItemIdentity::hash()), so that lookups, inserts
+ * and removals are done in constant time independent of the number of
+ * cached items
+ */
+class HashedFifoReadCache : public CacheReadStrategy
+{
+public:
+  HashedFifoReadCache(GeneralCache* cache);
+  virtual ~HashedFifoReadCache();
+
+  /**
+   * searches the cache-data structure for an item with the
+   * given identity and returns it's data if it was found
+   * @param ident
+   * @return data or NULL if not present
+   */
+  virtual Item* get(const ItemIdentity& ident);
+
+  /**
+   * adds a new item to the cache
+   * @param ident the identity of the new item
+   * @param item the item's data
+   * @return true / false
+   */
+  virtual bool add(const ItemIdentity& ident, Item* item);
+
+  /**
+   * removes an item from the read-cache pool
+   *
+   * @param ident the Item with the given Identity will be removed
+   */
+  virtual void removeItem(const ItemIdentity& ident);
+
+  /**
+   * takes the item to evict according to the cache-strategy out of the cache
+   * @param[out] ident the identity of the victim
+   * @return the victim's data; NULL if no item is free
+   */
+  virtual Item* evictItem(ItemIdentity*& ident);
+
+  /**
+   * clears all currently free items from the cache
+   */
+  virtual void clear(void);
+
+  /**
+   * returns the number of items in the cache
+   * @return number of elements in the cache
+   */
+  virtual num_items_t getNumItems(void) const;
+
+private:
+
+  struct HashedCacheItem
+  {
+    ItemIdentity* ident;
+    Item* item;
+    uint32 hash;
+
+    // next element in the same hash-bucket
+    HashedCacheItem* bucket_next;
+
+    // FIFO-queue links (fifo_prev points towards the older items)
+    HashedCacheItem* fifo_prev;
+    HashedCacheItem* fifo_next;
+  };
+
+  // initial number of hash buckets, has to be a power of 2
+  static const uint32 INITIAL_NUM_BUCKETS = 64;
+
+  /**
+   * searches the hash-bucket of the given identity for the matching item
+   * @param ident
+   * @return the found item or NULL
+   */
+  HashedCacheItem* findUnprotected(const ItemIdentity& ident) const;
+
+  /**
+   * takes the given item out of the hash-index and the FIFO-queue
+   * and destroys the item's data
+   * @param entry
+   */
+  void removeUnprotected(HashedCacheItem* entry);
+
+  /**
+   * doubles the number of buckets and re-hashes all cached items
+   */
+  void growUnprotected(void);
+
+  // the hash-buckets (single linked chains of items)
+  HashedCacheItem** buckets_;
+  uint32 num_buckets_;
+
+  // the FIFO-queue, head_ is the oldest item
+  HashedCacheItem* fifo_head_;
+  HashedCacheItem* fifo_tail_;
+
+  num_items_t num_items_;
+
+#ifndef USE_FILE_SYSTEM_ON_GUEST_OS
+  mutable Mutex fifo_mutex_;
+#endif
+};
+
+} // end of namespace "Cache"
+
+#endif /* HASHEDFIFOREADCACHE_H_ */
@@ -0,0 +1,183 @@
+/**
+ * Filename: TwoQueueReadCache.h
+ * Description:
+ *
+ * Created on: 18.10.2026
+ */
+
+#ifndef TWOQUEUEREADCACHE_H_
+#define TWOQUEUEREADCACHE_H_
+
+#include "GeneralCache.h"
+
+namespace Cache
+{
+
+/**
+ * @class a scan resistant Read Cache Strategy realization (2Q, see
+ * Johnson and Shasha "2Q: A Low Overhead High Performance Buffer
+ * Management Replacement Algorithm")
+ *
+ * Items that are read the first time are kept in a small FIFO (A1in).
+ * Items evicted from A1in just leave their identity behind in a ghost
+ * FIFO (A1out). Only an item that is read again while it's identity is
+ * in A1out is considered to be hot and is put into the main LRU queue (Am).
+ * Re-reads while the item is still in A1in are not counted (the full 2Q
+ * version of the paper), so a scan that reads a sector in several pieces
+ * or reads it again right away does not promote it. One large sequential
+ * read just runs through A1in and does not push hot data like bitmaps or
+ * i-node tables out of the cache.
+ *
+ * All lookups are done via a hash index (keyed by ItemIdentity::hash())
+ */
+class TwoQueueReadCache : public CacheReadStrategy
+{
+public:
+  TwoQueueReadCache(GeneralCache* cache);
+  virtual ~TwoQueueReadCache();
+
+  /**
+   * searches the cache-data structure for an item with the
+   * given identity and returns it's data if it was found
+   * @param ident
+   * @return data or NULL if not present
+   */
+  virtual Item* get(const ItemIdentity& ident);
+
+  /**
+   * adds a new item to the cache
+   * @param ident the identity of the new item
+   * @param item the item's data
+   * @return true / false
+   */
+  virtual bool add(const ItemIdentity& ident, Item* item);
+
+  /**
+   * adds an item that was read ahead, it is put into A1in without being
+   * referenced, so it leaves no ghost entry if it is evicted unread
+   * @param ident the identity of the new item
+   * @param item the item's data
+   * @return true / false
+   */
+  virtual bool addPrefetched(const ItemIdentity& ident, Item* item);
+
+  /**
+   * checks whether the item is cached without touching it's queue position
+   * @param ident
+   * @return true if the item is present (ghost entries do not count)
+   */
+  virtual bool contains(const ItemIdentity& ident);
+
+  /**
+   * removes an item from the read-cache pool
+   *
+   * @param ident the Item with the given Identity will be removed
+   */
+  virtual void removeItem(const ItemIdentity& ident);
+
+  /**
+   * takes the item to evict according to the cache-strategy out of the cache
+   * @param[out] ident the identity of the victim
+   * @return the victim's data; NULL if no item is free
+   */
+  virtual Item* evictItem(ItemIdentity*& ident);
+
+  /**
+   * clears all currently free items from the cache
+   */
+  virtual void clear(void);
+
+  /**
+   * returns the number of items in the cache
+   * @return number of elements in the cache
+   */
+  virtual num_items_t getNumItems(void) const;
+
+private:
+
+  enum QueueType
+  {
+    A1_IN,  // items read once
+    A1_OUT, // ghost entries (identity only) of items evicted from A1_IN
+    AM      // hot items, LRU ordered
+  };
+
+  struct TwoQueueItem
+  {
+    ItemIdentity* ident;
+    Item* item;
+    uint32 hash;
+    QueueType queue;
+
+    // false for items that were read ahead and were not requested yet
+    bool referenced;
+
+    // next element in the same hash-bucket
+    TwoQueueItem* bucket_next;
+
+    // queue links (prev points towards the head = the oldest item)
+    TwoQueueItem* prev;
+    TwoQueueItem* next;
+  };
+
+  struct ItemQueue
+  {
+    TwoQueueItem* head;
+    TwoQueueItem* tail;
+    num_items_t size;
+  };
+
+  // initial number of hash buckets, has to be a power of 2
+  static const uint32 INITIAL_NUM_BUCKETS = 64;
+
+  TwoQueueItem* findUnprotected(const ItemIdentity& ident) const;
+
+  /**
+   * adds a new item to the cache (common part of add() / addPrefetched())
+   */
+  bool addUnprotected(const ItemIdentity& ident, Item* item, bool referenced);
+
+  void insertIndexUnprotected(TwoQueueItem* entry);
+  void removeIndexUnprotected(TwoQueueItem* entry);
+  void growUnprotected(void);
+
+  ItemQueue& getQueue(QueueType type);
+  void enqueueUnprotected(TwoQueueItem* entry, QueueType type);
+  void dequeueUnprotected(TwoQueueItem* entry);
+
+  /**
+   * takes the entry out of the index and it's queue and destroys it
+   * (including the item's data if it is not a ghost entry)
+   */
+  void destroyUnprotected(TwoQueueItem* entry);
+
+  /**
+   * takes the oldest free item of the given queue out of the cache
+   * items evicted from A1_IN are demoted to ghost entries
+   *
+   * @param[out] ident the identity of the victim
+   * @return the victim's data; NULL if the queue has no free item
+   */
+  Item* evictFromUnprotected(QueueType type, ItemIdentity*& ident);
+
+  // the hash-buckets (single linked chains of items)
+  TwoQueueItem** buckets_;
+  uint32 num_buckets_;
+  num_items_t num_entries_; // all entries, including the ghosts
+
+  ItemQueue a1_in_;
+  ItemQueue a1_out_;
+  ItemQueue am_;
+
+  // the target size of A1in and the maximal size of A1out
+  num_items_t max_a1_in_;
+  num_items_t max_a1_out_;
+
+#ifndef USE_FILE_SYSTEM_ON_GUEST_OS
+  mutable Mutex queue_mutex_;
+#endif
+};
+
+} // end of namespace "Cache"
+
+#endif /* TWOQUEUEREADCACHE_H_ */
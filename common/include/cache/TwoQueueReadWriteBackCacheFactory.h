@@ -0,0 +1,45 @@
+/**
+ * Filename: TwoQueueReadWriteBackCacheFactory.h
+ * Description:
+ *
+ * Created on: 18.10.2026
+ */
+
+#ifndef TWOQUEUEREADWRITEBACKCACHEFACTORY_H_
+#define TWOQUEUEREADWRITEBACKCACHEFACTORY_H_
+
+#include "CacheFactory.h"
+
+namespace Cache
+{
+
+/**
+ * @class TwoQueueReadWriteBackCacheFactory creates a Read : 2Q (scan resistant) and
+ * Write : Write-Back cache
+ */
+class TwoQueueReadWriteBackCacheFactory : public Cache::CacheFactory
+{
+public:
+  TwoQueueReadWriteBackCacheFactory();
+  virtual ~TwoQueueReadWriteBackCacheFactory();
+
+protected:
+
+  /**
+   * creates a new CacheReadStrategy and returns it
+   * @param cache the hosting Cache
+   */
+  virtual CacheReadStrategy* getReadStrategy(GeneralCache* cache) const;
+
+  /**
+   * creates a new CacheWriteStrategy and returns an instance of it
+   * @param device the Device associated with the Cache and the
+   * CacheWriteStrategy
+   */
+  virtual CacheWriteStrategy* getWriteStrategy(DeviceAdapter* device) const;
+
+};
+
+} // end of namespace "cache"
+
+#endif /* TWOQUEUEREADWRITEBACKCACHEFACTORY_H_ */
@@ -83,13 +83,80 @@ public:
    */
   virtual void removeItem(const Cache::ItemIdentity& ident);
 
+  /**
+   * applies the dirty thresholds, see CacheWriteStrategy
+   *
+   * @param soft_limit
+   * @param hard_limit
+   */
+  virtual void setDirtyThresholds(num_items_t soft_limit, num_items_t hard_limit);
+
+  /**
+   * getting the number of pending write operations
+   */
+  num_items_t getNumDirtyItems(void) const;
+
+  /**
+   * checks whether pending writes have to be written back in the
+   * background, that is if there are more than the soft limit of them or
+   * if the oldest one is pending for longer than MAX_DIRTY_AGE
+   *
+   * @return true if writeBack() should be called
+   */
+  bool needsWriteBack(void) const;
+
+  /**
+   * getting the time until needsWriteBack() becomes true because of the
+   * age of the oldest pending write operation
+   *
+   * @return the number of timer ticks, 0 if a write back is needed right
+   * now, NO_DIRTY_ITEMS if there is nothing to write back at all
+   */
+  uint32 getTicksUntilWriteBack(void) const;
+
+  static const uint32 NO_DIRTY_ITEMS = -1U;
+
+  /**
+   * writes back the oldest pending write operations as long as
+   * needsWriteBack() is true, but at most max_items
+   *
+   * @param max_items the maximal number of items to write back
+   * @return the number of items written back
+   */
+  num_items_t writeBack(num_items_t max_items);
+
+  // the maximal time (in timer ticks) a write operation stays pending
+  // before it is written back in the background (~5s at 18.2 Hz)
+  static const uint32 MAX_DIRTY_AGE = 90;
+
 private:
 
+  /**
+   * writes back the oldest pending write operation
+   */
+  void writeBackOldestUnprotected(void);
+
+  /**
+   * getting the current time stamp for the dirty ages
+   */
+  static uint32 getCurrentTime(void);
+
+  struct WriteBackItem;
+
+  /**
+   * sorts the given items by the order keys of their identities, items
+   * with the same key keep their queue order
+   *
+   * @param items
+   * @param num_items
+   */
+  static void sortByOrderKey(WriteBackItem** items, uint32 num_items);
+
   struct WriteBackItem
   {
     WriteBackItem(Cache::ItemIdentity* id, Cache::Item* it_data,
-        bool delete_itm) :
-          ident(id), item(it_data), delete_item(delete_itm)
+        bool delete_itm, uint32 queued) :
+          ident(id), item(it_data), delete_item(delete_itm), queued_at(queued)
     {
     }
 
@@ -104,6 +171,7 @@ private:
     Cache::ItemIdentity* ident;
     Cache::Item* item;
     bool delete_item; // flag: delete item after writing
+    uint32 queued_at; // time stamp of the first pending write operation
   };
 
   // use a vector as a waiting queue for write operations
@@ -115,6 +183,10 @@ private:
   ustl::vector<WriteBackItem*> item_queue_;
   mutable Mutex mutex_;
 #endif
+
+  // the dirty thresholds (no limits if 0)
+  num_items_t soft_limit_;
+  num_items_t hard_limit_;
 };
 
 } // end of namespace
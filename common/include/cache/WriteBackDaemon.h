@@ -0,0 +1,89 @@
+/**
+ * Filename: WriteBackDaemon.h
+ * Description:
+ *
+ * Created on: 18.10.2026
+ */
+
+#ifndef WRITEBACKDAEMON_H_
+#define WRITEBACKDAEMON_H_
+
+#ifndef USE_FILE_SYSTEM_ON_GUEST_OS
+
+#include "types.h"
+#include "Thread.h"
+#include "Mutex.h"
+#include "ustl/uvector.h"
+
+namespace Cache
+{
+
+class WriteBackCache;
+
+/**
+ * @class the kernel thread writing back the pending write operations of
+ * all WriteBackCaches in the background. It sleeps as long as there is no
+ * dirty data and is woken up by a cache getting it's first dirty item or
+ * exceeding it's soft limit. While there is dirty data it sleeps until the
+ * oldest item is due for being written back.
+ */
+class WriteBackDaemon : public Thread
+{
+public:
+
+  /**
+   * getting the single daemon instance (created on the first call)
+   */
+  static WriteBackDaemon* instance();
+
+  virtual void Run();
+
+  /**
+   * adds a cache to the set of caches written back by the daemon
+   * @param cache
+   */
+  void registerCache(WriteBackCache* cache);
+
+  /**
+   * removes a cache, after the call the daemon does not touch it anymore
+   * @param cache
+   */
+  void unregisterCache(WriteBackCache* cache);
+
+  /**
+   * wakes up the daemon (there is something to write back)
+   */
+  void wakeUp();
+
+private:
+  WriteBackDaemon();
+  virtual ~WriteBackDaemon();
+
+  /**
+   * writes back all caches that need it
+   * @return the number of timer ticks until the next write back is due,
+   * WriteBackCache::NO_DIRTY_ITEMS if there is no dirty data left
+   */
+  uint32 writeBackCaches();
+
+  // number of items written back per cache before the other caches and
+  // threads get their turn
+  static const uint32 WRITE_BACK_BATCH = 8;
+
+  static WriteBackDaemon* instance_;
+
+  // the registered caches, also held while a cache is written back
+  ustl::vector<WriteBackCache*> caches_;
+  Mutex caches_lock_;
+
+  // both are only changed with interrupts disabled, so that a wakeUp()
+  // can not get lost between checking work_pending_ and going to sleep
+  volatile bool work_pending_;
+  volatile bool sleeping_;
+};
+
+} // end of namespace "Cache"
+
+#endif
+
+#endif /* WRITEBACKDAEMON_H_ */
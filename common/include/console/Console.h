@@ -144,6 +144,12 @@ class Console : public Thread
      */
     void handleKey ( uint32 key );
 
+    /**
+     * starts a kernel stress test in a thread of its own
+     * @param number the index of the test (F7 starts test 0, F8 test 1, ...)
+     */
+    void startStressTest ( uint32 number );
+
     /**
      * not implemented here
      */
@@ -39,6 +39,7 @@ const uint32 BACKTRACE          = 0x00080100 | OUTPUT_ENABLED;
 const uint32 MM                 = 0x00100000;
 const uint32 PM                 = 0x00100001 | OUTPUT_ENABLED;
 const uint32 KMM                = 0x00100002;
+const uint32 OBJECT_CACHE       = 0x00100004; // also poisons the ObjectCaches
 
 //group driver
 const uint32 DRIVER             = 0x00200000;
@@ -61,6 +62,7 @@ const uint32 FS_DEVICE          = 0x00800004;
 const uint32 FS_BITMAP          = 0x00800008;
 const uint32 FS_INODE           = 0x00800010;
 const uint32 FS_UTIL            = 0x00800020;
+const uint32 DENTRY_CACHE       = 0x00800080;
 
 // group: Unix style FileSystems
 const uint32 FS_UNIX            = 0x00804000;
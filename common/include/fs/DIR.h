@@ -31,7 +31,7 @@ struct DIR
   }
 
   Directory* dir_;      // the opened-directory
-  uint32 cursor_pos;    // the current position of the cursor
+  uint32 cursor_pos;    // the cursor of Directory::getNextChild()
 };
 
 
@@ -0,0 +1,181 @@
+/**
+ * Filename: DentryCache.h
+ * Description:
+ *
+ * Created on: 18.10.2026
+ */
+
+#ifndef DENTRYCACHE_H_
+#define DENTRYCACHE_H_
+
+#include "types.h"
+#include "fs/FsDefinitions.h"
+
+#ifndef USE_FILE_SYSTEM_ON_GUEST_OS
+#include "kernel/Mutex.h"
+#endif
+
+class FileSystem;
+class Directory;
+class Inode;
+class VfsSyscall;
+
+/**
+ * @class DentryCache caches the results of FileSystem::lookup(), so that
+ * resolving a path does not have to search the children of every
+ * Directory on the way.
+ *
+ * An entry maps (FileSystem, parent I-Node ID, name) to the (FileSystem,
+ * I-Node ID) of the child, mount-points are already resolved to the root
+ * of the mounted FileSystem. Negative entries remember that a name does
+ * not exist. The entries do not hold a reference to the I-Nodes, so a
+ * cached path can be followed without touching the Directories on the
+ * way, just the final I-Node is acquired from it's FileSystem. The owner
+ * and the permissions of a child Directory are stored in the entry, so the
+ * search permission of the Directories in between can still be checked.
+ *
+ * Every operation adding or removing a name has to invalidate it's entry
+ * while the parent Directory is still write-locked. Lookups that raced with
+ * an invalidation are not inserted (see getGeneration()). Changing the
+ * owner or the permissions of a Directory has to invalidate it by
+ * invalidateDirectory().
+ */
+class DentryCache
+{
+public:
+  /**
+   * constructor
+   * @param max_entries the maximal number of cached entries, the least
+   * recently used entries are evicted
+   */
+  DentryCache(uint32 max_entries = DEFAULT_MAX_ENTRIES);
+
+  /**
+   * destructor
+   */
+  virtual ~DentryCache();
+
+  /**
+   * follows the cached entries of the given path components, as long as
+   * they are cached and lead to a Directory (or are the last component).
+   * Only the last reached I-Node is acquired, the ones in between are
+   * not touched at all.
+   * The walk stops at a Directory in between that must not be searched
+   * according to VfsSyscall::isSearchPermitted(), so the caller's regular
+   * check on the acquired Directory reports it.
+   *
+   * @param dir the Directory to start at (referenced by the caller, it's
+   * search permission is checked by the caller)
+   * @param names the path components
+   * @param num_names the number of path components
+   * @param vfs checks the search permission of the Directories in between,
+   * NULL if no checks are needed
+   * @param child [out] the last reached child with an acquired reference,
+   * NULL if the walk ended at a negative entry
+   * @return the number of resolved components, 0 if the first one is not
+   * cached (child is not set in this case)
+   */
+  uint32 walk(Directory* dir, char* const* names, uint32 num_names, VfsSyscall* vfs, Inode*& child);
+
+  /**
+   * getting the invalidation generation, it has to be read before
+   * the FileSystem::lookup() whose result is inserted
+   * @return the current generation
+   */
+  uint32 getGeneration(void) const;
+
+  /**
+   * adds the result of a FileSystem::lookup() to the cache
+   *
+   * @param parent the parent Directory
+   * @param name the looked up name
+   * @param child the found child or NULL to add a negative entry
+   * @param generation the generation read before the lookup, the entry
+   * is dropped if any invalidation happened in the meantime
+   */
+  void insert(Directory* parent, const char* name, Inode* child, uint32 generation);
+
+  /**
+   * removes the entry of the given name (a link was added or removed)
+   * @param parent the parent Directory
+   * @param name the name of the changed child
+   */
+  void invalidate(Directory* parent, const char* name);
+
+  /**
+   * removes all entries in and pointing to the given (removed) Directory
+   * @param dir the Directory
+   */
+  void invalidateDirectory(Directory* dir);
+
+  /**
+   * removes all entries (e.g. after the mount-tree changed)
+   */
+  void clear(void);
+
+  /**
+   * getting the number of cached entries
+   */
+  uint32 getNumEntries(void) const;
+
+private:
+
+  struct DentryCacheEntry
+  {
+    // the key: the parent Directory and the name of the child
+    FileSystem* parent_fs;
+    inode_id_t parent_id;
+    char* name;
+    uint32 hash;
+
+    // the child, child_fs is NULL for a negative entry
+    FileSystem* child_fs;
+    inode_id_t child_id;
+    bool child_is_dir;
+
+    // owner and permissions of a child Directory (for the search permission)
+    uint32 child_uid;
+    uint32 child_gid;
+    uint32 child_permissions;
+
+    // next element in the same hash-bucket
+    DentryCacheEntry* bucket_next;
+
+    // LRU-list links (lru_prev points towards the least recently used)
+    DentryCacheEntry* lru_prev;
+    DentryCacheEntry* lru_next;
+  };
+
+  // the default maximal number of entries
+  static const uint32 DEFAULT_MAX_ENTRIES = 1024;
+
+  static uint32 hashName(inode_id_t parent_id, const char* name);
+
+  DentryCacheEntry* findUnprotected(FileSystem* fs, inode_id_t parent_id,
+                                    const char* name, uint32 hash) const;
+
+  void removeUnprotected(DentryCacheEntry* entry);
+  void appendLruUnprotected(DentryCacheEntry* entry);
+  void unlinkLruUnprotected(DentryCacheEntry* entry);
+
+  // the hash-buckets (single linked chains), the number of buckets is a
+  // power of 2 and not smaller than max_entries_
+  DentryCacheEntry** buckets_;
+  uint32 num_buckets_;
+
+  // the LRU-list, head_ is the least recently used entry
+  DentryCacheEntry* lru_head_;
+  DentryCacheEntry* lru_tail_;
+
+  uint32 num_entries_;
+  uint32 max_entries_;
+
+  // incremented by every invalidation
+  uint32 generation_;
+
+#ifndef USE_FILE_SYSTEM_ON_GUEST_OS
+  mutable Mutex lock_;
+#endif
+};
+
+#endif /* DENTRYCACHE_H_ */
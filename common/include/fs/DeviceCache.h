@@ -13,6 +13,7 @@
 
 #include "cache/CacheItem.h"
 #include "FsDefinitions.h"
+#include "mm/ObjectCache.h"
 
 /**
  * @class the Cache's identity object for the Block-device data
@@ -35,6 +36,16 @@ public:
    */
   virtual bool operator==(const Cache::ItemIdentity& cmp);
 
+  /**
+   * hash value of the identity (the sector number)
+   */
+  virtual uint32 hash(void) const;
+
+  /**
+   * order key of the identity (the sector number)
+   */
+  virtual uint32 getOrderKey(void) const;
+
   /**
    * clones this object and returns a new instance of it
    * Located on the heap
@@ -61,6 +72,8 @@ private:
 
   // the used block-size:
   sector_len_t block_size_;
+
+  OBJECT_CACHE_MEMBERS
 };
 
 /**
@@ -78,6 +91,8 @@ public:
 private:
 
   char* sector_;
+
+  OBJECT_CACHE_MEMBERS
 };
 
 #endif /* DEVICECACHE_H_INCLUDED_ */
@@ -7,6 +7,7 @@
 
 #include "fs/FsDefinitions.h"
 #include "types.h"
+#include "mm/ObjectCache.h"
 
 class File;
 class Thread;
@@ -53,6 +54,14 @@ class FileDescriptor
     // Synchronous mode
     bool synchronous_;
 
+    // sequential access detection for the readahead: the position the
+    // next read is expected at, the current readahead window (in
+    // data-blocks, 0 if the file is not read sequentially) and the index
+    // of the data-block behind the last one that was read ahead
+    file_size_t read_ahead_next_pos_;
+    uint32 read_ahead_window_;
+    uint32 read_ahead_end_;
+
   public:
     /**
      * constructor
@@ -80,6 +89,12 @@ class FileDescriptor
      */
     fd_size_t getFd() { return fd_; }
 
+    /**
+     * set the file descriptor (assigned by the FileDescriptorTable)
+     * @param fd the fd
+     */
+    void setFd(fd_size_t fd) { fd_ = fd; }
+
     /**
      * get the file
      * @return the file
@@ -159,29 +174,29 @@ class FileDescriptor
     bool synchronizeMode(void) const;
 
     /**
-     * add fd to global fd list
-     * @param fd
+     * updates the sequential access detection with a read of len bytes at
+     * the given position and returns the readahead window for it
+     * A read that starts where the previous one ended opens the window
+     * (or doubles it up to READ_AHEAD_MAX_WINDOW), any other read closes it.
+     *
+     * @param pos the position the read starts at
+     * @param len the number of bytes to read
+     * @return the number of data-blocks to read ahead after the read range
      */
-    static void add(FileDescriptor* fd);
+    uint32 updateReadAheadWindow(file_size_t pos, file_size_t len);
 
     /**
-     * remove fd from global fd list
-     * @param fd
+     * getting / setting the index of the data-block behind the last one
+     * that was read ahead (reset by a non-sequential read)
      */
-    static void remove(FileDescriptor* fd);
+    uint32 getReadAheadEnd(void) const;
+    void setReadAheadEnd(uint32 end_block);
 
-    /**
-     * remove fd from global fd list
-     * @param fd
-     */
-    static bool remove(fd_size_t fd);
+    // the initial and the maximal readahead window (in data-blocks)
+    static const uint32 READ_AHEAD_MIN_WINDOW = 4;
+    static const uint32 READ_AHEAD_MAX_WINDOW = 32;
 
-    /**
-     * getting a FileDescriptor
-     * @param
-     * @return
-     */
-    static FileDescriptor* getFileDescriptor(fd_size_t fd);
+    OBJECT_CACHE_MEMBERS
 };
 
 #endif // FILEDESCRIPTOR_H_
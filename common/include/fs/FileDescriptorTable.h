@@ -0,0 +1,100 @@
+/**
+ * Filename: FileDescriptorTable.h
+ * Description:
+ *
+ * Created on: 18.10.2026
+ */
+
+#ifndef FILEDESCRIPTORTABLE_H_
+#define FILEDESCRIPTORTABLE_H_
+
+#include "types.h"
+#include "fs/FsDefinitions.h"
+
+#ifndef USE_FILE_SYSTEM_ON_GUEST_OS
+#include "kernel/Mutex.h"
+#endif
+
+class FileDescriptor;
+
+/**
+ * @class FileDescriptorTable the open FileDescriptors of a Process
+ *
+ * The table is a dense array indexed by the fd number, so a FileDescriptor
+ * is found without any search. A new FileDescriptor gets the lowest free
+ * number (starting at FIRST_FD, the numbers below are the standard streams
+ * handled by the Syscalls), the array grows on demand.
+ * Every table has it's own lock, so Processes doing I/O do not contend.
+ */
+class FileDescriptorTable
+{
+public:
+  /**
+   * constructor, creates an empty table
+   */
+  FileDescriptorTable();
+
+  /**
+   * destructor, closes all FileDescriptors that are still open
+   */
+  virtual ~FileDescriptorTable();
+
+  /**
+   * adds a FileDescriptor to the table and assigns it's number
+   * @param fd the new FileDescriptor, the table takes over the ownership
+   * @return the number of the FileDescriptor
+   */
+  fd_size_t add(FileDescriptor* fd);
+
+  /**
+   * getting a FileDescriptor
+   * NOTE: the FileDescriptor is not referenced, it is only valid until it
+   * is removed (closed) from the table
+   * @param fd the number of the FileDescriptor
+   * @return the FileDescriptor or NULL if the number is not open
+   */
+  FileDescriptor* get(fd_size_t fd) const;
+
+  /**
+   * removes and deletes a FileDescriptor
+   * @param fd the number of the FileDescriptor
+   * @return false if the number is not open
+   */
+  bool remove(fd_size_t fd);
+
+  /**
+   * removes and deletes all FileDescriptors
+   */
+  void clear(void);
+
+  /**
+   * getting the number of open FileDescriptors
+   */
+  uint32 getNumOpen(void) const;
+
+  // the lowest fd number handed out (0, 1 and 2 are the standard streams)
+  static const fd_size_t FIRST_FD = 3;
+
+private:
+
+  FileDescriptorTable(const FileDescriptorTable&);
+  FileDescriptorTable& operator=(const FileDescriptorTable&);
+
+  // the initial size of the array
+  static const uint32 MIN_CAPACITY = 16;
+
+  // the FileDescriptors indexed by their number, NULL for a free number
+  FileDescriptor** fds_;
+  uint32 capacity_;
+
+  // all numbers below are in use (the search for a free one starts here)
+  uint32 lowest_free_;
+
+  uint32 num_open_;
+
+#ifndef USE_FILE_SYSTEM_ON_GUEST_OS
+  mutable Mutex lock_;
+#endif
+};
+
+#endif /* FILEDESCRIPTORTABLE_H_ */
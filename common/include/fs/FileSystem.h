@@ -276,6 +276,16 @@ public:
    */
   virtual sector_addr_t appendSectorToInode(Inode* inode, bool zero_out_sector = false) = 0;
 
+  /**
+   * releases the data blocks the FileSystem reserved for the next appends
+   * to the I-Node (preallocation, see appendSectorToInode()), called when a
+   * File opened for writing is closed
+   * The caller has to hold the I-Node's write lock.
+   *
+   * @param inode the I-Node
+   */
+  virtual void releaseReservedSectors(Inode* inode);
+
   /**
    * removes the n-th data block from the given I-Node (so that the sector can
    * be used again by other I-Node's). This causes the I-Node's size to shrink.
@@ -310,8 +320,10 @@ public:
    * one or more missing sectors
    *
    * @param inode the i-node thats list of blocks has to be updated
+   * @param number the list has to be loaded at least up to this sector
+   * (or completely if the i-node has fewer sectors)
    */
-  virtual void updateInodesSectorList(Inode* inode) = 0;
+  virtual void updateInodesSectorList(Inode* inode, uint32 number) = 0;
 
   /**
    * getting a pointer to the instance of the FileSystem's FsVolumeManager
@@ -11,6 +11,10 @@
 
 #include "FsDefinitions.h"
 
+#ifndef USE_FILE_SYSTEM_ON_GUEST_OS
+#include "kernel/Mutex.h"
+#endif
+
 // forwards
 class FileSystem;
 class FsVolumeManager;
@@ -18,6 +22,17 @@ class FsVolumeManager;
 /**
  * @class File-System Bitmap
  * The FsBitmap is perfectly ThreadSafe!
+ *
+ * The number of free bits of every Bitmap block is kept in memory (counted
+ * once on the first use), so full blocks are skipped without reading them
+ * and getNumFreeBits() needs no I/O at all. The blocks are scanned a
+ * 32bit-word at a time. The search for free bits starts behind the last
+ * occupied bit (next-fit) and wraps around at the end of the Bitmap.
+ *
+ * Bits can also be reserved in memory only (preallocation). Reserved bits
+ * count as occupied for all searches and free-counts, but the Bitmap on the
+ * device is not changed until the bit is occupied by occupyReservedBit(). So
+ * reservations never leak on the device, they are gone after a crash.
  */
 class FsBitmap
 {
@@ -62,6 +77,54 @@ public:
    */
   bitmap_t occupyNextFreeBit(void);
 
+  /**
+   * searches, occupies and returns a run of contiguous free bits
+   *
+   * @param num_bits the length of the run
+   * @param goal the search starts at this bit, by default (-1) behind the
+   * last occupied bit
+   * @return the number of the first bit of the run or -1 if there is no
+   * such run in the Bitmap
+   */
+  bitmap_t occupyNextFreeBits(bitmap_t num_bits, bitmap_t goal = -1);
+
+  /**
+   * searches and reserves (in memory only) a run of contiguous free bits
+   *
+   * @param num_bits the length of the run
+   * @param goal the search starts at this bit, by default (-1) behind the
+   * last occupied bit
+   * @return the number of the first bit of the run or -1 if there is no
+   * such run in the Bitmap
+   */
+  bitmap_t reserveNextFreeBits(bitmap_t num_bits, bitmap_t goal = -1);
+
+  /**
+   * reserves (in memory only) the free bits starting exactly at the given
+   * bit, up to the next occupied or reserved bit
+   *
+   * @param first the first bit to reserve
+   * @param max_bits the maximal number of bits to reserve
+   * @return the number of reserved bits, 0 if the first bit is not free
+   */
+  bitmap_t reserveFreeBitsAt(bitmap_t first, bitmap_t max_bits);
+
+  /**
+   * occupies a reserved bit, it is set in the Bitmap on the device
+   *
+   * @param index the reserved bit
+   * @return false if the bit is not reserved or in case of an error
+   */
+  bool occupyReservedBit(bitmap_t index);
+
+  /**
+   * gives reserved bits back, they are free again
+   *
+   * @param first the first reserved bit
+   * @param num_bits the number of reserved bits
+   */
+  void releaseReservedBits(bitmap_t first, bitmap_t num_bits);
+
   /**
    * statistical method
    * determines and returns the number of free bits in the FsBitmap
@@ -72,6 +135,55 @@ public:
 
 private:
 
+  FsBitmap(const FsBitmap&);
+  FsBitmap& operator=(const FsBitmap&);
+
+  /**
+   * counts the free bits of every block (once), the caller has to hold lock_
+   */
+  void loadFreeCounts(void) const;
+
+  /**
+   * sets a Bit in the Bitmap on the device, the caller has to hold lock_
+   */
+  bool setBitUnprotected(bitmap_t index, bool value);
+
+  /**
+   * searches a run of free bits behind the goal (or the last occupied bit)
+   * and wraps around, the caller has to hold lock_
+   * @return the first bit of the run or -1 if there is no such run
+   */
+  bitmap_t findNextFreeBits(bitmap_t num_bits, bitmap_t goal) const;
+
+  /**
+   * searches a run of free bits within [from, to), the caller has to hold
+   * lock_
+   * @return the first bit of the run or -1 if there is no such run
+   */
+  bitmap_t findFreeBits(bitmap_t num_bits, bitmap_t from, bitmap_t to) const;
+
+  /**
+   * sets the bits [first, first + num_bits) to 1, the caller has to hold
+   * lock_
+   */
+  void occupyBits(bitmap_t first, bitmap_t num_bits);
+
+  /**
+   * marks the bits [first, first + num_bits) as reserved, the caller has to
+   * hold lock_
+   */
+  void reserveBits(bitmap_t first, bitmap_t num_bits);
+
+  /**
+   * @return true if the bit is reserved, the caller has to hold lock_
+   */
+  bool isReserved(bitmap_t index) const;
+
+  /**
+   * getting the number of bits stored in a Bitmap block
+   */
+  bitmap_t getNumBitsOfBlock(sector_addr_t block) const;
+
   // the associated FileSystem where the Bitmap is stored
   FileSystem* file_system_;
 
@@ -86,6 +198,27 @@ private:
 
   // number of blocks used by the Bitmap
   const sector_addr_t num_blocks_;
+
+  // number of bits per Bitmap block
+  const bitmap_t bits_per_block_;
+
+  // the number of free bits of every block and the total number of free
+  // bits (reserved bits are not free), NULL until they are counted
+  mutable bitmap_t* free_bits_of_block_;
+  mutable bitmap_t num_free_bits_;
+
+  // the reserved bits in 32bit-words, allocated together with the
+  // free-counts (never written to the device)
+  mutable uint32* reserved_words_;
+
+  // the search for a free bit starts here
+  bitmap_t next_free_hint_;
+
+#ifndef USE_FILE_SYSTEM_ON_GUEST_OS
+  // protects the free-counts, the reservations and the hint, occupying a
+  // bit is search + set
+  mutable Mutex lock_;
+#endif
 };
 
 #endif /* FSBITMAP_H_ */
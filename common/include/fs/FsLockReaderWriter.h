@@ -15,9 +15,26 @@
 
 #include "types.h"
 #include "kernel/Mutex.h"
+#include "kernel/Condition.h"
 
 /**
  * @class a Reader / Writers lock-system
+ *
+ * The whole lock state (writer active, waiters present, number of readers)
+ * is a single word. As long as no thread has to wait, acquiring and
+ * releasing the lock is a single compareAndSwap() on this word.
+ *
+ * Threads that have to wait sleep on a Condition. From the moment a
+ * thread waits, the WAITERS bit forces everybody onto the slow path (under
+ * lock_) and the lock is handed over directly to the sleepers, so a
+ * woken thread already owns the lock:
+ * - a new reader has to wait if a writer is active or waiting (writers are
+ *   preferred)
+ * - a releasing writer hands the lock to all waiting readers (as one
+ *   batch), otherwise to the next waiting writer
+ * - the last reader of a batch hands the lock to the next waiting writer
+ * Readers and writers alternate under contention, so neither of them
+ * starves.
  */
 class FsLockReaderWriter : public FileSystemLock
 {
@@ -41,15 +58,64 @@ class FsLockReaderWriter : public FileSystemLock
 
   private:
 
-    // number of readers
-    uint32 num_readers_;
+    FsLockReaderWriter(const FsLockReaderWriter&);
+    FsLockReaderWriter& operator=(const FsLockReaderWriter&);
+
+    // a writer holds the lock
+    static const uint32 WRITER_ACTIVE = 0x80000000;
+
+    // threads are waiting, the state is only changed with lock_ held
+    static const uint32 WAITERS = 0x40000000;
+
+    // the number of readers holding the lock
+    static const uint32 READERS_MASK = 0x3FFFFFFF;
+
+    /**
+     * reads the current state word
+     */
+    uint32 getState(void) const;
+
+    /**
+     * atomically sets / clears bits of the state word
+     */
+    void setStateBits(uint32 bits);
+    void clearStateBits(uint32 bits);
+
+    /**
+     * sets the WAITERS bit if threads are waiting, clears it otherwise
+     * NOTE: lock_ has to be held
+     */
+    void updateWaiters(void);
+
+    /**
+     * hands the lock over to the waiting readers (all of them)
+     * NOTE: lock_ has to be held, the lock must not be held by a writer
+     */
+    void grantReaders(void);
+
+    /**
+     * hands the lock over to the next waiting writer
+     * NOTE: lock_ has to be held, the lock must be free
+     */
+    void grantWriter(void);
+
+    // WRITER_ACTIVE | WAITERS | number of readers
+    uint32 state_;
+
+    // number of sleeping readers / writers
+    uint32 num_waiting_readers_;
+    uint32 num_waiting_writers_;
+
+    // incremented for every batch of readers the lock is handed over to
+    uint32 read_generation_;
 
-    // a request to write data is here
-    uint32 num_write_requests_;
-    bool writer_active_;
+    // number of handovers to writers not yet taken by a woken writer
+    uint32 write_grants_;
 
-    // lock
+    // lock for the slow paths
     Mutex lock_;
+    Condition readers_cond_;
+    Condition writers_cond_;
 };
 
 #endif /* FSLOCKREADERWRITER_H_ */
@@ -16,6 +16,64 @@ class FileSystem;
 #include "cache/CacheFactory.h"
 #include "util/SlotLockManager.h"
 
+/**
+ * @class a borrowed, read-only view of the cached sectors of a data-block
+ * the sectors are pinned in the sector cache as long as the data-block
+ * is acquired, so no copy of the data-block has to be made. The view
+ * becomes invalid with releasing the data-block.
+ */
+class DataBlockView
+{
+public:
+  DataBlockView();
+  ~DataBlockView();
+
+  /**
+   * getting the number of sectors of the viewed data-block
+   */
+  uint32 getNumSectors(void) const;
+
+  /**
+   * getting the data of the index-th sector of the data-block
+   * @param index
+   * @return the sector's data (still owned by the cache)
+   */
+  const char* getSector(uint32 index) const;
+
+  /**
+   * copies a range of the data-block directly out of the cached
+   * sectors into the given buffer
+   *
+   * @param dest the destination buffer
+   * @param offset the offset within the data-block
+   * @param len the number of bytes to copy
+   */
+  void copyOut(char* dest, sector_len_t offset, sector_len_t len) const;
+
+private:
+  friend class FsVolumeManager;
+
+  DataBlockView(const DataBlockView&);
+  DataBlockView& operator=(const DataBlockView&);
+
+  /**
+   * makes room for the sector pointers of a data-block
+   * @param num_sectors the number of sectors per data-block
+   */
+  void resize(uint32 num_sectors);
+
+  // data-blocks up to this number of sectors (4 KiB with 512 byte sectors)
+  // do not need an allocation
+  static const uint32 INLINE_SECTORS = 8;
+
+  char* inline_sectors_[INLINE_SECTORS];
+
+  // inline_sectors_ or an array on the heap for larger data-blocks
+  char** sectors_;
+  uint32 num_sectors_;
+  sector_len_t sector_size_;
+};
+
 /**
  * @class FsVolumeManager manages the Volume at which the FileSystem
  * is stored on and provides and interface to access single sectors
@@ -143,16 +201,51 @@ public:
   virtual void releaseWriteDataBlock(sector_addr_t data_block, uint32 num_ref_releases = 1);
 
   /**
-   * reads out a data-block and returns it
+   * reads out a data-block and returns a copy of it located on the heap
+   * (the Caller has to delete[] it)
    */
   virtual char* readDataBlockUnprotected(sector_addr_t sector);
+
+  /**
+   * reads out a data-block without copying it: all sectors of the block
+   * are referenced (pinned) in the cache and are handed out via the view
+   * The references are dropped with releaseReadDataBlock() /
+   * releaseWriteDataBlock() as usual.
+   *
+   * @param data_block the data-block to read
+   * @param[out] view the view to fill
+   * @return true in case of success; in case of an I/O error no
+   * sector stays referenced, the data-block has to be released with
+   * num_ref_releases = 0 then
+   */
+  virtual bool readDataBlockViewUnprotected(sector_addr_t data_block, DataBlockView& view);
   virtual bool writeDataBlockUnprotected(sector_addr_t sector, const char* block);
 
+  /**
+   * reads the given data-blocks ahead into the sector cache, so that
+   * later reads of them are cache-hits. Sectors that are already cached
+   * are skipped, the others are read with as few device requests as
+   * possible (consecutive sectors are merged).
+   * No data-block has to be acquired for this, nothing stays referenced.
+   *
+   * @param data_blocks the data-blocks to read ahead
+   * @param num_data_blocks number of data-blocks
+   */
+  virtual void readAheadDataBlocks(const sector_addr_t* data_blocks, uint32 num_data_blocks);
+
   /**
    * flushes all pending write-operations on the Device data block cache
+   * and the write cache of the Device itself
    */
   void flush(void);
 
+  /**
+   * writes the write cache of the Device to stable storage (barrier),
+   * the data block cache is left untouched
+   * @return true / false
+   */
+  bool flushDeviceCache(void);
+
   /**
    * If there is a pending write-operation to the given sector it will be
    * executed right now.
@@ -10,6 +10,7 @@
 #define FSWORKINGDIRECTORY_H_
 
 #include "types.h"
+#include "fs/FileDescriptorTable.h"
 
 class Directory;
 
@@ -39,9 +40,11 @@ public:
   /**
    * sets the current working directory
    * @param working_dir the new working directory
+   * @param working_dir_inode the resolved new working directory or NULL,
+   * the FsWorkingDirectory takes over the reference to the I-Node
    * @return error-code
    */
-  int32 setWorkingDir(const char* working_dir);
+  int32 setWorkingDir(const char* working_dir, Directory* working_dir_inode = 0);
 
   /**
    * getting the current working directory
@@ -49,7 +52,13 @@ public:
    */
   //char* getWorkingDirPath(void) const;
   const char* getWorkingDirPath(void) const;
-  //Directory* getWorkingDir(void);
+
+  /**
+   * getting the pinned Directory of the current working directory, the
+   * reference stays owned by the FsWorkingDirectory
+   * @return the Directory or NULL if it was not resolved so far
+   */
+  Directory* getWorkingDir(void);
 
   /**
    * sets the new root directory of the Thread / Process
@@ -65,6 +74,12 @@ public:
   const char* getRootDirPath(void) const;
   //Directory* getRootDir(void);
 
+  /**
+   * getting the table of the open files of the Thread / Process
+   * @return the FileDescriptorTable
+   */
+  FileDescriptorTable* getFileDescriptorTable(void);
+
 private:
 
   void deleteRootString(void);
@@ -81,6 +96,9 @@ private:
 
   // root-directory i-node
   Directory* root_dir_;
+
+  // the open files, a copy starts without any
+  FileDescriptorTable fd_table_;
 };
 
 #endif /* FSWORKINGDIRECTORY_H_ */
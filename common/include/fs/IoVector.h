@@ -0,0 +1,26 @@
+/**
+ * Filename: IoVector.h
+ * Description:
+ *
+ * Created on: 18.10.2026
+ */
+
+#ifndef IOVECTOR_H_
+#define IOVECTOR_H_
+
+#include "types.h"
+
+/**
+ * @struct a buffer of a vectored I/O operation (readv() / writev()), has
+ * the same layout as the struct iovec of the userspace
+ */
+struct iovec_s
+{
+  void* iov_base;   // start of the buffer
+  size_t iov_len;   // length of the buffer in bytes
+};
+
+// the maximal number of buffers of a single readv() / writev() call
+#define IOV_MAX           1024
+
+#endif /* IOVECTOR_H_ */
@@ -28,6 +28,8 @@ enum
 #define MS_MANDLOCK MS_MANDLOCK
   MS_DIRSYNC = 128,   /* Directory modifications are synchronous.  */
 #define MS_DIRSYNC  MS_DIRSYNC
+  MS_CACHE_2Q = 512,    /* SWEB: scan resistant 2Q sector cache (unused by Linux).  */
+#define MS_CACHE_2Q MS_CACHE_2Q
   MS_NOATIME = 1024,    /* Do not update access times.  */
 #define MS_NOATIME  MS_NOATIME
   MS_NODIRATIME = 2048,   /* Do not update directory access times.  */
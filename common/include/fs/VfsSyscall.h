@@ -10,6 +10,7 @@
 #include "fs/FsDefinitions.h"
 #include "fs/FileSystemPool.h"
 #include "fs/FileSystem.h"
+#include "fs/DentryCache.h"
 
 #ifndef USE_FILE_SYSTEM_ON_GUEST_OS
 #include "kernel/Mutex.h"
@@ -24,6 +25,7 @@ class Directory;
 class File;
 
 struct statfs_s;
+struct iovec_s;
 struct DIR;
 class Dirent;
 class FileDescriptor;
@@ -48,6 +50,7 @@ class VfsSyscall
 {
   // my friends
   friend class FsWorkingDirectory;
+  friend class DentryCache;
 
   public:
 
@@ -230,6 +233,47 @@ class VfsSyscall
      */
     virtual int32 write ( FsWorkingDirectory* wd_info, fd_size_t fd, const char *buffer, size_t count );
 
+    /**
+     * pread() / pwrite() read / write up to count bytes at the given offset
+     * of the file, the file position is not used and not changed. Several
+     * Threads can use them on the same file descriptor without interfering.
+     * @param wd_info current working dir
+     * @param fd the file descriptor
+     * @param buffer the buffer to read to / to write
+     * @param count the number of bytes
+     * @param offset the offset from the start of the file
+     * @return On success, the number of bytes read / written is returned.
+     *         On error, -1 is returned.
+     */
+    virtual int32 pread ( FsWorkingDirectory* wd_info, fd_size_t fd, char* buffer, size_t count, l_off_t offset );
+    virtual int32 pwrite ( FsWorkingDirectory* wd_info, fd_size_t fd, const char *buffer, size_t count, l_off_t offset );
+
+    /**
+     * readv() / writev() read into / write from iov_count buffers (in order)
+     * at the file position, just like a single read() / write() of the
+     * concatenated buffers
+     * @param wd_info current working dir
+     * @param fd the file descriptor
+     * @param iov the buffers
+     * @param iov_count the number of buffers (at most IOV_MAX)
+     * @return On success, the number of bytes read / written is returned,
+     *         and the file position is advanced by this number.
+     *         On error, -1 is returned.
+     */
+    virtual int32 readv ( FsWorkingDirectory* wd_info, fd_size_t fd, const iovec_s* iov, uint32 iov_count );
+    virtual int32 writev ( FsWorkingDirectory* wd_info, fd_size_t fd, const iovec_s* iov, uint32 iov_count );
+
+    /**
+     * creates a private copy of a FileDescriptor for mapping the file into
+     * memory, the copy stays valid if fd is closed
+     * @param wd_info current working dir
+     * @param fd the file descriptor
+     * @param for_writing true if the mapping writes changes back to the file
+     * @return the copy (to be deleted by the caller) or NULL if fd is not an
+     *         open regular file or has not the required rights
+     */
+    virtual FileDescriptor* getFileDescriptorForMapping ( FsWorkingDirectory* wd_info, fd_size_t fd, bool for_writing );
+
     /**
      * commit buffer cache to disk (http://linux.die.net/man/2/sync)
      * sync() causes all buffered modifications to file metadata and data
@@ -336,6 +380,17 @@ class VfsSyscall
 
   protected:
 
+    /**
+     * looks up a child of the given Directory on it's FileSystem and adds
+     * the result to the dentry cache (mount-points are resolved to the
+     * root of the mounted FileSystem)
+     *
+     * @param dir the Directory to search, referenced by the caller
+     * @param name the name of the child
+     * @return the acquired child or NULL if there is no such child
+     */
+    Inode* lookupChild(Directory* dir, const char* name);
+
     /**
      * resolves a string-given path and returns the Inode
      *
@@ -398,6 +453,23 @@ class VfsSyscall
      */
     virtual bool isOperationPermitted(Inode* inode, int32 operation);
 
+    /**
+     * HOOK; not implemented
+     *
+     * checks if the current-Thread is allowed to search a Directory with the
+     * given attributes, isOperationPermitted() uses it for EXECUTE on a
+     * Directory and the DentryCache for the Directories it passes without
+     * acquiring them (it is called with the DentryCache locked)
+     * NOTE: there are no user rights yet, so every search is permitted
+     *
+     * @param fs the FileSystem of the Directory
+     * @param uid the owner of the Directory
+     * @param gid the group of the Directory
+     * @param permissions the permissions of the Directory (Unix octal style)
+     * @return true if the Thread is allowed to search the Directory
+     */
+    virtual bool isSearchPermitted(FileSystem* fs, uint32 uid, uint32 gid, uint32 permissions);
+
     /**
      * HOOK; not implemented
      * checking User's disk-quota
@@ -523,6 +595,31 @@ class VfsSyscall
      */
     FileDescriptor* createFDForFile(File* file, uint32 flags);
 
+    /**
+     * translates a file descriptor number into the FileDescriptor object
+     * and checks the access rights
+     *
+     * @param wd_info current working dir
+     * @param fd the file descriptor
+     * @param for_writing true if write-rights are required, otherwise
+     * read-rights are required
+     * @param caller the name of the calling syscall (for debugging)
+     * @return the FileDescriptor or NULL if fd is not open or has not the
+     * requested rights
+     */
+    FileDescriptor* getFileDescriptor(FsWorkingDirectory* wd_info, fd_size_t fd,
+                                      bool for_writing, const char* caller);
+
+    /**
+     * syncs the File of a FileDescriptor opened with O_SYNC after a
+     * successful write operation (if the FileSystem is not mounted
+     * synchronously anyway)
+     *
+     * @param fd_object the FileDescriptor written to
+     * @param bytes_written the result of the write operation
+     */
+    void synchronizeWrite(FileDescriptor* fd_object, int32 bytes_written);
+
     /**
      * rewrites the Inode of a parent-directory that was affected by
      * some changes (e.g. creation / removing of sub-directory / file)
@@ -544,6 +641,9 @@ class VfsSyscall
 
     // the FileSystem pool containing all available file-systems
     FileSystemPool fs_pool_;
+
+    // the cached results of the path-component lookups
+    DentryCache dentry_cache_;
 };
 
 #endif // VFS_SYSCALL_H___
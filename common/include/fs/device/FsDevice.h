@@ -64,6 +64,13 @@ class FsDevice : public Cache::DeviceAdapter
      */
     virtual sector_addr_t getNumBlocks(void) const = 0;
 
+    /**
+     * writes the volatile write cache of the (Block)Device to stable storage,
+     * this is a barrier for sync() and fsync()
+     * @return true / false
+     */
+    virtual bool flushCache(void) { return true; }
+
     /**
      * IMPLEMENTS the DeviceAdapter read() method, this is just another
      * version of the readSector() method
@@ -84,6 +91,35 @@ class FsDevice : public Cache::DeviceAdapter
      */
     virtual bool remove(const Cache::ItemIdentity& ident, Cache::Item* item = NULL);
 
+    /**
+     * IMPLEMENTS the DeviceAdapter readItems() method, runs of
+     * consecutive sectors are read with a single readSector() call
+     */
+    virtual void readItems(const Cache::ItemIdentity* const* idents, Cache::Item** items, uint32 num_items);
+
+    /**
+     * IMPLEMENTS the DeviceAdapter writeItems() method, runs of
+     * consecutive sectors are written with a single writeSector() call
+     */
+    virtual bool writeItems(const Cache::ItemIdentity* const* idents, Cache::Item* const* items, uint32 num_items);
+
+    // the maximal number of sectors merged into one readSector() or
+    // writeSector() call
+    static const uint32 MAX_SECTORS_PER_REQUEST = 64;
+
+  private:
+
+    /**
+     * determines the run of consecutive sectors (with the same sector size)
+     * starting at the first of the given items, that can be read or written
+     * with a single request
+     *
+     * @param idents the SectorCacheIdents of the items
+     * @param num_items the number of items
+     * @return the length of the run (at least 1, at most MAX_SECTORS_PER_REQUEST)
+     */
+    static uint32 getRunLength(const Cache::ItemIdentity* const* idents, uint32 num_items);
+
 };
 
 #endif /* FSDEVICE_H_ */
@@ -75,6 +75,12 @@ class FsDeviceFile : public FsDevice
      */
     virtual sector_addr_t getNumBlocks(void) const;
 
+    /**
+     * writes the volatile write cache to stable storage
+     * @return true / false
+     */
+    virtual bool flushCache(void);
+
   private:
 
     // the image file to write / read to / from
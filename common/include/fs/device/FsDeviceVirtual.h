@@ -67,6 +67,12 @@ class FsDeviceVirtual : public FsDevice
      */
     virtual sector_addr_t getNumBlocks(void) const;
 
+    /**
+     * writes the volatile write cache to stable storage
+     * @return true / false
+     */
+    virtual bool flushCache(void);
+
   private:
 
     // the wrapped device
@@ -10,17 +10,16 @@
 #define DIRECTORY_H_
 
 #ifndef USE_FILE_SYSTEM_ON_GUEST_OS
-#include "ustl/ustring.h"
-#include "ustl/umap.h"
+#include "ustl/uvector.h"
 #include "ustl/ustack.h"
 #else
-#include <string>
-#include <map>
 #include <stack>
 #endif // USE_FILE_SYSTEM_ON_GUEST_OS
 
 #include "fs/FsDefinitions.h"
 #include "fs/inodes/Inode.h"
+#include "fs/inodes/DirectoryChildIndex.h"
+#include "mm/ObjectCache.h"
 
 /**
  * @class special I-Node type - a Directory
@@ -95,14 +94,17 @@ class Directory : public Inode
     Inode* getInode(const char* filename);
 
     /**
-     * getting an I-Node's data by it's index within the Directory children
-     * list
-     * @param index the index of the I-Node within the Directorie's list
-     * @return a pointer to the I-Node or NULL in case that
-     * index >= getNumChildren()
+     * getting the next child for iterating the Directory (e.g. readdir()),
+     * the cursor stays valid while other children are added or removed
+     * @param cursor [in, out] the cursor position, 0 for the first child
+     * @param filename [out] the name of the child, valid until the child is
+     * removed
+     * @param inode_id [out] the I-Node ID of the child (a mount-point is not
+     * resolved)
+     * @return false if there are no more children
      * NOTE: required to be called from a locked context!
      */
-    Inode* getInode(uint32 index);
+    bool getNextChild(uint32& cursor, const char*& filename, inode_id_t& inode_id) const;
 
     /**
      * getting a child Inode, in case the requested Inode refers to a mount-point
@@ -204,13 +206,7 @@ class Directory : public Inode
     bool all_children_loaded_;
 
     // a mapping from the filename to the Inode data
-#ifndef USE_FILE_SYSTEM_ON_GUEST_OS
-    typedef ustl::map<ustl::string, inode_id_t>::iterator ChildrenIterator;
-    ustl::map<ustl::string, inode_id_t> children_;
-#else
-    typedef std::map<std::string, inode_id_t>::iterator ChildrenIterator;
-    std::map<std::string, inode_id_t> children_;
-#endif
+    DirectoryChildIndex children_;
 
     // stack of mounted FileSystems
 #ifndef USE_FILE_SYSTEM_ON_GUEST_OS
@@ -234,6 +230,7 @@ class Directory : public Inode
      */
     Inode* obtainInode(inode_id_t id, const char* name);
 
+    OBJECT_CACHE_MEMBERS
 };
 
 #endif /* DIRECTORY_H_ */
@@ -0,0 +1,132 @@
+/**
+ * Filename: DirectoryChildIndex.h
+ * Description:
+ *
+ * Created on: 18.10.2026
+ */
+
+#ifndef DIRECTORYCHILDINDEX_H_
+#define DIRECTORYCHILDINDEX_H_
+
+#include "types.h"
+#include "fs/FsDefinitions.h"
+
+#ifndef NULL
+#define NULL 0
+#endif
+
+/**
+ * @class DirectoryChildIndex the children (name -> I-Node ID) of a
+ * Directory, hashed by name for the lookup
+ *
+ * The entries are stored in a slot-array, a slot keeps it's position until
+ * the entry is removed. So the slot number can be used as a stable cursor
+ * for iterating the children (see getNext()), adding and removing other
+ * children does not move the cursor. Freed slots are reused, so a child
+ * added while iterating may or may not be returned (just as POSIX allows
+ * for readdir()).
+ *
+ * NOTE: the index has no own lock, it is protected by the lock of it's
+ * Directory
+ */
+class DirectoryChildIndex
+{
+public:
+  /**
+   * constructor, creates an empty index
+   */
+  DirectoryChildIndex();
+
+  /**
+   * destructor
+   */
+  virtual ~DirectoryChildIndex();
+
+  /**
+   * getting the number of children
+   */
+  uint32 size(void) const;
+
+  /**
+   * searches the child with the given name
+   * @param name the name of the child
+   * @param inode_id [out] the I-Node ID of the child (if found)
+   * @return true if the child exists
+   */
+  bool find(const char* name, inode_id_t& inode_id) const;
+
+  /**
+   * adds a new child
+   * @param name the name of the child
+   * @param inode_id the I-Node ID of the child
+   * @return false if a child with the given name already exists
+   */
+  bool insert(const char* name, inode_id_t inode_id);
+
+  /**
+   * removes a child
+   * @param name the name of the child
+   * @return false if there is no child with the given name
+   */
+  bool remove(const char* name);
+
+  /**
+   * removes all children
+   */
+  void clear(void);
+
+  /**
+   * getting the child at or behind the cursor position and moving the
+   * cursor behind it, start with a cursor of 0
+   * @param cursor [in, out] the cursor position
+   * @param name [out] the name of the child, valid until the child is removed
+   * @param inode_id [out] the I-Node ID of the child
+   * @return false if there are no more children
+   */
+  bool getNext(uint32& cursor, const char*& name, inode_id_t& inode_id) const;
+
+private:
+
+  DirectoryChildIndex(const DirectoryChildIndex&);
+  DirectoryChildIndex& operator=(const DirectoryChildIndex&);
+
+  struct ChildSlot
+  {
+    // the name of the child, NULL for an unused slot
+    char* name;
+    uint32 hash;
+    inode_id_t inode_id;
+
+    // next slot in the same hash-bucket, respectively the next free slot
+    uint32 next;
+  };
+
+  // marks the end of a slot chain
+  static const uint32 NO_SLOT = 0xFFFFFFFF;
+
+  // the initial number of slots and buckets
+  static const uint32 MIN_CAPACITY = 8;
+
+  static uint32 hashName(const char* name);
+
+  uint32 findSlot(const char* name, uint32 hash) const;
+
+  void growSlots(void);
+  void rehash(uint32 num_buckets);
+
+  // the slot-array, slots_[0 .. num_used_slots_ - 1] were used at least once
+  ChildSlot* slots_;
+  uint32 num_slots_;
+  uint32 num_used_slots_;
+
+  // chain of the freed slots
+  uint32 free_slot_;
+
+  // the hash-buckets (slot chains), the number of buckets is a power of 2
+  uint32* buckets_;
+  uint32 num_buckets_;
+
+  uint32 num_children_;
+};
+
+#endif /* DIRECTORYCHILDINDEX_H_ */
@@ -12,6 +12,7 @@
 //typedef uint32 l_off_t;
 
 class FileDescriptor;
+struct iovec_s;
 
 /**
  * @class File
@@ -81,6 +82,35 @@ class File : public Inode
      */
     virtual int32 write(FileDescriptor* fd, const char* buffer, uint32 len) = 0;
 
+    /**
+     * reads / writes data at the given position of the file, the
+     * file-cursor of the FileDescriptor is neither used nor changed
+     *
+     * @param fd the associated FileDescriptor object
+     * @param buffer the buffer to read to / to write
+     * @param len the number of bytes to read / write
+     * @param offset the position in the file
+     * @return the number of bytes read / written or a negative value
+     * in case of error
+     */
+    virtual int32 pread(FileDescriptor* fd, char* buffer, uint32 len, file_size_t offset) = 0;
+    virtual int32 pwrite(FileDescriptor* fd, const char* buffer, uint32 len, file_size_t offset) = 0;
+
+    /**
+     * reads into / writes from several buffers (in order) at the
+     * file-cursor, just like a single read() / write() of the concatenated
+     * buffers
+     * the default implementation calls read() / write() for every buffer
+     *
+     * @param fd the associated FileDescriptor object
+     * @param iov the buffers
+     * @param iov_count the number of buffers
+     * @return the number of bytes read / written or a negative value
+     * in case of error
+     */
+    virtual int32 readv(FileDescriptor* fd, const iovec_s* iov, uint32 iov_count);
+    virtual int32 writev(FileDescriptor* fd, const iovec_s* iov, uint32 iov_count);
+
     /**
      * discards all contents of the file without further safety checks
      * and without establishing mutual exclusion!
@@ -101,6 +131,13 @@ class File : public Inode
      */
     virtual bool truncateProtected(void);
 
+    /**
+     * releases the data blocks the FileSystem reserved for appending to the
+     * File (FileSystem::releaseReservedSectors()), acquires the File's Lock
+     * for Writing; called on closing a File opened for writing
+     */
+    void releaseReservedSectorsProtected(void);
+
   protected:
 
     // the file-size -> moved to Inode.h
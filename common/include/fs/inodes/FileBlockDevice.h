@@ -63,6 +63,12 @@ public:
    */
   virtual int32 write(FileDescriptor* fd, const char* buffer, uint32 len);
 
+  /**
+   * reads / writes data at the given position of the device
+   */
+  virtual int32 pread(FileDescriptor* fd, char* buffer, uint32 len, file_size_t offset);
+  virtual int32 pwrite(FileDescriptor* fd, const char* buffer, uint32 len, file_size_t offset);
+
 private:
 
   // the Block-device associated with
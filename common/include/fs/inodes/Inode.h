@@ -19,6 +19,11 @@
 
 #include "fs/FsDefinitions.h"
 #include "fs/FileSystemLock.h"
+#include "fs/inodes/SectorExtentMap.h"
+
+#ifndef USE_FILE_SYSTEM_ON_GUEST_OS
+#include "kernel/Mutex.h"
+#endif
 
 // forwards
 class Dentry;
@@ -230,8 +235,8 @@ class Inode
 
     /**
      * getting the n-th sector of the I-Node
-     * if the sector is missing the method will try to update the i-node's
-     * sector list by loading them from the FileSystem
+     * if the sector is not loaded so far the method will load the i-node's
+     * sector list up to it by FileSystem::updateInodesSectorList()
      *
      * @param number the number of the i-node to return
      * @return the sector number or 0 if there is not a sector with the
@@ -250,7 +255,8 @@ class Inode
     sector_addr_t getSector(uint32 number) const;
 
     /**
-     * adds a sector to the end of the linked-sector-list
+     * adds a sector to the end of the sector-list
+     * NOTE: modifying the sector-list loads it completely first
      * @param sector the number of the following sector
      */
     void addSector(sector_addr_t sector);
@@ -269,16 +275,76 @@ class Inode
 
     /**
      * getting the number of sectors used by the I-Node
+     * (loads the complete sector-list)
      *
      * @return the number of elements currently stored in the list
      */
-    uint32 getNumSectors(void) const;
+    uint32 getNumSectors(void);
 
     /**
      * clears the list of all sectors
      */
     void clearSectorList(void);
 
+    /**
+     * adds a sector read from the device to the end of the sector-list,
+     * used by the FileSystem for loading the list (not a modification)
+     * @param sector the number of the following sector
+     */
+    void addLoadedSector(sector_addr_t sector);
+
+    /**
+     * adds a run of contiguous sectors read from the device to the end of
+     * the sector-list (see addLoadedSector())
+     * @param first_sector the first sector of the run
+     * @param num_sectors the length of the run
+     */
+    void addLoadedSectors(sector_addr_t first_sector, uint32 num_sectors);
+
+    /**
+     * getting the number of sectors loaded so far
+     */
+    uint32 getNumLoadedSectors(void) const;
+
+    /**
+     * marks the sector-list as complete or as partially loaded, a
+     * partially loaded list is completed on demand
+     * @param loaded true if all sectors are in the list
+     */
+    void setAllSectorsLoaded(bool loaded);
+
+    /**
+     * is the sector-list complete?
+     */
+    bool areAllSectorsLoaded(void) const;
+
+    /**
+     * was the sector-list modified since it was loaded or stored?
+     * (the FileSystem just has to store the sector addresses in that case)
+     */
+    bool isSectorListModified(void) const;
+    void setSectorListModified(bool modified);
+
+    /**
+     * getting the number of runs of contiguous sectors in the sector-list
+     */
+    uint32 getNumSectorExtents(void) const;
+
+    /**
+     * getting the data blocks the FileSystem reserved for the next appends
+     * to the I-Node (preallocation, see FileSystem::appendSectorToInode())
+     * @param first_sector [out] the first reserved block
+     * @param num_sectors [out] the number of reserved blocks, 0 if none
+     */
+    void getReservedSectors(sector_addr_t& first_sector, uint32& num_sectors) const;
+
+    /**
+     * sets the reserved data blocks (used by the FileSystem only)
+     * @param first_sector the first reserved block
+     * @param num_sectors the number of reserved blocks
+     */
+    void setReservedSectors(sector_addr_t first_sector, uint32 num_sectors);
+
     /**
      * sets an indirect block with sectors to the I-Node
      *
@@ -307,6 +373,11 @@ class Inode
 
   private:
 
+    /**
+     * loads the rest of a partially loaded sector-list
+     */
+    void loadAllSectors(void);
+
     // optional I-Node Number (ID)
     inode_id_t number_;
 
@@ -318,11 +389,24 @@ class Inode
     sector_addr_t device_sector_;
     sector_len_t sector_offset_;
 
-    // linked-list with block-devices sectors
+    // the block-devices sectors as runs of contiguous sectors
+    SectorExtentMap data_sectors_;
+
+    // is data_sectors_ complete, or is it loaded on demand?
+    bool all_sectors_loaded_;
+
+    // was data_sectors_ modified since it was loaded or stored? (a new
+    // I-Node's list is considered as modified until it is stored)
+    bool sector_list_modified_;
+
+    // contiguous data blocks reserved for the next appends, but not yet
+    // part of data_sectors_
+    sector_addr_t reserved_sector_;
+    uint32 num_reserved_sectors_;
+
 #ifndef USE_FILE_SYSTEM_ON_GUEST_OS
-    ustl::list<sector_addr_t> data_sectors_;
-#else
-    std::vector<sector_addr_t> data_sectors_;
+    // protects the loading of data_sectors_ by concurrent readers
+    Mutex sector_list_lock_;
 #endif
 
     // optional list of blocks that refer to data-blocks (indirect address)
@@ -10,6 +10,7 @@
 #define REGULARFILE_H_
 
 #include "File.h"
+#include "mm/ObjectCache.h"
 
 class FsVolumeManager;
 
@@ -39,6 +40,12 @@ public:
   virtual int32 read(FileDescriptor* fd, char* buffer, uint32 len);
   virtual int32 write(FileDescriptor* fd, const char* buffer, uint32 len);
 
+  virtual int32 pread(FileDescriptor* fd, char* buffer, uint32 len, file_size_t offset);
+  virtual int32 pwrite(FileDescriptor* fd, const char* buffer, uint32 len, file_size_t offset);
+
+  virtual int32 readv(FileDescriptor* fd, const iovec_s* iov, uint32 iov_count);
+  virtual int32 writev(FileDescriptor* fd, const iovec_s* iov, uint32 iov_count);
+
   /**
    * discards all contents of the file without further safety checks
    * and without establishing mutual exclusion!
@@ -60,6 +67,82 @@ private:
    */
   bool updateLastAccessTimeProtected(FileDescriptor* fd);
 
+  /**
+   * reads the data-blocks [first_block, end_block) of the file ahead into
+   * the sector cache (stops at the first block that is not allocated)
+   *
+   * @param first_block the index of the first data-block of the file
+   * @param end_block the index behind the last data-block to read ahead
+   * @return the index behind the last data-block that was read ahead
+   */
+  uint32 readAhead(uint32 first_block, uint32 end_block);
+
+  /**
+   * reads into the buffers at the given position or at the file-cursor
+   * (moving it), with the File's Lock held for reading
+   *
+   * @param fd the associated FileDescriptor object
+   * @param iov the buffers
+   * @param iov_count the number of buffers
+   * @param pos the position to read at (ignored if use_cursor is set)
+   * @param use_cursor read at the file-cursor
+   * @return the number of bytes read or a negative error code
+   */
+  int32 readVector(FileDescriptor* fd, const iovec_s* iov, uint32 iov_count,
+                   file_size_t pos, bool use_cursor);
+
+  /**
+   * writes the buffers at the given position or at the file-cursor (moving
+   * it), with the File's Lock held for writing
+   *
+   * @param fd the associated FileDescriptor object
+   * @param iov the buffers
+   * @param iov_count the number of buffers
+   * @param pos the position to write at (ignored if use_cursor is set)
+   * @param use_cursor write at the file-cursor (or at the end of the file
+   * in append-mode)
+   * @return the number of bytes written or a negative error code
+   */
+  int32 writeVector(FileDescriptor* fd, const iovec_s* iov, uint32 iov_count,
+                    file_size_t pos, bool use_cursor);
+
+  /**
+   * reads up to len bytes at the given position, the File's Lock has to
+   * be held
+   *
+   * @param buffer the buffer to read to
+   * @param len the number of bytes to read
+   * @param pos the position in the file
+   * @param range_len the number of bytes the whole operation reads from
+   * pos on (the data-blocks of that range are read in batches)
+   * @param read_ahead_window the readahead window (in data-blocks)
+   * @param read_ahead_end [in, out] the data-block behind the last one
+   * that was read ahead
+   * @return the number of bytes read (less than len at the end of the
+   * file) or a negative error code
+   */
+  int32 readUnprotected(char* buffer, uint32 len, file_size_t pos, uint32 range_len,
+                        uint32 read_ahead_window, uint32& read_ahead_end);
+
+  /**
+   * writes len bytes at the given position, appending data-blocks if
+   * necessary, the File's Lock has to be held for writing
+   * the file-size is not updated
+   *
+   * @param buffer the data to write
+   * @param len the number of bytes to write
+   * @param pos the position in the file (not behind the end of the file)
+   * @param inode_changed [out] set if data-blocks were appended
+   * @return the number of bytes written (less than len on errors) or a
+   * negative error code if nothing was written
+   */
+  int32 writeUnprotected(const char* buffer, uint32 len, file_size_t pos, bool& inode_changed);
+
+  /**
+   * acquires a read-lock
+   */
+  int32 lockRead(FileDescriptor* fd);
+
   /**
    * acquires a write-lock
    */
@@ -73,6 +156,7 @@ private:
   // the FsVolumeManager of the FileSystem
   FsVolumeManager* volume_manager_;
 
+  OBJECT_CACHE_MEMBERS
 };
 
 #endif /* REGULARFILE_H_ */
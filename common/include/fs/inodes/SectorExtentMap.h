@@ -0,0 +1,116 @@
+/**
+ * Filename: SectorExtentMap.h
+ * Description:
+ *
+ * Created on: 18.10.2026
+ */
+
+#ifndef SECTOREXTENTMAP_H_
+#define SECTOREXTENTMAP_H_
+
+#include "types.h"
+#include "fs/FsDefinitions.h"
+
+#ifndef USE_FILE_SYSTEM_ON_GUEST_OS
+#include <ustl/uvector.h>
+#else
+#include <vector>
+#endif
+
+/**
+ * @class SectorExtentMap the list of an I-Node's data sectors, stored as
+ * runs of contiguous sectors (extents)
+ *
+ * A file written in one go mostly consists of a few long runs, so the map
+ * needs a few bytes instead of one entry per sector. The n-th sector is
+ * found by a binary search over the extents.
+ */
+class SectorExtentMap
+{
+public:
+  /**
+   * constructor, creates an empty map
+   */
+  SectorExtentMap();
+
+  /**
+   * destructor
+   */
+  virtual ~SectorExtentMap();
+
+  /**
+   * getting the n-th sector
+   * @param number the index of the sector
+   * @return the sector or 0 if number >= size()
+   */
+  sector_addr_t getSector(uint32 number) const;
+
+  /**
+   * adds a sector to the end, it extends the last extent if it follows it
+   * @param sector the sector to add
+   */
+  void append(sector_addr_t sector);
+
+  /**
+   * adds a run of contiguous sectors to the end
+   * @param first_sector the first sector of the run
+   * @param num_sectors the length of the run
+   */
+  void append(sector_addr_t first_sector, uint32 num_sectors);
+
+  /**
+   * removes the last sector
+   */
+  void removeLast(void);
+
+  /**
+   * removes the n-th sector, the following sectors move up by one
+   * @param number the index of the sector to remove
+   */
+  void remove(uint32 number);
+
+  /**
+   * removes all sectors
+   */
+  void clear(void);
+
+  /**
+   * getting the number of sectors
+   */
+  uint32 size(void) const;
+
+  /**
+   * getting the number of extents (the memory used is proportional to it)
+   */
+  uint32 getNumExtents(void) const;
+
+  struct SectorExtent
+  {
+    // the first sector of the run
+    sector_addr_t first_sector;
+
+    // the index of the first sector within the map
+    uint32 first_index;
+
+    // the length of the run
+    uint32 num_sectors;
+  };
+
+private:
+
+  /**
+   * finds the extent holding the n-th sector (number has to be < size())
+   * @return the index of the extent
+   */
+  uint32 findExtent(uint32 number) const;
+
+#ifndef USE_FILE_SYSTEM_ON_GUEST_OS
+  ustl::vector<SectorExtent> extents_;
+#else
+  std::vector<SectorExtent> extents_;
+#endif
+
+  uint32 num_sectors_;
+};
+
+#endif /* SECTOREXTENTMAP_H_ */
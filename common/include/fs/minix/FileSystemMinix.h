@@ -217,6 +217,14 @@ public:
    */
   virtual sector_addr_t appendSectorToInode(Inode* inode, bool zero_out_sector = false);
 
+  /**
+   * frees the data blocks reserved for a File's next appends
+   * (for details see FileSystem.h)
+   *
+   * @param inode the I-Node
+   */
+  virtual void releaseReservedSectors(Inode* inode);
+
   /**
    * removes the n-th data block from the given I-Node (so that the sector can
    * be used again by other I-Node's). This causes the I-Node's size to shrink.
@@ -244,8 +252,9 @@ public:
    * updates an I-Node's sector list (for details see FileSystem.h)
    *
    * @param inode the i-node thats list of blocks has to be updated
+   * @param number the list has to be loaded at least up to this sector
    */
-  virtual void updateInodesSectorList(Inode* inode);
+  virtual void updateInodesSectorList(Inode* inode, uint32 number);
 
   /**
    * reads out the Super-Block from the FsDevice
@@ -304,6 +313,28 @@ private:
    */
   bool removeDirectoryEntry(Directory* parent, const char* name, uint16 inode);
 
+  /**
+   * reserves a contiguous window of free zones for the File's next appends,
+   * preferably right behind the File's last data block. The zones are
+   * reserved in the in-memory Zone Bitmap only, they are occupied on the
+   * device one by one by appendSectorToInode()
+   *
+   * @param inode the File
+   * @return false if the device is full
+   */
+  bool reserveSectors(Inode* inode);
+
+  /**
+   * sets all bytes of a data block to 0x00
+   *
+   * @param block_addr the address of the data-block
+   */
+  void clearDataBlock(sector_addr_t block_addr);
+
+  // the reservation window is as big as the File, but at least / at most
+  static const uint32 MIN_RESERVED_SECTORS = 8;
+  static const uint32 MAX_RESERVED_SECTORS = 128;
+
   /**
    * adds a new Dir-Entry to the given buffer
    *
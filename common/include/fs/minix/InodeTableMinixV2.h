@@ -87,6 +87,14 @@ public:
    */
   virtual sector_len_t getInodeSectorOffset(inode_id_t id);
 
+  /**
+   * loads the I-Node's indirect addressed data blocks on demand
+   *
+   * @param inode the I-Node
+   * @param number the list has to be loaded at least up to this data block
+   */
+  virtual void loadDataBlocks(Inode* inode, uint32 number);
+
   /**
    * inits a just created I-Node class instance
    *
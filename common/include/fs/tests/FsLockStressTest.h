@@ -0,0 +1,93 @@
+/**
+ * Filename: FsLockStressTest.h
+ * Description:
+ *
+ * Created on: 18.10.2026
+ */
+
+#ifndef FSLOCKSTRESSTEST_H_
+#define FSLOCKSTRESSTEST_H_
+
+#include "types.h"
+#include "Thread.h"
+#include "Mutex.h"
+#include "Condition.h"
+
+class FileSystemLock;
+
+/**
+ * @class a kernel test measuring the throughput of a single, shared
+ * file-system lock (as used by an I-Node) with 1 to 32 threads. Every
+ * thread acquires and releases the lock in a loop and does a bit of work
+ * while holding it, either only for reading or with every WRITE_RATIO-th
+ * acquisition for writing.
+ * The results are printed as lock acquisitions per timer tick. The writers
+ * increment a shared counter, a lost update is reported as an error.
+ */
+class FsLockStressTest
+{
+public:
+  FsLockStressTest();
+  ~FsLockStressTest();
+
+  /**
+   * runs the test, to be started with a StressTestThread
+   */
+  static void start();
+
+  void run();
+
+private:
+
+  /**
+   * a single thread acquiring / releasing the lock
+   */
+  class LockThread : public Thread
+  {
+  public:
+    LockThread(FsLockStressTest* test, uint32 write_ratio);
+    virtual void Run();
+
+  private:
+    FsLockStressTest* test_;
+    uint32 write_ratio_;
+  };
+
+  /**
+   * runs the given number of threads on a fresh lock and waits until
+   * all of them are finished
+   * @param num_threads
+   * @param write_ratio every write_ratio-th acquisition is a write, 0 for
+   * readers only
+   * @return the number of timer ticks the run took
+   */
+  uint32 runThreads(uint32 num_threads, uint32 write_ratio);
+
+  /**
+   * called by every LockThread as soon as it is finished
+   */
+  void threadDone();
+
+  // the maximal number of threads
+  static const uint32 MAX_THREADS = 32;
+
+  // number of lock acquisitions per thread
+  static const uint32 OPS_PER_THREAD = 4000;
+
+  // every WRITE_RATIO-th acquisition is for writing (in the mixed runs)
+  static const uint32 WRITE_RATIO = 8;
+
+  // the work done while holding the lock
+  static const uint32 WORK_LOOPS = 64;
+
+  FileSystemLock* lock_;
+
+  // protected by lock_ (for writing)
+  uint32 counter_;
+
+  Mutex threads_lock_;
+  Condition all_threads_done_;
+  uint32 threads_running_;
+};
+
+#endif /* FSLOCKSTRESSTEST_H_ */
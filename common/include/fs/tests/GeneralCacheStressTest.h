@@ -0,0 +1,86 @@
+/**
+ * Filename: GeneralCacheStressTest.h
+ * Description:
+ *
+ * Created on: 18.10.2026
+ */
+
+#ifndef GENERALCACHESTRESSTEST_H_
+#define GENERALCACHESTRESSTEST_H_
+
+#include "types.h"
+#include "Thread.h"
+#include "Mutex.h"
+#include "Condition.h"
+
+namespace Cache
+{
+class GeneralCache;
+}
+
+/**
+ * @class a kernel test measuring the throughput of the GeneralCache
+ * with a growing number of reader threads. Each reader borrows and releases
+ * its own range of (always cached) sectors, so the readers only compete
+ * for the locks of the cache itself.
+ * The results are printed as cache operations per timer tick.
+ */
+class GeneralCacheStressTest
+{
+public:
+  GeneralCacheStressTest();
+  ~GeneralCacheStressTest();
+
+  /**
+   * runs the test, to be started with a StressTestThread
+   */
+  static void start();
+
+  void run();
+
+private:
+
+  /**
+   * a single reader, doing getItem() / releaseItem() calls
+   */
+  class ReaderThread : public Thread
+  {
+  public:
+    ReaderThread(GeneralCacheStressTest* test, uint32 first_sector);
+    virtual void Run();
+
+  private:
+    GeneralCacheStressTest* test_;
+    uint32 first_sector_;
+  };
+
+  /**
+   * runs the given number of readers on a fresh cache and waits until
+   * all of them are finished
+   * @param num_readers
+   * @return the number of timer ticks the run took
+   */
+  uint32 runReaders(uint32 num_readers);
+
+  /**
+   * called by every ReaderThread as soon as it is finished
+   */
+  void readerDone();
+
+  // the maximal number of reader threads
+  static const uint32 MAX_READERS = 8;
+
+  // number of getItem() / releaseItem() pairs per reader
+  static const uint32 OPS_PER_READER = 20000;
+
+  // number of sectors used by a single reader
+  static const uint32 SECTORS_PER_READER = 32;
+
+  Cache::GeneralCache* cache_;
+
+  Mutex readers_lock_;
+  Condition all_readers_done_;
+  uint32 readers_running_;
+};
+
+#endif /* GENERALCACHESTRESSTEST_H_ */
@@ -65,21 +65,24 @@ public:
   virtual bool freeOccupiedBlock(sector_addr_t block_address) = 0;
 
   /**
-   * resolves an indirect data block and inserts the single (direct) data blocks
-   * in the i-nodes list
+   * loads the i-node's data blocks addressed by indirect blocks into it's
+   * sector list on demand; the list is extended by whole single-indirect
+   * blocks until it contains the requested sector or the last data block
+   * (then the list is marked as complete)
    *
-   * NOTE: the caller has to assert that the given indirect_block really contains
-   * valid indirect sector addresses and that the degree_of_indirection is
-   * exactly correct! The given values can not be validated!
+   * NOTE: the i-node's list has to contain all direct data blocks and the
+   * indirect blocks have to be set (Inode::setIndirectBlock())
    *
-   * @param inode the i-node where the new direct data blocks are added to
-   * @param indirect_block
-   * @param degree_of_indirection
+   * @param inode the i-node where the data blocks are added to
+   * @param number the number of the data block that has to be loaded
+   * @param num_direct_blocks the number of directly addressed data blocks
+   * @param max_degree_of_indirection the highest degree of indirection used
+   * by the FileSystem
    * @param sector_addr_len the FileSystem's specific length of sector addresses
    * in bytes(!)
    */
-  static void resolveIndirectDataBlocks(Inode* inode, sector_addr_t indirect_block,
-      uint16 degree_of_indirection, uint16 sector_addr_len);
+  static void loadIndirectDataBlocks(Inode* inode, uint32 number, uint32 num_direct_blocks,
+      uint16 max_degree_of_indirection, uint16 sector_addr_len);
 
   /**
    * storeIndirectDataBlocks - stores the Inode's linear list of data-blocks
@@ -108,6 +111,35 @@ public:
 
 protected:
 
+  /**
+   * loads the data blocks addressed by an indirect block (and the blocks
+   * below it) into the i-node's sector list, beginning with the data block
+   * at the given index within the block's tree
+   *
+   * @param inode the i-node where the data blocks are added to
+   * @param indirect_block the address of the indirect block
+   * @param degree_of_indirection the degree of indirection of the block
+   * @param index the index of the first data block to load within the tree
+   * @param number loading stops behind the single-indirect block holding
+   * the data block with this number
+   * @param entries_per_block the number of addresses per indirect block
+   * @param sector_addr_len the length of disk addresses in bytes
+   * @return false if the end of the i-node's data blocks was reached
+   */
+  static bool loadIndirectBlock(Inode* inode, sector_addr_t indirect_block,
+      uint16 degree_of_indirection, uint32 index, uint32 number,
+      uint32 entries_per_block, uint16 sector_addr_len);
+
+  /**
+   * reads the n-th sector address out of an indirect block
+   *
+   * @param sector the data of the indirect block
+   * @param entry the number of the address within the block
+   * @param sector_addr_len the length of disk addresses in bytes
+   */
+  static sector_addr_t readIndirectBlockEntry(const char* sector, uint32 entry,
+      uint16 sector_addr_len);
+
   /**
    * makes and returns a safe escaped string from a given fixed length string
    * that might not be escaped safely
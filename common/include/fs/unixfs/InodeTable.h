@@ -99,6 +99,15 @@ public:
    */
   virtual sector_len_t getInodeSectorOffset(inode_id_t id) = 0;
 
+  /**
+   * loads the I-Node's data blocks that are not loaded so far into it's
+   * sector list (see FileSystem::updateInodesSectorList())
+   *
+   * @param inode the I-Node
+   * @param number the list has to be loaded at least up to this data block
+   */
+  virtual void loadDataBlocks(Inode* inode, uint32 number) = 0;
+
   /**
    * [optional] inits a just created I-Node class instance
    *
@@ -26,6 +26,11 @@ public:
    */
   virtual bool operator==(const Cache::ItemIdentity& cmp);
 
+  /**
+   * hash value of the identity (the inode number)
+   */
+  virtual uint32 hash(void) const;
+
   /**
    * clones this object and returns a new instance of it
    * Located on the heap
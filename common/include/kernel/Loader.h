@@ -13,6 +13,9 @@
 #include "ElfFormat.h"
 #include <ustl/uvector.h>
 
+class MemoryMapping;
+class FileDescriptor;
+
 /**
 * @class Loader manages the Addressspace creation of a thread
 */
@@ -54,6 +57,37 @@ class Loader
      */
     void loadOnePageSafeButSlow ( pointer virtual_address );
 
+    /**
+     *maps a file (or zero-filled memory) into the address space, the pages
+     *are loaded on demand by loadOnePageSafeButSlow()
+     * @param num_pages the size of the mapping
+     * @param writeable true if the userspace may write to the pages
+     * @param shared true if changes are written back to the file
+     * @param file the file to map (the mapping takes it over, also on
+     *  failure), NULL for an anonymous mapping
+     * @param offset the file offset of the first page
+     * @return the first page of the mapping or 0 if there is no room
+     */
+    size_t mapMemory ( size_t num_pages, bool writeable, bool shared, FileDescriptor* file, size_t offset );
+
+    /**
+     *writes the pages of a range back to the files (if shared) and unmaps
+     *them, a range may cover parts of mappings
+     * @param first_page the first page of the range
+     * @param num_pages the length of the range
+     * @return 0 on success, -1 if writing back failed
+     */
+    int32 unmapMemory ( size_t first_page, size_t num_pages );
+
+    /**
+     *writes the dirty pages of a range back to the mapped files
+     * @param first_page the first page of the range
+     * @param num_pages the length of the range
+     * @param synchronous true to write the data through to the device
+     * @return 0 on success, -1 if writing back failed
+     */
+    int32 syncMemory ( size_t first_page, size_t num_pages, bool synchronous );
+
     ArchMemory arch_memory_;
 
   private:
@@ -64,12 +98,26 @@ class Loader
      */
     bool readHeaders();
 
+    /**
+     *finds the memory mapping holding a page
+     * @return the index in mappings_ or mappings_.size() if there is none
+     */
+    size_t findMapping ( size_t virtual_page ) const;
+
 
     size_t fd_;
     Thread *thread_;
     Elf::Ehdr *hdr_;
     ustl::vector<Elf::Phdr> phdrs_;
     Mutex load_lock_;
+
+    // the memory mappings, sorted by their first page
+    ustl::vector<MemoryMapping*> mappings_;
+
+    // the part of the address space used for memory mappings (the userspace
+    // stack is at the end of the lower 2 GiB)
+    static const size_t MAPPING_START_PAGE = 1024U*256U;
+    static const size_t MAPPING_END_PAGE = 1024U*512U - 1024U;
 };
 
 #endif
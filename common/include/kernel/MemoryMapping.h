@@ -0,0 +1,124 @@
+/**
+ * Filename: MemoryMapping.h
+ * Description:
+ *
+ * Created on: 18.10.2026
+ */
+
+#ifndef MEMORYMAPPING_H_
+#define MEMORYMAPPING_H_
+
+#include "types.h"
+#include <ustl/uvector.h>
+
+class ArchMemory;
+class FileDescriptor;
+
+// protection and flags of mmap(), the same values as in the userspace mman.h
+#define PROT_NONE     0x00000000
+#define PROT_READ     0x00000001
+#define PROT_WRITE    0x00000002
+
+#define MAP_PRIVATE   0x00000000
+#define MAP_SHARED    0x40000000
+#define MAP_ANONYMOUS 0x80000000
+
+// flags of msync()
+#define MS_ASYNC      0x00000001
+#define MS_INVALIDATE 0x00000002
+#define MS_SYNC       0x00000004
+
+/**
+ * @class MemoryMapping a range of pages of a process' address space that
+ * mirrors a part of a file (or zero-filled memory if there is no file)
+ *
+ * The pages are loaded on demand: the page fault handler (through the
+ * Loader) reads a page from the file when it is touched the first time.
+ * Pages of a shared writeable mapping are written back to the file if
+ * their dirty flag is set (sync()), a private mapping never writes back.
+ */
+class MemoryMapping
+{
+  public:
+    /**
+     * constructor
+     * @param first_page the first virtual page of the mapping
+     * @param num_pages the number of pages
+     * @param writeable true if the userspace may write to the pages
+     * @param shared true if changes are written back to the file
+     * @param file the FileDescriptor to read from (the mapping takes it
+     * over), NULL for an anonymous mapping
+     * @param offset the file offset of the first page
+     */
+    MemoryMapping(size_t first_page, size_t num_pages, bool writeable, bool shared,
+                  FileDescriptor* file, size_t offset);
+
+    /**
+     * destructor, the pages are neither written back nor unmapped
+     */
+    ~MemoryMapping();
+
+    /**
+     * getting the first virtual page / the number of pages
+     */
+    size_t getFirstPage(void) const;
+    size_t getNumPages(void) const;
+
+    /**
+     * checks if a virtual page belongs to the mapping
+     */
+    bool contains(size_t virtual_page) const;
+
+    /**
+     * reads a page from the file and maps it
+     * @param arch_memory the address space
+     * @param virtual_page the page to load (has to be part of the mapping)
+     * @return true on success, false if the file could not be read
+     */
+    bool loadPage(ArchMemory& arch_memory, size_t virtual_page);
+
+    /**
+     * writes the dirty pages of the given range back to the file (only for
+     * shared writeable file mappings)
+     * @param arch_memory the address space
+     * @param first_page the first virtual page of the range
+     * @param num_pages the length of the range
+     * @param synchronous true to write the data through to the device
+     * @return 0 on success, -1 if writing failed
+     */
+    int32 sync(ArchMemory& arch_memory, size_t first_page, size_t num_pages, bool synchronous);
+
+    /**
+     * unmaps all loaded pages (without writing them back)
+     * @param arch_memory the address space
+     */
+    void unmap(ArchMemory& arch_memory);
+
+    /**
+     * cuts off the tail of the mapping starting at the given page
+     * @param virtual_page the first page of the tail (the mapping must not
+     * start at this page)
+     * @return the tail as new MemoryMapping
+     */
+    MemoryMapping* split(size_t virtual_page);
+
+  private:
+
+    MemoryMapping(const MemoryMapping&);
+    MemoryMapping& operator=(const MemoryMapping&);
+
+    size_t first_page_;
+    bool writeable_;
+    bool shared_;
+
+    // the mapped file (private copy of the FileDescriptor) or NULL
+    FileDescriptor* file_;
+
+    // the file offset of the first page
+    size_t offset_;
+
+    // the physical page of every loaded page, 0 if not loaded yet
+    ustl::vector<size_t> pages_;
+};
+
+#endif /* MEMORYMAPPING_H_ */
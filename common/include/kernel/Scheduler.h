@@ -22,11 +22,29 @@ extern Thread *currentThread;
  *
  * This is a singelton class, it is instantiated in startup() and must be accessed via Scheduler::instance()->....
  * The Scheduler knows about all running and sleeping threads and decides which thread to run next
+ *
+ * Only the runnable threads are kept on the run queues, one FIFO per priority
+ * and a bitmap of the non-empty FIFOs, so picking the next thread does not
+ * depend on the number of sleeping threads. Every thread gets a time slice
+ * per epoch (longer for higher priorities), a thread that has used it up
+ * waits on the expired queue until all runnable threads have used theirs.
+ * A thread that goes to sleep is taken off the run queue by schedule(),
+ * wake() puts it back. The IdleThread is on no queue, it runs if nothing
+ * else is runnable and once at the start of every epoch.
  */
 class Scheduler
 {
   public:
 
+    /**
+     * nice values range from NICE_MIN (highest priority) to NICE_MAX, the
+     * priority of a thread is its nice value - NICE_MIN
+     */
+    static const int32 NICE_MIN = -20;
+    static const int32 NICE_MAX = 19;
+    static const uint32 NUM_PRIORITIES = NICE_MAX - NICE_MIN + 1;
+    static const uint32 DEFAULT_PRIORITY = -NICE_MIN;
+
     /**
      * Singelton Class Instance Access Method
      * @return Pointer to Scheduler
@@ -106,6 +124,15 @@ class Scheduler
      */
     void sleepAndRestoreInterrupts ( bool interrupts );
 
+    /**
+     * the same as sleepAndRestoreInterrupts(), but the thread is woken up
+     * by the scheduler after the given number of timer ticks at the latest
+     * (used for I/O requests completed by an interrupt handler)
+     * @param interrupts
+     * @param timeout_ticks
+     */
+    void sleepAndRestoreInterrupts ( bool interrupts, uint32 timeout_ticks );
+
     /**
      * compares all threads in the scheduler's list to the one given
      * since the scheduler knows about all existing threads, this is
@@ -115,6 +142,19 @@ class Scheduler
      */
     bool checkThreadExists ( Thread* thread );
 
+    /**
+     * changes the priority of a thread
+     * @param thread the thread
+     * @param nice the new nice value, clamped to NICE_MIN..NICE_MAX
+     * @return the nice value that has been set
+     */
+    int32 setNice ( Thread* thread, int32 nice );
+
+    /**
+     * @return the nice value of the thread
+     */
+    int32 getNice ( Thread* thread );
+
     /**
      * @ret true if Scheduling is enabled, false otherwis
      */
@@ -134,6 +174,11 @@ class Scheduler
      */
     void incTicks();
 
+    /**
+     * returns the ticks value stored
+     */
+    uint32 getTicks();
+
   protected:
     friend class IdleThread;
     /**
@@ -141,11 +186,6 @@ class Scheduler
      * it removes and deletes Threads in state ToBeDestroyed
      */
     void cleanupDeadThreads();
-
-    /**
-     * returns the ticks value stored
-     */
-    uint32 getTicks();
     
   private:
 
@@ -178,11 +218,79 @@ class Scheduler
      */
     void waitForFreeSpinLock(SpinLock& lock);
 
+    /**
+     * the queue a thread is on (Thread::sched_queue_), the run queues are
+     * addressed by their index in run_queues_, so swapping the active and
+     * the expired queue does not touch the threads
+     */
+    enum { NOT_QUEUED = 0, RUN_QUEUE_0 = 1, RUN_QUEUE_1 = 2, TIMEOUT_QUEUE = 3 };
+
+    /**
+     * the runnable threads of one epoch, a FIFO per priority and a bitmap
+     * of the priorities with at least one thread
+     */
+    struct RunQueue
+    {
+      Thread* heads_[NUM_PRIORITIES];
+      Thread* tails_[NUM_PRIORITIES];
+      uint32 bitmap_[(NUM_PRIORITIES + 31) / 32];
+      uint32 num_threads_;
+    };
+
+    /**
+     * the methods below change the queues and have to be called with
+     * interrupts disabled, they don't allocate memory
+     */
+
+    /**
+     * puts a thread at the tail of its priority on the active run queue,
+     * or on the expired run queue (with a new time slice) if it has used
+     * up its time slice
+     */
+    void enqueue ( Thread* thread );
+
+    /**
+     * takes a thread off the queue it is on
+     */
+    void dequeue ( Thread* thread );
+
+    /**
+     * adds a thread sleeping with a timeout to the timeout queue, which is
+     * sorted by the wakeup tick
+     */
+    void enqueueTimeout ( Thread* thread );
+
+    /**
+     * wakes up the threads whose timeout has expired
+     */
+    void wakeTimedOutThreads();
+
+    /**
+     * @return the thread with the highest priority on the run queue, 0 if
+     * the queue is empty
+     */
+    Thread* firstThread ( RunQueue* queue );
+
+    /**
+     * @return the number of timer ticks a thread of the priority may run
+     * per epoch
+     */
+    uint32 timeSlice ( uint32 priority );
+
     static Scheduler *instance_;
 
     typedef ustl::list<Thread*> ThreadList;
     ThreadList threads_;
 
+    RunQueue run_queues_[2];
+    RunQueue* active_;
+    RunQueue* expired_;
+
+    // the sleeping threads with a timeout, the next to wake up first
+    Thread* timeout_head_;
+
+    Thread* idle_thread_;
+
     size_t block_scheduling_;
 
     size_t ticks_;
@@ -0,0 +1,39 @@
+/**
+ * @file StressTestThread.h
+ */
+
+#ifndef _STRESSTESTTHREAD_H_
+#define _STRESSTESTTHREAD_H_
+
+#include "Thread.h"
+
+/**
+ * a kernel stress test, runs in the context of a StressTestThread
+ */
+typedef void (*StressTestFunction)();
+
+/**
+ * @class StressTestThread
+ * Helper thread which runs a single kernel stress test (started from the
+ * console, see Console::startStressTest()) and terminates afterwards
+ */
+class StressTestThread : public Thread
+{
+  public:
+    /**
+     * Constructor
+     * @param name the name of the test (and of the thread)
+     * @param test the test to run
+     */
+    StressTestThread ( const char* name, StressTestFunction test );
+
+    /**
+     * runs the test
+     */
+    virtual void Run();
+
+  private:
+    StressTestFunction test_;
+};
+
+#endif
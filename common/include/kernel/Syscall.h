@@ -11,6 +11,7 @@
 #include "Scheduler.h"
 #include "console/kprintf.h"
 
+struct iovec_s;
 
 /**
  * @class Syscall
@@ -83,6 +84,76 @@ class Syscall
  */
   static size_t read(size_t fd, pointer buffer, size_t count);
 
+/**
+ * pwrite / pread write / read at the given offset of the file, the file
+ * position is neither used nor changed
+ *
+ * @pre IF==1
+ * @pre pointer < 2gb
+ * @param fd File-Descriptor of a file a process has opened
+ * @param buffer is a pointer to a userspace buffer
+ * @param size / count is the size of the buffer
+ * @param offset the offset from the start of the file
+ */
+  static size_t pwrite(size_t fd, pointer buffer, size_t size, size_t offset);
+  static size_t pread(size_t fd, pointer buffer, size_t count, size_t offset);
+
+/**
+ * writev / readv write / read a vector of userspace buffers at the file
+ * position in a single operation
+ *
+ * @pre IF==1
+ * @pre pointer < 2gb
+ * @param fd File-Descriptor of a file a process has opened
+ * @param iov is a pointer to a userspace array of struct iovec
+ * @param iov_count is the number of entries of the array (at most IOV_MAX)
+ */
+  static size_t writev(size_t fd, pointer iov, size_t iov_count);
+  static size_t readv(size_t fd, pointer iov, size_t iov_count);
+
+/**
+ * mmap maps a file (or zero-filled memory with MAP_ANONYMOUS) into the
+ * address space, the pages are loaded on demand
+ *
+ * @pre IF==1
+ * @pre pointer < 2gb
+ * @param args is a pointer to the userspace arguments (start, length, prot,
+ *        flags, fd, offset), each of the size of a pointer
+ * @return the address of the mapping or -1 on error
+ */
+  static size_t mmap(pointer args);
+
+/**
+ * munmap removes the mappings of a range, changes of shared mappings are
+ * written back to the file
+ *
+ * @pre IF==1
+ * @param start the page aligned start of the range
+ * @param length the length of the range
+ */
+  static size_t munmap(pointer start, size_t length);
+
+/**
+ * msync writes the changed pages of the shared mappings of a range back
+ * to the files
+ *
+ * @pre IF==1
+ * @param start the page aligned start of the range
+ * @param length the length of the range
+ * @param flags MS_SYNC (write through to the device) or MS_ASYNC
+ */
+  static size_t msync(pointer start, size_t length, size_t flags);
+
+/**
+ * lseek repositions the file position of a file descriptor
+ *
+ * @pre IF==1
+ * @param fd File-Descriptor of a file a process has opened
+ * @param offset the new offset (relative to origin)
+ * @param origin SEEK_SET, SEEK_CUR or SEEK_END
+ */
+  static size_t lseek(size_t fd, size_t offset, size_t origin);
+
 /**
  * close is a basic example of a method handling the close syscall
  *
@@ -113,6 +184,16 @@ class Syscall
  */
   static size_t createprocess(size_t path, size_t sleep);
 
+/**
+ * changes the priority of the calling thread
+ *
+ * @pre IF==1
+ * @param increment is added to the nice value (-20 is the highest priority,
+ *        19 the lowest, values outside are clamped)
+ * @return the new nice value
+ */
+  static size_t nice(size_t increment);
+
   //static size_t clone();
   //static size_t brk(..);
   //static void waitpid();
@@ -122,6 +203,13 @@ class Syscall
 
   private:
   //helper functions
+
+/**
+ * copies the userspace iovec array into the kernel and checks all buffers
+ *
+ * @return the copy (to be deleted by the caller) or 0 on an invalid vector
+ */
+  static iovec_s* copyIoVector(pointer iov, size_t iov_count);
 };
 
 #endif
@@ -127,6 +127,12 @@ class Thread
      * debugging information for mutex deadlocks
      */
     Mutex* sleeping_on_mutex_;
+
+    /**
+     * the timer tick at which a sleeping thread is woken up by the
+     * scheduler, 0 if it sleeps without timeout
+     */
+    uint32 wakeup_tick_;
   private:
 
     /**
@@ -148,6 +154,19 @@ class Thread
 
     Terminal *my_terminal_;
 
+    /**
+     * scheduling information, only used by the Scheduler
+     * priority_: 0 is the highest priority (see Scheduler::setNice())
+     * time_slice_: the timer ticks left in the current epoch
+     * sched_queue_: the queue the thread is on
+     * queue_next_, queue_prev_: the neighbours on that queue
+     */
+    uint32 priority_;
+    uint32 time_slice_;
+    uint32 sched_queue_;
+    Thread* queue_next_;
+    Thread* queue_prev_;
+
   protected:
     FsWorkingDirectory* working_dir_;
 
@@ -6,6 +6,7 @@
 #define _USERPROCESS_H_
 
 #include "Thread.h"
+#include "mm/ObjectCache.h"
 
 class MountMinixAndStartUserProgramsThread;
 
@@ -44,6 +45,8 @@ class UserProcess : public Thread
     uint32 terminal_number_;
     int32 fd_;
     MountMinixAndStartUserProgramsThread *process_registry_;
+
+    OBJECT_CACHE_MEMBERS
 };
 
 #endif
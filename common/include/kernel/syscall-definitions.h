@@ -43,6 +43,9 @@
 //....
 #define sc_reboot 88
 //....
+#define sc_mmap 90
+#define sc_munmap 91
+//....
 #define sc_outline 105
 //....
 #define sc_ipc 117
@@ -51,9 +54,14 @@
 //....
 #define sc_flock 143
 #define sc_msync 144
+#define sc_readv 145
+#define sc_writev 146
 //....
 #define sc_sched_yield 158
 //....
+#define sc_pread 180
+#define sc_pwrite 181
+//....
 #define sc_vfork 190
 #define sc_createprocess 191
 
@@ -7,6 +7,7 @@
 // DO NOT CHANGE THE NAME OR THE TYPE OF THE user_progs VARIABLE!
 char const *user_progs[] = {
 // for reasons of automated testing
+                            "/createprocess-test.sweb",
                             "/stdin-test.sweb",
                             0
                            };
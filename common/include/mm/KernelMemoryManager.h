@@ -86,6 +86,43 @@ class MallocSegment
 // und kann auch leicht ein Loch mit dem davor oder danach mergen
 // free'n muss dann halt umsortiern etc
 
+/**
+ * @class SlabPage
+ *
+ * The header at the start of every page of the size class (slab) allocator.
+ * The rest of the page is cut into objects of one size class, the free ones
+ * are linked through their first word. The marker_ tells freeMemory() that
+ * an address belongs to a slab and not to a MallocSegment.
+ */
+class SlabPage
+{
+  public:
+    uint32 marker_;// = 0xcafebabe;
+    uint16 size_class_;
+    uint16 used_;
+    pointer free_;
+    SlabPage *next_;
+    SlabPage *prev_;
+};
+
+/**
+ * @struct SlabSizeClass
+ * a size class of the slab allocator with the slabs that have free objects
+ */
+struct SlabSizeClass
+{
+    size_t object_size_;
+    uint32 objects_per_slab_;
+    SlabPage *partial_; // slabs with at least one free object
+
+    //statistics:
+    uint32 slabs_;
+    uint32 empty_slabs_;
+    uint32 objects_used_;
+    uint32 allocations_;
+    uint32 frees_;
+};
+
 extern void* kernel_end_address;
 
 
@@ -114,6 +151,8 @@ class KernelMemoryManager
 
     /**
      * allocateMemory is called by new
+     * small sizes (up to SLAB_MAX_OBJECT_SIZE) are taken from the free list of
+     * their size class, larger ones (or if no slab page can be added)
      * searches the MallocSegment-List for a free segment with size >= requested_size
      * @param requested_size number of bytes to allocate
      * @return pointer to Memory Address or 0 if Not Enough Memory
@@ -122,7 +161,7 @@ class KernelMemoryManager
 
     /**
      * freeMemory is called by delete
-     * checks if the given address points to an actual memory segment and marks it unused
+     * checks if the given address points to an actual memory segment (or slab object) and marks it unused
      * if possible it tries to merge with the free segments around it
      * @param virtual_address memory address that was originally returned by allocateMemory
      * @return true if segment was freed or false if address was wrong
@@ -141,6 +180,20 @@ class KernelMemoryManager
      */
     pointer reallocateMemory ( pointer virtual_address, size_t new_size );
 
+    /**
+     * switches the slab allocator for small sizes on or off, new allocations
+     * then only use the MallocSegment list. Objects already allocated from a
+     * slab can still be freed. (used to compare both paths in KmmStressTest)
+     * @param enabled true to use the slabs
+     */
+    void setSlabsEnabled ( bool enabled );
+
+    /**
+     * prints the allocation and fragmentation statistics of the slabs
+     * and the MallocSegment list
+     */
+    void printStatistics();
+
     /**
      * called from startup() after the scheduler has been created and just
      * before the Interrupts are turned on
@@ -209,6 +262,57 @@ class KernelMemoryManager
      */
     inline pointer private_AllocateMemory ( size_t requested_size );
 
+    /**
+     * takes an object of the size class of requested_size from a slab
+     * @param requested_size the 16 byte aligned size (<= SLAB_MAX_OBJECT_SIZE)
+     * @return the object or 0 if no slab could be added to the size class
+     */
+    pointer allocateSlabObject ( size_t requested_size );
+
+    /**
+     * puts an object back to its slab
+     * @param virtual_address the object
+     * @return false if the address is not part of a slab
+     */
+    bool freeSlabObject ( pointer virtual_address );
+
+    /**
+     * returns the slab an address belongs to
+     * @param virtual_address the address
+     * @return the slab or 0 if the address is not part of a slab
+     */
+    SlabPage *getSlabFromAddress ( pointer virtual_address );
+
+    /**
+     * adds a fresh page from the PageManager to a size class,
+     * called with the KMM locked (the lock is dropped for the PageManager)
+     * @param size_class the size class
+     * @return false if the PageManager must not be used right now
+     */
+    bool addSlab ( uint32 size_class );
+
+    /**
+     * the PageManager lock is a Mutex, we must not wait for it where a
+     * thread must not sleep, or if the allocation is done by the lock itself
+     * @return true if the PageManager may be used
+     */
+    bool mayUsePageManager();
+
+    /**
+     * inserts / removes a slab in the list of slabs with free objects
+     */
+    void linkSlab ( SlabSizeClass &size_class, SlabPage *slab );
+    void unlinkSlab ( SlabSizeClass &size_class, SlabPage *slab );
+
+    static const uint32 SLAB_MARKER = 0xcafebabe;
+
+    // the objects start behind the SlabPage, 16 byte aligned
+    static const size_t SLAB_HEADER_SIZE = 32;
+
+    static const size_t SLAB_MAX_OBJECT_SIZE = 2032;
+    static const uint32 NUM_SIZE_CLASSES = 14;
+    static const size_t SIZE_CLASSES[NUM_SIZE_CLASSES];
+
     MallocSegment* first_;  //first_ must _never_ be NULL
     MallocSegment* last_;
     pointer malloc_end_;
@@ -230,6 +334,16 @@ class KernelMemoryManager
     uint32 segments_free_;
     size_t approx_memory_free_;
 
+    SlabSizeClass size_classes_[NUM_SIZE_CLASSES];
+
+    // the size class of every 16 byte step up to SLAB_MAX_OBJECT_SIZE
+    uint8 size_class_of_[SLAB_MAX_OBJECT_SIZE / 16 + 1];
+
+    bool slabs_enabled_;
+
+    // small allocations that had to use the MallocSegment list
+    uint32 slab_fallbacks_;
+
     static KernelMemoryManager *instance_;
 
 };
@@ -0,0 +1,138 @@
+/**
+ * Filename: ObjectCache.h
+ * Description:
+ *
+ * Created on: 18.10.2026
+ */
+
+#ifndef OBJECTCACHE_H_
+#define OBJECTCACHE_H_
+
+#include "types.h"
+
+#ifndef USE_FILE_SYSTEM_ON_GUEST_OS
+
+#include "kernel/SpinLock.h"
+
+/**
+ * @class ObjectCache keeps the memory of deleted objects of one class for
+ * the next new of that class, so frequently created objects bypass the
+ * KernelMemoryManager (its segment list and its lock).
+ *
+ * A class opts in with OBJECT_CACHE_MEMBERS in its declaration and
+ * OBJECT_CACHE_DEFINITIONS in its source file. Only objects of exactly the
+ * size of the class are cached, derived classes using the inherited
+ * operators go to the KMM. As with the KMM, new returns zeroed memory.
+ * If poisoning is on (the OBJECT_CACHE debug flag), cached objects are
+ * filled with a pattern that is checked on reuse to detect writes to
+ * deleted objects.
+ */
+class ObjectCache
+{
+  public:
+
+    /**
+     * returns the cache, creating it on the first call
+     * (there are no global constructors in the kernel)
+     * @param cache the pointer of the class holding its cache
+     * @param name the name of the class
+     * @param object_size the size of the class
+     * @return the cache
+     */
+    static ObjectCache* getCache(ObjectCache*& cache, const char* name, size_t object_size);
+
+    /**
+     * returns a cached object or new memory from the KMM
+     * @param size the size requested by new
+     * @return the zeroed memory
+     */
+    void* allocate(size_t size);
+
+    /**
+     * caches an object or gives it back to the KMM if the cache is full
+     * @param object the deleted object
+     * @param size the size of the object
+     */
+    void free(void* object, size_t size);
+
+    /**
+     * prints the hit/miss counters of all caches
+     */
+    static void printStatistics();
+
+  private:
+
+    ObjectCache(const char* name, size_t object_size, bool poison);
+
+    ObjectCache(const ObjectCache&);
+    ObjectCache& operator=(const ObjectCache&);
+
+    /**
+     * checks the pattern of a poisoned object
+     * @return true if the object was not written to
+     */
+    bool checkPoison(void* object) const;
+
+    static const uint8 POISON = 0x6b;
+
+    // the memory a cache may hold
+    static const size_t MAX_CACHED_BYTES = 32 * 1024;
+    static const uint32 MIN_CACHED_OBJECTS = 4;
+
+    const char* name_;
+    size_t object_size_;
+    bool poison_;
+    uint32 max_cached_;
+
+    // the cached objects, linked through their first word
+    void* free_list_;
+    uint32 num_cached_;
+
+    SpinLock lock_;
+
+    //statistics:
+    uint32 hits_;
+    uint32 misses_;
+    uint32 uncached_;
+    uint32 poison_errors_;
+
+    ObjectCache* next_cache_;
+
+    static ObjectCache* first_cache_;
+    static size_t create_lock_;
+};
+
+/**
+ * declares the class specific new / delete and the cache,
+ * has to be put at the end of the class declaration (continues private)
+ */
+#define OBJECT_CACHE_MEMBERS \
+  public: \
+    static void* operator new(size_t size); \
+    static void operator delete(void* object, size_t size); \
+  private: \
+    static ObjectCache* object_cache_;
+
+/**
+ * defines the class specific new / delete of a class
+ */
+#define OBJECT_CACHE_DEFINITIONS(Class) \
+  ObjectCache* Class::object_cache_ = 0; \
+  void* Class::operator new(size_t size) \
+  { \
+    return ObjectCache::getCache(object_cache_, #Class, sizeof(Class))->allocate(size); \
+  } \
+  void Class::operator delete(void* object, size_t size) \
+  { \
+    object_cache_->free(object, size); \
+  }
+
+#else
+
+// the guest OS build uses the allocator of the host
+#define OBJECT_CACHE_MEMBERS
+#define OBJECT_CACHE_DEFINITIONS(Class)
+
+#endif // USE_FILE_SYSTEM_ON_GUEST_OS
+
+#endif /* OBJECTCACHE_H_ */
@@ -19,8 +19,18 @@ typedef uint8 puttype;
 
 #define PAGE_FREE static_cast<puttype>(0)
 
+// the lower 4 bits of a page_usage_table_ entry hold the type, the upper
+// 4 bits the order + 1 if the page is the first one of a (free or used) block
+#define PAGE_TYPE_MASK static_cast<puttype>(0x0F)
+
 /**
  * @class PageManager is in issence a BitMap managing free or used pages of size PAGE_SIZE only
+ *
+ * The free pages are managed by a buddy allocator: free blocks of 2^order
+ * pages (aligned to their size) are kept in one list per order, so
+ * allocating and freeing takes O(MAX_ORDER) steps. A block is split on
+ * allocation and merged with its buddy on free. The list links are stored
+ * in the free pages themselves (through the identity mapping).
  */
 class PageManager
 {
@@ -58,13 +68,41 @@ class PageManager
      */
     uint32 getFreePhysicalPage ( uint32 type = PAGE_USERSPACE ); //also marks page as used
 
+    /**
+     * returns the first page of 2^order contiguous free physical pages,
+     * aligned to 2^order pages, and marks them as used
+     * (i.e. order 9 for a 2 MiB page on x86/64, order 10 for a 4 MiB page)
+     * @param order the order of the block (<= MAX_ORDER)
+     * @param type can be either PAGE_USERSPACE or PAGE_KERNEL (default)
+     * @return the first page or 0 if there is no free block that large
+     */
+    uint32 getFreePhysicalPages ( uint32 order, uint32 type = PAGE_KERNEL );
+
     /**
      * marks physical page <page_number> as free, if it was used in
-     * user or kernel space.
+     * user or kernel space. If the page is the first page of a block of
+     * getFreePhysicalPages(), the whole block is freed.
      * @param page_number Physcial Page to mark as unused
      */
     void freePage ( uint32 page_number );
 
+    /**
+     * @return the number of free pages
+     */
+    uint32 getNumFreePages() const;
+
+    // the largest block is 2^MAX_ORDER pages
+    static const uint32 MAX_ORDER = 10;
+
+    /**
+     * checks if a thread is inside getFreePhysicalPage() or freePage().
+     * The lock_ allocates kernel memory while a thread is waiting for it,
+     * such allocations must not come back to the PageManager (see
+     * KernelMemoryManager), so the slab allocator uses this as a hint
+     * @return true if the PageManager is in use
+     */
+    bool isBusy() const;
+
   private:
 
     /**
@@ -81,12 +119,52 @@ class PageManager
     //PageManager &operator=(PageManager const&){};
     static PageManager* instance_;
 
+    /**
+     * takes a block out of the free lists, splitting larger blocks if
+     * necessary (called with lock_ held)
+     * @return the first page of the block or 0 if there is none
+     */
+    uint32 allocateBlock ( uint32 order, uint32 type );
+
+    /**
+     * inserts / removes a free block in the list of its order
+     */
+    void pushFreeBlock ( uint32 page_number, uint32 order );
+    void removeFreeBlock ( uint32 page_number, uint32 order );
+
+    /**
+     * the links of a free block, stored in its first page
+     */
+    struct FreeBlockLinks
+    {
+      uint32 next_;
+      uint32 prev_;
+    };
+    FreeBlockLinks *getLinks ( uint32 page_number );
+
+    /**
+     * the page_usage_table_ entry of the first page of a block
+     */
+    static puttype blockHead ( puttype type, uint32 order )
+    {
+      return static_cast<puttype>(type | ((order + 1) << 4));
+    }
+
     puttype  *page_usage_table_;
     uint32 number_of_pages_;
     uint32 lowest_unreserved_page_;
 
+    // the first free block of every order (0 if there is none, page 0 is
+    // always reserved)
+    uint32 free_lists_[MAX_ORDER + 1];
+    uint32 num_free_blocks_[MAX_ORDER + 1];
+    uint32 num_free_pages_;
+
     Mutex lock_;
 
+    // number of threads in getFreePhysicalPage() / freePage()
+    uint32 busy_;
+
 };
 
 #endif
@@ -0,0 +1,52 @@
+/**
+ * Filename: KmmStressTest.h
+ * Description:
+ *
+ * Created on: 18.10.2026
+ */
+
+#ifndef KMMSTRESSTEST_H_
+#define KMMSTRESSTEST_H_
+
+#include "types.h"
+
+/**
+ * @class a kernel test comparing the slab allocator of the
+ * KernelMemoryManager with the plain MallocSegment list. It keeps a set of
+ * small objects (the sizes of cache identities, cache items, sector buffers
+ * and short strings) alive and replaces them in a pseudo random order, once
+ * with the slabs switched off and once with the slabs switched on.
+ * The results are printed as allocations per timer tick together with the
+ * KMM statistics.
+ */
+class KmmStressTest
+{
+public:
+  KmmStressTest();
+  ~KmmStressTest();
+
+  /**
+   * runs the test, to be started with a StressTestThread
+   */
+  static void start();
+
+  void run();
+
+private:
+
+  /**
+   * replaces the live objects OPS times
+   * @return the number of timer ticks the run took
+   */
+  uint32 runAllocations();
+
+  // number of objects alive at the same time
+  static const uint32 LIVE_OBJECTS = 1024;
+
+  // number of delete / new pairs per run
+  static const uint32 OPS = 200000;
+
+  char** objects_;
+};
+
+#endif /* KMMSTRESSTEST_H_ */
@@ -0,0 +1,80 @@
+/**
+ * Filename: PageManagerStressTest.h
+ * Description:
+ *
+ * Created on: 18.10.2026
+ */
+
+#ifndef PAGEMANAGERSTRESSTEST_H_
+#define PAGEMANAGERSTRESSTEST_H_
+
+#include "types.h"
+
+/**
+ * @class a kernel test measuring the page allocation latency of the
+ * PageManager: single pages, a random mix of small blocks and large (2 MiB /
+ * 4 MiB) blocks. Every block is checked to be aligned and not to overlap
+ * with another one (each page is stamped with the block it belongs to),
+ * and all pages must be free again at the end.
+ * The results are printed as allocations per timer tick.
+ */
+class PageManagerStressTest
+{
+public:
+  PageManagerStressTest();
+  ~PageManagerStressTest();
+
+  /**
+   * runs the test, to be started with a StressTestThread
+   */
+  static void start();
+
+  void run();
+
+private:
+
+  /**
+   * allocates and frees single pages
+   * @return the number of timer ticks the run took
+   */
+  uint32 runSinglePages();
+
+  /**
+   * replaces blocks of random orders (0..MAX_MIXED_ORDER) in random order
+   * @return the number of timer ticks the run took
+   */
+  uint32 runMixedOrders();
+
+  /**
+   * allocates as many blocks of the given order as possible (up to
+   * MAX_LARGE_BLOCKS, so the rest of the kernel still finds pages) and
+   * frees them
+   * @return the number of blocks
+   */
+  uint32 runLargeBlocks(uint32 order);
+
+  /**
+   * allocates a block and stamps its pages
+   * @return the first page or 0
+   */
+  uint32 allocateBlock(uint32 order);
+
+  /**
+   * checks the stamps of a block and frees it
+   */
+  void freeBlock(uint32 page, uint32 order);
+
+  // number of blocks alive at the same time
+  static const uint32 MAX_BLOCKS = 256;
+
+  // number of allocations per run
+  static const uint32 OPS = 50000;
+
+  static const uint32 MAX_MIXED_ORDER = 3;
+
+  static const uint32 MAX_LARGE_BLOCKS = 8;
+
+  uint32 errors_;
+};
+
+#endif /* PAGEMANAGERSTRESSTEST_H_ */
@@ -14,23 +14,35 @@
 #include "MutexLock.h"
 #endif
 
-#ifndef USE_FILE_SYSTEM_ON_GUEST_OS
-#include "ustl/umap.h"
-#define STL_NAMESPACE_PREFIX    ustl::
-using ustl::map;
-#else
-#include <map>
+#ifdef USE_FILE_SYSTEM_ON_GUEST_OS
 #include "assert.h"
-#define STL_NAMESPACE_PREFIX    std::
-using std::map;
 #endif
 
 #include "fs/FileSystemLock.h"
 #include "fs/FsDefinitions.h"
 
+#ifndef NULL
+#define NULL 0
+#endif
+
 /**
  * @class provides an efficient way to lock (protect) certain slots in a system
  * with an arbitrary number of slots.
+ *
+ * The locks of the currently used slots are kept in a fixed-size hash-table
+ * (NUM_STRIPES * BUCKETS_PER_STRIPE chains), indexed by the hash of the
+ * slot. Every stripe of the table has its own mutex, so acquiring unrelated
+ * slots does not contend for a global lock. A slot still gets a lock of its
+ * own (there is no false sharing between slots, so nested acquisitions of
+ * different slots stay deadlock-free). These locks are taken from a per
+ * stripe pool and go back into it when the slot is released, so there is
+ * no allocation once the pool is large enough for the slots used at a time.
+ *
+ * The stripe mutex is never held while waiting for a slot lock.
+ *
+ * Multiple slots have to be acquired in ascending order (see the range
+ * variants of the acquire methods), then no two threads can wait for each
+ * other.
  */
 template<class T, typename U> class SlotLockManager
 {
@@ -43,8 +55,7 @@ public:
   /**
    * destructor
    */
-  virtual ~SlotLockManager()
-  { assert(active_locks_.size() == 0); }
+  virtual ~SlotLockManager();
 
   /**
    * acquires a lock to the given Slot
@@ -53,34 +64,18 @@ public:
    */
   void acquireReadBlocking(const T& slot)
   {
-#ifndef NO_USE_OF_MULTITHREADING
-    MutexLock mutex_lock(lock_map_lock_);
-#endif
-
-    FileSystemLock* lock = findLockInMap(slot, 1);
-    if(lock == NULL)
-    {
-      lock = createNewSlot(slot);
-    }
-
-    assert(lock != NULL);
-    lock->acquireReadBlocking();
+    referenceSlot(slot)->fs_lock->acquireReadBlocking();
   }
 
   bool acquireReadNonBlocking(const T& slot)
   {
-#ifndef NO_USE_OF_MULTITHREADING
-    MutexLock mutex_lock(lock_map_lock_);
-#endif
+    SlotLock* slot_lock = referenceSlot(slot);
 
-    FileSystemLock* lock = findLockInMap(slot, 1);
-    if(lock == NULL)
-    {
-      lock = createNewSlot(slot);
-    }
+    if(slot_lock->fs_lock->acquireReadNonBlocking())
+      return true;
 
-    assert(lock != NULL);
-    return lock->acquireReadNonBlocking();
+    unreferenceSlot(slot);
+    return false;
   }
 
   /**
@@ -89,14 +84,15 @@ public:
    */
   void releaseRead(const T& slot)
   {
+    SlotStripe& stripe = getStripe(slot);
 #ifndef NO_USE_OF_MULTITHREADING
-    MutexLock mutex_lock(lock_map_lock_);
+    MutexLock mutex_lock(stripe.mutex);
 #endif
 
-    FileSystemLock* lock = findLockInMap(slot, -1);
-    assert(lock != NULL); // !!! indicates a fatal locking fault
-    lock->releaseRead();
-    removeEntryIfUnused(slot);
+    SlotLock* slot_lock = findSlotUnprotected(stripe, slot);
+    assert(slot_lock != NULL); // !!! indicates a fatal locking fault
+    slot_lock->fs_lock->releaseRead();
+    putSlotUnprotected(stripe, slot_lock);
   }
 
   /**
@@ -105,34 +101,18 @@ public:
    */
   void acquireWriteBlocking(const T& slot)
   {
-#ifndef NO_USE_OF_MULTITHREADING
-    MutexLock mutex_lock(lock_map_lock_);
-#endif
-
-    FileSystemLock* lock = findLockInMap(slot, 1);
-    if(lock == NULL)
-    {
-      lock = createNewSlot(slot);
-    }
-
-    assert(lock != NULL);
-    lock->acquireWriteBlocking();
+    referenceSlot(slot)->fs_lock->acquireWriteBlocking();
   }
 
   bool acquireWriteNonBlocking(const T& slot)
   {
-#ifndef NO_USE_OF_MULTITHREADING
-    MutexLock mutex_lock(lock_map_lock_);
-#endif
+    SlotLock* slot_lock = referenceSlot(slot);
 
-    FileSystemLock* lock = findLockInMap(slot, 1);
-    if(lock == NULL)
-    {
-      lock = createNewSlot(slot);
-    }
+    if(slot_lock->fs_lock->acquireWriteNonBlocking())
+      return true;
 
-    assert(lock != NULL);
-    return lock->acquireWriteNonBlocking();
+    unreferenceSlot(slot);
+    return false;
   }
 
   /**
@@ -141,14 +121,46 @@ public:
    */
   void releaseWrite(const T& slot)
   {
+    SlotStripe& stripe = getStripe(slot);
 #ifndef NO_USE_OF_MULTITHREADING
-    MutexLock mutex_lock(lock_map_lock_);
+    MutexLock mutex_lock(stripe.mutex);
 #endif
 
-    FileSystemLock* lock = findLockInMap(slot, -1);
-    assert(lock != NULL); // !!! indicates a fatal locking fault!
-    lock->releaseWrite();
-    removeEntryIfUnused(slot);
+    SlotLock* slot_lock = findSlotUnprotected(stripe, slot);
+    assert(slot_lock != NULL); // !!! indicates a fatal locking fault!
+    slot_lock->fs_lock->releaseWrite();
+    putSlotUnprotected(stripe, slot_lock);
+  }
+
+  /**
+   * acquires / releases the slots first_slot ... first_slot + num_slots - 1
+   * the slots are acquired in ascending order
+   *
+   * @param first_slot the first slot of the range
+   * @param num_slots the number of slots
+   */
+  void acquireReadBlocking(const T& first_slot, uint32 num_slots)
+  {
+    for(uint32 i = 0; i < num_slots; i++)
+      acquireReadBlocking(first_slot + i);
+  }
+
+  void acquireWriteBlocking(const T& first_slot, uint32 num_slots)
+  {
+    for(uint32 i = 0; i < num_slots; i++)
+      acquireWriteBlocking(first_slot + i);
+  }
+
+  void releaseRead(const T& first_slot, uint32 num_slots)
+  {
+    for(uint32 i = num_slots; i > 0; i--)
+      releaseRead(first_slot + i - 1);
+  }
+
+  void releaseWrite(const T& first_slot, uint32 num_slots)
+  {
+    for(uint32 i = num_slots; i > 0; i--)
+      releaseWrite(first_slot + i - 1);
   }
 
   /**
@@ -178,136 +190,250 @@ public:
 
 private:
 
+  SlotLockManager(const SlotLockManager&);
+  SlotLockManager& operator=(const SlotLockManager&);
+
+  /**
+   * a Slot-Lock entry carrying informations
+   */
+  struct SlotLock
+  {
+    T slot;                   // the slot, if the entry is in use
+    FileSystemLock* fs_lock;  // the Locking-aid to establish mutual exclusion
+    uint32 ref_count;         // reference counter
+    U additional_info;        // user defined custom additional information
+    SlotLock* next;           // next entry in the chain / in the pool
+  };
+
+  // the number of stripes and of hash-chains per stripe, powers of 2
+  static const uint32 NUM_STRIPES = 16;
+  static const uint32 BUCKETS_PER_STRIPE = 16;
+
+  // the number of entries each stripe-pool starts with
+  static const uint32 PREALLOCATED_PER_STRIPE = 4;
+
+  /**
+   * a part of the hash-table with its own lock
+   */
+  struct SlotStripe
+  {
+    SlotStripe();
+
+    // the used entries, hashed
+    SlotLock* buckets[BUCKETS_PER_STRIPE];
+
+    // unused entries (with their FileSystemLock)
+    SlotLock* pool;
+
+#ifndef NO_USE_OF_MULTITHREADING
+    Mutex mutex;
+#endif
+  };
+
+  /**
+   * the hash of a slot, the upper bits choose the stripe and the chain
+   */
+  static uint32 hashSlot(const T& slot)
+  {
+    return static_cast<uint32>(slot) * 0x9E3779B1;
+  }
+
+  SlotStripe& getStripe(const T& slot) const
+  {
+    return *stripes_[hashSlot(slot) >> 28];
+  }
+
+  static SlotLock*& getBucket(SlotStripe& stripe, const T& slot)
+  {
+    return stripe.buckets[(hashSlot(slot) >> 24) & (BUCKETS_PER_STRIPE - 1)];
+  }
+
   /**
-   * finding a lock in the map
-   * @param slot the slot to find the lock for
-   * @param delta_ref_count what to do with the ref-count? (-1 dec, 0-stay, 1-incr)
+   * searches the entry of a slot
+   * @param stripe the (locked) stripe of the slot
+   * @return the entry or NULL if the slot is not in use
    */
-  FileSystemLock* findLockInMap(const T& slot, int32 delta_ref_count)
+  static SlotLock* findSlotUnprotected(SlotStripe& stripe, const T& slot)
   {
-    for(map_it it = active_locks_.begin(); it != active_locks_.end(); it++)
+    for(SlotLock* slot_lock = getBucket(stripe, slot); slot_lock != NULL; slot_lock = slot_lock->next)
     {
-      if((*it).first == slot)
-      {
-        // we found the lock :D
-        if(delta_ref_count < 0)
-          (*it).second.ref_count--;
-        else if(delta_ref_count > 0)
-          (*it).second.ref_count++;
-
-        // returning the FsLock:
-        return (*it).second.fs_lock;
-      }
+      if(slot_lock->slot == slot)
+        return slot_lock;
     }
-    // no lock present in the map
+
+    // the slot is not in use
     return NULL;
   }
 
   /**
-   * creates and inserts a new slot into the map
-   *
-   * @param slot the id of the new slot to create
-   * @return the new FileSystemLock object of the slot
+   * gets the entry of a slot and increments its ref-count, the entry is
+   * taken from the pool if the slot is not in use yet
+   * @param stripe the (locked) stripe of the slot
    */
-  FileSystemLock* createNewSlot(const T& slot)
+  SlotLock* getSlotUnprotected(SlotStripe& stripe, const T& slot)
   {
-    // insert new lock to the map
-    SlotLock slot_lock;
-    slot_lock.fs_lock = FileSystemLock::getNewFSLock();
-    slot_lock.ref_count = 1;
-    slot_lock.additional_info = def_add_info_;
+    SlotLock* slot_lock = findSlotUnprotected(stripe, slot);
+
+    if(slot_lock == NULL)
+    {
+      slot_lock = stripe.pool;
+
+      if(slot_lock != NULL)
+        stripe.pool = slot_lock->next;
+      else
+        slot_lock = createSlotLock();
 
-    active_locks_.insert(STL_NAMESPACE_PREFIX make_pair(slot, slot_lock));
+      slot_lock->slot = slot;
+      slot_lock->ref_count = 0;
+      slot_lock->additional_info = def_add_info_;
+
+      SlotLock*& bucket = getBucket(stripe, slot);
+      slot_lock->next = bucket;
+      bucket = slot_lock;
+    }
 
-    return slot_lock.fs_lock;
+    slot_lock->ref_count++;
+    return slot_lock;
   }
 
   /**
-   * deletes an lock-map entry if the ref-count is 0
+   * decrements the ref-count of an entry, an unused entry goes back into
+   * the pool
+   * @param stripe the (locked) stripe of the slot
    */
-  void removeEntryIfUnused(const T& slot)
+  static void putSlotUnprotected(SlotStripe& stripe, SlotLock* slot_lock)
   {
-    for(map_it it = active_locks_.begin(); it != active_locks_.end(); it++)
-    {
-      if((*it).first == slot)
-      {
-        if((*it).second.ref_count == 0)
-        {
-          delete (*it).second.fs_lock;
-          active_locks_.erase(it);
-        }
-        return; // entry found, quit
-      }
-    }
+    if(--slot_lock->ref_count > 0)
+      return;
+
+    SlotLock** link = &getBucket(stripe, slot_lock->slot);
+    while(*link != slot_lock)
+      link = &(*link)->next;
+
+    *link = slot_lock->next;
+
+    slot_lock->next = stripe.pool;
+    stripe.pool = slot_lock;
   }
 
   /**
-   * a Slot-Lock entry carrying informations
+   * references the entry of a slot, the entry stays valid until it is
+   * unreferenced (by a release)
    */
-  struct SlotLock
+  SlotLock* referenceSlot(const T& slot)
   {
-    FileSystemLock* fs_lock;  // the Locking-aid to establish mutual exclusion
-    uint32 ref_count;         // reference counter
-    U additional_info;        // user defined custom additional information
-  };
+    SlotStripe& stripe = getStripe(slot);
+#ifndef NO_USE_OF_MULTITHREADING
+    MutexLock mutex_lock(stripe.mutex);
+#endif
 
-  // the lock map:
-  typedef typename map<T, SlotLock>::iterator map_it;
-  map<T, SlotLock> active_locks_;
+    return getSlotUnprotected(stripe, slot);
+  }
 
-  // the mutex that protects the above map
+  void unreferenceSlot(const T& slot)
+  {
+    SlotStripe& stripe = getStripe(slot);
 #ifndef NO_USE_OF_MULTITHREADING
-  mutable Mutex lock_map_lock_;
+    MutexLock mutex_lock(stripe.mutex);
 #endif
 
+    SlotLock* slot_lock = findSlotUnprotected(stripe, slot);
+    assert(slot_lock != NULL);
+    putSlotUnprotected(stripe, slot_lock);
+  }
+
+  static SlotLock* createSlotLock(void)
+  {
+    SlotLock* slot_lock = new SlotLock();
+    slot_lock->fs_lock = FileSystemLock::getNewFSLock();
+    slot_lock->ref_count = 0;
+    slot_lock->next = NULL;
+
+    return slot_lock;
+  }
+
+  SlotStripe* stripes_[NUM_STRIPES];
+
   // the default additional-info value to apply on slot-item creation:
   U def_add_info_;
 };
 
 template<class T, typename U>
-SlotLockManager<T,U>::SlotLockManager()
+SlotLockManager<T,U>::SlotStripe::SlotStripe() : pool(NULL)
 #ifndef NO_USE_OF_MULTITHREADING
-: lock_map_lock_("SlotLockManager - ustl::map lock")
+    , mutex("SlotLockManager::SlotStripe")
 #endif
 {
+  for(uint32 i = 0; i < BUCKETS_PER_STRIPE; i++)
+    buckets[i] = NULL;
 }
 
 template<class T, typename U>
-bool SlotLockManager<T,U>::setSlotAdditionalInfo(const T& slot, U info)
+SlotLockManager<T,U>::SlotLockManager() : def_add_info_()
 {
-#ifndef NO_USE_OF_MULTITHREADING
-  MutexLock mutex_lock(lock_map_lock_);
-#endif
+  for(uint32 i = 0; i < NUM_STRIPES; i++)
+  {
+    stripes_[i] = new SlotStripe();
+
+    for(uint32 j = 0; j < PREALLOCATED_PER_STRIPE; j++)
+    {
+      SlotLock* slot_lock = createSlotLock();
+      slot_lock->next = stripes_[i]->pool;
+      stripes_[i]->pool = slot_lock;
+    }
+  }
+}
 
-  for(map_it it = active_locks_.begin(); it != active_locks_.end(); it++)
+template<class T, typename U>
+SlotLockManager<T,U>::~SlotLockManager()
+{
+  for(uint32 i = 0; i < NUM_STRIPES; i++)
   {
-    if((*it).first == slot)
+    for(uint32 j = 0; j < BUCKETS_PER_STRIPE; j++)
+      assert(stripes_[i]->buckets[j] == NULL);
+
+    while(stripes_[i]->pool != NULL)
     {
-      (*it).second.additional_info = info;
-      return true;
+      SlotLock* slot_lock = stripes_[i]->pool;
+      stripes_[i]->pool = slot_lock->next;
+
+      delete slot_lock->fs_lock;
+      delete slot_lock;
     }
+
+    delete stripes_[i];
   }
+}
+
+template<class T, typename U>
+bool SlotLockManager<T,U>::setSlotAdditionalInfo(const T& slot, U info)
+{
+  SlotStripe& stripe = getStripe(slot);
+#ifndef NO_USE_OF_MULTITHREADING
+  MutexLock mutex_lock(stripe.mutex);
+#endif
+
+  SlotLock* slot_lock = findSlotUnprotected(stripe, slot);
+  if(slot_lock == NULL)
+    return false;
 
-  return false;
+  slot_lock->additional_info = info;
+  return true;
 }
 
 template<class T, typename U>
 U SlotLockManager<T,U>::getSlotAdditionalInfo(const T& slot) const
 {
+  SlotStripe& stripe = getStripe(slot);
 #ifndef NO_USE_OF_MULTITHREADING
-  MutexLock mutex_lock(lock_map_lock_);
+  MutexLock mutex_lock(stripe.mutex);
 #endif
 
-  typename STL_NAMESPACE_PREFIX map<T, SlotLock>::const_iterator it;
+  SlotLock* slot_lock = findSlotUnprotected(stripe, slot);
+  if(slot_lock == NULL)
+    return 0;
 
-  for(it = active_locks_.begin(); it != active_locks_.end(); it++)
-  {
-    if((*it).first == slot)
-    {
-      return (*it).second.additional_info;
-    }
-  }
-  return 0;
+  return slot_lock->additional_info;
 }
 
 template<class T, typename U>
@@ -21,9 +21,10 @@ CacheFactory::~CacheFactory()
 {
 }
 
-GeneralCache* CacheFactory::getNewCache(DeviceAdapter* device, num_items_t max_items) const
+GeneralCache* CacheFactory::getNewCache(DeviceAdapter* device, num_items_t max_items,
+                                        num_items_t soft_limit) const
 {
-  GeneralCache* cache = new GeneralCache(device, 0, max_items);
+  GeneralCache* cache = new GeneralCache(device, soft_limit, max_items);
   assert(cache != NULL);
 
   cache->setReadStrategy(getReadStrategy(cache));
@@ -7,7 +7,7 @@
  */
 
 #include "FiFoReadNoWriteCacheFactory.h"
-#include "../cache/FifoReadCache.h"
+#include "../cache/HashedFifoReadCache.h"
 
 namespace Cache
 {
@@ -22,7 +22,7 @@ FiFoReadNoWriteCacheFactory::~FiFoReadNoWriteCacheFactory()
 
 CacheReadStrategy* FiFoReadNoWriteCacheFactory::getReadStrategy(GeneralCache* cache) const
 {
-  return new FifoReadCache(cache);
+  return new HashedFifoReadCache(cache);
 }
 
 CacheWriteStrategy* FiFoReadNoWriteCacheFactory::getWriteStrategy(DeviceAdapter* device __attribute__((unused))) const
@@ -85,7 +85,7 @@ void FifoReadCache::removeItem(const ItemIdentity& ident)
   }
 }
 
-void FifoReadCache::evictItem(void)
+Item* FifoReadCache::evictItem(ItemIdentity*& ident)
 {
 #ifndef USE_FILE_SYSTEM_ON_GUEST_OS
   MutexLock auto_lock(fifo_mutex_);
@@ -94,15 +94,13 @@ void FifoReadCache::evictItem(void)
   // search for the first free item
   for(num_items_t i = 0; i < fifo_items_.size(); i++)
   {
-    if(cache_->isItemFree(*fifo_items_[i].ident))
+    if(cache_->lockFreeItem(*fifo_items_[i].ident))
     {
-      // before deleting, write the item back
-      cache_->writeItemImmediately(*fifo_items_[i].ident);
-
-      delete fifo_items_[i].item;
-      delete fifo_items_[i].ident;
+      // the caller writes the item back and deletes it
+      Item* item = fifo_items_[i].item;
+      ident = fifo_items_[i].ident;
       fifo_items_.erase(fifo_items_.begin()+i);
-      return;
+      return item;
     }
   }
 
@@ -111,6 +109,7 @@ void FifoReadCache::evictItem(void)
 #ifndef USE_FILE_SYSTEM_ON_GUEST_OS
   debug(READ_CACHE, "evictItem - FAIL could not delete an item!\n");
 #endif
+  return NULL;
 }
 
 void FifoReadCache::clear(void)
@@ -8,7 +8,7 @@
 
 #include "cache/FifoReadWriteBackCacheFactory.h"
 #include "cache/GeneralCache.h"
-#include "cache/FifoReadCache.h"
+#include "cache/HashedFifoReadCache.h"
 #include "cache/WriteBackCache.h"
 
 namespace Cache
@@ -27,7 +27,7 @@ FifoReadWriteBackCacheFactory::~FifoReadWriteBackCacheFactory()
 
 CacheReadStrategy* FifoReadWriteBackCacheFactory::getReadStrategy(GeneralCache* cache) const
 {
-  return new FifoReadCache(cache);
+  return new HashedFifoReadCache(cache);
 }
 
 CacheWriteStrategy* FifoReadWriteBackCacheFactory::getWriteStrategy(DeviceAdapter* device) const
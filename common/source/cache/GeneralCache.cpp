@@ -6,11 +6,10 @@
  */
 
 #ifdef USE_FILE_SYSTEM_ON_GUEST_OS
-#include <map>
 #include "assert.h"
 #else
 #include "Scheduler.h"
-#include "ustl/umap.h"
+#include "ArchThreads.h"
 #include "kprintf.h"
 #endif
 
@@ -24,13 +23,8 @@ GeneralCache::GeneralCache(DeviceAdapter* cache_device,
 		cache_read_strategy_(NULL),
 		cache_write_strategy_(NULL),
 		soft_limit_(soft_limit), hard_limit_(hard_limit),
-		non_blocking_cache_(false)
-#ifndef USE_FILE_SYSTEM_ON_GUEST_OS
-		,map_lock_("GeneralCache")
-#endif
-#ifndef NO_USE_OF_MULTITHREADING
-    ,item_locks_mutex_("item_locks_ vector mutex")
-#endif
+		non_blocking_cache_(false),
+		num_items_(0), evicted_items_(0)
 {
   // cache stores at least 3 items, otherwise the overhead would be too
   // big in order to make sense
@@ -38,6 +32,11 @@ GeneralCache::GeneralCache(DeviceAdapter* cache_device,
   {
     hard_limit_ = 3;
   }
+
+  for(uint32 i = 0; i < NUM_STRIPES; i++)
+  {
+    stripes_[i] = new CacheStripe();
+  }
 }
 
 GeneralCache::~GeneralCache()
@@ -59,6 +58,13 @@ GeneralCache::~GeneralCache()
 	{
 		delete cache_write_strategy_;
 	}
+
+  for(uint32 i = 0; i < NUM_STRIPES; i++)
+  {
+    // assertion indicates that items are still borrowed!
+    assert(stripes_[i]->slots == NULL);
+    delete stripes_[i];
+  }
 }
 
 void GeneralCache::setReadStrategy(CacheReadStrategy* cache_read_strategy)
@@ -69,6 +75,15 @@ void GeneralCache::setReadStrategy(CacheReadStrategy* cache_read_strategy)
 void GeneralCache::setWriteStrategy(CacheWriteStrategy* cache_write_strategy)
 {
   cache_write_strategy_ = cache_write_strategy;
+
+  if(cache_write_strategy_ != NULL && soft_limit_ > 0)
+  {
+    num_items_t dirty_hard_limit = hard_limit_ / 2;
+    if(dirty_hard_limit <= soft_limit_)
+      dirty_hard_limit = soft_limit_ + 1;
+
+    cache_write_strategy_->setDirtyThresholds(soft_limit_, dirty_hard_limit);
+  }
 }
 
 void GeneralCache::setCacheDevice(DeviceAdapter* cache_device)
@@ -96,15 +111,13 @@ Item* GeneralCache::getItem(const ItemIdentity& ident)
     return NULL;
   }
 
-  stats_.num_requests++;
-
   // try to get the Item from the Read-Cache
   Item* data = cache_read_strategy_->get(ident);
 
 	// requested item was not in the Cache, so load it!
 	if(data == NULL)
 	{
-	  stats_.num_misses++;
+	  countRequest(ident, false);
 #ifndef USE_FILE_SYSTEM_ON_GUEST_OS
   debug(CACHE, "getItem - cache miss, load from device!\n");
 #endif
@@ -131,8 +144,8 @@ Item* GeneralCache::getItem(const ItemIdentity& ident)
 	}
 	else
 	{
+	  countRequest(ident, true);
 #ifndef USE_FILE_SYSTEM_ON_GUEST_OS
-	  stats_.num_cache_hits++;
 	  debug(CACHE, "getItem - cache hit!\n");
 #endif
 	}
@@ -167,25 +180,122 @@ void GeneralCache::addItem(const ItemIdentity& ident, Item* item)
   debug(CACHE, "addItem - CALL\n");
 #endif
 
-  // first check if there's the need to remove an item from the cache
-  if(cache_read_strategy_->getNumItems()+1 > hard_limit_)
+  insertItem(ident, item, false);
+}
+
+void GeneralCache::insertItem(const ItemIdentity& ident, Item* item, bool prefetched)
+{
+  // the new item takes it's place first, every insert that exceeds the hard
+  // limit has to evict an item (concurrent inserts just share the counter)
+  if(atomicAdd(num_items_, 1) + 1 > hard_limit_)
   {
 #ifndef USE_FILE_SYSTEM_ON_GUEST_OS
     debug(CACHE, "addItem - hard limit exceeded, going to evict an Item.\n");
 #endif
-    stats_.evicted_items++;
 
     // cache is now full, evict an (some) item(s)
-    cache_read_strategy_->evictItem();
+    if(evictItem())
+      atomicAdd(num_items_, -1);
   }
 
   // add new element to cache
-  cache_read_strategy_->add(ident, item);
+  if(prefetched)
+    cache_read_strategy_->addPrefetched(ident, item);
+  else
+    cache_read_strategy_->add(ident, item);
 
   // TODO-DEBUG: cache is NOT allowed to become full at any time!
   assert(cache_read_strategy_->getNumItems() <= hard_limit_);
 }
 
+bool GeneralCache::evictItem(void)
+{
+  ItemIdentity* ident = NULL;
+  Item* item = cache_read_strategy_->evictItem(ident);
+
+  if(item == NULL)
+    return false;
+
+  atomicAdd(evicted_items_, 1);
+
+  // the victim stays locked until it is written back, so nobody reads the
+  // outdated data from the device in the meantime; no other lock is held,
+  // inserts of unrelated items don't wait for the device
+  writeItemImmediately(*ident);
+  delete item;
+
+  unlockItem(*ident);
+  delete ident;
+
+  return true;
+}
+
+uint32 GeneralCache::atomicAdd(uint32& counter, int32 increment)
+{
+#ifdef USE_FILE_SYSTEM_ON_GUEST_OS
+  uint32 old_value = counter;
+  counter += increment;
+  return old_value;
+#else
+  return ArchThreads::atomic_add(counter, increment);
+#endif
+}
+
+uint32 GeneralCache::prefetchItems(const ItemIdentity* const* idents, uint32 num_items)
+{
+  if(cache_read_strategy_ == NULL || cache_device_ == NULL || num_items == 0)
+    return 0;
+
+  // the Items that have to be read from the Device
+  const ItemIdentity** to_read = new const ItemIdentity*[num_items];
+  Item** items = new Item*[num_items];
+  uint32 num_to_read = 0;
+
+  for(uint32 i = 0; i < num_items; i++)
+  {
+    // an Item that can not be locked right now is in use, so there is no
+    // point in reading it ahead (this also avoids waiting for other threads)
+    if(!lockItemNonBlocking(*idents[i]))
+      continue;
+
+    if(getIdentDeleteAfterReleaseState(*idents[i]) || cache_read_strategy_->contains(*idents[i]))
+    {
+      unlockItem(*idents[i]);
+      continue;
+    }
+
+    to_read[num_to_read++] = idents[i];
+  }
+
+  uint32 num_added = 0;
+
+  if(num_to_read > 0)
+  {
+    // all Items are locked, they can neither be loaded nor evicted by
+    // someone else in the meantime
+    cache_device_->readItems(to_read, items, num_to_read);
+
+    for(uint32 i = 0; i < num_to_read; i++)
+    {
+      if(items[i] != NULL)
+      {
+        insertItem(*to_read[i], items[i], true);
+        num_added++;
+      }
+      unlockItem(*to_read[i]);
+    }
+  }
+
+#ifndef USE_FILE_SYSTEM_ON_GUEST_OS
+  debug(CACHE, "prefetchItems - %d of %d items read ahead\n", num_added, num_items);
+#endif
+
+  delete[] to_read;
+  delete[] items;
+
+  return num_added;
+}
+
 bool GeneralCache::writeItem(const ItemIdentity& ident, Item* item, bool delete_item)
 {
   // no Item object, just the Ident passed, fetch it from the read-Cache
@@ -228,35 +338,45 @@ bool GeneralCache::writeItem(const ItemIdentity& ident, Item* item, bool delete_
 
 bool GeneralCache::isItemFree(const ItemIdentity& ident)
 {
-#ifndef USE_FILE_SYSTEM_ON_GUEST_OS
-  MutexLock used_items_lock(map_lock_);
-#endif
+  CacheStripe& stripe = getStripe(ident);
 
-  // lock the given ident-slot in order to make this operation exclusive for the
-  // current slot
-  //lockItem(ident);
-  if(!lockItemNonBlocking(ident))
+  if(!lockStripe(stripe, false))
   {
     return false;
   }
 
-  bool item_free = true;
+  CacheSlot* slot = findSlotUnprotected(stripe, ident);
+
+  // an item that is currently locked is in use as well
+  bool item_free = (slot == NULL) || (!slot->locked && slot->ref_count == 0);
+
+  unlockStripe(stripe);
+
+	return item_free;
+}
+
+bool GeneralCache::lockFreeItem(const ItemIdentity& ident)
+{
+  CacheStripe& stripe = getStripe(ident);
 
-  for(lock_list_iterator it = borrowed_items_.begin(); it != borrowed_items_.end(); it++)
+  if(!lockStripe(stripe, false))
   {
-    if((*(*it).first) == ident)
-    {
-      if(it->second > 0)
-        item_free = false;
-      else if(it->second == 0)
-        item_free = true;
-      break;
-    }
+    return false;
   }
 
-  unlockItem(ident);
+  CacheSlot* slot = findSlotUnprotected(stripe, ident);
+  bool item_free = (slot == NULL) || (!slot->locked && slot->ref_count == 0);
 
-	return item_free;
+#ifndef NO_USE_OF_MULTITHREADING
+  if(item_free)
+  {
+    getSlotUnprotected(stripe, ident)->locked = true;
+  }
+#endif // NO_USE_OF_MULTITHREADING
+
+  unlockStripe(stripe);
+
+  return item_free;
 }
 
 void GeneralCache::removeItem(const ItemIdentity& ident)
@@ -266,7 +386,6 @@ void GeneralCache::removeItem(const ItemIdentity& ident)
 
 #ifndef USE_FILE_SYSTEM_ON_GUEST_OS
   debug(CACHE, "removeItem - CALL\n");
-  MutexLock used_items_lock(map_lock_);
 #endif
 
   // atomic operation to the item
@@ -275,26 +394,20 @@ void GeneralCache::removeItem(const ItemIdentity& ident)
   // item removable? - all references cleared?
   bool remove_item = true;
 
-  for(lock_list_iterator it = borrowed_items_.begin(); it != borrowed_items_.end(); it++)
+  CacheStripe& stripe = getStripe(ident);
+  lockStripe(stripe, true);
+
+  CacheSlot* slot = findSlotUnprotected(stripe, ident);
+  if(slot != NULL && slot->ref_count > 0)
   {
-    if((*(*it).first) == ident)
-    {
-      if(it->second > 0)
-      {
-        // someone is still holding references to the item, remove it
-        // after the last one has released it's reference
-        (*(*it).first).setDeleteAfterRelease();
-        remove_item = false;
-      }
-      else if(it->second == 0)
-      {
-        // perfect, no more references, delete right now
-        remove_item = true;
-      }
-      break;
-    }
+    // someone is still holding references to the item, remove it
+    // after the last one has released it's reference
+    slot->ident->setDeleteAfterRelease();
+    remove_item = false;
   }
 
+  unlockStripe(stripe);
+
   // nobody holds any reference to the given Item, so it can be deleted right now
   if(remove_item)
   {
@@ -324,23 +437,24 @@ void GeneralCache::deleteItem(const ItemIdentity& ident)
   // at least remove the Item from the Read-Strategy so that the instance
   // will be destroyed and nothing of the Item remains (neither in memory
   // nor on the device)
-  if(cache_read_strategy_ != NULL) cache_read_strategy_->removeItem(ident);
+  if(cache_read_strategy_ != NULL && cache_read_strategy_->contains(ident))
+  {
+    cache_read_strategy_->removeItem(ident);
+    atomicAdd(num_items_, -1);
+  }
 }
 
 bool GeneralCache::getIdentDeleteAfterReleaseState(const ItemIdentity& ident)
 {
-#ifndef USE_FILE_SYSTEM_ON_GUEST_OS
-  MutexLock used_items_lock(map_lock_);
-#endif
+  CacheStripe& stripe = getStripe(ident);
+  lockStripe(stripe, true);
 
-  for(lock_list_iterator it = borrowed_items_.begin(); it != borrowed_items_.end(); it++)
-  {
-    if((*(*it).first) == ident)
-    {
-      return (*it).first->deleteAfterRelease();
-    }
-  }
-  return false;
+  CacheSlot* slot = findSlotUnprotected(stripe, ident);
+  bool delete_after_release = (slot != NULL) && slot->ident->deleteAfterRelease();
+
+  unlockStripe(stripe);
+
+  return delete_after_release;
 }
 
 void GeneralCache::flush(void)
@@ -390,59 +504,56 @@ bool GeneralCache::writeItemImmediately(const ItemIdentity& ident/*, Item* item*
 
 void GeneralCache::incrRefCount(const ItemIdentity& ident)
 {
-#ifndef USE_FILE_SYSTEM_ON_GUEST_OS
-  MutexLock used_items_lock(map_lock_);
-#endif
+  CacheStripe& stripe = getStripe(ident);
+  lockStripe(stripe, true);
 
-  for(lock_list_iterator it = borrowed_items_.begin(); it != borrowed_items_.end(); it++)
-  {
-    if((*(*it).first) == ident)
-    {
-      // increment reference count:
-      (*it).second++;
-      return;
-    }
-  }
+  // increment reference count, the first reference creates the slot
+  getSlotUnprotected(stripe, ident)->ref_count++;
 
-  // this is the first reference to an Item with this identity,
-  // so insert a new pair
-#ifndef USE_FILE_SYSTEM_ON_GUEST_OS
-  borrowed_items_.insert(ustl::make_pair<ItemIdentity*, uint32>(ident.clone(), 1));
-#else
-  borrowed_items_.insert(std::make_pair<ItemIdentity*, uint32>(ident.clone(), 1));
-#endif
+  unlockStripe(stripe);
+}
+
+void GeneralCache::countRequest(const ItemIdentity& ident, bool cache_hit)
+{
+  CacheStripe& stripe = getStripe(ident);
+  lockStripe(stripe, true);
+
+  stripe.stats.num_requests++;
+  if(cache_hit)
+    stripe.stats.num_cache_hits++;
+  else
+    stripe.stats.num_misses++;
+
+  unlockStripe(stripe);
 }
 
 void GeneralCache::decrRefCount(const ItemIdentity& ident)
 {
-#ifndef USE_FILE_SYSTEM_ON_GUEST_OS
-  MutexLock used_items_lock(map_lock_);
-#endif
+  CacheStripe& stripe = getStripe(ident);
+  lockStripe(stripe, true);
 
-  for(lock_list_iterator it = borrowed_items_.begin(); it != borrowed_items_.end(); it++)
-  {
-    if((*(*it).first) == ident)
-    {
-      // increment reference count:
-      (*it).second--;
+  CacheSlot* slot = findSlotUnprotected(stripe, ident);
 
-      if((*it).second == 0)
-      {
-        if((*it).first->deleteAfterRelease())
-        {
-          deleteItem(*(*it).first);
-        }
-        // remove item from map
-        delete (*it).first; // free Ident-object
-        borrowed_items_.erase(it);
-      }
+  // item was not found -> indicates a fatal locking fault!
+  assert(slot != NULL && slot->ref_count > 0);
 
-      return;
-    }
+  slot->ref_count--;
+
+  bool delete_item = false;
+  if(slot->ref_count == 0)
+  {
+    delete_item = slot->ident->deleteAfterRelease();
+    putSlotUnprotected(stripe, slot);
   }
 
-  // item was not found -> indicates a fatal locking fault!
-  assert(false);
+  unlockStripe(stripe);
+
+  // the item is still locked by the caller, so it is safe to delete it
+  // without holding the stripe
+  if(delete_item)
+  {
+    deleteItem(ident);
+  }
 }
 
 bool GeneralCache::lockItem(const ItemIdentity& ident)
@@ -460,19 +571,21 @@ bool GeneralCache::lockItem(const ItemIdentity& ident)
 void GeneralCache::lockItemBlocking(const ItemIdentity& ident)
 {
 #ifndef NO_USE_OF_MULTITHREADING
+  CacheStripe& stripe = getStripe(ident);
+
   while(true)
   {
-    item_locks_mutex_.acquire("GeneralCache::lockItemBlocking");
+    lockStripe(stripe, true);
 
-    // check data-structure
-    if(!isInVectorUnprotected(ident))
+    CacheSlot* slot = getSlotUnprotected(stripe, ident);
+    if(!slot->locked)
     {
-      item_locks_.push_back(ident.clone());
-      item_locks_mutex_.release("GeneralCache::lockItemBlocking");
+      slot->locked = true;
+      unlockStripe(stripe);
       return;
     }
 
-    item_locks_mutex_.release("GeneralCache::lockItemBlocking");
+    unlockStripe(stripe);
 #ifndef USE_FILE_SYSTEM_ON_GUEST_OS
     Scheduler::instance()->yield();
 #endif
@@ -483,20 +596,23 @@ void GeneralCache::lockItemBlocking(const ItemIdentity& ident)
 bool GeneralCache::lockItemNonBlocking(const ItemIdentity& ident)
 {
 #ifndef NO_USE_OF_MULTITHREADING
-  if(!item_locks_mutex_.acquireNonBlocking("GeneralCache::lockItemNonBlocking"))
+  CacheStripe& stripe = getStripe(ident);
+
+  if(!lockStripe(stripe, false))
   {
     return false;
   }
 
-  if(isInVectorUnprotected(ident))
+  CacheSlot* slot = getSlotUnprotected(stripe, ident);
+  if(slot->locked)
   {
     // no mutual exclusion today!
-    item_locks_mutex_.release("GeneralCache::lockItemNonBlocking");
+    unlockStripe(stripe);
     return false;
   }
 
-  item_locks_.push_back(ident.clone());
-  item_locks_mutex_.release("GeneralCache::lockItemNonBlocking");
+  slot->locked = true;
+  unlockStripe(stripe);
 #endif // NO_USE_OF_MULTITHREADING
 
   // by default locking can be established (in order to work if the macro is
@@ -507,59 +623,136 @@ bool GeneralCache::lockItemNonBlocking(const ItemIdentity& ident)
 bool GeneralCache::unlockItem(const ItemIdentity& ident)
 {
 #ifndef NO_USE_OF_MULTITHREADING
-  if(non_blocking_cache_)
-  {
-    if(!item_locks_mutex_.acquireNonBlocking("GeneralCache::unlockItem"))
-    {
-      return false;
-    }
-  }
-  else
+  CacheStripe& stripe = getStripe(ident);
+
+  if(!lockStripe(stripe, !non_blocking_cache_))
   {
-    item_locks_mutex_.acquire("GeneralCache::unlockItem");
+    return false;
   }
 
-  bool item_to_realease_was_found = false;
+  CacheSlot* slot = findSlotUnprotected(stripe, ident);
 
-  for(uint32 i = 0; i < item_locks_.size(); i++)
-  {
-    if((*item_locks_[i]) == ident)
-    {
-      delete item_locks_[i];
-      item_locks_.erase(item_locks_.begin() + i);
+  // indicates a bad, bad, bad locking fault!!!
+  assert(slot != NULL && slot->locked);
 
-      item_to_realease_was_found = true;
-      break;
-    }
-  }
+  slot->locked = false;
+  putSlotUnprotected(stripe, slot);
 
-  // indicates a bad, bad, bad locking fault!!!
-  assert(item_to_realease_was_found);
+  unlockStripe(stripe);
+#endif // NO_USE_OF_MULTITHREADING
+  return true;
+}
+
+GeneralCache::CacheStripe::CacheStripe() : slots(NULL)
+#ifndef NO_USE_OF_MULTITHREADING
+    , mutex("GeneralCache::CacheStripe")
+#endif
+{
+  stats.num_requests = 0;
+  stats.num_cache_hits = 0;
+  stats.num_misses = 0;
+  stats.evicted_items = 0;
+}
+
+GeneralCache::CacheStripe& GeneralCache::getStripe(const ItemIdentity& ident)
+{
+  return *stripes_[ident.hash() & (NUM_STRIPES - 1)];
+}
 
-  item_locks_mutex_.release("GeneralCache::unlockItem");
-  //
+bool GeneralCache::lockStripe(CacheStripe& stripe, bool blocking) const
+{
+#ifndef NO_USE_OF_MULTITHREADING
+  if(!blocking)
+  {
+    return stripe.mutex.acquireNonBlocking("GeneralCache::lockStripe");
+  }
+  stripe.mutex.acquire("GeneralCache::lockStripe");
 #endif // NO_USE_OF_MULTITHREADING
   return true;
 }
 
+void GeneralCache::unlockStripe(CacheStripe& stripe) const
+{
 #ifndef NO_USE_OF_MULTITHREADING
-bool GeneralCache::isInVectorUnprotected(const ItemIdentity& ident)
+  stripe.mutex.release("GeneralCache::unlockStripe");
+#endif // NO_USE_OF_MULTITHREADING
+}
+
+GeneralCache::CacheSlot* GeneralCache::findSlotUnprotected(CacheStripe& stripe, const ItemIdentity& ident)
 {
-  for(uint32 i = 0; i < item_locks_.size(); i++)
+  uint32 hash = ident.hash();
+
+  for(CacheSlot* slot = stripe.slots; slot != NULL; slot = slot->next)
   {
-    if((*item_locks_[i]) == ident)
+    if(slot->hash == hash && *slot->ident == ident)
     {
-      return true;
+      return slot;
     }
   }
 
-  return false;
+  return NULL;
+}
+
+GeneralCache::CacheSlot* GeneralCache::getSlotUnprotected(CacheStripe& stripe, const ItemIdentity& ident)
+{
+  CacheSlot* slot = findSlotUnprotected(stripe, ident);
+  if(slot != NULL)
+  {
+    return slot;
+  }
+
+  slot = new CacheSlot;
+  slot->ident = ident.clone();
+  slot->hash = ident.hash();
+  slot->ref_count = 0;
+  slot->locked = false;
+
+  slot->next = stripe.slots;
+  stripe.slots = slot;
+
+  return slot;
+}
+
+void GeneralCache::putSlotUnprotected(CacheStripe& stripe, CacheSlot* slot)
+{
+  if(slot->locked || slot->ref_count > 0)
+  {
+    return;
+  }
+
+  CacheSlot** link = &stripe.slots;
+  while(*link != slot)
+  {
+    assert(*link != NULL);
+    link = &(*link)->next;
+  }
+  *link = slot->next;
+
+  delete slot->ident; // free Ident-object
+  delete slot;
 }
-#endif // NO_USE_OF_MULTITHREADING
 
 void GeneralCache::getStats(CacheStat& stats) const
 {
-  stats = stats_;
+  stats.num_requests = 0;
+  stats.num_cache_hits = 0;
+  stats.num_misses = 0;
+
+  for(uint32 i = 0; i < NUM_STRIPES; i++)
+  {
+    lockStripe(*stripes_[i], true);
+    stats.num_requests += stripes_[i]->stats.num_requests;
+    stats.num_cache_hits += stripes_[i]->stats.num_cache_hits;
+    stats.num_misses += stripes_[i]->stats.num_misses;
+    unlockStripe(*stripes_[i]);
+  }
+
+  stats.evicted_items = evicted_items_;
+}
+
+num_items_t GeneralCache::getHardLimit(void) const
+{
+  return hard_limit_;
 }
 
 } // end of namespace "Cache"
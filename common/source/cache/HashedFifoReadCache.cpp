@@ -0,0 +1,243 @@
+/**
+ * Filename: HashedFifoReadCache.cpp
+ * Description:
+ *
+ * Created on: 18.10.2026
+ */
+
+#include "HashedFifoReadCache.h"
+
+#ifndef USE_FILE_SYSTEM_ON_GUEST_OS
+#include "assert.h"
+#include "kprintf.h"
+#else
+#include <assert.h>
+#include "debug_print.h"
+#endif
+
+namespace Cache
+{
+
+HashedFifoReadCache::HashedFifoReadCache(GeneralCache* cache) : CacheReadStrategy(cache),
+    buckets_(NULL), num_buckets_(INITIAL_NUM_BUCKETS),
+    fifo_head_(NULL), fifo_tail_(NULL), num_items_(0)
+#ifndef USE_FILE_SYSTEM_ON_GUEST_OS
+    , fifo_mutex_("HashedFifoReadCache Mutex")
+#endif
+{
+  buckets_ = new HashedCacheItem*[num_buckets_];
+  for(uint32 i = 0; i < num_buckets_; i++)
+    buckets_[i] = NULL;
+}
+
+HashedFifoReadCache::~HashedFifoReadCache()
+{
+  clear();
+  assert(num_items_ == 0); // assertion indicates a locking fault!
+
+  delete[] buckets_;
+}
+
+HashedFifoReadCache::HashedCacheItem* HashedFifoReadCache::findUnprotected(const ItemIdentity& ident) const
+{
+  uint32 hash = ident.hash();
+
+  for(HashedCacheItem* entry = buckets_[hash & (num_buckets_ - 1)]; entry != NULL; entry = entry->bucket_next)
+  {
+    if(entry->hash == hash && *entry->ident == ident)
+      return entry;
+  }
+
+  return NULL;
+}
+
+Item* HashedFifoReadCache::get(const ItemIdentity& ident)
+{
+#ifndef USE_FILE_SYSTEM_ON_GUEST_OS
+  MutexLock auto_lock(fifo_mutex_);
+#endif
+
+  HashedCacheItem* entry = findUnprotected(ident);
+  if(entry == NULL)
+    return NULL;
+
+  return entry->item; // Cache-Hit!
+}
+
+bool HashedFifoReadCache::add(const ItemIdentity& ident, Item* item)
+{
+  if(item == NULL)
+    return false;
+
+  HashedCacheItem* new_entry = new HashedCacheItem;
+  new_entry->ident = ident.clone();
+  new_entry->item = item;
+  new_entry->hash = ident.hash();
+  new_entry->bucket_next = NULL;
+  new_entry->fifo_next = NULL;
+
+#ifndef USE_FILE_SYSTEM_ON_GUEST_OS
+  MutexLock auto_lock(fifo_mutex_);
+#endif
+
+  // keep the load factor below 1, so that the chains stay short
+  if(num_items_ + 1 > num_buckets_)
+    growUnprotected();
+
+  // append to the end of the bucket chain, so that a lookup finds the
+  // oldest item with the given identity first (as the FIFO-scan did)
+  HashedCacheItem** link = &buckets_[new_entry->hash & (num_buckets_ - 1)];
+  while(*link != NULL)
+    link = &(*link)->bucket_next;
+  *link = new_entry;
+
+  // enqueue at the tail of the FIFO
+  new_entry->fifo_prev = fifo_tail_;
+  if(fifo_tail_ != NULL)
+    fifo_tail_->fifo_next = new_entry;
+  else
+    fifo_head_ = new_entry;
+  fifo_tail_ = new_entry;
+
+  num_items_++;
+  return true;
+}
+
+void HashedFifoReadCache::removeUnprotected(HashedCacheItem* entry)
+{
+  // unlink from the hash-bucket
+  HashedCacheItem** link = &buckets_[entry->hash & (num_buckets_ - 1)];
+  while(*link != entry)
+  {
+    assert(*link != NULL);
+    link = &(*link)->bucket_next;
+  }
+  *link = entry->bucket_next;
+
+  // unlink from the FIFO-queue
+  if(entry->fifo_prev != NULL)
+    entry->fifo_prev->fifo_next = entry->fifo_next;
+  else
+    fifo_head_ = entry->fifo_next;
+
+  if(entry->fifo_next != NULL)
+    entry->fifo_next->fifo_prev = entry->fifo_prev;
+  else
+    fifo_tail_ = entry->fifo_prev;
+
+  delete entry->item;
+  delete entry->ident;
+  delete entry;
+
+  num_items_--;
+}
+
+void HashedFifoReadCache::growUnprotected(void)
+{
+  uint32 new_num_buckets = num_buckets_ * 2;
+  HashedCacheItem** new_buckets = new HashedCacheItem*[new_num_buckets];
+
+  for(uint32 i = 0; i < new_num_buckets; i++)
+    new_buckets[i] = NULL;
+
+  // re-hash in FIFO order, so the chains stay ordered from old to new
+  HashedCacheItem** tails = new HashedCacheItem*[new_num_buckets];
+  for(uint32 i = 0; i < new_num_buckets; i++)
+    tails[i] = NULL;
+
+  for(HashedCacheItem* entry = fifo_head_; entry != NULL; entry = entry->fifo_next)
+  {
+    uint32 bucket = entry->hash & (new_num_buckets - 1);
+    entry->bucket_next = NULL;
+
+    if(tails[bucket] != NULL)
+      tails[bucket]->bucket_next = entry;
+    else
+      new_buckets[bucket] = entry;
+    tails[bucket] = entry;
+  }
+
+  delete[] tails;
+  delete[] buckets_;
+
+  buckets_ = new_buckets;
+  num_buckets_ = new_num_buckets;
+
+  debug(READ_CACHE, "growUnprotected - hash index now has %d buckets\n", num_buckets_);
+}
+
+void HashedFifoReadCache::removeItem(const ItemIdentity& ident)
+{
+#ifndef USE_FILE_SYSTEM_ON_GUEST_OS
+  MutexLock auto_lock(fifo_mutex_);
+#endif
+
+  HashedCacheItem* entry = findUnprotected(ident);
+  if(entry != NULL)
+    removeUnprotected(entry);
+}
+
+Item* HashedFifoReadCache::evictItem(ItemIdentity*& ident)
+{
+#ifndef USE_FILE_SYSTEM_ON_GUEST_OS
+  MutexLock auto_lock(fifo_mutex_);
+#endif
+
+  // search for the first (oldest) free item
+  for(HashedCacheItem* entry = fifo_head_; entry != NULL; entry = entry->fifo_next)
+  {
+    if(cache_->lockFreeItem(*entry->ident))
+    {
+      // the caller writes the item back and deletes it
+      Item* item = entry->item;
+      ident = entry->ident;
+      entry->item = NULL;
+      entry->ident = NULL;
+
+      removeUnprotected(entry);
+      return item;
+    }
+  }
+
+  debug(READ_CACHE, "evictItem - num_items=%d\n", num_items_);
+
+#ifndef USE_FILE_SYSTEM_ON_GUEST_OS
+  debug(READ_CACHE, "evictItem - FAIL could not delete an item!\n");
+#endif
+  return NULL;
+}
+
+void HashedFifoReadCache::clear(void)
+{
+#ifndef USE_FILE_SYSTEM_ON_GUEST_OS
+  MutexLock auto_lock(fifo_mutex_);
+#endif
+
+  HashedCacheItem* entry = fifo_head_;
+  while(entry != NULL)
+  {
+    HashedCacheItem* next = entry->fifo_next;
+
+    if(cache_->isItemFree(*entry->ident))
+    {
+      removeUnprotected(entry);
+    }
+    else
+    {
+      debug(READ_CACHE, "clear - FAIL could not clear item because it is still referenced!\n");
+    }
+
+    entry = next;
+  }
+}
+
+num_items_t HashedFifoReadCache::getNumItems(void) const
+{
+#ifndef USE_FILE_SYSTEM_ON_GUEST_OS
+  MutexLock auto_lock(fifo_mutex_);
+#endif
+
+  return num_items_;
+}
+
+} // end of namespace "Cache"
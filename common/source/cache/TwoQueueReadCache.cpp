@@ -0,0 +1,399 @@
+/**
+ * Filename: TwoQueueReadCache.cpp
+ * Description:
+ *
+ * Created on: 18.10.2026
+ */
+
+#include "TwoQueueReadCache.h"
+
+#ifndef USE_FILE_SYSTEM_ON_GUEST_OS
+#include "assert.h"
+#include "kprintf.h"
+#else
+#include <assert.h>
+#include "debug_print.h"
+#endif
+
+namespace Cache
+{
+
+TwoQueueReadCache::TwoQueueReadCache(GeneralCache* cache) : CacheReadStrategy(cache),
+    buckets_(NULL), num_buckets_(INITIAL_NUM_BUCKETS), num_entries_(0),
+    max_a1_in_(0), max_a1_out_(0)
+#ifndef USE_FILE_SYSTEM_ON_GUEST_OS
+    , queue_mutex_("TwoQueueReadCache Mutex")
+#endif
+{
+  a1_in_.head = a1_in_.tail = NULL;
+  a1_in_.size = 0;
+  a1_out_.head = a1_out_.tail = NULL;
+  a1_out_.size = 0;
+  am_.head = am_.tail = NULL;
+  am_.size = 0;
+
+  // the queue sizes recommended by the 2Q paper: A1in gets 25% of the
+  // cache, A1out remembers as many identities as half of the cache holds
+  max_a1_in_ = cache->getHardLimit() / 4;
+  if(max_a1_in_ == 0)
+    max_a1_in_ = 1;
+
+  max_a1_out_ = cache->getHardLimit() / 2;
+  if(max_a1_out_ == 0)
+    max_a1_out_ = 1;
+
+  buckets_ = new TwoQueueItem*[num_buckets_];
+  for(uint32 i = 0; i < num_buckets_; i++)
+    buckets_[i] = NULL;
+}
+
+TwoQueueReadCache::~TwoQueueReadCache()
+{
+  clear();
+  assert(a1_in_.size + am_.size == 0); // assertion indicates a locking fault!
+
+  delete[] buckets_;
+}
+
+TwoQueueReadCache::TwoQueueItem* TwoQueueReadCache::findUnprotected(const ItemIdentity& ident) const
+{
+  uint32 hash = ident.hash();
+
+  for(TwoQueueItem* entry = buckets_[hash & (num_buckets_ - 1)]; entry != NULL; entry = entry->bucket_next)
+  {
+    if(entry->hash == hash && *entry->ident == ident)
+      return entry;
+  }
+
+  return NULL;
+}
+
+void TwoQueueReadCache::insertIndexUnprotected(TwoQueueItem* entry)
+{
+  // keep the load factor below 1, so that the chains stay short
+  if(num_entries_ + 1 > num_buckets_)
+    growUnprotected();
+
+  TwoQueueItem** link = &buckets_[entry->hash & (num_buckets_ - 1)];
+  while(*link != NULL)
+    link = &(*link)->bucket_next;
+
+  entry->bucket_next = NULL;
+  *link = entry;
+
+  num_entries_++;
+}
+
+void TwoQueueReadCache::removeIndexUnprotected(TwoQueueItem* entry)
+{
+  TwoQueueItem** link = &buckets_[entry->hash & (num_buckets_ - 1)];
+  while(*link != entry)
+  {
+    assert(*link != NULL);
+    link = &(*link)->bucket_next;
+  }
+  *link = entry->bucket_next;
+
+  num_entries_--;
+}
+
+void TwoQueueReadCache::growUnprotected(void)
+{
+  uint32 new_num_buckets = num_buckets_ * 2;
+  TwoQueueItem** new_buckets = new TwoQueueItem*[new_num_buckets];
+
+  for(uint32 i = 0; i < new_num_buckets; i++)
+    new_buckets[i] = NULL;
+
+  for(uint32 i = 0; i < num_buckets_; i++)
+  {
+    TwoQueueItem* entry = buckets_[i];
+    while(entry != NULL)
+    {
+      TwoQueueItem* next = entry->bucket_next;
+
+      // chains are re-linked in reversed order, duplicated identities
+      // are not expected here
+      uint32 bucket = entry->hash & (new_num_buckets - 1);
+      entry->bucket_next = new_buckets[bucket];
+      new_buckets[bucket] = entry;
+
+      entry = next;
+    }
+  }
+
+  delete[] buckets_;
+
+  buckets_ = new_buckets;
+  num_buckets_ = new_num_buckets;
+}
+
+TwoQueueReadCache::ItemQueue& TwoQueueReadCache::getQueue(QueueType type)
+{
+  switch(type)
+  {
+    case A1_IN:
+      return a1_in_;
+    case A1_OUT:
+      return a1_out_;
+    default:
+      return am_;
+  }
+}
+
+void TwoQueueReadCache::enqueueUnprotected(TwoQueueItem* entry, QueueType type)
+{
+  ItemQueue& queue = getQueue(type);
+
+  entry->queue = type;
+  entry->next = NULL;
+  entry->prev = queue.tail;
+
+  if(queue.tail != NULL)
+    queue.tail->next = entry;
+  else
+    queue.head = entry;
+
+  queue.tail = entry;
+  queue.size++;
+}
+
+void TwoQueueReadCache::dequeueUnprotected(TwoQueueItem* entry)
+{
+  ItemQueue& queue = getQueue(entry->queue);
+
+  if(entry->prev != NULL)
+    entry->prev->next = entry->next;
+  else
+    queue.head = entry->next;
+
+  if(entry->next != NULL)
+    entry->next->prev = entry->prev;
+  else
+    queue.tail = entry->prev;
+
+  queue.size--;
+}
+
+void TwoQueueReadCache::destroyUnprotected(TwoQueueItem* entry)
+{
+  dequeueUnprotected(entry);
+  removeIndexUnprotected(entry);
+
+  if(entry->item != NULL)
+    delete entry->item;
+  delete entry->ident;
+  delete entry;
+}
+
+Item* TwoQueueReadCache::get(const ItemIdentity& ident)
+{
+#ifndef USE_FILE_SYSTEM_ON_GUEST_OS
+  MutexLock auto_lock(queue_mutex_);
+#endif
+
+  TwoQueueItem* entry = findUnprotected(ident);
+
+  // a ghost entry has no data, so it is a cache-miss
+  if(entry == NULL || entry->queue == A1_OUT)
+    return NULL;
+
+  entry->referenced = true;
+
+  // a hit in A1in does not change anything (the re-reads of a scan are
+  // correlated references), a hit in Am refreshes the LRU position
+  if(entry->queue == AM)
+  {
+    dequeueUnprotected(entry);
+    enqueueUnprotected(entry, AM);
+  }
+
+  return entry->item; // Cache-Hit!
+}
+
+bool TwoQueueReadCache::add(const ItemIdentity& ident, Item* item)
+{
+  if(item == NULL)
+    return false;
+
+#ifndef USE_FILE_SYSTEM_ON_GUEST_OS
+  MutexLock auto_lock(queue_mutex_);
+#endif
+
+  return addUnprotected(ident, item, true);
+}
+
+bool TwoQueueReadCache::addPrefetched(const ItemIdentity& ident, Item* item)
+{
+  if(item == NULL)
+    return false;
+
+#ifndef USE_FILE_SYSTEM_ON_GUEST_OS
+  MutexLock auto_lock(queue_mutex_);
+#endif
+
+  return addUnprotected(ident, item, false);
+}
+
+bool TwoQueueReadCache::addUnprotected(const ItemIdentity& ident, Item* item, bool referenced)
+{
+  TwoQueueItem* entry = findUnprotected(ident);
+
+  if(entry != NULL && entry->queue == A1_OUT)
+  {
+    // the item was read before and is read again (or is expected to be
+    // read again if it was read ahead): it is a hot one
+    debug(READ_CACHE, "add - ghost hit, promoting item to Am\n");
+
+    dequeueUnprotected(entry);
+    entry->item = item;
+    entry->referenced = true;
+    enqueueUnprotected(entry, AM);
+    return true;
+  }
+
+  entry = new TwoQueueItem;
+  entry->ident = ident.clone();
+  entry->item = item;
+  entry->hash = ident.hash();
+  entry->referenced = referenced;
+
+  insertIndexUnprotected(entry);
+  enqueueUnprotected(entry, A1_IN);
+
+  return true;
+}
+
+bool TwoQueueReadCache::contains(const ItemIdentity& ident)
+{
+#ifndef USE_FILE_SYSTEM_ON_GUEST_OS
+  MutexLock auto_lock(queue_mutex_);
+#endif
+
+  TwoQueueItem* entry = findUnprotected(ident);
+  return entry != NULL && entry->queue != A1_OUT;
+}
+
+void TwoQueueReadCache::removeItem(const ItemIdentity& ident)
+{
+#ifndef USE_FILE_SYSTEM_ON_GUEST_OS
+  MutexLock auto_lock(queue_mutex_);
+#endif
+
+  TwoQueueItem* entry = findUnprotected(ident);
+  if(entry != NULL)
+    destroyUnprotected(entry);
+}
+
+Item* TwoQueueReadCache::evictFromUnprotected(QueueType type, ItemIdentity*& ident)
+{
+  ItemQueue& queue = getQueue(type);
+
+  // search for the oldest free item
+  for(TwoQueueItem* entry = queue.head; entry != NULL; entry = entry->next)
+  {
+    if(!cache_->lockFreeItem(*entry->ident))
+      continue;
+
+    // the caller writes the item back and deletes it
+    Item* item = entry->item;
+    ident = entry->ident->clone();
+    entry->item = NULL;
+
+    // an item that was read ahead but never read leaves no ghost behind,
+    // otherwise reading it the first time would promote it to Am
+    if(type != A1_IN || !entry->referenced)
+    {
+      destroyUnprotected(entry);
+      return item;
+    }
+
+    // demote the item to a ghost entry, just the identity is kept
+    dequeueUnprotected(entry);
+    enqueueUnprotected(entry, A1_OUT);
+
+    if(a1_out_.size > max_a1_out_)
+      destroyUnprotected(a1_out_.head);
+
+    return item;
+  }
+
+  return NULL;
+}
+
+Item* TwoQueueReadCache::evictItem(ItemIdentity*& ident)
+{
+#ifndef USE_FILE_SYSTEM_ON_GUEST_OS
+  MutexLock auto_lock(queue_mutex_);
+#endif
+
+  Item* item = NULL;
+
+  // A1in is drained first as long as it is above it's target size,
+  // otherwise the least recently used hot item has to go
+  if(a1_in_.size > max_a1_in_ || am_.size == 0)
+  {
+    if((item = evictFromUnprotected(A1_IN, ident)) == NULL)
+      item = evictFromUnprotected(AM, ident);
+  }
+  else
+  {
+    if((item = evictFromUnprotected(AM, ident)) == NULL)
+      item = evictFromUnprotected(A1_IN, ident);
+  }
+
+  if(item != NULL)
+    return item;
+
+  debug(READ_CACHE, "evictItem - num_items=%d\n", a1_in_.size + am_.size);
+
+#ifndef USE_FILE_SYSTEM_ON_GUEST_OS
+  debug(READ_CACHE, "evictItem - FAIL could not delete an item!\n");
+#endif
+  return NULL;
+}
+
+void TwoQueueReadCache::clear(void)
+{
+#ifndef USE_FILE_SYSTEM_ON_GUEST_OS
+  MutexLock auto_lock(queue_mutex_);
+#endif
+
+  // the ghost entries are no longer of any use
+  while(a1_out_.head != NULL)
+    destroyUnprotected(a1_out_.head);
+
+  ItemQueue* queues[] = { &a1_in_, &am_ };
+
+  for(uint32 i = 0; i < 2; i++)
+  {
+    TwoQueueItem* entry = queues[i]->head;
+    while(entry != NULL)
+    {
+      TwoQueueItem* next = entry->next;
+
+      if(cache_->isItemFree(*entry->ident))
+      {
+        destroyUnprotected(entry);
+      }
+      else
+      {
+        debug(READ_CACHE, "clear - FAIL could not clear item because it is still referenced!\n");
+      }
+
+      entry = next;
+    }
+  }
+}
+
+num_items_t TwoQueueReadCache::getNumItems(void) const
+{
+#ifndef USE_FILE_SYSTEM_ON_GUEST_OS
+  MutexLock auto_lock(queue_mutex_);
+#endif
+
+  // ghost entries do not hold any data, so they do not count
+  return a1_in_.size + am_.size;
+}
+
+} // end of namespace "Cache"
@@ -0,0 +1,34 @@
+/**
+ * Filename: TwoQueueReadWriteBackCacheFactory.cpp
+ * Description:
+ *
+ * Created on: 18.10.2026
+ */
+
+#include "cache/TwoQueueReadWriteBackCacheFactory.h"
+#include "cache/GeneralCache.h"
+#include "cache/TwoQueueReadCache.h"
+#include "cache/WriteBackCache.h"
+
+namespace Cache
+{
+
+TwoQueueReadWriteBackCacheFactory::TwoQueueReadWriteBackCacheFactory()
+{
+}
+
+TwoQueueReadWriteBackCacheFactory::~TwoQueueReadWriteBackCacheFactory()
+{
+}
+
+CacheReadStrategy* TwoQueueReadWriteBackCacheFactory::getReadStrategy(GeneralCache* cache) const
+{
+  return new TwoQueueReadCache(cache);
+}
+
+CacheWriteStrategy* TwoQueueReadWriteBackCacheFactory::getWriteStrategy(DeviceAdapter* device) const
+{
+  return new WriteBackCache(device);
+}
+
+} // end of namespace "cache"
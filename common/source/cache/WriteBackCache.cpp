@@ -8,6 +8,11 @@
 
 #include "cache/WriteBackCache.h"
 
+#ifndef USE_FILE_SYSTEM_ON_GUEST_OS
+#include "Scheduler.h"
+#include "cache/WriteBackDaemon.h"
+#endif
+
 namespace Cache
 {
 
@@ -15,11 +20,18 @@ WriteBackCache::WriteBackCache(DeviceAdapter* device) : CacheWriteStrategy(devic
 #ifndef USE_FILE_SYSTEM_ON_GUEST_OS
 , mutex_("WriteBackCache")
 #endif
+, soft_limit_(0), hard_limit_(0)
 {
+#ifndef USE_FILE_SYSTEM_ON_GUEST_OS
+  WriteBackDaemon::instance()->registerCache(this);
+#endif
 }
 
 WriteBackCache::~WriteBackCache()
 {
+#ifndef USE_FILE_SYSTEM_ON_GUEST_OS
+  WriteBackDaemon::instance()->unregisterCache(this);
+#endif
   flush();
 }
 
@@ -34,25 +46,54 @@ bool WriteBackCache::queueWrite(const Cache::ItemIdentity& ident, Cache::Item* i
   mutex_.acquire("WriteBackCache::queueWrite");
 #endif
 
+  uint32 queued_at = getCurrentTime();
+
   // check if there is already write operation for the given Ident ...
   for(uint32 i = 0; i < item_queue_.size(); i++)
   {
     if(*(item_queue_[i]->ident) == ident)
     {
-      // remove the old item, because a new one, will follow now
+      // replace the old item, because a new one, will follow now
+      // the item stays dirty since the first write, so it keeps it's age
+      // and it's position in the queue
+      queued_at = item_queue_[i]->queued_at;
       delete item_queue_[i];
-      item_queue_.erase( item_queue_.begin() + i );
+      item_queue_[i] = new WriteBackItem(ident.clone(), item, delete_item, queued_at);
 
-      debug(WRITE_CACHE, "queueWrite - already an item with that ident, remove it\n");
-      break;
+      debug(WRITE_CACHE, "queueWrite - already an item with that ident, replaced it\n");
+
+#ifndef USE_FILE_SYSTEM_ON_GUEST_OS
+      mutex_.release("WriteBackCache::queueWrite");
+#endif
+      return true;
     }
   }
 
   // now insert the new item to the writing queue
-  item_queue_.push_back( new WriteBackItem(ident.clone(), item, delete_item) );
+  item_queue_.push_back( new WriteBackItem(ident.clone(), item, delete_item, queued_at) );
+
+  // throttle the writer: above the hard limit the writer has to write back
+  // the oldest items itself, instead of dirtying even more of the cache
+  if(hard_limit_ != 0 && item_queue_.size() > hard_limit_)
+  {
+    debug(WRITE_CACHE, "queueWrite - hard limit reached, throttling the writer\n");
+
+    while(item_queue_.size() > soft_limit_)
+      writeBackOldestUnprotected();
+  }
+
+  // the daemon sleeps while there is no dirty data, it has to look after
+  // the first dirty item (age) and after too many dirty items
+  bool wake_up_daemon = (item_queue_.size() == 1) ||
+                        (soft_limit_ != 0 && item_queue_.size() > soft_limit_);
 
 #ifndef USE_FILE_SYSTEM_ON_GUEST_OS
   mutex_.release("WriteBackCache::queueWrite");
+
+  if(wake_up_daemon)
+    WriteBackDaemon::instance()->wakeUp();
+#else
+  (void)wake_up_daemon;
 #endif
 
   return true;
@@ -93,18 +134,92 @@ void WriteBackCache::flush(void)
 
   debug(WRITE_CACHE, "flush - %d pending items\n", item_queue_.size());
 
-  for(uint32 i = 0; i < item_queue_.size(); i++)
+  uint32 num_items = item_queue_.size();
+  if(num_items == 0)
+    return;
+
+  // write back in device order (elevator), so that the device can merge
+  // the writes of neighbouring items into a single request
+  WriteBackItem** sorted = new WriteBackItem*[num_items];
+  for(uint32 i = 0; i < num_items; i++)
+    sorted[i] = item_queue_[i];
+
+  sortByOrderKey(sorted, num_items);
+
+  const Cache::ItemIdentity** idents = new const Cache::ItemIdentity*[num_items];
+  Cache::Item** items = new Cache::Item*[num_items];
+  uint32 num_writes = 0;
+
+  for(uint32 i = 0; i < num_items; i++)
   {
-    debug(WRITE_CACHE, "flush - writing back %d (item=%x)\n", i, item_queue_[i]->item);
+    // the sort is stable, so of several writes to the same item the last
+    // queued one comes last and is the only one that has to be written
+    if(i + 1 < num_items && *(sorted[i + 1]->ident) == *(sorted[i]->ident))
+    {
+      debug(WRITE_CACHE, "flush - dropping duplicated write (item=%x)\n", sorted[i]->item);
+      continue;
+    }
 
-    // writing item back to the Device and remove it from the list
-    device_->write(*item_queue_[i]->ident, item_queue_[i]->item);
-    delete item_queue_[i];
+    idents[num_writes] = sorted[i]->ident;
+    items[num_writes] = sorted[i]->item;
+    num_writes++;
   }
 
+  debug(WRITE_CACHE, "flush - writing back %d items\n", num_writes);
+  device_->writeItems(idents, items, num_writes);
+
+  for(uint32 i = 0; i < num_items; i++)
+    delete sorted[i];
+
+  delete[] items;
+  delete[] idents;
+  delete[] sorted;
+
   item_queue_.clear();
 }
 
+void WriteBackCache::sortByOrderKey(WriteBackItem** items, uint32 num_items)
+{
+  // bottom-up merge sort, it is stable and does not need any recursion
+  WriteBackItem** buffer = new WriteBackItem*[num_items];
+  WriteBackItem** src = items;
+  WriteBackItem** dest = buffer;
+
+  for(uint32 width = 1; width < num_items; width *= 2)
+  {
+    for(uint32 left = 0; left < num_items; left += 2*width)
+    {
+      uint32 mid = (left + width < num_items) ? left + width : num_items;
+      uint32 right = (left + 2*width < num_items) ? left + 2*width : num_items;
+
+      uint32 i = left, j = mid, k = left;
+      while(i < mid && j < right)
+      {
+        if(src[j]->ident->getOrderKey() < src[i]->ident->getOrderKey())
+          dest[k++] = src[j++];
+        else
+          dest[k++] = src[i++];
+      }
+      while(i < mid)
+        dest[k++] = src[i++];
+      while(j < right)
+        dest[k++] = src[j++];
+    }
+
+    WriteBackItem** tmp = src;
+    src = dest;
+    dest = tmp;
+  }
+
+  if(src != items)
+  {
+    for(uint32 i = 0; i < num_items; i++)
+      items[i] = src[i];
+  }
+
+  delete[] buffer;
+}
+
 void WriteBackCache::removeItem(const Cache::ItemIdentity& ident)
 {
 #ifndef USE_FILE_SYSTEM_ON_GUEST_OS
@@ -123,4 +238,97 @@ void WriteBackCache::removeItem(const Cache::ItemIdentity& ident)
   }
 }
 
+void WriteBackCache::setDirtyThresholds(num_items_t soft_limit, num_items_t hard_limit)
+{
+#ifndef USE_FILE_SYSTEM_ON_GUEST_OS
+  MutexLock auto_lock(mutex_);
+#endif
+
+  soft_limit_ = soft_limit;
+  hard_limit_ = hard_limit;
+}
+
+num_items_t WriteBackCache::getNumDirtyItems(void) const
+{
+#ifndef USE_FILE_SYSTEM_ON_GUEST_OS
+  MutexLock auto_lock(mutex_);
+#endif
+
+  return item_queue_.size();
+}
+
+bool WriteBackCache::needsWriteBack(void) const
+{
+#ifndef USE_FILE_SYSTEM_ON_GUEST_OS
+  MutexLock auto_lock(mutex_);
+#endif
+
+  if(item_queue_.size() == 0)
+    return false;
+
+  if(soft_limit_ != 0 && item_queue_.size() > soft_limit_)
+    return true;
+
+  // the queue is ordered by age, so the first item is the oldest one
+  return (getCurrentTime() - item_queue_[0]->queued_at) >= MAX_DIRTY_AGE;
+}
+
+uint32 WriteBackCache::getTicksUntilWriteBack(void) const
+{
+#ifndef USE_FILE_SYSTEM_ON_GUEST_OS
+  MutexLock auto_lock(mutex_);
+#endif
+
+  if(item_queue_.size() == 0)
+    return NO_DIRTY_ITEMS;
+
+  if(soft_limit_ != 0 && item_queue_.size() > soft_limit_)
+    return 0;
+
+  uint32 age = getCurrentTime() - item_queue_[0]->queued_at;
+  return (age >= MAX_DIRTY_AGE) ? 0 : MAX_DIRTY_AGE - age;
+}
+
+num_items_t WriteBackCache::writeBack(num_items_t max_items)
+{
+  num_items_t num_written = 0;
+
+  while(num_written < max_items && needsWriteBack())
+  {
+#ifndef USE_FILE_SYSTEM_ON_GUEST_OS
+    MutexLock auto_lock(mutex_);
+#endif
+
+    // the queue could have been flushed in the meantime
+    if(item_queue_.size() == 0)
+      break;
+
+    writeBackOldestUnprotected();
+    num_written++;
+  }
+
+  return num_written;
+}
+
+void WriteBackCache::writeBackOldestUnprotected(void)
+{
+  debug(WRITE_CACHE, "writeBackOldestUnprotected - writing back (item=%x)\n", item_queue_[0]->item);
+
+  device_->write(*item_queue_[0]->ident, item_queue_[0]->item);
+
+  delete item_queue_[0];
+  item_queue_.erase(item_queue_.begin());
+}
+
+uint32 WriteBackCache::getCurrentTime(void)
+{
+#ifndef USE_FILE_SYSTEM_ON_GUEST_OS
+  return Scheduler::instance()->getTicks();
+#else
+  // there is no background writeback on the host, so the age does not
+  // matter here
+  return 0;
+#endif
+}
+
 } // end of namespace
@@ -0,0 +1,133 @@
+/**
+ * Filename: WriteBackDaemon.cpp
+ * Description:
+ *
+ * Created on: 18.10.2026
+ */
+
+#ifndef USE_FILE_SYSTEM_ON_GUEST_OS
+
+#include "cache/WriteBackDaemon.h"
+#include "cache/WriteBackCache.h"
+#include "Scheduler.h"
+#include "ArchInterrupts.h"
+#include "MutexLock.h"
+#include "kprintf.h"
+
+namespace Cache
+{
+
+WriteBackDaemon* WriteBackDaemon::instance_ = 0;
+
+WriteBackDaemon* WriteBackDaemon::instance()
+{
+  if(instance_ == 0)
+    instance_ = new WriteBackDaemon();
+
+  return instance_;
+}
+
+WriteBackDaemon::WriteBackDaemon() : Thread("WriteBackDaemon"),
+    caches_lock_("WriteBackDaemon::caches_lock_"), work_pending_(false),
+    sleeping_(false)
+{
+}
+
+WriteBackDaemon::~WriteBackDaemon()
+{
+}
+
+void WriteBackDaemon::registerCache(WriteBackCache* cache)
+{
+  MutexLock auto_lock(caches_lock_);
+  caches_.push_back(cache);
+
+  debug(WRITE_CACHE, "WriteBackDaemon::registerCache - %d caches\n", caches_.size());
+}
+
+void WriteBackDaemon::unregisterCache(WriteBackCache* cache)
+{
+  MutexLock auto_lock(caches_lock_);
+
+  for(uint32 i = 0; i < caches_.size(); i++)
+  {
+    if(caches_[i] == cache)
+    {
+      caches_.erase(caches_.begin() + i);
+      return;
+    }
+  }
+}
+
+void WriteBackDaemon::wakeUp()
+{
+  bool interrupts = ArchInterrupts::disableInterrupts();
+
+  work_pending_ = true;
+
+  // only the daemon's own sleep may be interrupted, waking it up while it
+  // waits for a Mutex would break the Mutex
+  if(sleeping_)
+  {
+    sleeping_ = false;
+    Scheduler::instance()->wake(this);
+  }
+
+  if(interrupts)
+    ArchInterrupts::enableInterrupts();
+}
+
+uint32 WriteBackDaemon::writeBackCaches()
+{
+  MutexLock auto_lock(caches_lock_);
+
+  uint32 next_write_back = WriteBackCache::NO_DIRTY_ITEMS;
+
+  for(uint32 i = 0; i < caches_.size(); i++)
+  {
+    caches_[i]->writeBack(WRITE_BACK_BATCH);
+
+    uint32 ticks = caches_[i]->getTicksUntilWriteBack();
+    if(ticks < next_write_back)
+      next_write_back = ticks;
+  }
+
+  return next_write_back;
+}
+
+void WriteBackDaemon::Run()
+{
+  debug(WRITE_CACHE, "WriteBackDaemon::Run - started\n");
+
+  while(true)
+  {
+    uint32 next_write_back = writeBackCaches();
+
+    // more than a batch is due, the others get their turn in between
+    if(next_write_back == 0)
+    {
+      Scheduler::instance()->yield();
+      continue;
+    }
+
+    // sleep until the oldest dirty item is due, or until a writer wakes
+    // us up (without dirty data there is no timeout)
+    ArchInterrupts::disableInterrupts();
+    if(!work_pending_)
+    {
+      sleeping_ = true;
+      if(next_write_back == WriteBackCache::NO_DIRTY_ITEMS)
+        Scheduler::instance()->sleepAndRestoreInterrupts(true);
+      else
+        Scheduler::instance()->sleepAndRestoreInterrupts(true, next_write_back);
+      ArchInterrupts::disableInterrupts();
+      sleeping_ = false;
+    }
+    work_pending_ = false;
+    ArchInterrupts::enableInterrupts();
+  }
+}
+
+} // end of namespace "Cache"
+
+#endif
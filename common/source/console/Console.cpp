@@ -4,6 +4,33 @@
 #include "Console.h"
 #include "Terminal.h"
 #include "arch_keyboard_manager.h"
+#include "fs/tests/GeneralCacheStressTest.h"
+#include "fs/tests/FsLockStressTest.h"
+#include "mm/tests/KmmStressTest.h"
+#include "mm/tests/PageManagerStressTest.h"
+#include "StressTestThread.h"
+
+namespace
+{
+
+struct StressTest
+{
+  const char* name;
+  StressTestFunction function;
+};
+
+// the kernel stress tests, started with F7, F8, ... (in this order)
+const StressTest STRESS_TESTS[] =
+{
+  { "PageManagerStressTest", &PageManagerStressTest::start },
+  { "KmmStressTest", &KmmStressTest::start },
+  { "FsLockStressTest", &FsLockStressTest::start },
+  { "GeneralCacheStressTest", &GeneralCacheStressTest::start }
+};
+
+const uint32 NUM_STRESS_TESTS = sizeof(STRESS_TESTS) / sizeof(STRESS_TESTS[0]);
+
+}
 
 Console* main_console=0;
 
@@ -44,6 +71,13 @@ void Console::handleKey ( uint32 key )
 // else...
   switch (key)
   {
+    case KEY_F7:
+    case KEY_F8:
+    case KEY_F9:
+    case KEY_F10:
+      startStressTest(key - KEY_F7);
+      break;
+
     case KEY_F11:
       Scheduler::instance()->printStackTraces();
        break;
@@ -58,6 +92,15 @@ void Console::handleKey ( uint32 key )
   }
 }
 
+void Console::startStressTest ( uint32 number )
+{
+  if (number >= NUM_STRESS_TESTS)
+    return;
+
+  Scheduler::instance()->addNewThread(new StressTestThread(STRESS_TESTS[number].name,
+                                                           STRESS_TESTS[number].function));
+}
+
 uint32 Console::getNumTerminals() const
 {
   return terminals_.size();
@@ -0,0 +1,302 @@
+/**
+ * Filename: DentryCache.cpp
+ * Description:
+ *
+ * Created on: 18.10.2026
+ */
+
+#include "fs/DentryCache.h"
+
+#include "fs/FileSystem.h"
+#include "fs/inodes/Inode.h"
+#include "fs/inodes/Directory.h"
+#include "fs/VfsSyscall.h"
+
+#ifndef USE_FILE_SYSTEM_ON_GUEST_OS
+#include "util/string.h"
+#include "assert.h"
+#include "kprintf.h"
+#else
+#include <cstring>
+#include <assert.h>
+#include "debug_print.h"
+#endif
+
+DentryCache::DentryCache(uint32 max_entries) : buckets_(NULL), num_buckets_(1),
+    lru_head_(NULL), lru_tail_(NULL), num_entries_(0), max_entries_(max_entries),
+    generation_(0)
+#ifndef USE_FILE_SYSTEM_ON_GUEST_OS
+    , lock_("DentryCache Mutex")
+#endif
+{
+  // the table never grows, so it is sized for the maximal number of entries
+  while(num_buckets_ < max_entries_)
+    num_buckets_ *= 2;
+
+  buckets_ = new DentryCacheEntry*[num_buckets_];
+  for(uint32 i = 0; i < num_buckets_; i++)
+    buckets_[i] = NULL;
+}
+
+DentryCache::~DentryCache()
+{
+  clear();
+  delete[] buckets_;
+}
+
+uint32 DentryCache::hashName(inode_id_t parent_id, const char* name)
+{
+  // FNV-1a over the name, seeded with the parent ID (the FileSystem is
+  // compared by findUnprotected() only)
+  uint32 hash = 2166136261U ^ (parent_id * 2654435761U);
+
+  for(const char* c = name; *c != '\0'; c++)
+  {
+    hash ^= (uint8)*c;
+    hash *= 16777619U;
+  }
+
+  return hash;
+}
+
+DentryCache::DentryCacheEntry* DentryCache::findUnprotected(FileSystem* fs,
+    inode_id_t parent_id, const char* name, uint32 hash) const
+{
+  for(DentryCacheEntry* entry = buckets_[hash & (num_buckets_ - 1)]; entry != NULL; entry = entry->bucket_next)
+  {
+    if(entry->hash == hash && entry->parent_id == parent_id &&
+       entry->parent_fs == fs && strcmp(entry->name, name) == 0)
+      return entry;
+  }
+
+  return NULL;
+}
+
+void DentryCache::appendLruUnprotected(DentryCacheEntry* entry)
+{
+  entry->lru_next = NULL;
+  entry->lru_prev = lru_tail_;
+
+  if(lru_tail_ != NULL)
+    lru_tail_->lru_next = entry;
+  else
+    lru_head_ = entry;
+
+  lru_tail_ = entry;
+}
+
+void DentryCache::unlinkLruUnprotected(DentryCacheEntry* entry)
+{
+  if(entry->lru_prev != NULL)
+    entry->lru_prev->lru_next = entry->lru_next;
+  else
+    lru_head_ = entry->lru_next;
+
+  if(entry->lru_next != NULL)
+    entry->lru_next->lru_prev = entry->lru_prev;
+  else
+    lru_tail_ = entry->lru_prev;
+}
+
+void DentryCache::removeUnprotected(DentryCacheEntry* entry)
+{
+  DentryCacheEntry** link = &buckets_[entry->hash & (num_buckets_ - 1)];
+  while(*link != entry)
+  {
+    assert(*link != NULL);
+    link = &(*link)->bucket_next;
+  }
+  *link = entry->bucket_next;
+
+  unlinkLruUnprotected(entry);
+
+  delete[] entry->name;
+  delete entry;
+
+  num_entries_--;
+}
+
+uint32 DentryCache::walk(Directory* dir, char* const* names, uint32 num_names, VfsSyscall* vfs, Inode*& child)
+{
+  FileSystem* fs = dir->getFileSystem();
+  inode_id_t id = dir->getID();
+
+#ifndef USE_FILE_SYSTEM_ON_GUEST_OS
+  MutexLock auto_lock(lock_);
+#endif
+
+  DentryCacheEntry* last = NULL;
+  uint32 num_resolved = 0;
+
+  while(num_resolved < num_names)
+  {
+    // the Directory reached by the last entry is searched next
+    if(last != NULL && vfs != NULL &&
+       !vfs->isSearchPermitted(last->child_fs, last->child_uid, last->child_gid, last->child_permissions))
+    {
+      debug(DENTRY_CACHE, "walk - no search permission for %d\n", last->child_id);
+      break;
+    }
+
+    DentryCacheEntry* entry = findUnprotected(fs, id, names[num_resolved], hashName(id, names[num_resolved]));
+    if(entry == NULL)
+      break;
+
+    // a File in between is left to the regular lookup, which reports it
+    if(entry->child_fs != NULL && !entry->child_is_dir && num_resolved + 1 < num_names)
+      break;
+
+    // refresh the LRU position
+    unlinkLruUnprotected(entry);
+    appendLruUnprotected(entry);
+
+    last = entry;
+    num_resolved++;
+
+    if(entry->child_fs == NULL)
+    {
+      debug(DENTRY_CACHE, "walk - negative entry for \"%s\" in %d\n", entry->name, entry->parent_id);
+      break;
+    }
+
+    fs = entry->child_fs;
+    id = entry->child_id;
+  }
+
+  if(last == NULL)
+    return 0;
+
+  child = NULL;
+
+  if(last->child_fs != NULL)
+  {
+    // acquiring the child while the entry is locked, so that an unlink()
+    // waiting to invalidate the entry can not destroy the I-Node before
+    child = last->child_fs->acquireInode(last->child_id, NULL, last->name);
+
+    if(child == NULL)
+    {
+      // the I-Node is gone, the entry is useless
+      removeUnprotected(last);
+      return 0;
+    }
+  }
+
+  return num_resolved;
+}
+
+uint32 DentryCache::getGeneration(void) const
+{
+#ifndef USE_FILE_SYSTEM_ON_GUEST_OS
+  MutexLock auto_lock(lock_);
+#endif
+
+  return generation_;
+}
+
+void DentryCache::insert(Directory* parent, const char* name, Inode* child, uint32 generation)
+{
+  FileSystem* fs = parent->getFileSystem();
+  uint32 hash = hashName(parent->getID(), name);
+  uint32 name_len = strlen(name);
+
+  // the cache is useless for long names anyway
+  if(name_len >= NAME_MAX)
+    return;
+
+#ifndef USE_FILE_SYSTEM_ON_GUEST_OS
+  MutexLock auto_lock(lock_);
+#endif
+
+  // the lookup result might already be outdated
+  if(generation != generation_)
+    return;
+
+  if(findUnprotected(fs, parent->getID(), name, hash) != NULL)
+    return;
+
+  if(num_entries_ >= max_entries_)
+    removeUnprotected(lru_head_);
+
+  DentryCacheEntry* entry = new DentryCacheEntry;
+  entry->parent_fs = fs;
+  entry->parent_id = parent->getID();
+  entry->name = new char[name_len + 1];
+  memcpy(entry->name, name, name_len + 1);
+  entry->hash = hash;
+  entry->child_fs = (child != NULL) ? child->getFileSystem() : NULL;
+  entry->child_id = (child != NULL) ? child->getID() : 0;
+  entry->child_is_dir = (child != NULL && child->getType() == Inode::InodeTypeDirectory);
+  entry->child_uid = (child != NULL) ? child->getUID() : 0;
+  entry->child_gid = (child != NULL) ? child->getGID() : 0;
+  entry->child_permissions = (child != NULL) ? child->getPermissions() : 0;
+
+  DentryCacheEntry** bucket = &buckets_[hash & (num_buckets_ - 1)];
+  entry->bucket_next = *bucket;
+  *bucket = entry;
+
+  appendLruUnprotected(entry);
+  num_entries_++;
+}
+
+void DentryCache::invalidate(Directory* parent, const char* name)
+{
+  FileSystem* fs = parent->getFileSystem();
+  uint32 hash = hashName(parent->getID(), name);
+
+#ifndef USE_FILE_SYSTEM_ON_GUEST_OS
+  MutexLock auto_lock(lock_);
+#endif
+
+  generation_++;
+
+  DentryCacheEntry* entry = findUnprotected(fs, parent->getID(), name, hash);
+  if(entry != NULL)
+    removeUnprotected(entry);
+}
+
+void DentryCache::invalidateDirectory(Directory* dir)
+{
+  FileSystem* fs = dir->getFileSystem();
+  inode_id_t id = dir->getID();
+
+#ifndef USE_FILE_SYSTEM_ON_GUEST_OS
+  MutexLock auto_lock(lock_);
+#endif
+
+  generation_++;
+
+  // removing a Directory is rare, so just scan all entries
+  DentryCacheEntry* entry = lru_head_;
+  while(entry != NULL)
+  {
+    DentryCacheEntry* next = entry->lru_next;
+
+    if((entry->parent_fs == fs && entry->parent_id == id) ||
+       (entry->child_fs == fs && entry->child_id == id))
+      removeUnprotected(entry);
+
+    entry = next;
+  }
+}
+
+void DentryCache::clear(void)
+{
+#ifndef USE_FILE_SYSTEM_ON_GUEST_OS
+  MutexLock auto_lock(lock_);
+#endif
+
+  generation_++;
+
+  while(lru_head_ != NULL)
+    removeUnprotected(lru_head_);
+}
+
+uint32 DentryCache::getNumEntries(void) const
+{
+#ifndef USE_FILE_SYSTEM_ON_GUEST_OS
+  MutexLock auto_lock(lock_);
+#endif
+
+  return num_entries_;
+}
@@ -12,6 +12,8 @@
 #define NULL 0
 #endif
 
+OBJECT_CACHE_DEFINITIONS(SectorCacheIdent)
+
 SectorCacheIdent::SectorCacheIdent(sector_addr_t sector_no,
     sector_addr_t block_size) : sector_no_(sector_no), block_size_(block_size)
 {
@@ -38,6 +40,16 @@ bool SectorCacheIdent::operator==(const Cache::ItemIdentity& cmp)
   return (p_cmp->getSectorNumber() == this->getSectorNumber());
 }
 
+uint32 SectorCacheIdent::hash(void) const
+{
+  return sector_no_;
+}
+
+uint32 SectorCacheIdent::getOrderKey(void) const
+{
+  return sector_no_;
+}
+
 Cache::ItemIdentity* SectorCacheIdent::clone(void) const
 {
   return new SectorCacheIdent(getSectorNumber(), getSectorSize());
@@ -57,6 +69,8 @@ sector_len_t SectorCacheIdent::getSectorSize(void) const
 //
 //------------------------------------------------------------------------------
 
+OBJECT_CACHE_DEFINITIONS(SectorCacheItem)
+
 SectorCacheItem::SectorCacheItem(char* sector_data) : Item(),
     sector_(sector_data)
 {
@@ -6,123 +6,31 @@
 #include "fs/FileSystem.h"
 
 #ifndef USE_FILE_SYSTEM_ON_GUEST_OS
-#include <ustl/ulist.h>
-#include "ArchThreads.h"
-
-#include "Mutex.h"
-#include "MutexLock.h"
-
-#define STL_NAMESPACE_PREFIX      ustl::
+#include "kprintf.h"
+#include "assert.h"
 #else
-#include <list>
-#define STL_NAMESPACE_PREFIX      std::
-#endif
-
-STL_NAMESPACE_PREFIX list<FileDescriptor*> global_fd;
-
-#ifndef USE_FILE_SYSTEM_ON_GUEST_OS
-Mutex global_fd_lock("global_fd_lock");
-#endif
-
-static uint32 fd_num_ = 3;
-
-void FileDescriptor::add(FileDescriptor* fd)
-{
-#ifndef USE_FILE_SYSTEM_ON_GUEST_OS
-  global_fd_lock.acquire();
-#endif
-
-  global_fd.push_back(fd);
-
-#ifndef USE_FILE_SYSTEM_ON_GUEST_OS
-  global_fd_lock.release();
-#endif
-}
-
-void FileDescriptor::remove(FileDescriptor* fd)
-{
-#ifndef USE_FILE_SYSTEM_ON_GUEST_OS
-  global_fd_lock.acquire();
+#include "debug_print.h"
 #endif
 
-  global_fd.remove(fd);
-  delete fd;
-
-#ifndef USE_FILE_SYSTEM_ON_GUEST_OS
-  global_fd_lock.release();
-#endif
-}
-
-bool FileDescriptor::remove(fd_size_t fd)
-{
-  bool remove_sucessfully = false;
-
-#ifndef USE_FILE_SYSTEM_ON_GUEST_OS
-  global_fd_lock.acquire();
-#endif
-
-  for(STL_NAMESPACE_PREFIX list<FileDescriptor*>::iterator it = global_fd.begin(); it != global_fd.end(); it++)
-  {
-    if(*it && (*it)->getFd() == fd)
-    {
-      delete (*it);
-      global_fd.erase(it);
-
-      debug(VFSSYSCALL, "close() - OK - removed FD from the list\n");
-      remove_sucessfully = true;
-      break;
-    }
-  }
-
-#ifndef USE_FILE_SYSTEM_ON_GUEST_OS
-  global_fd_lock.release();
-#endif
-  return remove_sucessfully;
-}
-
-FileDescriptor* FileDescriptor::getFileDescriptor(fd_size_t fd)
-{
-#ifndef USE_FILE_SYSTEM_ON_GUEST_OS
-  extern Mutex global_fd_lock;
-#endif
-
-  FileDescriptor* file_descriptor = 0;
-
-#ifndef USE_FILE_SYSTEM_ON_GUEST_OS
-  MutexLock mlock(global_fd_lock);
-#endif
-
-  for (STL_NAMESPACE_PREFIX list<FileDescriptor*>::iterator it = global_fd.begin(); it != global_fd.end(); it++)
-  {
-    if ((*it)->getFd() == fd)
-    {
-      file_descriptor = *it;
-      debug(VFSSYSCALL, "found the fd!\n");
-      break;
-    }
-  }
-  return file_descriptor;
-}
+OBJECT_CACHE_DEFINITIONS(FileDescriptor)
 
 FileDescriptor::FileDescriptor ( File* file, bool append_mode,
-                                 bool nonblocking_mode ) : file_(file), cursor_pos_(0),
+                                 bool nonblocking_mode ) : fd_(0), file_(file), cursor_pos_(0),
                                  append_mode_(append_mode),
                                  nonblocking_mode_(nonblocking_mode), read_mode_(false),
-                                 write_mode_(true), synchronous_(false)
+                                 write_mode_(true), synchronous_(false),
+                                 read_ahead_next_pos_(0), read_ahead_window_(0),
+                                 read_ahead_end_(0)
 {
-#ifndef USE_FILE_SYSTEM_ON_GUEST_OS
-  fd_ = ArchThreads::atomic_add(fd_num_, 1);
-#else
-  fd_ = fd_num_++;
-#endif
-  //file_ = file;
+  // the number is assigned by the FileDescriptorTable of the Process
 }
 
 FileDescriptor::FileDescriptor(const FileDescriptor& cpy) : fd_(cpy.fd_),
     file_(cpy.file_), cursor_pos_(cpy.cursor_pos_), owner_(cpy.owner_),
     append_mode_(cpy.append_mode_), nonblocking_mode_(cpy.nonblocking_mode_),
     read_mode_(cpy.read_mode_), write_mode_(cpy.write_mode_),
-    synchronous_(cpy.synchronous_)
+    synchronous_(cpy.synchronous_), read_ahead_next_pos_(cpy.read_ahead_next_pos_),
+    read_ahead_window_(cpy.read_ahead_window_), read_ahead_end_(cpy.read_ahead_end_)
 {
   // IMPORTANT: the fs uses a reference counter to prevent from deleting an object
   // instance while it is still in use; now that file_ is used once more we need
@@ -138,6 +46,10 @@ FileDescriptor::~FileDescriptor()
 
   if(file_ != NULL)
   {
+    // the blocks reserved for appending are not needed any more
+    if(write_mode_)
+      file_->releaseReservedSectorsProtected();
+
     // release the File-node from the FileSystem
     FileSystem* fs = file_->getFileSystem();
     fs->releaseInode(file_);
@@ -202,6 +114,39 @@ file_size_t FileDescriptor::moveCursor(file_size_t movement, bool to_the_end)
   return cursor_pos_;
 }
 
+uint32 FileDescriptor::updateReadAheadWindow(file_size_t pos, file_size_t len)
+{
+  // NOTE: the state is not locked, concurrent readers of the same fd just
+  // disturb the heuristic
+  if(pos == read_ahead_next_pos_)
+  {
+    if(read_ahead_window_ == 0)
+      read_ahead_window_ = READ_AHEAD_MIN_WINDOW;
+    else if(read_ahead_window_ * 2 <= READ_AHEAD_MAX_WINDOW)
+      read_ahead_window_ *= 2;
+    else
+      read_ahead_window_ = READ_AHEAD_MAX_WINDOW;
+  }
+  else
+  {
+    read_ahead_window_ = 0;
+    read_ahead_end_ = 0;
+  }
+
+  read_ahead_next_pos_ = pos + len;
+  return read_ahead_window_;
+}
+
+uint32 FileDescriptor::getReadAheadEnd(void) const
+{
+  return read_ahead_end_;
+}
+
+void FileDescriptor::setReadAheadEnd(uint32 end_block)
+{
+  read_ahead_end_ = end_block;
+}
+
 bool FileDescriptor::appendMode(void) const
 {
   return append_mode_;
@@ -0,0 +1,121 @@
+/**
+ * Filename: FileDescriptorTable.cpp
+ * Description:
+ *
+ * Created on: 18.10.2026
+ */
+
+#include "fs/FileDescriptorTable.h"
+#include "fs/FileDescriptor.h"
+
+#ifndef USE_FILE_SYSTEM_ON_GUEST_OS
+#include "util/string.h"
+#include "kprintf.h"
+#else
+#include <cstring>
+#include "debug_print.h"
+#endif
+
+FileDescriptorTable::FileDescriptorTable() : fds_(NULL), capacity_(0),
+    lowest_free_(FIRST_FD), num_open_(0)
+#ifndef USE_FILE_SYSTEM_ON_GUEST_OS
+    , lock_("FileDescriptorTable Mutex")
+#endif
+{
+}
+
+FileDescriptorTable::~FileDescriptorTable()
+{
+  clear();
+  delete[] fds_;
+}
+
+fd_size_t FileDescriptorTable::add(FileDescriptor* fd)
+{
+#ifndef USE_FILE_SYSTEM_ON_GUEST_OS
+  MutexLock auto_lock(lock_);
+#endif
+
+  uint32 num = lowest_free_;
+  while(num < capacity_ && fds_[num] != NULL)
+    num++;
+
+  if(num >= capacity_)
+  {
+    uint32 capacity = (capacity_ == 0) ? MIN_CAPACITY : capacity_ * 2;
+    FileDescriptor** fds = new FileDescriptor*[capacity];
+
+    if(capacity_ > 0)
+      memcpy(fds, fds_, capacity_ * sizeof(FileDescriptor*));
+    for(uint32 i = capacity_; i < capacity; i++)
+      fds[i] = NULL;
+
+    delete[] fds_;
+    fds_ = fds;
+    capacity_ = capacity;
+  }
+
+  fds_[num] = fd;
+  fd->setFd(num);
+
+  lowest_free_ = num + 1;
+  num_open_++;
+
+  debug(VFSSYSCALL, "FileDescriptorTable::add - new fd=%d\n", num);
+  return num;
+}
+
+FileDescriptor* FileDescriptorTable::get(fd_size_t fd) const
+{
+#ifndef USE_FILE_SYSTEM_ON_GUEST_OS
+  MutexLock auto_lock(lock_);
+#endif
+
+  if(fd >= capacity_)
+    return NULL;
+
+  return fds_[fd];
+}
+
+bool FileDescriptorTable::remove(fd_size_t fd)
+{
+  FileDescriptor* file_descriptor = NULL;
+
+  {
+#ifndef USE_FILE_SYSTEM_ON_GUEST_OS
+    MutexLock auto_lock(lock_);
+#endif
+
+    if(fd >= capacity_ || fds_[fd] == NULL)
+      return false;
+
+    file_descriptor = fds_[fd];
+    fds_[fd] = NULL;
+
+    if(fd < lowest_free_)
+      lowest_free_ = fd;
+
+    num_open_--;
+  }
+
+  // releasing the File might write back the I-Node, so not within the lock
+  delete file_descriptor;
+
+  debug(VFSSYSCALL, "FileDescriptorTable::remove - removed fd=%d\n", fd);
+  return true;
+}
+
+void FileDescriptorTable::clear(void)
+{
+  for(uint32 fd = FIRST_FD; fd < capacity_; fd++)
+    remove(fd);
+}
+
+uint32 FileDescriptorTable::getNumOpen(void) const
+{
+#ifndef USE_FILE_SYSTEM_ON_GUEST_OS
+  MutexLock auto_lock(lock_);
+#endif
+
+  return num_open_;
+}
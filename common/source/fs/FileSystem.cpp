@@ -18,6 +18,7 @@
 #include "cache/CacheFactory.h"
 #include "cache/FiFoReadNoWriteCacheFactory.h"
 #include "cache/FifoReadWriteBackCacheFactory.h"
+#include "cache/TwoQueueReadWriteBackCacheFactory.h"
 #include "fs/DeviceCache.h"
 
 #include "fs/FsSmartLock.h"
@@ -47,6 +48,12 @@ FileSystem::FileSystem(FsDevice* device, uint32 mount_flags) : device_(device),
     fs_cache_factory = new Cache::FiFoReadNoWriteCacheFactory();
     //fs_cache_factory = new Cache::AgingReadNoWriteCacheFactory();
   }
+  // MS_CACHE_2Q selects the scan resistant read strategy, so that large
+  // sequential reads do not evict the FileSystem's meta-data
+  else if( mount_flags & MS_CACHE_2Q )
+  {
+    fs_cache_factory = new Cache::TwoQueueReadWriteBackCacheFactory();
+  }
   // in all other cases use the Write-Back strategy
   else
   {
@@ -123,6 +130,11 @@ FsVolumeManager* FileSystem::getVolumeManager(void)
   return volume_manager_;
 }
 
+void FileSystem::releaseReservedSectors(Inode* inode __attribute__((unused)))
+{
+  // no preallocation by default
+}
+
 bool FileSystem::isFilenameValid(const char* filename, uint32 str_len)
 {
   if(strlen(filename) != str_len)
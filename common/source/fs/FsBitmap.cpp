@@ -10,21 +10,56 @@
 #include "fs/FileSystem.h"
 #include "fs/FsVolumeManager.h"
 
+#ifndef USE_FILE_SYSTEM_ON_GUEST_OS
+#include "kernel/MutexLock.h"
+#endif
+
+/**
+ * counts the set bits of a word (__builtin_popcount() would need
+ * __popcountsi2 of libgcc, which the kernel doesn't link)
+ */
+static uint32 countSetBits(uint32 word)
+{
+  word = word - ((word >> 1) & 0x55555555);
+  word = (word & 0x33333333) + ((word >> 2) & 0x33333333);
+  word = (word + (word >> 4)) & 0x0F0F0F0F;
+  return (word * 0x01010101) >> 24;
+}
+
 FsBitmap::FsBitmap(FileSystem* file_system, FsVolumeManager* fs_volume_manager,
     sector_addr_t start_sector, sector_addr_t end_sector,
     bitmap_t num_bits) : file_system_(file_system),
     volume_manager_(fs_volume_manager),
-    start_sector_(start_sector), num_bits_(num_bits), num_blocks_(end_sector+1 - start_sector)
+    start_sector_(start_sector), num_bits_(num_bits), num_blocks_(end_sector+1 - start_sector),
+    bits_per_block_(file_system->getBlockSize() * 8),
+    free_bits_of_block_(NULL), num_free_bits_(0), reserved_words_(NULL), next_free_hint_(0)
+#ifndef USE_FILE_SYSTEM_ON_GUEST_OS
+    , lock_("FsBitmap Mutex")
+#endif
 {
   // check capacity
   assert((end_sector+1 - start_sector) * file_system_->getBlockSize() * 8 >= num_bits);
+
+  // the blocks are scanned in 32bit-words
+  assert(bits_per_block_ % 32 == 0);
 }
 
 FsBitmap::~FsBitmap()
 {
+  delete[] free_bits_of_block_;
+  delete[] reserved_words_;
 }
 
 bool FsBitmap::setBit(bitmap_t index, bool value)
+{
+#ifndef USE_FILE_SYSTEM_ON_GUEST_OS
+  MutexLock auto_lock(lock_);
+#endif
+
+  return setBitUnprotected(index, value);
+}
+
+bool FsBitmap::setBitUnprotected(bitmap_t index, bool value)
 {
   if(index > num_bits_)
     return false;
@@ -39,6 +74,23 @@ bool FsBitmap::setBit(bitmap_t index, bool value)
 
   char* buffer = volume_manager_->readSectorUnprotected(sector);
 
+  // updating the free-counts if the bit changes
+  bool old_value = buffer[buf_idx] & (1<<bit);
+
+  if(free_bits_of_block_ != NULL && index < num_bits_ && old_value != value)
+  {
+    if(value)
+    {
+      free_bits_of_block_[index / bits_per_block_]--;
+      num_free_bits_--;
+    }
+    else
+    {
+      free_bits_of_block_[index / bits_per_block_]++;
+      num_free_bits_++;
+    }
+  }
+
   // setting the bit
   if(value)
     buffer[buf_idx] |= (1<<bit);
@@ -92,107 +144,371 @@ bool FsBitmap::getBit(bitmap_t index)
 
 bitmap_t FsBitmap::occupyNextFreeBit(void)
 {
-  debug(FS_BITMAP, "occupyNextFreeBit - finding a free Bit in the bitmap\n");
-  bitmap_t next_free_bit = 0;
+  return occupyNextFreeBits(1);
+}
 
-  sector_len_t block_size = file_system_->getBlockSize();
+bitmap_t FsBitmap::occupyNextFreeBits(bitmap_t num_bits, bitmap_t goal)
+{
+  debug(FS_BITMAP, "occupyNextFreeBits - finding %d free Bits in the bitmap\n", num_bits);
 
-  debug(FS_BITMAP, "occupyNextFreeBit - bitmap uses %d blocks.\n", num_blocks_);
+#ifndef USE_FILE_SYSTEM_ON_GUEST_OS
+  MutexLock auto_lock(lock_);
+#endif
 
-  // the current bit
-  bitmap_t cur_bit = 0;
+  loadFreeCounts();
 
-  for(sector_addr_t cur_block = 0; cur_block < num_blocks_; cur_block++)
+  bitmap_t first_bit = findNextFreeBits(num_bits, goal);
+
+  if(first_bit == (bitmap_t)-1)
   {
-    volume_manager_->acquireSectorForWriting(start_sector_ + cur_block);
+    debug(FS_BITMAP, "occupyNextFreeBits - ERROR no run of %d free bits.\n", num_bits);
+    return -1;
+  }
 
-    char* buffer = volume_manager_->readSectorUnprotected(start_sector_ + cur_block);
+  occupyBits(first_bit, num_bits);
+
+  debug(FS_BITMAP, "occupyNextFreeBits - free bits (%d - %d), occupied!\n", first_bit, first_bit + num_bits - 1);
+  return first_bit;
+}
+
+bitmap_t FsBitmap::reserveNextFreeBits(bitmap_t num_bits, bitmap_t goal)
+{
+  debug(FS_BITMAP, "reserveNextFreeBits - finding %d free Bits in the bitmap\n", num_bits);
+
+#ifndef USE_FILE_SYSTEM_ON_GUEST_OS
+  MutexLock auto_lock(lock_);
+#endif
+
+  loadFreeCounts();
+
+  bitmap_t first_bit = findNextFreeBits(num_bits, goal);
+
+  if(first_bit == (bitmap_t)-1)
+  {
+    debug(FS_BITMAP, "reserveNextFreeBits - ERROR no run of %d free bits.\n", num_bits);
+    return -1;
+  }
+
+  reserveBits(first_bit, num_bits);
+
+  debug(FS_BITMAP, "reserveNextFreeBits - free bits (%d - %d), reserved!\n", first_bit, first_bit + num_bits - 1);
+  return first_bit;
+}
+
+bitmap_t FsBitmap::findNextFreeBits(bitmap_t num_bits, bitmap_t goal) const
+{
+  if(num_bits == 0 || num_bits > num_free_bits_)
+  {
+    debug(FS_BITMAP, "findNextFreeBits - ERROR not enough free bits.\n");
+    return -1;
+  }
+
+  // next-fit: searching behind the last occupied bit (or the goal) first,
+  // then wrapping around to the beginning
+  bitmap_t start = (goal < num_bits_) ? goal : next_free_hint_;
+  bitmap_t first_bit = findFreeBits(num_bits, start, num_bits_);
+
+  if(first_bit == (bitmap_t)-1 && start > 0)
+  {
+    bitmap_t end = start + num_bits - 1;
+    first_bit = findFreeBits(num_bits, 0, (end < num_bits_) ? end : num_bits_);
+  }
+
+  return first_bit;
+}
+
+bitmap_t FsBitmap::reserveFreeBitsAt(bitmap_t first, bitmap_t max_bits)
+{
+#ifndef USE_FILE_SYSTEM_ON_GUEST_OS
+  MutexLock auto_lock(lock_);
+#endif
+
+  loadFreeCounts();
+
+  if(first >= num_bits_)
+    return 0;
+
+  if(max_bits > num_bits_ - first)
+    max_bits = num_bits_ - first;
+
+  // the length of the free run at first
+  bitmap_t num_bits = 0;
+
+  while(num_bits < max_bits)
+  {
+    bitmap_t cur_bit = first + num_bits;
+    sector_addr_t cur_block = cur_bit / bits_per_block_;
+
+    volume_manager_->acquireSectorForReading(start_sector_ + cur_block);
+    const char* buffer = volume_manager_->readSectorUnprotected(start_sector_ + cur_block);
     assert(buffer != NULL);
 
-    for(sector_len_t i = 0; i < block_size; i++)
+    bitmap_t block_end = (cur_block + 1) * bits_per_block_;
+
+    for(; num_bits < max_bits && cur_bit < block_end; num_bits++, cur_bit++)
     {
-      if(cur_bit >= num_bits_)
-      {
-        debug(FS_BITMAP, "occupyNextFreeBit - last bit is reached, quit.\n");
+      bitmap_t offset = cur_bit % bits_per_block_;
+      if((buffer[offset / 8] & (1 << (offset % 8))) || isReserved(cur_bit))
         break;
-      }
+    }
 
-      for(uint8 j = 0; j < 8; j++, cur_bit++)
-      {
-        //if(!(buffer[i] & (0xFF & (1<<j))))
-        if(!(buffer[i] & (1<<j)))
-        {
-          // this bit is free!
-          buffer[i] |= (1<<j);
-          next_free_bit = cur_bit; //i*8 + j;
-
-          // rewrite disk-block
-          debug(FS_BITMAP, "occupyNextFreeBit - found a free bit (%d), block-no=%x block-offset=%d bit-no=%d.\n", next_free_bit, start_sector_+cur_block, i, j);
-          volume_manager_->writeSectorUnprotected(start_sector_ + cur_block, buffer);
-          break;
-        }
-      }
+    volume_manager_->releaseReadSector(start_sector_ + cur_block);
 
-      if(next_free_bit != 0)
-        break;
-    }
+    if(cur_bit < block_end)
+      break;
+  }
 
-    volume_manager_->releaseWriteSector(start_sector_ + cur_block);
+  if(num_bits > 0)
+    reserveBits(first, num_bits);
 
-    if(next_free_bit != 0)
-    {
-      debug(FS_BITMAP, "occupyNextFreeBit - free bit (%d), occupied!\n", next_free_bit);
-      return next_free_bit;
-    }
+  return num_bits;
+}
+
+bool FsBitmap::occupyReservedBit(bitmap_t index)
+{
+#ifndef USE_FILE_SYSTEM_ON_GUEST_OS
+  MutexLock auto_lock(lock_);
+#endif
+
+  if(index >= num_bits_ || reserved_words_ == NULL || !isReserved(index))
+  {
+    debug(FS_BITMAP, "occupyReservedBit - ERROR bit %d is not reserved\n", index);
+    return false;
   }
 
-  // Bitmap is completely full... sorry
-  debug(FS_BITMAP, "occupyNextFreeBit - ERROR no more free bits.\n");
-  return -1;
+  // the bit is free on the device, setBitUnprotected() counts it again
+  reserved_words_[index / 32] &= ~(1U << (index % 32));
+  free_bits_of_block_[index / bits_per_block_]++;
+  num_free_bits_++;
+
+  return setBitUnprotected(index, true);
+}
+
+void FsBitmap::releaseReservedBits(bitmap_t first, bitmap_t num_bits)
+{
+#ifndef USE_FILE_SYSTEM_ON_GUEST_OS
+  MutexLock auto_lock(lock_);
+#endif
+
+  if(reserved_words_ == NULL)
+    return;
+
+  for(bitmap_t i = first; i < first + num_bits && i < num_bits_; i++)
+  {
+    if(!isReserved(i))
+      continue;
+
+    reserved_words_[i / 32] &= ~(1U << (i % 32));
+    free_bits_of_block_[i / bits_per_block_]++;
+    num_free_bits_++;
+  }
 }
 
 bitmap_t FsBitmap::getNumFreeBits(void) const
 {
-  debug(FS_BITMAP, "getNumFreeBits - CALL determining number of free bits.\n");
+#ifndef USE_FILE_SYSTEM_ON_GUEST_OS
+  MutexLock auto_lock(lock_);
+#endif
 
-  sector_len_t block_size = file_system_->getBlockSize();
+  loadFreeCounts();
+
+  debug(FS_BITMAP, "getNumFreeBits - Bitmap has %d free bits.\n", num_free_bits_);
+  return num_free_bits_;
+}
+
+void FsBitmap::loadFreeCounts(void) const
+{
+  if(free_bits_of_block_ != NULL)
+    return;
 
-  bitmap_t cur_bit = 0;
+  debug(FS_BITMAP, "loadFreeCounts - counting the free bits of %d blocks.\n", num_blocks_);
 
-  // number of free bits
-  bitmap_t num_free_bits = 0;
+  free_bits_of_block_ = new bitmap_t[num_blocks_];
+  num_free_bits_ = 0;
+
+  reserved_words_ = new uint32[(num_bits_ + 31) / 32];
+  for(bitmap_t i = 0; i < (num_bits_ + 31) / 32; i++)
+    reserved_words_[i] = 0;
 
   for(sector_addr_t cur_block = 0; cur_block < num_blocks_; cur_block++)
   {
+    bitmap_t num_block_bits = getNumBitsOfBlock(cur_block);
+    bitmap_t num_free = 0;
+
+    if(num_block_bits > 0)
+    {
+      volume_manager_->acquireSectorForReading(start_sector_ + cur_block);
+
+      const uint32* words = reinterpret_cast<const uint32*>(
+          volume_manager_->readSectorUnprotected(start_sector_ + cur_block));
+      assert(words != NULL);
+
+      for(bitmap_t i = 0; i < num_block_bits; i += 32)
+      {
+        uint32 free_bits = ~words[i / 32];
+
+        // the last word might be used partially
+        if(num_block_bits - i < 32)
+          free_bits &= (1U << (num_block_bits - i)) - 1;
+
+        num_free += countSetBits(free_bits);
+      }
+
+      volume_manager_->releaseReadSector(start_sector_ + cur_block);
+    }
+
+    free_bits_of_block_[cur_block] = num_free;
+    num_free_bits_ += num_free;
+  }
+}
+
+bitmap_t FsBitmap::findFreeBits(bitmap_t num_bits, bitmap_t from, bitmap_t to) const
+{
+  bitmap_t run_start = 0;
+  bitmap_t run_length = 0;
+
+  bitmap_t cur_bit = from;
+
+  while(cur_bit < to)
+  {
+    sector_addr_t cur_block = cur_bit / bits_per_block_;
+    bitmap_t block_start = cur_block * bits_per_block_;
+    bitmap_t num_block_bits = getNumBitsOfBlock(cur_block);
+
+    bitmap_t block_end = block_start + num_block_bits;
+    if(block_end > to)
+      block_end = to;
+
+    // full blocks break the run, free blocks continue it (no need to read them)
+    if(free_bits_of_block_[cur_block] == 0)
+    {
+      run_length = 0;
+      cur_bit = block_end;
+      continue;
+    }
+    else if(free_bits_of_block_[cur_block] == num_block_bits)
+    {
+      if(run_length == 0)
+        run_start = cur_bit;
+
+      run_length += block_end - cur_bit;
+      cur_bit = block_end;
+
+      if(run_length >= num_bits)
+        return run_start;
+
+      continue;
+    }
+
     volume_manager_->acquireSectorForReading(start_sector_ + cur_block);
 
-    char* buffer = volume_manager_->readSectorUnprotected(start_sector_ + cur_block);
+    // NOTE: the bitmap is stored little-endian, so bit n of a word is
+    // the n-th bit of the word's 4 bytes (as the in-memory reserved words,
+    // the blocks start at a word boundary)
+    const uint32* words = reinterpret_cast<const uint32*>(
+        volume_manager_->readSectorUnprotected(start_sector_ + cur_block));
+    assert(words != NULL);
 
-    for(sector_len_t i = 0; i < block_size; i++)
+    while(cur_bit < block_end && run_length < num_bits)
     {
+      bitmap_t offset = cur_bit - block_start;
+
+      // the bits of the current word from cur_bit on
+      uint32 word = (words[offset / 32] | reserved_words_[cur_bit / 32]) >> (offset % 32);
 
-      for(uint8 j = 0; j < 8; j++, cur_bit++)
+      bitmap_t remaining = 32 - offset % 32;
+      if(remaining > block_end - cur_bit)
+        remaining = block_end - cur_bit;
+
+      // length of the sequence of equal bits starting at cur_bit
+      bitmap_t length = 0;
+
+      if(word & 1)
+      {
+        length = (~word == 0) ? 32 : __builtin_ctz(~word);
+        run_length = 0;
+      }
+      else
       {
-        if(cur_bit >= num_bits_)
-        {
-          debug(FS_BITMAP, "getNumFreeBits - DONE Bitmap has %d free bits.\n", num_free_bits);
-
-          volume_manager_->releaseReadSector(start_sector_ + cur_block);
-          return num_free_bits;
-        }
-
-        if(!(buffer[i] & (1<<j)))
-        {
-          // this bit is free!
-          num_free_bits++;
-        }
+        length = (word == 0) ? 32 : __builtin_ctz(word);
+
+        if(run_length == 0)
+          run_start = cur_bit;
+
+        run_length += (length < remaining) ? length : remaining;
       }
 
+      cur_bit += (length < remaining) ? length : remaining;
     }
 
     volume_manager_->releaseReadSector(start_sector_ + cur_block);
+
+    if(run_length >= num_bits)
+      return run_start;
   }
 
-  debug(FS_BITMAP, "getNumFreeBits - DONE Bitmap has %d free bits.\n", num_free_bits);
-  return num_free_bits;
+  return -1;
+}
+
+void FsBitmap::occupyBits(bitmap_t first, bitmap_t num_bits)
+{
+  bitmap_t cur_bit = first;
+  bitmap_t end = first + num_bits;
+
+  while(cur_bit < end)
+  {
+    sector_addr_t cur_block = cur_bit / bits_per_block_;
+    bitmap_t block_end = (cur_block + 1) * bits_per_block_;
+    if(block_end > end)
+      block_end = end;
+
+    volume_manager_->acquireSectorForWriting(start_sector_ + cur_block);
+
+    char* buffer = volume_manager_->readSectorUnprotected(start_sector_ + cur_block);
+    assert(buffer != NULL);
+
+    for(bitmap_t i = cur_bit; i < block_end; i++)
+    {
+      bitmap_t offset = i % bits_per_block_;
+      buffer[offset / 8] |= (1 << (offset % 8));
+    }
+
+    // rewrite disk-block
+    volume_manager_->writeSectorUnprotected(start_sector_ + cur_block, buffer);
+    volume_manager_->releaseWriteSector(start_sector_ + cur_block);
+
+    free_bits_of_block_[cur_block] -= block_end - cur_bit;
+    num_free_bits_ -= block_end - cur_bit;
+
+    cur_bit = block_end;
+  }
+
+  next_free_hint_ = (end < num_bits_) ? end : 0;
+}
+
+void FsBitmap::reserveBits(bitmap_t first, bitmap_t num_bits)
+{
+  for(bitmap_t i = first; i < first + num_bits; i++)
+  {
+    reserved_words_[i / 32] |= (1U << (i % 32));
+    free_bits_of_block_[i / bits_per_block_]--;
+  }
+  num_free_bits_ -= num_bits;
+
+  next_free_hint_ = (first + num_bits < num_bits_) ? first + num_bits : 0;
+}
+
+bool FsBitmap::isReserved(bitmap_t index) const
+{
+  return reserved_words_[index / 32] & (1U << (index % 32));
+}
+
+bitmap_t FsBitmap::getNumBitsOfBlock(sector_addr_t block) const
+{
+  bitmap_t block_start = block * bits_per_block_;
+
+  if(block_start >= num_bits_)
+    return 0;
+
+  return (num_bits_ - block_start < bits_per_block_) ? num_bits_ - block_start : bits_per_block_;
 }
@@ -10,10 +10,13 @@
 
 #include "fs/FsLockReaderWriter.h"
 
-#include "kernel/Scheduler.h"
+#include "ArchThreads.h"
+#include "assert.h"
 
-FsLockReaderWriter::FsLockReaderWriter() : FileSystemLock(), num_readers_(0),
-    num_write_requests_(0), writer_active_(false), lock_("FsLockReaderWriter")
+FsLockReaderWriter::FsLockReaderWriter() : FileSystemLock(), state_(0),
+    num_waiting_readers_(0), num_waiting_writers_(0), read_generation_(0),
+    write_grants_(0), lock_("FsLockReaderWriter"), readers_cond_(&lock_),
+    writers_cond_(&lock_)
 {
 }
 
@@ -21,14 +24,80 @@ FsLockReaderWriter::~FsLockReaderWriter()
 {
 }
 
+uint32 FsLockReaderWriter::getState(void) const
+{
+  return *((volatile const uint32*)&state_);
+}
+
+void FsLockReaderWriter::setStateBits(uint32 bits)
+{
+  uint32 state;
+  do
+  {
+    state = getState();
+  }
+  while(ArchThreads::compareAndSwap(state_, state, state | bits) != state);
+}
+
+void FsLockReaderWriter::clearStateBits(uint32 bits)
+{
+  uint32 state;
+  do
+  {
+    state = getState();
+  }
+  while(ArchThreads::compareAndSwap(state_, state, state & ~bits) != state);
+}
+
+void FsLockReaderWriter::updateWaiters(void)
+{
+  if(num_waiting_readers_ > 0 || num_waiting_writers_ > 0)
+    setStateBits(WAITERS);
+  else
+    clearStateBits(WAITERS);
+}
+
+void FsLockReaderWriter::grantReaders(void)
+{
+  // the readers are counted here, a woken reader already owns the lock
+  ArchThreads::atomic_add(state_, num_waiting_readers_);
+  num_waiting_readers_ = 0;
+
+  read_generation_++;
+  readers_cond_.broadcast();
+}
+
+void FsLockReaderWriter::grantWriter(void)
+{
+  setStateBits(WRITER_ACTIVE);
+  num_waiting_writers_--;
+
+  write_grants_++;
+  writers_cond_.signal();
+}
+
 bool FsLockReaderWriter::acquireReadNonBlocking(void)
 {
+  uint32 state = getState();
+
+  // fast path: no writer and nobody waiting
+  while((state & (WRITER_ACTIVE | WAITERS)) == 0)
+  {
+    if(ArchThreads::compareAndSwap(state_, state, state + 1) == state)
+      return true;
+
+    state = getState();
+  }
+
+  if(state & WRITER_ACTIVE)
+    return false;
+
   MutexLock auto_lock(lock_);
 
   // no write request here, allow to enter another reader
-  if(!writer_active_ && num_write_requests_ == 0)
+  if((getState() & WRITER_ACTIVE) == 0 && num_waiting_writers_ == 0)
   {
-    num_readers_++;
+    ArchThreads::atomic_add(state_, 1);
     return true;
   }
 
@@ -38,83 +107,131 @@ bool FsLockReaderWriter::acquireReadNonBlocking(void)
 
 void FsLockReaderWriter::acquireReadBlocking(void)
 {
-  while(true)
-  {
-    lock_.acquire("acquireReadBlocking - lock acquire");
+  if(acquireReadNonBlocking())
+    return;
+
+  lock_.acquire("acquireReadBlocking - lock acquire");
 
-    if(!writer_active_ && num_write_requests_ == 0)
-    {
-      num_readers_++;
-      lock_.release("acquireReadBlocking - lock release");
-      break;
-    }
+  // from now on the state only changes with lock_ held
+  setStateBits(WAITERS);
 
-    lock_.release("acquireReadBlocking - lock release");
-    Scheduler::instance()->yield();
+  if((getState() & WRITER_ACTIVE) == 0 && num_waiting_writers_ == 0)
+  {
+    // the writer has left in the meantime
+    ArchThreads::atomic_add(state_, 1);
+  }
+  else
+  {
+    num_waiting_readers_++;
+
+    // sleeping until the lock is handed over to the readers
+    uint32 generation = read_generation_;
+    while(generation == read_generation_)
+      readers_cond_.wait();
   }
+
+  updateWaiters();
+  lock_.release("acquireReadBlocking - lock release");
 }
 
 void FsLockReaderWriter::releaseRead(void)
 {
+  uint32 state = getState();
+  assert((state & READERS_MASK) > 0);
+
+  // fast path: nobody to wake up
+  while((state & WAITERS) == 0)
+  {
+    if(ArchThreads::compareAndSwap(state_, state, state - 1) == state)
+      return;
+
+    state = getState();
+  }
+
   lock_.acquire("releaseRead - lock acquire");
-  num_readers_--;
+
+  // the last reader hands the lock over
+  if((ArchThreads::atomic_add(state_, -1) & READERS_MASK) == 1)
+  {
+    if(num_waiting_writers_ > 0)
+      grantWriter();
+    else if(num_waiting_readers_ > 0)
+      grantReaders();
+  }
+
+  updateWaiters();
   lock_.release("releaseRead - lock release");
 }
 
 bool FsLockReaderWriter::acquireWriteNonBlocking(void)
 {
-  bool ret = false;
+  // fast path: the lock is free and nobody waiting
+  if(ArchThreads::compareAndSwap(state_, 0, WRITER_ACTIVE) == 0)
+    return true;
 
-  lock_.acquire("acquireWriteNonBlocking - lock acquire");
+  if((getState() & WAITERS) == 0)
+    return false;
+
+  MutexLock auto_lock(lock_);
 
   // no readers AND no writer here
-  if(num_readers_ == 0 && writer_active_ == false)
+  if((getState() & ~WAITERS) == 0)
   {
     // we have the lock!
-    writer_active_ = true;
-    ret = true;
+    setStateBits(WRITER_ACTIVE);
+    return true;
   }
-  lock_.release("acquireWriteNonBlocking - lock release");
 
-  return ret;
+  return false;
 }
 
 void FsLockReaderWriter::acquireWriteBlocking(void)
 {
+  if(ArchThreads::compareAndSwap(state_, 0, WRITER_ACTIVE) == 0)
+    return;
+
   // request exclusive access!
   lock_.acquire("acquireWriteBlocking - lock acquire");
-  num_write_requests_++;
-  lock_.release("acquireWriteBlocking - lock release");
-
-  // waiting for the lock
-  while(true)
-  {
-    lock_.acquire("acquireWriteBlocking - lock acquire");
 
-    bool access_gained = false;
+  // from now on the state only changes with lock_ held
+  setStateBits(WAITERS);
 
-    // lock has became available
-    if(writer_active_ == false && num_readers_ == 0)
-    {
-      // we are now the write; one request less
-      writer_active_ = true;
-      num_write_requests_--;
-      access_gained = true;
-    }
-    lock_.release("acquireWriteBlocking - lock release");
+  if((getState() & ~WAITERS) == 0)
+  {
+    // the lock has become available in the meantime
+    setStateBits(WRITER_ACTIVE);
+  }
+  else
+  {
+    num_waiting_writers_++;
 
-    if(access_gained == true)
-      break;
+    // sleeping until the lock is handed over to a writer
+    while(write_grants_ == 0)
+      writers_cond_.wait();
 
-    // next one to go ...
-    Scheduler::instance()->yield();
+    write_grants_--;
   }
+
+  updateWaiters();
+  lock_.release("acquireWriteBlocking - lock release");
 }
 
 void FsLockReaderWriter::releaseWrite(void)
 {
+  // fast path: nobody to wake up
+  if(ArchThreads::compareAndSwap(state_, WRITER_ACTIVE, 0) == WRITER_ACTIVE)
+    return;
+
   lock_.acquire("releaseWrite - lock acquire");
-  writer_active_ = false;
+  clearStateBits(WRITER_ACTIVE);
+
+  // the waiting readers first, they had to wait for this writer
+  if(num_waiting_readers_ > 0)
+    grantReaders();
+  else if(num_waiting_writers_ > 0)
+    grantWriter();
+
+  updateWaiters();
   lock_.release("releaseWrite - lock release");
 }
 
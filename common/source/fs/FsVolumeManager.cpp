@@ -24,8 +24,11 @@ FsVolumeManager::FsVolumeManager(FileSystem* file_system, FsDevice* device,
 {
   debug(VOLUME_MANAGER, "FsVolumeManager() - constructor\n");
 
-  // create volume's sector cache with the help of the passed factory
-  dev_sector_cache_ = cache_factory->getNewCache(device, cache_max_elements);
+  // create volume's sector cache with the help of the passed factory, dirty
+  // sectors are written back in the background as soon as they exceed an
+  // eighth of the cache
+  dev_sector_cache_ = cache_factory->getNewCache(device, cache_max_elements,
+                                                 cache_max_elements / 8);
 
   debug(VOLUME_MANAGER, "FsVolumeManager() - created the cache with (%d) items\n", cache_max_elements);
 }
@@ -164,10 +167,11 @@ void FsVolumeManager::acquireDataBlockForReading(sector_addr_t data_block)
   // how many sectors are giving one data-block?
   uint32 num_sectors_per_data_block = getDataBlockSize() / getBlockSize();
 
-  for(uint32 i = 0; i < num_sectors_per_data_block; i++)
-  {
-    acquireSectorForReading(file_system_->convertDataBlockToSectorAddress(data_block) + i);
-  }
+  // all sectors of the block at once, in ascending order
+  sector_addr_t first_sector = file_system_->convertDataBlockToSectorAddress(data_block);
+  debug(VOLUME_MANAGER, "acquireDataBlockForReading - sectors (%d) - (%d)\n", first_sector,
+        first_sector + num_sectors_per_data_block - 1);
+  sector_lock_manager_.acquireReadBlocking(first_sector, num_sectors_per_data_block);
 }
 
 void FsVolumeManager::acquireDataBlockForWriting(sector_addr_t data_block)
@@ -178,10 +182,11 @@ void FsVolumeManager::acquireDataBlockForWriting(sector_addr_t data_block)
   // how many sectors are giving one data-block?
   uint32 num_sectors_per_data_block = getDataBlockSize() / getBlockSize();
 
-  for(uint32 i = 0; i < num_sectors_per_data_block; i++)
-  {
-    acquireSectorForWriting(file_system_->convertDataBlockToSectorAddress(data_block) + i);
-  }
+  // all sectors of the block at once, in ascending order
+  sector_addr_t first_sector = file_system_->convertDataBlockToSectorAddress(data_block);
+  debug(VOLUME_MANAGER, "acquireDataBlockForWriting - sectors (%d) - (%d)\n", first_sector,
+        first_sector + num_sectors_per_data_block - 1);
+  sector_lock_manager_.acquireWriteBlocking(first_sector, num_sectors_per_data_block);
 }
 
 void FsVolumeManager::releaseReadDataBlock(sector_addr_t data_block, uint32 num_ref_releases)
@@ -214,24 +219,75 @@ void FsVolumeManager::releaseWriteDataBlock(sector_addr_t data_block, uint32 num
 
 char* FsVolumeManager::readDataBlockUnprotected(sector_addr_t data_block)
 {
-  if(getDataBlockSize() % getBlockSize() != 0)
+  DataBlockView view;
+  if(!readDataBlockViewUnprotected(data_block, view))
     return NULL;
 
+  // the buffer holding the read data
+  char* buffer = new char[getDataBlockSize()];
+  view.copyOut(buffer, 0, getDataBlockSize());
+
+  return buffer;
+}
+
+bool FsVolumeManager::readDataBlockViewUnprotected(sector_addr_t data_block, DataBlockView& view)
+{
+  if(getDataBlockSize() % getBlockSize() != 0)
+    return false;
+
   sector_len_t block_size = getBlockSize();
 
   // how many sectors are giving one data-block?
   uint32 num_sectors_per_data_block = getDataBlockSize() / block_size;
 
-  // the buffer holding the read data
-  char* buffer = new char[getDataBlockSize()];
+  view.resize(num_sectors_per_data_block);
+
+  sector_addr_t first_sector = file_system_->convertDataBlockToSectorAddress(data_block);
 
   for(uint32 i = 0; i < num_sectors_per_data_block; i++)
   {
-    char* temp = readSectorUnprotected( file_system_->convertDataBlockToSectorAddress(data_block) + i );
-    memcpy(buffer + (i*block_size), temp, block_size);
+    view.sectors_[i] = readSectorUnprotected(first_sector + i);
+
+    if(view.sectors_[i] == NULL)
+    {
+      // drop the references taken so far
+      for(uint32 j = 0; j < i; j++)
+        decrRefCounterOfCacheElements(first_sector + j, 1);
+
+      return false;
+    }
   }
 
-  return buffer;
+  view.num_sectors_ = num_sectors_per_data_block;
+  view.sector_size_ = block_size;
+
+  return true;
+}
+void FsVolumeManager::readAheadDataBlocks(const sector_addr_t* data_blocks, uint32 num_data_blocks)
+{
+  if(getDataBlockSize() % getBlockSize() != 0 || num_data_blocks == 0)
+    return;
+
+  // how many sectors are giving one data-block?
+  uint32 num_sectors_per_data_block = getDataBlockSize() / getBlockSize();
+  uint32 num_sectors = num_data_blocks * num_sectors_per_data_block;
+
+  const Cache::ItemIdentity** idents = new const Cache::ItemIdentity*[num_sectors];
+
+  for(uint32 i = 0; i < num_data_blocks; i++)
+  {
+    sector_addr_t first_sector = file_system_->convertDataBlockToSectorAddress(data_blocks[i]);
+
+    for(uint32 j = 0; j < num_sectors_per_data_block; j++)
+      idents[i*num_sectors_per_data_block + j] = new SectorCacheIdent(first_sector + j, getBlockSize());
+  }
+
+  debug(VOLUME_MANAGER, "readAheadDataBlocks - reading ahead %d sectors\n", num_sectors);
+  dev_sector_cache_->prefetchItems(idents, num_sectors);
+
+  for(uint32 i = 0; i < num_sectors; i++)
+    delete idents[i];
+  delete[] idents;
 }
 
 void FsVolumeManager::updateSectorData(sector_addr_t sector, const char* block, sector_len_t offset)
@@ -283,6 +339,12 @@ bool FsVolumeManager::writeDataBlockUnprotected(sector_addr_t data_block, const
 void FsVolumeManager::flush(void)
 {
   dev_sector_cache_->flush();
+  device_->flushCache();
+}
+
+bool FsVolumeManager::flushDeviceCache(void)
+{
+  return device_->flushCache();
 }
 
 bool FsVolumeManager::synchronizeSector(sector_addr_t sector)
@@ -296,3 +358,65 @@ void FsVolumeManager::getCacheStat(Cache::CacheStat& stats)
 {
   dev_sector_cache_->getStats(stats);
 }
+
+//------------------------------------------------------------------------------
+//
+//------------------------------------------------------------------------------
+
+DataBlockView::DataBlockView() : sectors_(inline_sectors_), num_sectors_(0), sector_size_(0)
+{
+}
+
+DataBlockView::~DataBlockView()
+{
+  if(sectors_ != inline_sectors_)
+    delete[] sectors_;
+}
+
+void DataBlockView::resize(uint32 num_sectors)
+{
+  if(sectors_ != inline_sectors_)
+    delete[] sectors_;
+
+  if(num_sectors > INLINE_SECTORS)
+    sectors_ = new char*[num_sectors];
+  else
+    sectors_ = inline_sectors_;
+
+  num_sectors_ = 0;
+}
+
+uint32 DataBlockView::getNumSectors(void) const
+{
+  return num_sectors_;
+}
+
+const char* DataBlockView::getSector(uint32 index) const
+{
+  if(index >= num_sectors_)
+    return NULL;
+
+  return sectors_[index];
+}
+
+void DataBlockView::copyOut(char* dest, sector_len_t offset, sector_len_t len) const
+{
+  assert(offset + len <= num_sectors_ * sector_size_);
+
+  while(len > 0)
+  {
+    uint32 index = offset / sector_size_;
+    sector_len_t sector_offset = offset % sector_size_;
+
+    // copy up to the end of the current sector
+    sector_len_t num_bytes = sector_size_ - sector_offset;
+    if(num_bytes > len)
+      num_bytes = len;
+
+    memcpy(dest, sectors_[index] + sector_offset, num_bytes);
+
+    dest += num_bytes;
+    offset += num_bytes;
+    len -= num_bytes;
+  }
+}
@@ -22,7 +22,7 @@
 #endif
 
 FsWorkingDirectory::FsWorkingDirectory() : working_dir_path_(NULL), working_dir_(NULL),
-    root_dir_path_(NULL), root_dir_(NULL)
+    root_dir_path_(NULL), root_dir_(NULL), fd_table_()
 {
   // initalise root-directory to the VFS-root
   changeRootDir(NULL);
@@ -31,11 +31,18 @@ FsWorkingDirectory::FsWorkingDirectory() : working_dir_path_(NULL), working_dir_
 
 FsWorkingDirectory::FsWorkingDirectory(const FsWorkingDirectory& cpy) :
     working_dir_path_(NULL), working_dir_(NULL),
-    root_dir_path_(NULL), root_dir_(NULL)
+    root_dir_path_(NULL), root_dir_(NULL), fd_table_()
 {
   if(cpy.working_dir_path_ != NULL)
   {
     working_dir_path_ = strdup(cpy.working_dir_path_);
+
+    // the copy needs it's own reference to the pinned Directory
+    if(cpy.working_dir_ != NULL)
+    {
+      FileSystem* fs = cpy.working_dir_->getFileSystem();
+      working_dir_ = static_cast<Directory*>(fs->acquireInode(cpy.working_dir_->getID(), NULL, cpy.working_dir_->getName()));
+    }
   }
   else
   {
@@ -56,11 +63,14 @@ FsWorkingDirectory::~FsWorkingDirectory()
 {
   debug(FILE_SYSTEM, "~FsWorkingDirectory - CALL\n");
 
+  // closing the files the Thread / Process left open
+  fd_table_.clear();
+
   deleteRootString();
   deleteWorkingString();
 }
 
-int32 FsWorkingDirectory::setWorkingDir(const char* working_dir)
+int32 FsWorkingDirectory::setWorkingDir(const char* working_dir, Directory* working_dir_inode)
 {
   debug(FILE_SYSTEM, "setWorkingDir - CALL\n");
 
@@ -134,6 +144,9 @@ int32 FsWorkingDirectory::setWorkingDir(const char* working_dir)
     }
   }
 
+  // the old Directory was released together with the old path
+  working_dir_ = working_dir_inode;
+
   debug(FILE_SYSTEM, "setWorkingDir - DONE new wd \"%s\"\n", working_dir_path_);
 
   return 0;
@@ -152,12 +165,10 @@ const char* FsWorkingDirectory::getWorkingDirPath(void) const
   return working_dir_path_;
 }
 
-/*
 Directory* FsWorkingDirectory::getWorkingDir(void)
 {
   return working_dir_;
 }
-*/
 
 void FsWorkingDirectory::changeRootDir(const char* new_root_dir)
 {
@@ -210,6 +221,11 @@ Directory* FsWorkingDirectory::getRootDir(void)
 }
 */
 
+FileDescriptorTable* FsWorkingDirectory::getFileDescriptorTable(void)
+{
+  return &fd_table_;
+}
+
 void FsWorkingDirectory::deleteRootString(void)
 {
   if(root_dir_path_ != NULL)
@@ -223,6 +239,7 @@ void FsWorkingDirectory::deleteRootString(void)
     // decrement reference count of I-Node
     FileSystem* fs = root_dir_->getFileSystem();
     fs->releaseInode(root_dir_);
+    root_dir_ = NULL;
   }
 }
 
@@ -245,5 +262,6 @@ void FsWorkingDirectory::deleteWorkingString(void)
     // decrement reference count of I-Node
     FileSystem* fs = working_dir_->getFileSystem();
     fs->releaseInode(working_dir_);
+    working_dir_ = NULL;
   }
 }
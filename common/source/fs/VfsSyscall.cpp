@@ -10,6 +10,7 @@
 #include "mm/kmalloc.h"
 #else
 #include <cstring>
+#include <ctime>
 #include <assert.h>
 #endif
 
@@ -25,6 +26,7 @@
 #include "fs/Dirent.h"
 #include "fs/DIR.h"
 #include "fs/Statfs.h"
+#include "fs/IoVector.h"
 
 #include "fs/device/FsDevice.h"
 #include "fs/device/FsDeviceVirtual.h"
@@ -64,7 +66,8 @@ VfsSyscall* VfsSyscall::instance()
 }
 
 VfsSyscall::VfsSyscall(char path_separator) : PATH_SEPARATOR(path_separator),
-     mounted_fs_(), mount_lock_("vfs_mounts_lock"), root_(NULL), fs_pool_()
+     mounted_fs_(), mount_lock_("vfs_mounts_lock"), root_(NULL), fs_pool_(),
+     dentry_cache_()
 {
   LAST_DEFINED_PATH_SEPARATOR = path_separator;
   debug(VFSSYSCALL, "starting to create VfsSyscall Singleton-instance\n");
@@ -93,7 +96,7 @@ int32 VfsSyscall::initRootFs(void)
   debug(VFSSYSCALL, "root file system partition identifier=%x\n", bddev->getPartitionType());
 
   // create the root-file system
-  root_ = fs_pool_.getNewFsInstance(root_fs_dev, bddev->getPartitionType(), /*MS_SYNCHRONOUS |*/ MS_NOATIME);
+  root_ = fs_pool_.getNewFsInstance(root_fs_dev, bddev->getPartitionType(), /*MS_SYNCHRONOUS |*/ MS_NOATIME | MS_CACHE_2Q);
 
   // failed to create the root-file system
   if(root_ == NULL)
@@ -122,6 +125,8 @@ void VfsSyscall::unmountRoot(void)
     }
   }
 
+  dentry_cache_.clear();
+
   delete root_;
   root_ = NULL;
   mount_lock_.release("VfsSyscall::unmountRoot");
@@ -130,7 +135,8 @@ void VfsSyscall::unmountRoot(void)
 #else
 
 VfsSyscall::VfsSyscall(FsDevice* fs_device, uint8 partition_type,
-    char path_separator) : PATH_SEPARATOR(path_separator), root_(NULL), fs_pool_()
+    char path_separator) : PATH_SEPARATOR(path_separator), root_(NULL), fs_pool_(),
+    dentry_cache_()
 {
   // create root-fs instance
   root_ = fs_pool_.getNewFsInstance(fs_device, partition_type, MS_NOATIME);
@@ -143,6 +149,7 @@ VfsSyscall::~VfsSyscall()
 {
   if(root_ != NULL)
   {
+    dentry_cache_.clear();
     delete root_;
   }
 }
@@ -257,6 +264,9 @@ int32 VfsSyscall::mkdir(FsWorkingDirectory* wd_info, const char* pathname, mode_
   unix_time_stamp current_time = getCurrentTimeStamp();
   inode_id_t new_dir_id = 0;
 
+  // there might be a negative entry for the new name
+  dentry_cache_.invalidate(parent, folder_name);
+
   // delegate mkdir() call to the file-system in charge
   int32 ret_val = fs->mkdir(parent, folder_name, current_time, mode, 0, 0, new_dir_id);
 
@@ -338,6 +348,10 @@ int32 VfsSyscall::rmdir ( FsWorkingDirectory* wd_info, const char* pathname )
     return FS_ERROR_DIR_NOT_EMPTY; // ENOTEMPTY
   }
 
+  // forget the name and everything cached inside of the Directory
+  dentry_cache_.invalidate(parent, folder_name);
+  dentry_cache_.invalidateDirectory(dir_to_rm);
+
   // delegate rmdir() call to the file-system in charge
   int32 ret_val = fs->rmdir(parent, dir_to_rm->getID(), folder_name);
 
@@ -420,6 +434,9 @@ int32 VfsSyscall::link(FsWorkingDirectory* wd_info, const char* oldpath, const c
   // mutual exclusion for the parent-directory
   file_to_link->getLock()->acquireWriteBlocking();
 
+  // there might be a negative entry for the new name
+  dentry_cache_.invalidate(parent, filename);
+
   // delegate call to the FS in charge
   int32 ret_val = fs->link(file_to_link, parent, filename);
 
@@ -498,6 +515,9 @@ int32 VfsSyscall::unlink(FsWorkingDirectory* wd_info, const char *pathname)
   // lock file to unlink
   file_to_unlink->getLock()->acquireWriteBlocking();
 
+  // the cached entry must not outlive the link
+  dentry_cache_.invalidate(parent, filename);
+
   // delegate unlink call
   int32 ret_val = fs->unlink(file_to_unlink, parent, filename);
 
@@ -561,15 +581,18 @@ Dirent* VfsSyscall::readdir ( FsWorkingDirectory* wd_info __attribute__((unused)
   // assert mutual exclusion:
   FsWriteSmartLock write_auto_lock( dirp->dir_->getLock() );
 
-  Inode* child = dirp->dir_->getInode( dirp->cursor_pos );
-  if(child == NULL)
+  // the child itself is not loaded, the index already knows the name and ID
+  const char* child_name = NULL;
+  inode_id_t child_id = 0;
+
+  if(!dirp->dir_->getNextChild(dirp->cursor_pos, child_name, child_id))
   {
     debug(VFSSYSCALL, "readdir - end of directory\n");
     return NULL; // end of directory reached
   }
 
   // gathering informations about the current node
-  Dirent* dirent = new Dirent(child->getID(), child->getName());
+  Dirent* dirent = new Dirent(child_id, child_name);
 
   if(dirent != NULL && dirp->dir_->doUpdateAccessTime())
   {
@@ -577,12 +600,6 @@ Dirent* VfsSyscall::readdir ( FsWorkingDirectory* wd_info __attribute__((unused)
     dirp->dir_->updateAccessTime( getCurrentTimeStamp() );
   }
 
-  // increment cursor pos
-  dirp->cursor_pos++;
-
-  // release lock and cache-reference
-  child->getFileSystem()->releaseInode(child);
-
   debug(VFSSYSCALL, "readdir - OK\n");
   return dirent;
 }
@@ -625,16 +642,18 @@ int32 VfsSyscall::chdir ( FsWorkingDirectory* wd_info, const char* pathname )
     return -1;
   }
 
-#ifndef USE_FILE_SYSTEM_ON_GUEST_OS
-  if(VfsSyscall::instance()->resolveDirectory(wd_info, pathname) == NULL)
+  Directory* new_wd = resolveDirectory(wd_info, pathname);
+
+  if(new_wd == NULL)
   {
     debug(VFSSYSCALL, "Invalid path \"%s\"\n", pathname);
     return -1;
   }
-#endif
 
+  // the working-directory keeps the reference, so relative paths do not
+  // have to resolve it again
   debug(VFSSYSCALL, "chdir - changing current directory to \"%s\"\n", pathname);
-  return wd_info->setWorkingDir(pathname);
+  return wd_info->setWorkingDir(pathname, new_wd);
 }
 
 const char* VfsSyscall::getwd(FsWorkingDirectory* wd_info) const
@@ -701,10 +720,10 @@ int32 VfsSyscall::open(FsWorkingDirectory* wd_info, const char* pathname, int32
     return -1;
   }
 
-  FileDescriptor::add(fd);
-  debug(VFSSYSCALL, "open() - FD nr is=%d!\n", fd->getFd());
+  fd_size_t fd_num = wd_info->getFileDescriptorTable()->add(fd);
+  debug(VFSSYSCALL, "open() - FD nr is=%d!\n", fd_num);
 
-  return fd->getFd();
+  return fd_num;
 }
 
 FileDescriptor* VfsSyscall::createFDForFile(File* file, uint32 flag)
@@ -808,6 +827,9 @@ File* VfsSyscall::createFile(FsWorkingDirectory* wd_info, const char* pathname,
     }
   }
 
+  // there might be a negative entry for the new name
+  dentry_cache_.invalidate(parent, filename);
+
   // create new file in resolved parent directory
   File* new_file = fs->creat(parent, filename, mode, 0, 0);
 
@@ -838,11 +860,11 @@ File* VfsSyscall::createFile(FsWorkingDirectory* wd_info, const char* pathname,
   return new_file;
 }
 
-int32 VfsSyscall::close(FsWorkingDirectory* wd_info __attribute__((unused)), uint32 fd)
+int32 VfsSyscall::close(FsWorkingDirectory* wd_info, uint32 fd)
 {
   debug(VFSSYSCALL, "close() - INFO - closing FD\n");
 
-  if(!FileDescriptor::remove(fd))
+  if(!wd_info->getFileDescriptorTable()->remove(fd))
   {
     return -1; // EBADF
   }
@@ -851,74 +873,162 @@ int32 VfsSyscall::close(FsWorkingDirectory* wd_info __attribute__((unused)), uin
   return 0;
 }
 
-int32 VfsSyscall::read ( FsWorkingDirectory* wd_info __attribute__((unused)), fd_size_t fd, char* buffer, size_t count )
+FileDescriptor* VfsSyscall::getFileDescriptor(FsWorkingDirectory* wd_info, fd_size_t fd,
+                                              bool for_writing, const char* caller)
 {
-  debug(VFSSYSCALL, "read() - call\n");
-
   // translating the integer into a FileDescriptor object:
-  FileDescriptor* fd_object = FileDescriptor::getFileDescriptor(fd);
+  FileDescriptor* fd_object = wd_info->getFileDescriptorTable()->get(fd);
 
   if(fd_object == NULL)
   {
-    debug(VFSSYSCALL, "read() - invalid FD\n");
-    return -1; //
+    debug(VFSSYSCALL, "%s() - invalid FD\n", caller);
+    return NULL;
+  }
+
+  assert(fd_object->getFile() != NULL);
+
+  if(for_writing && !fd_object->writeMode())
+  {
+    debug(VFSSYSCALL, "%s() - no write-rights on the file.\n", caller);
+    return NULL;
+  }
+
+  if(!for_writing && !fd_object->readMode())
+  {
+    debug(VFSSYSCALL, "%s() - no read-rights on the file.\n", caller);
+    return NULL;
   }
 
+  return fd_object;
+}
+
+void VfsSyscall::synchronizeWrite(FileDescriptor* fd_object, int32 bytes_written)
+{
   File* file = fd_object->getFile();
-  assert(file != NULL);
 
-  if(!fd_object->readMode())
+  // if the FileSystem does not use a write-trough cache and the write
+  // operation was successful (writing at least one byte) AND the open()
+  // call has the O_SYNC flag specified, then sync the File with the FileSystem
+  if(!(file->getFileSystem()->getMountFlags() & MS_SYNCHRONOUS)
+      && fd_object->synchronizeMode() && bytes_written > 0)
   {
-    debug(VFSSYSCALL, "read() - no read-rights on the file.\n");
-    return -1;
+    file->getFileSystem()->fsync(file);
   }
+}
+
+int32 VfsSyscall::read ( FsWorkingDirectory* wd_info, fd_size_t fd, char* buffer, size_t count )
+{
+  debug(VFSSYSCALL, "read() - call\n");
+
+  FileDescriptor* fd_object = getFileDescriptor(wd_info, fd, false, "read");
+  if(fd_object == NULL)
+    return -1;
 
   // read from file and return
-  return file->read(fd_object, buffer, count);
+  return fd_object->getFile()->read(fd_object, buffer, count);
 }
 
-int32 VfsSyscall::write ( FsWorkingDirectory* wd_info __attribute__((unused)), fd_size_t fd, const char *buffer, size_t count )
+int32 VfsSyscall::write ( FsWorkingDirectory* wd_info, fd_size_t fd, const char *buffer, size_t count )
 {
   debug(VFSSYSCALL, "write - CALL writing %d bytes to fd=%d\n", count, fd);
 
-  // translating the integer into a FileDescriptor object:
-  FileDescriptor* fd_object = FileDescriptor::getFileDescriptor(fd);
+  FileDescriptor* fd_object = getFileDescriptor(wd_info, fd, true, "write");
+  if(fd_object == NULL)
+    return -1;
 
+  // write to file and return
+  int32 bytes_written = fd_object->getFile()->write(fd_object, buffer, count);
+  synchronizeWrite(fd_object, bytes_written);
+
+  return bytes_written;
+}
+
+int32 VfsSyscall::pread ( FsWorkingDirectory* wd_info, fd_size_t fd, char* buffer, size_t count, l_off_t offset )
+{
+  debug(VFSSYSCALL, "pread() - reading %d bytes at %d from fd=%d\n", count, offset, fd);
+
+  FileDescriptor* fd_object = getFileDescriptor(wd_info, fd, false, "pread");
   if(fd_object == NULL)
-  {
-    debug(VFSSYSCALL, "write() - invalid FD\n");
-    return -1; //
-  }
+    return -1;
 
-  File* file = fd_object->getFile();
+  return fd_object->getFile()->pread(fd_object, buffer, count, offset);
+}
 
-  if(!fd_object->writeMode())
-  {
-    debug(VFSSYSCALL, "write() - no write-rights on the file.\n");
+int32 VfsSyscall::pwrite ( FsWorkingDirectory* wd_info, fd_size_t fd, const char *buffer, size_t count, l_off_t offset )
+{
+  debug(VFSSYSCALL, "pwrite() - writing %d bytes at %d to fd=%d\n", count, offset, fd);
+
+  FileDescriptor* fd_object = getFileDescriptor(wd_info, fd, true, "pwrite");
+  if(fd_object == NULL)
     return -1;
-  }
 
-  // write to file and return
-  int32 bytes_written = file->write(fd_object, buffer, count);
+  int32 bytes_written = fd_object->getFile()->pwrite(fd_object, buffer, count, offset);
+  synchronizeWrite(fd_object, bytes_written);
 
-  // if the FileSystem does not use a write-trough cache and the write
-  // operation was successful (writing at least one byte) AND the open()
-  // call has the O_SYNC flag specified, then sync the File with the FileSystem
-  if(!(file->getFileSystem()->getMountFlags() & MS_SYNCHRONOUS)
-      && fd_object->synchronizeMode() && bytes_written > 0)
+  return bytes_written;
+}
+
+int32 VfsSyscall::readv ( FsWorkingDirectory* wd_info, fd_size_t fd, const iovec_s* iov, uint32 iov_count )
+{
+  debug(VFSSYSCALL, "readv() - reading %d buffers from fd=%d\n", iov_count, fd);
+
+  if(iov_count > IOV_MAX)
+    return -1; // EINVAL
+
+  FileDescriptor* fd_object = getFileDescriptor(wd_info, fd, false, "readv");
+  if(fd_object == NULL)
+    return -1;
+
+  return fd_object->getFile()->readv(fd_object, iov, iov_count);
+}
+
+int32 VfsSyscall::writev ( FsWorkingDirectory* wd_info, fd_size_t fd, const iovec_s* iov, uint32 iov_count )
+{
+  debug(VFSSYSCALL, "writev() - writing %d buffers to fd=%d\n", iov_count, fd);
+
+  if(iov_count > IOV_MAX)
+    return -1; // EINVAL
+
+  FileDescriptor* fd_object = getFileDescriptor(wd_info, fd, true, "writev");
+  if(fd_object == NULL)
+    return -1;
+
+  int32 bytes_written = fd_object->getFile()->writev(fd_object, iov, iov_count);
+  synchronizeWrite(fd_object, bytes_written);
+
+  return bytes_written;
+}
+
+FileDescriptor* VfsSyscall::getFileDescriptorForMapping ( FsWorkingDirectory* wd_info, fd_size_t fd, bool for_writing )
+{
+  debug(VFSSYSCALL, "getFileDescriptorForMapping() - mapping fd=%d\n", fd);
+
+  // a mapping always reads the file
+  FileDescriptor* fd_object = getFileDescriptor(wd_info, fd, false, "mmap");
+  if(fd_object == NULL)
+    return NULL;
+
+  if(for_writing && !fd_object->writeMode())
   {
-    file->getFileSystem()->fsync(file);
+    debug(VFSSYSCALL, "mmap() - no write-rights on the file.\n");
+    return NULL;
   }
 
-  return bytes_written;
+  if(fd_object->getFile()->getType() != Inode::InodeTypeFile)
+  {
+    debug(VFSSYSCALL, "mmap() - only regular files can be mapped.\n");
+    return NULL;
+  }
+
+  return new FileDescriptor(*fd_object);
 }
 
-l_off_t VfsSyscall::lseek ( FsWorkingDirectory* wd_info __attribute__((unused)), fd_size_t fd, l_off_t offset, uint8 whence )
+l_off_t VfsSyscall::lseek ( FsWorkingDirectory* wd_info, fd_size_t fd, l_off_t offset, uint8 whence )
 {
   debug(VFSSYSCALL, "lseek() - seeking fd(%d) by=%d whence=%d\n", fd, offset, whence);
 
   // translating the integer into a FileDescriptor object:
-  FileDescriptor* fd_object = FileDescriptor::getFileDescriptor(fd);
+  FileDescriptor* fd_object = wd_info->getFileDescriptorTable()->get(fd);
 
   if(fd_object == NULL)
   {
@@ -973,12 +1083,12 @@ void VfsSyscall::sync(FsWorkingDirectory* wd_info __attribute__((unused)))
 #endif
 }
 
-int32 VfsSyscall::fsync(FsWorkingDirectory* wd_info __attribute__((unused)), int32 fd)
+int32 VfsSyscall::fsync(FsWorkingDirectory* wd_info, int32 fd)
 {
   debug(VFSSYSCALL, "fsync() - CALL\n");
 
   // resolve int-fd into object
-  FileDescriptor* fd_object = FileDescriptor::getFileDescriptor(fd);
+  FileDescriptor* fd_object = wd_info->getFileDescriptorTable()->get(fd);
 
   if(fd_object == NULL)
   {
@@ -1107,17 +1217,42 @@ bool VfsSyscall::isOperationPermitted(Inode* inode, int32 operation)
     return false;
   }
 
+  // searching a Directory is decided on it's attributes only, the same
+  // rule is applied to the Directories passed by DentryCache::walk()
+  if( operation == EXECUTE && inode->getType() == Inode::InodeTypeDirectory )
+    return isSearchPermitted(fs, inode->getUID(), inode->getGID(), inode->getPermissions());
+
   // TODO implement UserRights here!
 
   return true;
 }
 
+bool VfsSyscall::isSearchPermitted(FileSystem* fs __attribute__((unused)), uint32 uid __attribute__((unused)),
+                                   uint32 gid __attribute__((unused)), uint32 permissions __attribute__((unused)))
+{
+  // there are no user rights yet (see isOperationPermitted()), this is the
+  // single place the search check will go to
+  return true;
+}
+
 bool VfsSyscall::diskQuotaNotExceeded()
 {
   // TODO implement disk-quota checking here
   return true;
 }
 
+Inode* VfsSyscall::lookupChild(Directory* dir, const char* name)
+{
+  // an invalidation while looking up the child makes the result
+  // unsuitable for caching, so the generation has to be read before
+  uint32 generation = dentry_cache_.getGeneration();
+
+  Inode* child = dir->getFileSystem()->lookup(dir, name);
+  dentry_cache_.insert(dir, name, child, generation);
+
+  return child;
+}
+
 Inode* VfsSyscall::resolvePath(FsWorkingDirectory* wd_info, const char* path)
 {
   if(path == NULL)
@@ -1158,7 +1293,18 @@ Inode* VfsSyscall::resolvePath(FsWorkingDirectory* wd_info, const char* path)
     // in case of failure pick the VFS-root
     if(wd_info != NULL)
     {
-      cur_dir = resolveDirectory(NULL, wd_info->getWorkingDirPath());
+      Directory* wd = wd_info->getWorkingDir();
+
+      if(wd != NULL)
+      {
+        // the pinned working-directory, just take another reference
+        cur_dir = static_cast<Directory*>(wd->getFileSystem()->acquireInode(wd->getID(), NULL, wd->getName()));
+      }
+
+      if(cur_dir == NULL)
+      {
+        cur_dir = resolveDirectory(NULL, wd_info->getWorkingDirPath());
+      }
     }
 
     if(strlen(path) == 0)
@@ -1179,76 +1325,90 @@ Inode* VfsSyscall::resolvePath(FsWorkingDirectory* wd_info, const char* path)
   // split path into tokens
   char* path_cpy = strdup(path);
   char* path_ptr = path_cpy;
+  debug(VFSSYSCALL, "resolvePath() - duplicated path is \"%s\"\n", path_cpy);
+
+  // every token takes at least one char and one separator
+  char** path_tokens = new char*[strlen(path_cpy) / 2 + 1];
+  uint32 num_tokens = 0;
 
   char* path_token = strtok_threadsafe(&path_ptr, "/");
-  debug(VFSSYSCALL, "resolvePath() - duplicated path is \"%s\"\n", path_cpy);
+  while(path_token != NULL && strcmp(path_token, "") != 0)
+  {
+    path_tokens[num_tokens++] = path_token;
+    path_token = strtok_threadsafe(&path_ptr, "/");
+  }
 
-  while(true)
+  // the resolved I-Node, a path without tokens refers to the start
+  Inode* child = cur_dir;
+  uint32 cur_token = 0;
+
+  while(cur_token < num_tokens)
   {
-    debug(VFSSYSCALL, "resolvePath() - current path token is \"%s\"\n", path_token);
+    debug(VFSSYSCALL, "resolvePath() - current path token is \"%s\"\n", path_tokens[cur_token]);
 
     // check if the calling thread is allowed to scan the directory
     if(wd_info != NULL && !this->isOperationPermitted(cur_dir, EXECUTE))
     {
-      debug(VFSSYSCALL, "resolvePath() - ERROR calling thread is not allowed to read Directory!\n", path_token);
+      debug(VFSSYSCALL, "resolvePath() - ERROR calling thread is not allowed to read Directory!\n");
 
-      delete[] path_cpy;
-      return NULL;
+      cur_dir->getFileSystem()->releaseInode(cur_dir);
+      child = NULL;
+      break;
     }
 
-    // the FileSystem of the current-directory
-    FileSystem* cur_dir_fs = cur_dir->getFileSystem();
+    // follow the cached part of the path, the Directories in between are
+    // not even acquired, their search permission is checked by
+    // isSearchPermitted() on the attributes stored in the cache
+    uint32 num_resolved = dentry_cache_.walk(cur_dir, path_tokens + cur_token, num_tokens - cur_token,
+                                             (wd_info != NULL) ? this : NULL, child);
+
+    if(num_resolved == 0)
+    {
+      // looking up the child inode of the directory:
+      child = lookupChild(cur_dir, path_tokens[cur_token]);
+      num_resolved = 1;
+    }
 
-    // looking up the child inode of the directory:
-    Inode* child = cur_dir_fs->lookup(cur_dir, path_token);
+    cur_token += num_resolved;
 
     // release Directory I-Node
-    cur_dir_fs->releaseInode(cur_dir);
+    cur_dir->getFileSystem()->releaseInode(cur_dir);
 
     if(child == NULL)
     {
       // failed to resolve path!
       debug(VFSSYSCALL, "resolvePath() - failed to resolve path child==NULL\n");
-
-      delete[] path_cpy;
-      return NULL;
+      break;
     }
 
-    // get next token
-    path_token = strtok_threadsafe(&path_ptr, "/");
-
     // no next path token available
-    if(path_token == NULL || strcmp(path_token, "") == 0)
+    if(cur_token == num_tokens)
     {
       // just return the last resolved I-Node
       debug(VFSSYSCALL, "resolvePath() - path was successfully resolved, inode-id=%d\n", child->getID());
-
-      delete[] path_cpy;
-      return child;
+      break;
     }
-    // continue to resolve the path
-    else
-    {
-      // child has to be a Directory, otherwise it would not
-      // make sense to continue path resolving
-      if(child->getType() != Inode::InodeTypeDirectory)
-      {
-        debug(VFSSYSCALL, "resolvePath() - a part in between the path was not a Directory %d\n", child->getID());
 
-        // decrement reference counter of child-node
-        child->getFileSystem()->releaseInode(child);
-        delete[] path_cpy;
-        return NULL;
-      }
+    // child has to be a Directory, otherwise it would not
+    // make sense to continue path resolving
+    if(child->getType() != Inode::InodeTypeDirectory)
+    {
+      debug(VFSSYSCALL, "resolvePath() - a part in between the path was not a Directory %d\n", child->getID());
 
-      // update cur_dir
-      cur_dir = static_cast<Directory*>(child);
+      // decrement reference counter of child-node
+      child->getFileSystem()->releaseInode(child);
+      child = NULL;
+      break;
     }
+
+    // update cur_dir
+    cur_dir = static_cast<Directory*>(child);
   }
 
+  delete[] path_tokens;
   delete[] path_cpy;
-  // should not be reached
-  return NULL;
+
+  return child;
 }
 
 Directory* VfsSyscall::resolveDirectory(FsWorkingDirectory* wd_info, const char* path)
@@ -1407,6 +1567,9 @@ int32 VfsSyscall::mount( FsWorkingDirectory* wd_info, const char *device_name,
   // reference will not be released until umount is called
   mount_path->pushMountedFs(mounted_fs);
 
+  // the cached entries of the mount-path refer to the real Directory
+  dentry_cache_.clear();
+
   mount_path->getLock()->releaseWrite();
 
   // add FileSystem to mount-list
@@ -1450,6 +1613,10 @@ int32 VfsSyscall::umount ( FsWorkingDirectory* wd_info, const char *dir_name, in
     if(mounted_fs_[i] == mount_path->getMountedFs())
     {
       assert( mount_path->popMountedFs() );
+
+      // there must not be any entries of the removed FileSystem left
+      dentry_cache_.clear();
+
       delete mounted_fs_[i];
       mounted_fs_.erase(mounted_fs_.begin() + i);
       break;
@@ -10,6 +10,7 @@
 #include "fs/DeviceCache.h"
 
 #ifdef USE_FILE_SYSTEM_ON_GUEST_OS
+#include <cstring>
 #include "debug_print.h"
 #else
 #include "kprintf.h"
@@ -81,3 +82,96 @@ bool FsDevice::remove(const Cache::ItemIdentity& ident __attribute__((unused)),
   // physically not possible to remove a sector from a disk
   return false;
 }
+
+uint32 FsDevice::getRunLength(const Cache::ItemIdentity* const* idents, uint32 num_items)
+{
+  const SectorCacheIdent* first = static_cast<const SectorCacheIdent*>(idents[0]);
+
+  uint32 run_len = 1;
+  while(run_len < num_items && run_len < MAX_SECTORS_PER_REQUEST)
+  {
+    const SectorCacheIdent* next = static_cast<const SectorCacheIdent*>(idents[run_len]);
+    if(next->getSectorNumber() != first->getSectorNumber() + run_len ||
+       next->getSectorSize() != first->getSectorSize())
+      break;
+
+    run_len++;
+  }
+
+  return run_len;
+}
+
+void FsDevice::readItems(const Cache::ItemIdentity* const* idents, Cache::Item** items, uint32 num_items)
+{
+  uint32 i = 0;
+  while(i < num_items)
+  {
+    const SectorCacheIdent* first = static_cast<const SectorCacheIdent*>(idents[i]);
+    sector_len_t block_size = first->getSectorSize();
+
+    uint32 run_len = getRunLength(idents + i, num_items - i);
+
+    if(run_len == 1)
+    {
+      items[i] = read(*idents[i]);
+      i++;
+      continue;
+    }
+
+    debug(FS_DEVICE, "readItems - reading %d sectors starting at sector=%x\n", run_len, first->getSectorNumber());
+
+    char* buffer = new char[run_len * block_size];
+    bool success = readSector(first->getSectorNumber(), buffer, run_len * block_size);
+
+    for(uint32 j = 0; j < run_len; j++)
+    {
+      items[i + j] = NULL;
+      if(!success)
+        continue;
+
+      char* data = new char[block_size];
+      memcpy(data, buffer + j*block_size, block_size);
+      items[i + j] = new SectorCacheItem( data );
+    }
+
+    delete[] buffer;
+    i += run_len;
+  }
+}
+
+bool FsDevice::writeItems(const Cache::ItemIdentity* const* idents, Cache::Item* const* items, uint32 num_items)
+{
+  bool success = true;
+
+  uint32 i = 0;
+  while(i < num_items)
+  {
+    const SectorCacheIdent* first = static_cast<const SectorCacheIdent*>(idents[i]);
+    sector_len_t block_size = first->getSectorSize();
+
+    uint32 run_len = getRunLength(idents + i, num_items - i);
+
+    if(run_len == 1)
+    {
+      if(!write(*idents[i], items[i]))
+        success = false;
+
+      i++;
+      continue;
+    }
+
+    debug(FS_DEVICE, "writeItems - writing %d sectors starting at sector=%x\n", run_len, first->getSectorNumber());
+
+    char* buffer = new char[run_len * block_size];
+    for(uint32 j = 0; j < run_len; j++)
+      memcpy(buffer + j*block_size, items[i + j]->getData(), block_size);
+
+    if(!writeSector(first->getSectorNumber(), buffer, run_len * block_size))
+      success = false;
+
+    delete[] buffer;
+    i += run_len;
+  }
+
+  return success;
+}
@@ -96,4 +96,9 @@ sector_addr_t FsDeviceFile::getNumBlocks(void) const
   return num_blocks_;
 }
 
+bool FsDeviceFile::flushCache(void)
+{
+  return fflush(image_file_) == 0;
+}
+
 #endif // USE_FILE_SYSTEM_ON_GUEST_OS
@@ -90,4 +90,11 @@ sector_addr_t FsDeviceVirtual::getNumBlocks(void) const
   return dev_->getNumBlocks();
 }
 
+bool FsDeviceVirtual::flushCache(void)
+{
+  debug(FS_DEVICE, "flushCache - CALL\n");
+
+  return dev_->flushCache() == 0;
+}
+
 #endif // USE_FILE_SYSTEM_ON_GUEST_OS
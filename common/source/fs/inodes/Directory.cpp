@@ -11,12 +11,12 @@
 
 #ifdef USE_FILE_SYSTEM_ON_GUEST_OS
 #include "debug_print.h"
-#define STL_NAMESPACE_PREFIX        std::
 #else
 #include "kprintf.h"
-#define STL_NAMESPACE_PREFIX        ustl::
 #endif
 
+OBJECT_CACHE_DEFINITIONS(Directory)
+
 Directory::Directory(inode_id_t inode_number,
                      sector_addr_t device_sector, sector_len_t sector_offset,
                      FileSystem* file_system,
@@ -25,7 +25,7 @@ Directory::Directory(inode_id_t inode_number,
                      uint32 ref_count, file_size_t size) :
     Inode(inode_number, device_sector, sector_offset, file_system,
           access_time, mod_time, c_time, ref_count, size),
-    all_children_loaded_(false), mounted_fs_()
+    all_children_loaded_(false), children_(), mounted_fs_()
 {
 }
 
@@ -34,7 +34,7 @@ Directory::Directory(inode_id_t inode_number, FileSystem* file_system,
               unix_time_stamp mod_time,
               unix_time_stamp c_time) : Inode(inode_number, 0, 0, file_system,
                   access_time, mod_time, c_time),
-    all_children_loaded_(false), mounted_fs_()
+    all_children_loaded_(false), children_(), mounted_fs_()
 {
 }
 
@@ -84,107 +84,55 @@ Inode* Directory::getInode(const char* filename)
 
   debug(FS_INODE, "getInode - getting child inode \"%s\"\n", filename);
 
-  // finding an I-Node with that given filename
-  for(ChildrenIterator it = children_.begin(); it != children_.end(); it++)
-  {
-    debug(FS_INODE, "getInode - child \"%s\"\n", (*it).first.c_str());
-
-    if((*it).first == filename)
-    {
-      // I-Node does exists in the Directory, resolve the ID to the I-Node object
-      return obtainInode(it->second, filename);
-    }
-  }
+  inode_id_t inode_id;
+  if(!children_.find(filename, inode_id))
+    return NULL;
 
-  return NULL;
+  // I-Node does exists in the Directory, resolve the ID to the I-Node object
+  return obtainInode(inode_id, filename);
 }
 
-Inode* Directory::getInode(uint32 index)
+bool Directory::getNextChild(uint32& cursor, const char*& filename, inode_id_t& inode_id) const
 {
-  // invalid index!
-  if(index >= getNumChildren())
-    return NULL;
-
-  uint32 num = 0;
-  for(ChildrenIterator it = children_.begin(); it != children_.end(); it++, num++)
-  {
-    debug(FS_INODE, "getInode - child \"%s\"\n", (*it).first.c_str());
-
-    if(num == index)
-    {
-      debug(FS_INODE, "getInode - request to load the i-node from the FS\n");
-
-      Inode* inode = obtainInode(it->second, it->first.c_str());
-
-      // setting additional name informations for the readdir() call
-      if(inode != NULL)
-      {
-        inode->setName(it->first.c_str());
-      }
-      return inode;
-    }
-  }
-
-  // i-node not available
-  return NULL;
+  return children_.getNext(cursor, filename, inode_id);
 }
 
 Inode* Directory::getRealInode(const char* filename)
 {
   if(filename == NULL) return NULL;
 
-  debug(FS_INODE, "getInode - getting child inode \"%s\"\n", filename);
-
-  // finding an I-Node with that given filename
-  for(ChildrenIterator it = children_.begin(); it != children_.end(); it++)
-  {
-    debug(FS_INODE, "getInode - child \"%s\"\n", (*it).first.c_str());
+  debug(FS_INODE, "getRealInode - getting child inode \"%s\"\n", filename);
 
-    if((*it).first == filename)
-    {
-      // I-Node does exists in the Directory, resolve the ID to the I-Node object
-      return file_system_->acquireInode(it->second, this, filename);
-    }
-  }
+  inode_id_t inode_id;
+  if(!children_.find(filename, inode_id))
+    return NULL;
 
-  return NULL;
+  // I-Node does exists in the Directory, resolve the ID to the I-Node object
+  return file_system_->acquireInode(inode_id, this, filename);
 }
 
 bool Directory::isChild(const char* filename) const
 {
-  STL_NAMESPACE_PREFIX map<STL_NAMESPACE_PREFIX string, inode_id_t>::const_iterator it;
-
-  // is there a child with the given name?
-  for(it = children_.begin(); it != children_.end(); it++)
-  {
-    if((*it).first == filename)
-    {
-      return true;
-    }
-  }
-
-  return false;
+  inode_id_t inode_id;
+  return children_.find(filename, inode_id);
 }
 
 void Directory::addChild(const char* filename, inode_id_t inode_id)
 {
   // check for double existence of such an I-Node
-  if(!isChild(filename))
+  if(children_.insert(filename, inode_id))
   {
-    // I-Node with that name does not exist -> insert
-    children_.insert(STL_NAMESPACE_PREFIX pair<STL_NAMESPACE_PREFIX string, inode_id_t>(filename, inode_id));
     debug(FS_INODE, "addChild - new inode \"%s\" added successful.\n", filename);
   }
   else
   {
-    debug(FS_INODE, "addChild - ERROR child was already inserted.\n", filename);
+    debug(FS_INODE, "addChild - ERROR child \"%s\" was already inserted.\n", filename);
   }
 }
 
 bool Directory::removeChild(const char* filename)
 {
-  children_.erase(filename);
-  return true;
+  return children_.remove(filename);
 }
 
 bool Directory::isEmpty(void) const
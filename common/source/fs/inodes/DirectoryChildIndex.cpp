@@ -0,0 +1,208 @@
+/**
+ * Filename: DirectoryChildIndex.cpp
+ * Description:
+ *
+ * Created on: 18.10.2026
+ */
+
+#include "fs/inodes/DirectoryChildIndex.h"
+
+#ifndef USE_FILE_SYSTEM_ON_GUEST_OS
+#include "util/string.h"
+#include "assert.h"
+#else
+#include <cstring>
+#include <assert.h>
+#endif
+
+DirectoryChildIndex::DirectoryChildIndex() : slots_(NULL), num_slots_(0),
+    num_used_slots_(0), free_slot_(NO_SLOT), buckets_(NULL), num_buckets_(0),
+    num_children_(0)
+{
+}
+
+DirectoryChildIndex::~DirectoryChildIndex()
+{
+  clear();
+}
+
+uint32 DirectoryChildIndex::hashName(const char* name)
+{
+  // FNV-1a
+  uint32 hash = 2166136261U;
+
+  for(const char* c = name; *c != '\0'; c++)
+  {
+    hash ^= (uint8)*c;
+    hash *= 16777619U;
+  }
+
+  return hash;
+}
+
+uint32 DirectoryChildIndex::size(void) const
+{
+  return num_children_;
+}
+
+uint32 DirectoryChildIndex::findSlot(const char* name, uint32 hash) const
+{
+  if(num_buckets_ == 0)
+    return NO_SLOT;
+
+  for(uint32 slot = buckets_[hash & (num_buckets_ - 1)]; slot != NO_SLOT; slot = slots_[slot].next)
+  {
+    if(slots_[slot].hash == hash && strcmp(slots_[slot].name, name) == 0)
+      return slot;
+  }
+
+  return NO_SLOT;
+}
+
+bool DirectoryChildIndex::find(const char* name, inode_id_t& inode_id) const
+{
+  uint32 slot = findSlot(name, hashName(name));
+  if(slot == NO_SLOT)
+    return false;
+
+  inode_id = slots_[slot].inode_id;
+  return true;
+}
+
+void DirectoryChildIndex::growSlots(void)
+{
+  uint32 num_slots = (num_slots_ == 0) ? MIN_CAPACITY : num_slots_ * 2;
+
+  // the slots keep their numbers, so the bucket-chains stay valid
+  ChildSlot* slots = new ChildSlot[num_slots];
+  if(num_slots_ > 0)
+    memcpy(slots, slots_, num_slots_ * sizeof(ChildSlot));
+
+  delete[] slots_;
+  slots_ = slots;
+  num_slots_ = num_slots;
+}
+
+void DirectoryChildIndex::rehash(uint32 num_buckets)
+{
+  delete[] buckets_;
+  buckets_ = new uint32[num_buckets];
+  num_buckets_ = num_buckets;
+
+  for(uint32 i = 0; i < num_buckets_; i++)
+    buckets_[i] = NO_SLOT;
+
+  for(uint32 slot = 0; slot < num_used_slots_; slot++)
+  {
+    if(slots_[slot].name == NULL)
+      continue;
+
+    uint32* bucket = &buckets_[slots_[slot].hash & (num_buckets_ - 1)];
+    slots_[slot].next = *bucket;
+    *bucket = slot;
+  }
+}
+
+bool DirectoryChildIndex::insert(const char* name, inode_id_t inode_id)
+{
+  uint32 hash = hashName(name);
+
+  if(findSlot(name, hash) != NO_SLOT)
+    return false;
+
+  // keeping the load factor below 1
+  if(num_children_ >= num_buckets_)
+    rehash((num_buckets_ == 0) ? MIN_CAPACITY : num_buckets_ * 2);
+
+  uint32 slot;
+  if(free_slot_ != NO_SLOT)
+  {
+    slot = free_slot_;
+    free_slot_ = slots_[slot].next;
+  }
+  else
+  {
+    if(num_used_slots_ == num_slots_)
+      growSlots();
+
+    slot = num_used_slots_++;
+  }
+
+  uint32 name_len = strlen(name);
+  slots_[slot].name = new char[name_len + 1];
+  memcpy(slots_[slot].name, name, name_len + 1);
+  slots_[slot].hash = hash;
+  slots_[slot].inode_id = inode_id;
+
+  uint32* bucket = &buckets_[hash & (num_buckets_ - 1)];
+  slots_[slot].next = *bucket;
+  *bucket = slot;
+
+  num_children_++;
+  return true;
+}
+
+bool DirectoryChildIndex::remove(const char* name)
+{
+  if(num_buckets_ == 0)
+    return false;
+
+  uint32 hash = hashName(name);
+  uint32* link = &buckets_[hash & (num_buckets_ - 1)];
+
+  while(*link != NO_SLOT)
+  {
+    ChildSlot& cur = slots_[*link];
+
+    if(cur.hash == hash && strcmp(cur.name, name) == 0)
+    {
+      uint32 slot = *link;
+      *link = cur.next;
+
+      delete[] cur.name;
+      cur.name = NULL;
+      cur.next = free_slot_;
+      free_slot_ = slot;
+
+      num_children_--;
+      return true;
+    }
+
+    link = &cur.next;
+  }
+
+  return false;
+}
+
+void DirectoryChildIndex::clear(void)
+{
+  for(uint32 slot = 0; slot < num_used_slots_; slot++)
+    delete[] slots_[slot].name;
+
+  delete[] slots_;
+  delete[] buckets_;
+
+  slots_ = NULL;
+  num_slots_ = 0;
+  num_used_slots_ = 0;
+  free_slot_ = NO_SLOT;
+  buckets_ = NULL;
+  num_buckets_ = 0;
+  num_children_ = 0;
+}
+
+bool DirectoryChildIndex::getNext(uint32& cursor, const char*& name, inode_id_t& inode_id) const
+{
+  // skipping the freed slots
+  while(cursor < num_used_slots_ && slots_[cursor].name == NULL)
+    cursor++;
+
+  if(cursor >= num_used_slots_)
+    return false;
+
+  name = slots_[cursor].name;
+  inode_id = slots_[cursor].inode_id;
+  cursor++;
+
+  return true;
+}
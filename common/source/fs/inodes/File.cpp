@@ -3,7 +3,8 @@
  */
 
 #include "fs/inodes/File.h"
-//#include "fs/inodes/Inode.h"
+#include "fs/FileSystem.h"
+#include "fs/IoVector.h"
 
 File::File(uint32 inode_number, uint32 device_sector, uint32 sector_offset,
         FileSystem* file_system, unix_time_stamp access_time,
@@ -41,3 +42,49 @@ bool File::truncateProtected(void)
 
   return result;
 }
+
+void File::releaseReservedSectorsProtected(void)
+{
+  getLock()->acquireWriteBlocking();
+  getFileSystem()->releaseReservedSectors(this);
+  getLock()->releaseWrite();
+}
+
+int32 File::readv(FileDescriptor* fd, const iovec_s* iov, uint32 iov_count)
+{
+  int32 read_bytes = 0;
+
+  for(uint32 i = 0; i < iov_count; i++)
+  {
+    int32 result = read(fd, static_cast<char*>(iov[i].iov_base), iov[i].iov_len);
+    if(result < 0)
+      return (read_bytes > 0) ? read_bytes : result;
+
+    read_bytes += result;
+
+    // end of file reached
+    if((uint32)result < iov[i].iov_len)
+      break;
+  }
+
+  return read_bytes;
+}
+
+int32 File::writev(FileDescriptor* fd, const iovec_s* iov, uint32 iov_count)
+{
+  int32 written_bytes = 0;
+
+  for(uint32 i = 0; i < iov_count; i++)
+  {
+    int32 result = write(fd, static_cast<const char*>(iov[i].iov_base), iov[i].iov_len);
+    if(result < 0)
+      return (written_bytes > 0) ? written_bytes : result;
+
+    written_bytes += result;
+
+    if((uint32)result < iov[i].iov_len)
+      break;
+  }
+
+  return written_bytes;
+}
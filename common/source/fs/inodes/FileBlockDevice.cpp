@@ -46,4 +46,16 @@ int32 FileBlockDevice::write(FileDescriptor* fd, const char* buffer, uint32 len)
   return 0;
 }
 
+int32 FileBlockDevice::pread(FileDescriptor* fd __attribute__((unused)), char* buffer, uint32 len, file_size_t offset)
+{
+  block_dev_->readData(offset, len, buffer);
+  return 0;
+}
+
+int32 FileBlockDevice::pwrite(FileDescriptor* fd __attribute__((unused)), const char* buffer, uint32 len, file_size_t offset)
+{
+  block_dev_->writeData(offset, len, strdup( buffer ));
+  return 0;
+}
+
 #endif // USE_FILE_SYSTEM_ON_GUEST_OS
@@ -7,7 +7,7 @@
 
 #ifndef USE_FILE_SYSTEM_ON_GUEST_OS
 #include "util/string.h"
-//#include "MutexLock.h"
+#include "kernel/MutexLock.h"
 #else
 #include <string>
 #include <cstring>
@@ -23,6 +23,11 @@ Inode::Inode(inode_id_t inode_number,
              uint32 uid, uint32 gid) :
   number_(inode_number), name_(NULL),
   device_sector_(device_sector), sector_offset_(sector_offset), data_sectors_(),
+  all_sectors_loaded_(true), sector_list_modified_(true),
+  reserved_sector_(0), num_reserved_sectors_(0),
+#ifndef USE_FILE_SYSTEM_ON_GUEST_OS
+  sector_list_lock_("Inode sector-list Mutex"),
+#endif
   //parent_(NULL),
   inode_lock_(NULL), file_system_(file_system),
   access_time_(access_time), mod_time_(mod_time), c_time_(c_time),
@@ -35,6 +40,12 @@ Inode::Inode(inode_id_t inode_number,
 Inode::Inode(const Inode& cpy) : number_(cpy.number_), name_(cpy.name_),
     device_sector_(cpy.device_sector_), sector_offset_(cpy.sector_offset_),
     data_sectors_(cpy.data_sectors_),
+    all_sectors_loaded_(cpy.all_sectors_loaded_),
+    sector_list_modified_(cpy.sector_list_modified_),
+    reserved_sector_(0), num_reserved_sectors_(0),
+#ifndef USE_FILE_SYSTEM_ON_GUEST_OS
+    sector_list_lock_("Inode sector-list Mutex"),
+#endif
     //parent_(cpy.parent_),
     inode_lock_(NULL), file_system_(cpy.file_system_),
     access_time_(cpy.access_time_), mod_time_(cpy.mod_time_), c_time_(cpy.c_time_),
@@ -210,57 +221,130 @@ uint32 Inode::getPermissions(void) const
 
 sector_addr_t Inode::getSector(uint32 number)
 {
-  if(number >= data_sectors_.size())
+  if(!all_sectors_loaded_)
   {
-    // try to reload more sectors
-    file_system_->updateInodesSectorList(this);
-
-    // after reloading, again a sector with the given number is not
-    // available ...
-    if(number >= data_sectors_.size())
-    {
-      return 0; // non such a sector on the i-node
-    }
+#ifndef USE_FILE_SYSTEM_ON_GUEST_OS
+    MutexLock auto_lock(sector_list_lock_);
+#endif
+
+    // load the sector-list up to the requested sector
+    if(!all_sectors_loaded_ && number >= data_sectors_.size())
+      file_system_->updateInodesSectorList(this, number);
   }
 
-  return data_sectors_[number];
+  // 0 if there is no such a sector on the i-node
+  return data_sectors_.getSector(number);
 }
 
 sector_addr_t Inode::getSector(uint32 number) const
 {
-  if(number >= data_sectors_.size())
-  {
-    return 0;
-  }
-  return data_sectors_[number];
+  return data_sectors_.getSector(number);
+}
+
+void Inode::loadAllSectors(void)
+{
+  if(all_sectors_loaded_)
+    return;
+
+#ifndef USE_FILE_SYSTEM_ON_GUEST_OS
+  MutexLock auto_lock(sector_list_lock_);
+#endif
+
+  if(!all_sectors_loaded_)
+    file_system_->updateInodesSectorList(this, 0xFFFFFFFF);
 }
 
 void Inode::addSector(sector_addr_t sector)
 {
-  data_sectors_.push_back(sector);
+  loadAllSectors();
+
+  data_sectors_.append(sector);
+  sector_list_modified_ = true;
 }
 
 void Inode::removeLastSector(void)
 {
-  data_sectors_.pop_back();
+  loadAllSectors();
+
+  data_sectors_.removeLast();
+  sector_list_modified_ = true;
 }
 
 void Inode::removeSector(uint32 number)
 {
+  loadAllSectors();
+
   if(number >= data_sectors_.size())
     return;
 
-  data_sectors_.erase( data_sectors_.begin() + number );
+  data_sectors_.remove(number);
+  sector_list_modified_ = true;
 }
 
-uint32 Inode::getNumSectors(void) const
+uint32 Inode::getNumSectors(void)
 {
+  loadAllSectors();
+
   return data_sectors_.size();
 }
 
 void Inode::clearSectorList(void)
 {
   data_sectors_.clear();
+  all_sectors_loaded_ = true;
+  sector_list_modified_ = true;
+}
+
+void Inode::addLoadedSector(sector_addr_t sector)
+{
+  data_sectors_.append(sector);
+}
+
+void Inode::addLoadedSectors(sector_addr_t first_sector, uint32 num_sectors)
+{
+  data_sectors_.append(first_sector, num_sectors);
+}
+
+uint32 Inode::getNumLoadedSectors(void) const
+{
+  return data_sectors_.size();
+}
+
+void Inode::setAllSectorsLoaded(bool loaded)
+{
+  all_sectors_loaded_ = loaded;
+}
+
+bool Inode::areAllSectorsLoaded(void) const
+{
+  return all_sectors_loaded_;
+}
+
+bool Inode::isSectorListModified(void) const
+{
+  return sector_list_modified_;
+}
+
+void Inode::setSectorListModified(bool modified)
+{
+  sector_list_modified_ = modified;
+}
+
+uint32 Inode::getNumSectorExtents(void) const
+{
+  return data_sectors_.getNumExtents();
+}
+
+void Inode::getReservedSectors(sector_addr_t& first_sector, uint32& num_sectors) const
+{
+  first_sector = reserved_sector_;
+  num_sectors = num_reserved_sectors_;
+}
+
+void Inode::setReservedSectors(sector_addr_t first_sector, uint32 num_sectors)
+{
+  reserved_sector_ = first_sector;
+  num_reserved_sectors_ = num_sectors;
 }
 
 void Inode::setIndirectBlock(uint32 deg_of_indirection, sector_addr_t sector)
@@ -13,11 +13,14 @@
 #include "fs/FsVolumeManager.h"
 #include "fs/FileDescriptor.h"
 #include "fs/FsDefinitions.h"
+#include "fs/IoVector.h"
 
 #ifdef USE_FILE_SYSTEM_ON_GUEST_OS
 #include <cstring>
 #endif
 
+OBJECT_CACHE_DEFINITIONS(RegularFile)
+
 RegularFile::RegularFile(uint32 inode_number, uint32 device_sector,
     uint32 sector_offset, FileSystem* file_system, FsVolumeManager* volume_manager,
     unix_time_stamp access_time, unix_time_stamp mod_time, unix_time_stamp c_time,
@@ -32,6 +35,30 @@ RegularFile::~RegularFile()
 }
 
 int32 RegularFile::read(FileDescriptor* fd, char* buffer, uint32 len)
+{
+  iovec_s iov;
+  iov.iov_base = buffer;
+  iov.iov_len = len;
+
+  return readVector(fd, &iov, 1, 0, true);
+}
+
+int32 RegularFile::pread(FileDescriptor* fd, char* buffer, uint32 len, file_size_t offset)
+{
+  iovec_s iov;
+  iov.iov_base = buffer;
+  iov.iov_len = len;
+
+  return readVector(fd, &iov, 1, offset, false);
+}
+
+int32 RegularFile::readv(FileDescriptor* fd, const iovec_s* iov, uint32 iov_count)
+{
+  return readVector(fd, iov, iov_count, 0, true);
+}
+
+int32 RegularFile::readVector(FileDescriptor* fd, const iovec_s* iov, uint32 iov_count,
+                              file_size_t pos, bool use_cursor)
 {
   assert(fd != NULL);
   assert(fd->getFile() != NULL);
@@ -43,37 +70,114 @@ int32 RegularFile::read(FileDescriptor* fd, char* buffer, uint32 len)
     return FileSystem::InvalidArgument;
   }
 
+  // the total number of bytes to read (has to fit into the return value)
+  uint32 len = 0;
+  for(uint32 i = 0; i < iov_count; i++)
+  {
+    if(iov[i].iov_len > 0x7FFFFFFF - len)
+      return FileSystem::InvalidArgument;
+
+    len += iov[i].iov_len;
+  }
+
+  // the file-size must not change while reading, the file-cursor is only
+  // used if requested (pread() can run in parallel on the same FD)
+  int32 lock_result = lockRead(fd);
+  if(lock_result != 0)
+    return lock_result;
+
+  uint32 read_ahead_window = 0;
+  uint32 read_ahead_end = 0;
+
+  if(use_cursor)
+  {
+    pos = fd->getCursorPos();
+
+    // sequential access detection for the readahead
+    read_ahead_window = fd->updateReadAheadWindow(pos, len);
+    read_ahead_end = fd->getReadAheadEnd();
+  }
+
   // number of bytes successfully read (so far)
   uint32 read_bytes = 0;
+  int32 result = 0;
 
-  FileSystemLock* lock = fd->getFile()->getLock();
+  for(uint32 i = 0; i < iov_count; i++)
+  {
+    result = readUnprotected(static_cast<char*>(iov[i].iov_base), iov[i].iov_len,
+                             pos + read_bytes, len - read_bytes, read_ahead_window, read_ahead_end);
+    if(result < 0)
+      break;
 
-  // read() requires exclusive access, because of potential conflicts with
-  // the file-cursor and the file-size
-  if(fd->nonblockingMode())
+    read_bytes += result;
+
+    // end of file reached
+    if((uint32)result < iov[i].iov_len)
+      break;
+  }
+
+  if(use_cursor)
   {
-    debug(FS_INODE, "RegularFile::read - nonblocking mode\n");
+    // update file cursor position
+    fd->moveCursor(read_bytes);
+    fd->setReadAheadEnd(read_ahead_end);
+  }
 
-    if(!lock->acquireReadNonBlocking())
-    {
-      debug(FS_INODE, "RegularFile::read - failed to assert mutual exclusion\n");
-      return FileSystem::NonBlockAcquire;
-    }
+  getLock()->releaseRead();
+
+  if(result < 0 && read_bytes == 0)
+    return result;
+
+  // update time of last modification st_atime
+  if(read_bytes > 0 && doUpdateAccessTime())
+  {
+    updateLastAccessTimeProtected(fd);
   }
-  else
+
+  return read_bytes;
+}
+
+int32 RegularFile::readUnprotected(char* buffer, uint32 len, file_size_t pos, uint32 range_len,
+                                   uint32 read_ahead_window, uint32& read_ahead_end)
+{
+  // number of bytes successfully read (so far)
+  uint32 read_bytes = 0;
+
+  // the data-blocks of the requested range plus (on sequential access)
+  // the readahead window are read with as few device requests as possible
+  uint32 read_ahead_limit = 0;
+
+  if(range_len > 0 && pos < getFileSize())
   {
-    // wait until we obtain the lock
-    lock->acquireReadBlocking();
+    file_size_t last_pos = pos + range_len - 1;
+    if(last_pos >= getFileSize() || last_pos < pos)
+      last_pos = getFileSize() - 1;
+
+    read_ahead_limit = last_pos / file_system_->getDataBlockSize() + 1 + read_ahead_window;
+
+    uint32 file_blocks = (getFileSize() + file_system_->getDataBlockSize() - 1) / file_system_->getDataBlockSize();
+    if(read_ahead_limit > file_blocks)
+      read_ahead_limit = file_blocks;
   }
 
-  // current cursor position
-  file_size_t cursor_pos = fd->getCursorPos();
+  // nothing to read behind the end of the file
+  if(pos >= getFileSize())
+    return 0;
 
   while(read_bytes < len)
   {
     // determine on which block the next chunk of data is located
-    uint32 sector_number = (cursor_pos + read_bytes) / file_system_->getDataBlockSize();
-    sector_len_t sector_offset = (cursor_pos + read_bytes) % file_system_->getDataBlockSize();
+    uint32 sector_number = (pos + read_bytes) / file_system_->getDataBlockSize();
+    sector_len_t sector_offset = (pos + read_bytes) % file_system_->getDataBlockSize();
+
+    // keep the readahead at least half a window ahead of the reader, so
+    // that the blocks are read in batches and not one by one
+    if(sector_number + read_ahead_window / 2 >= read_ahead_end && sector_number + 1 < read_ahead_limit)
+    {
+      uint32 first_block = (read_ahead_end > sector_number) ? read_ahead_end : sector_number;
+      if(first_block < read_ahead_limit)
+        read_ahead_end = readAhead(first_block, read_ahead_limit);
+    }
 
     // getting the next sector
     sector_addr_t next_sector = getSector(sector_number);
@@ -82,12 +186,16 @@ int32 RegularFile::read(FileDescriptor* fd, char* buffer, uint32 len)
     // reading data-block
     volume_manager_->acquireDataBlockForReading(next_sector);
 
-    char* block = volume_manager_->readDataBlockUnprotected(next_sector);
-    if(block == NULL)
+    // the block's sectors stay pinned in the cache until the block is released
+    DataBlockView block;
+    if(!volume_manager_->readDataBlockViewUnprotected(next_sector, block))
     {
-      lock->releaseRead();
-      if(read_bytes == 0) return FileSystem::IOReadError;
-      else break;
+      volume_manager_->releaseReadDataBlock(next_sector, 0);
+      if(read_bytes == 0)
+      {
+        return FileSystem::IOReadError;
+      }
+      break;
     }
 
     // by default read everything from the offset to the end of the block ...
@@ -102,19 +210,18 @@ int32 RegularFile::read(FileDescriptor* fd, char* buffer, uint32 len)
     bool end_of_file = false;
 
     // avoid a size-overflow
-    if(cursor_pos + read_bytes + num_bytes_to_cpy > getFileSize())
+    if(pos + read_bytes + num_bytes_to_cpy > getFileSize())
     {
-      assert(getFileSize() >= (cursor_pos + read_bytes));
+      assert(getFileSize() >= (pos + read_bytes));
       // fragment size is the rest of the file that should be read
-      num_bytes_to_cpy = getFileSize() - (cursor_pos + read_bytes);
+      num_bytes_to_cpy = getFileSize() - (pos + read_bytes);
       end_of_file = true;
     }
 
-    // deep-copy the sector's data into the callers buffer
-    memcpy(buffer + read_bytes, block + sector_offset, num_bytes_to_cpy);
+    // copy the data straight out of the cached sectors into the callers buffer
+    block.copyOut(buffer + read_bytes, sector_offset, num_bytes_to_cpy);
 
     volume_manager_->releaseReadDataBlock(next_sector);
-    delete[] block;
 
     // update the number of read bytes
     read_bytes += num_bytes_to_cpy;
@@ -125,25 +232,37 @@ int32 RegularFile::read(FileDescriptor* fd, char* buffer, uint32 len)
     }
   }
 
-  // update file cursor position
-  fd->moveCursor(read_bytes);
+  return read_bytes;
+}
 
-  lock->releaseRead();
+int32 RegularFile::lockRead(FileDescriptor* fd)
+{
+  FileSystemLock* lock = fd->getFile()->getLock();
 
-  // update time of last modification st_atime
-  if(read_bytes > 0 && doUpdateAccessTime())
+  if(fd->nonblockingMode())
   {
-    updateLastAccessTimeProtected(fd);
+    debug(FS_INODE, "RegularFile::read - nonblocking mode\n");
+
+    if(!lock->acquireReadNonBlocking())
+    {
+      debug(FS_INODE, "RegularFile::read - failed to assert mutual exclusion\n");
+      return FileSystem::NonBlockAcquire;
+    }
+  }
+  else
+  {
+    // wait until we obtain the lock
+    lock->acquireReadBlocking();
   }
 
-  return read_bytes;
+  return 0;
 }
 
 int32 RegularFile::lockWrite(FileDescriptor* fd)
 {
   FileSystemLock* lock = fd->getFile()->getLock();
 
-  // read() requires exclusive access, because of potential conflicts with
+  // write() requires exclusive access, because of potential conflicts with
   // the file-cursor and the file-size
   if(fd->nonblockingMode())
   {
@@ -164,7 +283,55 @@ int32 RegularFile::lockWrite(FileDescriptor* fd)
   return 0;
 }
 
+uint32 RegularFile::readAhead(uint32 first_block, uint32 end_block)
+{
+  if(end_block > first_block + FileDescriptor::READ_AHEAD_MAX_WINDOW)
+    end_block = first_block + FileDescriptor::READ_AHEAD_MAX_WINDOW;
+
+  sector_addr_t data_blocks[FileDescriptor::READ_AHEAD_MAX_WINDOW];
+  uint32 num_data_blocks = 0;
+
+  for(uint32 i = first_block; i < end_block; i++)
+  {
+    sector_addr_t data_block = getSector(i);
+    if(data_block == 0)
+      break;
+
+    data_blocks[num_data_blocks++] = data_block;
+  }
+
+  debug(FS_INODE, "RegularFile::readAhead - reading %d data-blocks ahead, starting at %d\n", num_data_blocks, first_block);
+  volume_manager_->readAheadDataBlocks(data_blocks, num_data_blocks);
+
+  // a block that could not be resolved is not read ahead again
+  return first_block + (num_data_blocks > 0 ? num_data_blocks : 1);
+}
+
 int32 RegularFile::write(FileDescriptor* fd, const char* buffer, uint32 len)
+{
+  iovec_s iov;
+  iov.iov_base = const_cast<char*>(buffer);
+  iov.iov_len = len;
+
+  return writeVector(fd, &iov, 1, 0, true);
+}
+
+int32 RegularFile::pwrite(FileDescriptor* fd, const char* buffer, uint32 len, file_size_t offset)
+{
+  iovec_s iov;
+  iov.iov_base = const_cast<char*>(buffer);
+  iov.iov_len = len;
+
+  return writeVector(fd, &iov, 1, offset, false);
+}
+
+int32 RegularFile::writev(FileDescriptor* fd, const iovec_s* iov, uint32 iov_count)
+{
+  return writeVector(fd, iov, iov_count, 0, true);
+}
+
+int32 RegularFile::writeVector(FileDescriptor* fd, const iovec_s* iov, uint32 iov_count,
+                               file_size_t pos, bool use_cursor)
 {
   assert(fd != NULL);
   assert(fd->getFile() != NULL);
@@ -176,49 +343,46 @@ int32 RegularFile::write(FileDescriptor* fd, const char* buffer, uint32 len)
     return FileSystem::InvalidArgument;
   }
 
-  // number of bytes written
-  uint32 written_bytes = 0;
-
-  FileSystemLock* lock = fd->getFile()->getLock();
-
-  // read() requires exclusive access, because of potential conflicts with
-  // the file-cursor and the file-size
-  if(fd->nonblockingMode())
+  // the total number of bytes to write (has to fit into the return value)
+  uint32 len = 0;
+  for(uint32 i = 0; i < iov_count; i++)
   {
-    debug(FS_INODE, "RegularFile::write - nonblocking mode\n");
+    if(iov[i].iov_len > 0x7FFFFFFF - len)
+      return FileSystem::InvalidArgument;
 
-    if(!lock->acquireWriteNonBlocking())
-    {
-      debug(FS_INODE, "RegularFile::write - failed to assert mutual exclusion\n");
-      return FileSystem::NonBlockAcquire;
-    }
-  }
-  else
-  {
-    // wait until we obtain the lock
-    lock->acquireWriteBlocking();
+    len += iov[i].iov_len;
   }
 
+  int32 lock_result = lockWrite(fd);
+  if(lock_result != 0)
+    return lock_result;
+
+  FileSystemLock* lock = getLock();
+
   // were there any changes to the file, so the I-Node on the Disk has
   // to be updated?
   bool inode_changed = false;
 
-  // current cursor position
-  file_size_t cursor_pos = fd->getCursorPos();
-
-  if(fd->appendMode())
+  if(use_cursor)
   {
-    // file opened in append mode, set cursor to EOF before writing
-    cursor_pos = getFileSize();
-    debug(FS_INODE, "RegularFile::write - file in append mode, set cursor to EOF\n");
+    // current cursor position
+    pos = fd->getCursorPos();
+
+    if(fd->appendMode())
+    {
+      // file opened in append mode, set cursor to EOF before writing
+      pos = getFileSize();
+      debug(FS_INODE, "RegularFile::write - file in append mode, set cursor to EOF\n");
+    }
   }
-  else if(len > 0 && cursor_pos > getFileSize())
+
+  if(len > 0 && pos > getFileSize())
   {
     debug(FS_INODE, "RegularFile::write - FileCursor > EOF\n");
 
     // file cursor offset is beyond the current-file size, so
     // the file needs to be resized
-    file_size_t num_bytes_to_resize = cursor_pos - getFileSize();
+    file_size_t num_bytes_to_resize = pos - getFileSize();
 
     sector_addr_t num_blocks_to_request = (num_bytes_to_resize / file_system_->getDataBlockSize());
 
@@ -243,11 +407,67 @@ int32 RegularFile::write(FileDescriptor* fd, const char* buffer, uint32 len)
     setFileSize(getFileSize() + num_bytes_to_resize);
   }
 
+  // number of bytes written
+  uint32 written_bytes = 0;
+  int32 result = 0;
+
+  for(uint32 i = 0; i < iov_count; i++)
+  {
+    result = writeUnprotected(static_cast<const char*>(iov[i].iov_base), iov[i].iov_len,
+                              pos + written_bytes, inode_changed);
+    if(result < 0)
+      break;
+
+    written_bytes += result;
+
+    // the FileSystem is full or an I/O error occurred
+    if((uint32)result < iov[i].iov_len)
+      break;
+  }
+
+  // update file-size and cursor position:
+  if(pos + written_bytes > getFileSize())
+    setFileSize(pos + written_bytes);
+
+  if(use_cursor)
+    fd->setCursorPos(pos + written_bytes);
+
+  // update time of last change and c-time
+  if(written_bytes > 0 || len > 0)
+  {
+    // file-size has had a change:
+    inode_changed = true;
+
+    unix_time_stamp t = VfsSyscall::getCurrentTimeStamp();
+    updateModTime(t);
+    updateCTime(t);
+  }
+
+  // there was a change performed to the I-Node, update it on the device
+  if(inode_changed)
+  {
+    debug(FS_INODE, "RegularFile::write - file changed, rewrite i-node data to disk.\n");
+    file_system_->writeInode(this);
+  }
+
+  lock->releaseWrite();
+
+  if(result < 0 && written_bytes == 0)
+    return result;
+
+  return written_bytes;
+}
+
+int32 RegularFile::writeUnprotected(const char* buffer, uint32 len, file_size_t pos, bool& inode_changed)
+{
+  // number of bytes written
+  uint32 written_bytes = 0;
+
   while(written_bytes < len)
   {
     // determine the internal sector-number of the file that should be written to
-    uint32 sector_number = (cursor_pos + written_bytes) / file_system_->getDataBlockSize();
-    sector_len_t sector_offset = (cursor_pos + written_bytes) % file_system_->getDataBlockSize();
+    uint32 sector_number = (pos + written_bytes) / file_system_->getDataBlockSize();
+    sector_len_t sector_offset = (pos + written_bytes) % file_system_->getDataBlockSize();
 
     debug(FS_INODE, "RegularFile::write - sector_nr=%x sector_offset=%d\n", sector_number, sector_offset);
 
@@ -261,8 +481,7 @@ int32 RegularFile::write(FileDescriptor* fd, const char* buffer, uint32 len)
       if(!file_system_->appendSectorToInode(this, true))
       {
         debug(FS_INODE, "RegularFile::write - FAIL FileSystem is full!\n");
-        lock->releaseWrite();
-        return FileSystem::FileSystemFull;
+        return written_bytes > 0 ? (int32)written_bytes : FileSystem::FileSystemFull;
       }
       next_sector = getSector(sector_number);
       assert(next_sector != 0);
@@ -278,8 +497,8 @@ int32 RegularFile::write(FileDescriptor* fd, const char* buffer, uint32 len)
     char* block = volume_manager_->readDataBlockUnprotected(next_sector);
     if(block == NULL)
     {
-      lock->releaseWrite();
-      return FileSystem::IOReadError;
+      volume_manager_->releaseWriteDataBlock(next_sector, 0);
+      return written_bytes > 0 ? (int32)written_bytes : FileSystem::IOReadError;
     }
 
     sector_len_t bytes_to_write = file_system_->getDataBlockSize() - sector_offset;
@@ -296,10 +515,10 @@ int32 RegularFile::write(FileDescriptor* fd, const char* buffer, uint32 len)
     if(!volume_manager_->writeDataBlockUnprotected(next_sector, block))
     {
       debug(FS_INODE, "RegularFile::write - FAILED to write updated sector!\n");
-      lock->releaseWrite();
+      volume_manager_->releaseWriteDataBlock(next_sector);
       delete[] block;
 
-      return FileSystem::IOWriteError;
+      return written_bytes > 0 ? (int32)written_bytes : FileSystem::IOWriteError;
     }
 
     written_bytes += bytes_to_write;
@@ -311,34 +530,10 @@ int32 RegularFile::write(FileDescriptor* fd, const char* buffer, uint32 len)
     delete[] block;
   }
 
-  // update file-size and cursor position:
-  if(cursor_pos + written_bytes > getFileSize())
-    setFileSize( getFileSize() + (cursor_pos + written_bytes - getFileSize()) );
-
-  fd->moveCursor(written_bytes);
-
-  // update time of last change and c-time
-  if(written_bytes > 0 || len > 0)
-  {
-    // file-size has had a change:
-    inode_changed = true;
-
-    unix_time_stamp t = VfsSyscall::getCurrentTimeStamp();
-    updateModTime(t);
-    updateCTime(t);
-  }
-
-  // there was a change performed to the I-Node, update it on the device
-  if(inode_changed)
-  {
-    debug(FS_INODE, "RegularFile::write - file changed, rewrite i-node data to disk.\n");
-    file_system_->writeInode(this);
-  }
-
-  lock->releaseWrite();
   return written_bytes;
 }
 
+
 bool RegularFile::truncateUnprotected(void)
 {
   debug(FS_INODE, "RegularFile::truncateUnprotected - setting file-size to 0!\n");
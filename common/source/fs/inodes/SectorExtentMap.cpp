@@ -0,0 +1,154 @@
+/**
+ * Filename: SectorExtentMap.cpp
+ * Description:
+ *
+ * Created on: 18.10.2026
+ */
+
+#include "fs/inodes/SectorExtentMap.h"
+
+SectorExtentMap::SectorExtentMap() : extents_(), num_sectors_(0)
+{
+}
+
+SectorExtentMap::~SectorExtentMap()
+{
+}
+
+uint32 SectorExtentMap::findExtent(uint32 number) const
+{
+  // the last extent with first_index <= number
+  uint32 low = 0;
+  uint32 high = extents_.size();
+
+  while(high - low > 1)
+  {
+    uint32 mid = low + (high - low) / 2;
+
+    if(extents_[mid].first_index <= number)
+      low = mid;
+    else
+      high = mid;
+  }
+
+  return low;
+}
+
+sector_addr_t SectorExtentMap::getSector(uint32 number) const
+{
+  if(number >= num_sectors_)
+    return 0;
+
+  const SectorExtent& extent = extents_[findExtent(number)];
+  return extent.first_sector + (number - extent.first_index);
+}
+
+void SectorExtentMap::append(sector_addr_t sector)
+{
+  append(sector, 1);
+}
+
+void SectorExtentMap::append(sector_addr_t first_sector, uint32 num_sectors)
+{
+  if(num_sectors == 0)
+    return;
+
+  if(!extents_.empty())
+  {
+    SectorExtent& last = extents_.back();
+
+    if(last.first_sector + last.num_sectors == first_sector)
+    {
+      last.num_sectors += num_sectors;
+      num_sectors_ += num_sectors;
+      return;
+    }
+  }
+
+  SectorExtent extent;
+  extent.first_sector = first_sector;
+  extent.first_index = num_sectors_;
+  extent.num_sectors = num_sectors;
+
+  extents_.push_back(extent);
+  num_sectors_ += num_sectors;
+}
+
+void SectorExtentMap::removeLast(void)
+{
+  if(num_sectors_ == 0)
+    return;
+
+  if(--extents_.back().num_sectors == 0)
+    extents_.pop_back();
+
+  num_sectors_--;
+}
+
+void SectorExtentMap::remove(uint32 number)
+{
+  if(number >= num_sectors_)
+    return;
+
+  uint32 index = findExtent(number);
+  SectorExtent& extent = extents_[index];
+  uint32 offset = number - extent.first_index;
+
+  if(extent.num_sectors == 1)
+  {
+    extents_.erase(extents_.begin() + index);
+
+    // the neighbours might form one run now
+    if(index > 0 && index < extents_.size() &&
+       extents_[index - 1].first_sector + extents_[index - 1].num_sectors == extents_[index].first_sector)
+    {
+      extents_[index - 1].num_sectors += extents_[index].num_sectors;
+      extents_.erase(extents_.begin() + index);
+    }
+  }
+  else if(offset == 0)
+  {
+    extent.first_sector++;
+    extent.num_sectors--;
+    index++;
+  }
+  else if(offset == extent.num_sectors - 1)
+  {
+    extent.num_sectors--;
+    index++;
+  }
+  else
+  {
+    // splitting the run, the second part starts behind the removed sector
+    SectorExtent tail;
+    tail.first_sector = extent.first_sector + offset + 1;
+    tail.first_index = number + 1;
+    tail.num_sectors = extent.num_sectors - offset - 1;
+
+    extent.num_sectors = offset;
+    extents_.insert(extents_.begin() + index + 1, tail);
+    index++;
+  }
+
+  // the following sectors move up by one
+  for(uint32 i = index; i < extents_.size(); i++)
+    extents_[i].first_index--;
+
+  num_sectors_--;
+}
+
+void SectorExtentMap::clear(void)
+{
+  extents_.clear();
+  num_sectors_ = 0;
+}
+
+uint32 SectorExtentMap::size(void) const
+{
+  return num_sectors_;
+}
+
+uint32 SectorExtentMap::getNumExtents(void) const
+{
+  return extents_.size();
+}
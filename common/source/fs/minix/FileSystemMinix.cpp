@@ -583,6 +583,8 @@ bool FileSystemMinix::destroyInode(Inode* inode_ro_destroy)
 {
   debug(FS_MINIX, "destroyInode - going to remove inode from the volume.\n");
 
+  releaseReservedSectors(inode_ro_destroy);
+
   // free all used data-blocks
   for(sector_addr_t i = 0; inode_ro_destroy->getSector(i) != 0; i++)
   {
@@ -651,20 +653,24 @@ sector_addr_t FileSystemMinix::occupyAndReturnFreeBlock(bool clear_block)
   if(clear_block)
   {
     debug(FS_MINIX, "occupyAndReturnFreeBlock - resetting data-block.\n");
+    clearDataBlock(new_block_addr);
+  }
 
-    char* block = new char[getDataBlockSize()];
-    memset(block, 0x00, getDataBlockSize());
+  return new_block_addr;
+}
 
-    volume_manager_->acquireDataBlockForWriting(new_block_addr);
+void FileSystemMinix::clearDataBlock(sector_addr_t block_addr)
+{
+  char* block = new char[getDataBlockSize()];
+  memset(block, 0x00, getDataBlockSize());
 
-    // since this is the first time (and for sure the ONLY thread to write) to
-    // this data-block, no locking aids are required!
-    volume_manager_->writeDataBlockUnprotected(new_block_addr, block);
-    volume_manager_->releaseWriteDataBlock(new_block_addr, 0);
-    delete[] block;
-  }
+  volume_manager_->acquireDataBlockForWriting(block_addr);
 
-  return new_block_addr;
+  // since this is the first time (and for sure the ONLY thread to write) to
+  // this data-block, no locking aids are required!
+  volume_manager_->writeDataBlockUnprotected(block_addr, block);
+  volume_manager_->releaseWriteDataBlock(block_addr, 0);
+  delete[] block;
 }
 
 bool FileSystemMinix::freeOccupiedBlock(sector_addr_t block_address)
@@ -696,7 +702,38 @@ sector_addr_t FileSystemMinix::appendSectorToInode(Inode* inode, bool zero_out_s
 {
   debug(FS_MINIX, "appendSectorToInode - CALL InodeID=%d\n", inode->getID());
 
-  sector_addr_t next_free_zone = occupyAndReturnFreeBlock(zero_out_sector);
+  sector_addr_t next_free_zone = 0;
+
+  if(inode->getType() == Inode::InodeTypeFile)
+  {
+    // Files get their blocks out of a contiguous reservation, so concurrent
+    // appenders do not interleave their blocks
+    sector_addr_t reserved_sector = 0;
+    uint32 num_reserved_sectors = 0;
+    inode->getReservedSectors(reserved_sector, num_reserved_sectors);
+
+    if(num_reserved_sectors == 0 && reserveSectors(inode))
+      inode->getReservedSectors(reserved_sector, num_reserved_sectors);
+
+    if(num_reserved_sectors > 0)
+    {
+      inode->setReservedSectors(reserved_sector + 1, num_reserved_sectors - 1);
+
+      // the reservation exists in memory only, the zone gets occupied on
+      // the device as soon as it is used
+      if(zone_bitmap_->occupyReservedBit(reserved_sector - getFirstDataBlockAddress()))
+      {
+        next_free_zone = reserved_sector;
+
+        if(zero_out_sector)
+          clearDataBlock(next_free_zone);
+      }
+    }
+  }
+  else
+  {
+    next_free_zone = occupyAndReturnFreeBlock(zero_out_sector);
+  }
 
   if(next_free_zone == 0)
   {
@@ -710,10 +747,76 @@ sector_addr_t FileSystemMinix::appendSectorToInode(Inode* inode, bool zero_out_s
   return next_free_zone;
 }
 
+bool FileSystemMinix::reserveSectors(Inode* inode)
+{
+  uint32 num_sectors = inode->getNumSectors();
+
+  // the window grows with the File
+  bitmap_t window = num_sectors;
+  if(window < MIN_RESERVED_SECTORS)
+    window = MIN_RESERVED_SECTORS;
+  if(window > MAX_RESERVED_SECTORS)
+    window = MAX_RESERVED_SECTORS;
+
+  // the goal is the zone behind the File's last data block
+  bitmap_t goal = -1;
+  if(num_sectors > 0 && inode->getSector(num_sectors - 1) + 1 >= getFirstDataBlockAddress())
+    goal = inode->getSector(num_sectors - 1) + 1 - getFirstDataBlockAddress();
+
+  bitmap_t first_zone = -1;
+  bitmap_t num_zones = 0;
+
+  // continuing the File's last run (even if there are only a few zones free)
+  if(goal != (bitmap_t)-1)
+  {
+    num_zones = zone_bitmap_->reserveFreeBitsAt(goal, window);
+    if(num_zones > 0)
+      first_zone = goal;
+  }
+
+  // otherwise the next free run of the window size, smaller ones if the
+  // device is fragmented
+  for(; num_zones == 0 && window > 0; window /= 2)
+  {
+    first_zone = zone_bitmap_->reserveNextFreeBits(window, goal);
+    if(first_zone != (bitmap_t)-1)
+      num_zones = window;
+  }
+
+  if(num_zones == 0)
+  {
+    debug(FS_MINIX, "reserveSectors - no more free zones.\n");
+    return false;
+  }
+
+  debug(FS_MINIX, "reserveSectors - InodeID=%d reserved %d zones at %x\n", inode->getID(), num_zones, getFirstDataBlockAddress() + first_zone);
+  inode->setReservedSectors(getFirstDataBlockAddress() + first_zone, num_zones);
+  return true;
+}
+
+void FileSystemMinix::releaseReservedSectors(Inode* inode)
+{
+  sector_addr_t reserved_sector = 0;
+  uint32 num_reserved_sectors = 0;
+  inode->getReservedSectors(reserved_sector, num_reserved_sectors);
+
+  if(num_reserved_sectors == 0)
+    return;
+
+  debug(FS_MINIX, "releaseReservedSectors - InodeID=%d releasing %d zones at %x\n", inode->getID(), num_reserved_sectors, reserved_sector);
+
+  zone_bitmap_->releaseReservedBits(reserved_sector - getFirstDataBlockAddress(), num_reserved_sectors);
+
+  inode->setReservedSectors(0, 0);
+}
+
 sector_addr_t FileSystemMinix::removeSectorFromInode(Inode* inode, uint32 sector_to_remove)
 {
   debug(FS_MINIX, "removeSectorFromInode - CALL InodeID=%d\n", inode->getID());
 
+  // the reservation does not follow the File's last block any more
+  releaseReservedSectors(inode);
+
   // getting address of Inode's last sector
   sector_addr_t inode_last_sector = inode->getSector( sector_to_remove );
 
@@ -740,6 +843,9 @@ sector_addr_t FileSystemMinix::removeLastSectorOfInode(Inode* inode)
 {
   debug(FS_MINIX, "removeLastSectorOfInode - CALL InodeID=%d\n", inode->getID());
 
+  // the reservation does not follow the File's last block any more
+  releaseReservedSectors(inode);
+
   // getting address of Inode's last sector
   sector_addr_t inode_last_sector = inode->getSector( inode->getNumSectors() - 1 );
 
@@ -756,9 +862,11 @@ sector_addr_t FileSystemMinix::removeLastSectorOfInode(Inode* inode)
   return inode_last_sector;
 }
 
-void FileSystemMinix::updateInodesSectorList(Inode* inode __attribute__((unused)))
+void FileSystemMinix::updateInodesSectorList(Inode* inode, uint32 number)
 {
-  // already fully loaded initially, so here is nothing left to do
+  // the direct data blocks are loaded initially, the indirect addressed ones
+  // are loaded on demand by the InodeTable
+  inode_table_->loadDataBlocks(inode, number);
 }
 
 bool FileSystemMinix::addDirectoryEntry(Directory* parent, const char* name, uint16 inode)
@@ -60,7 +60,7 @@ Inode* InodeTableMinix::createInodeFromDeviceData(inode_id_t id,
   {
     if(node_data->i_zone[i] != UNUSED_DATA_BLOCK)
     {
-      inode->addSector(node_data->i_zone[i]);
+      inode->addLoadedSector(node_data->i_zone[i]);
       debug(INODE_TABLE, "InodeTableMinix::createInodeFromDeviceData - added direct sector=%x\n", node_data->i_zone[i]);
     }
   }
@@ -68,11 +68,9 @@ Inode* InodeTableMinix::createInodeFromDeviceData(inode_id_t id,
   inode->setIndirectBlock(1, node_data->i_zone[7]);
   inode->setIndirectBlock(2, node_data->i_zone[8]);
 
-  // resolve and load indirect data-sectors
-  // i_zone[7] points to a single in-direct block and i_zone[8]
-  // to a double-indirect block; all sector lens are 16bit (=2byte)
-  fs_->resolveIndirectDataBlocks(inode, node_data->i_zone[7], 1, 2);
-  fs_->resolveIndirectDataBlocks(inode, node_data->i_zone[8], 2, 2);
+  // the indirect data-sectors are loaded on demand (loadDataBlocks())
+  inode->setAllSectorsLoaded(node_data->i_zone[7] == UNUSED_DATA_BLOCK);
+  inode->setSectorListModified(false);
 
   return inode;
 }
@@ -142,10 +140,20 @@ uint16 InodeTableMinix::convertInodeTypeToMinixMode(Inode::InodeType type)
   return 0;
 }
 
+void InodeTableMinix::loadDataBlocks(Inode* inode, uint32 number)
+{
+  // 7 direct blocks, the single / double in-direct blocks follow
+  fs_->loadIndirectDataBlocks(inode, number, 7, 2, MINIX_DATA_BLOCK_ADDR_LEN);
+}
+
 void InodeTableMinix::storeDataBlocksToInode(Inode* inode, minix_inode* node_data)
 {
   debug(INODE_TABLE, "storeDataBlocksToInode - going to store %d\n", inode->getID());
 
+  // the data blocks on the disk are still up to date
+  if(!inode->isSectorListModified())
+    return;
+
   // first seven sectors are directly addressed
   for(uint16 i = 0; i < 7; i++)
   {
@@ -171,6 +179,8 @@ void InodeTableMinix::storeDataBlocksToInode(Inode* inode, minix_inode* node_dat
 
   inode->setIndirectBlock(1, sgl_indirect);
   inode->setIndirectBlock(2, dbl_indirect);
+
+  inode->setSectorListModified(false);
 }
 
 bool InodeTableMinix::storeInode(inode_id_t id, Inode* inode)
@@ -67,7 +67,7 @@ Inode* InodeTableMinixV2::createInodeFromDeviceData(inode_id_t id,
   {
     if(node_data->i_zone[i] != UNUSED_DATA_BLOCK)
     {
-      inode->addSector(node_data->i_zone[i]);
+      inode->addLoadedSector(node_data->i_zone[i]);
       debug(INODE_TABLE, "createInodeFromDeviceData - added direct sector=%x\n", node_data->i_zone[i]);
     }
   }
@@ -76,12 +76,9 @@ Inode* InodeTableMinixV2::createInodeFromDeviceData(inode_id_t id,
   inode->setIndirectBlock(2, node_data->i_zone[8]);
   inode->setIndirectBlock(3, node_data->i_zone[9]);
 
-  // resolve and load indirect data-sectors
-  // i_zone[7] points to a single in-direct block and i_zone[8]
-  // to a double-indirect block; all sector lens are 16bit (=2byte)
-  fs_->resolveIndirectDataBlocks(inode, node_data->i_zone[7], 1, 2);
-  fs_->resolveIndirectDataBlocks(inode, node_data->i_zone[8], 2, 2);
-  fs_->resolveIndirectDataBlocks(inode, node_data->i_zone[9], 3, 2);
+  // the indirect data-sectors are loaded on demand (loadDataBlocks())
+  inode->setAllSectorsLoaded(node_data->i_zone[7] == UNUSED_DATA_BLOCK);
+  inode->setSectorListModified(false);
 
   return inode;
 }
@@ -207,10 +204,20 @@ bool InodeTableMinixV2::storeInode(inode_id_t id, Inode* inode)
   return true;
 }
 
+void InodeTableMinixV2::loadDataBlocks(Inode* inode, uint32 number)
+{
+  // 7 direct blocks, the single / double / triple in-direct blocks follow
+  fs_->loadIndirectDataBlocks(inode, number, 7, 3, MINIX_V2_DATA_BLOCK_ADDR_LEN);
+}
+
 void InodeTableMinixV2::storeDataBlocksToInode(Inode* inode, minix2_inode* node_data)
 {
   debug(INODE_TABLE, "storeDataBlocksToInode - going to store %d\n", inode->getID());
 
+  // the data blocks on the disk are still up to date
+  if(!inode->isSectorListModified())
+    return;
+
   // first seven sectors are directly addressed
   for(uint16 i = 0; i < 7; i++)
   {
@@ -240,6 +247,8 @@ void InodeTableMinixV2::storeDataBlocksToInode(Inode* inode, minix2_inode* node_
   inode->setIndirectBlock(1, sgl_indirect);
   inode->setIndirectBlock(2, dbl_indirect);
   inode->setIndirectBlock(3, tri_indirect);
+
+  inode->setSectorListModified(false);
 }
 
 sector_addr_t InodeTableMinixV2::getInodeSectorAddr(inode_id_t id)
@@ -0,0 +1,124 @@
+/**
+ * Filename: FsLockStressTest.cpp
+ * Description:
+ *
+ * Created on: 18.10.2026
+ */
+
+#ifndef USE_FILE_SYSTEM_ON_GUEST_OS
+
+#include "fs/tests/FsLockStressTest.h"
+
+#include "Scheduler.h"
+#include "kprintf.h"
+#include "fs/FileSystemLock.h"
+
+FsLockStressTest::FsLockStressTest() : lock_(NULL), counter_(0), threads_lock_("FsLockStressTest::threads_lock_"),
+    all_threads_done_(&threads_lock_), threads_running_(0)
+{
+}
+
+FsLockStressTest::~FsLockStressTest()
+{
+}
+
+void FsLockStressTest::start()
+{
+  FsLockStressTest* test = new FsLockStressTest();
+  test->run();
+  delete test;
+}
+
+void FsLockStressTest::run()
+{
+  kprintf("FsLockStressTest: %d lock acquisitions per thread\n", OPS_PER_THREAD);
+
+  for(uint32 write_ratio = 0; write_ratio <= WRITE_RATIO; write_ratio += WRITE_RATIO)
+  {
+    for(uint32 num_threads = 1; num_threads <= MAX_THREADS; num_threads *= 2)
+    {
+      uint32 ticks = runThreads(num_threads, write_ratio);
+      uint32 total_ops = num_threads * OPS_PER_THREAD;
+
+      kprintf("FsLockStressTest: %s threads=%d ops=%d ticks=%d ops/tick=%d\n",
+              write_ratio ? "1/8 writes" : "reads only", num_threads, total_ops, ticks,
+              ticks > 0 ? total_ops / ticks : total_ops);
+
+      uint32 expected = write_ratio ? num_threads * (OPS_PER_THREAD / write_ratio) : 0;
+      if(counter_ != expected)
+        kprintf("FsLockStressTest: ERROR %d writes expected, counted %d\n", expected, counter_);
+    }
+  }
+}
+
+uint32 FsLockStressTest::runThreads(uint32 num_threads, uint32 write_ratio)
+{
+  lock_ = FileSystemLock::getNewFSLock();
+  counter_ = 0;
+
+  threads_lock_.acquire();
+  threads_running_ = num_threads;
+  uint32 start_ticks = Scheduler::instance()->getTicks();
+
+  for(uint32 i = 0; i < num_threads; i++)
+  {
+    Scheduler::instance()->addNewThread(new LockThread(this, write_ratio));
+  }
+
+  while(threads_running_ > 0)
+    all_threads_done_.wait();
+
+  uint32 ticks = Scheduler::instance()->getTicks() - start_ticks;
+  threads_lock_.release();
+
+  delete lock_;
+  lock_ = NULL;
+
+  return ticks;
+}
+
+void FsLockStressTest::threadDone()
+{
+  threads_lock_.acquire();
+
+  threads_running_--;
+  if(threads_running_ == 0)
+    all_threads_done_.signal();
+
+  threads_lock_.release();
+}
+
+FsLockStressTest::LockThread::LockThread(FsLockStressTest* test, uint32 write_ratio) :
+    Thread("FsLockStressTest::LockThread"), test_(test), write_ratio_(write_ratio)
+{
+}
+
+void FsLockStressTest::LockThread::Run()
+{
+  for(uint32 i = 1; i <= OPS_PER_THREAD; i++)
+  {
+    bool write = (write_ratio_ != 0 && i % write_ratio_ == 0);
+
+    if(write)
+      test_->lock_->acquireWriteBlocking();
+    else
+      test_->lock_->acquireReadBlocking();
+
+    // a non-atomic update, it is lost if the lock does not work
+    volatile uint32 value = test_->counter_;
+    for(uint32 j = 0; j < WORK_LOOPS; j++)
+      value = value + 0;
+
+    if(write)
+    {
+      test_->counter_ = value + 1;
+      test_->lock_->releaseWrite();
+    }
+    else
+      test_->lock_->releaseRead();
+  }
+
+  test_->threadDone();
+}
+
+#endif
@@ -0,0 +1,141 @@
+/**
+ * Filename: GeneralCacheStressTest.cpp
+ * Description:
+ *
+ * Created on: 18.10.2026
+ */
+
+#ifndef USE_FILE_SYSTEM_ON_GUEST_OS
+
+#include "fs/tests/GeneralCacheStressTest.h"
+
+#include "Scheduler.h"
+#include "kprintf.h"
+#include "cache/GeneralCache.h"
+#include "cache/HashedFifoReadCache.h"
+#include "fs/DeviceCache.h"
+
+namespace
+{
+
+/**
+ * @class a memory-only device handing out zeroed sectors
+ */
+class StressTestDevice : public Cache::DeviceAdapter
+{
+public:
+  virtual Cache::Item* read(const Cache::ItemIdentity& ident __attribute__((unused)))
+  {
+    char* data = new char[SECTOR_SIZE];
+    for(uint32 i = 0; i < SECTOR_SIZE; i++)
+      data[i] = 0;
+
+    return new SectorCacheItem(data);
+  }
+
+  virtual bool write(const Cache::ItemIdentity& ident __attribute__((unused)),
+                     Cache::Item* data __attribute__((unused)))
+  {
+    return true;
+  }
+
+  virtual bool remove(const Cache::ItemIdentity& ident __attribute__((unused)),
+                      Cache::Item* item __attribute__((unused)))
+  {
+    return true;
+  }
+
+  static const uint32 SECTOR_SIZE = 512;
+};
+
+}
+
+GeneralCacheStressTest::GeneralCacheStressTest() : cache_(NULL), readers_lock_("GeneralCacheStressTest::readers_lock_"),
+    all_readers_done_(&readers_lock_), readers_running_(0)
+{
+}
+
+GeneralCacheStressTest::~GeneralCacheStressTest()
+{
+}
+
+void GeneralCacheStressTest::start()
+{
+  GeneralCacheStressTest* test = new GeneralCacheStressTest();
+  test->run();
+  delete test;
+}
+
+void GeneralCacheStressTest::run()
+{
+  kprintf("GeneralCacheStressTest: %d getItem/releaseItem pairs per reader\n", OPS_PER_READER);
+
+  for(uint32 num_readers = 1; num_readers <= MAX_READERS; num_readers *= 2)
+  {
+    uint32 ticks = runReaders(num_readers);
+    uint32 total_ops = num_readers * OPS_PER_READER;
+
+    kprintf("GeneralCacheStressTest: readers=%d ops=%d ticks=%d ops/tick=%d\n",
+            num_readers, total_ops, ticks, ticks > 0 ? total_ops / ticks : total_ops);
+  }
+}
+
+uint32 GeneralCacheStressTest::runReaders(uint32 num_readers)
+{
+  StressTestDevice device;
+
+  // the cache is large enough to hold the sectors of all readers
+  cache_ = new Cache::GeneralCache(&device, 0, MAX_READERS * SECTORS_PER_READER);
+  cache_->setReadStrategy(new Cache::HashedFifoReadCache(cache_));
+
+  readers_lock_.acquire();
+  readers_running_ = num_readers;
+  uint32 start_ticks = Scheduler::instance()->getTicks();
+
+  for(uint32 i = 0; i < num_readers; i++)
+  {
+    Scheduler::instance()->addNewThread(new ReaderThread(this, i * SECTORS_PER_READER));
+  }
+
+  while(readers_running_ > 0)
+    all_readers_done_.wait();
+
+  uint32 ticks = Scheduler::instance()->getTicks() - start_ticks;
+  readers_lock_.release();
+
+  delete cache_;
+  cache_ = NULL;
+
+  return ticks;
+}
+
+void GeneralCacheStressTest::readerDone()
+{
+  readers_lock_.acquire();
+
+  readers_running_--;
+  if(readers_running_ == 0)
+    all_readers_done_.signal();
+
+  readers_lock_.release();
+}
+
+GeneralCacheStressTest::ReaderThread::ReaderThread(GeneralCacheStressTest* test, uint32 first_sector) :
+    Thread("GeneralCacheStressTest::ReaderThread"), test_(test), first_sector_(first_sector)
+{
+}
+
+void GeneralCacheStressTest::ReaderThread::Run()
+{
+  for(uint32 i = 0; i < OPS_PER_READER; i++)
+  {
+    SectorCacheIdent ident(first_sector_ + (i * 7) % SECTORS_PER_READER, StressTestDevice::SECTOR_SIZE);
+
+    if(test_->cache_->getItem(ident) != NULL)
+      test_->cache_->releaseItem(ident);
+  }
+
+  test_->readerDone();
+}
+
+#endif
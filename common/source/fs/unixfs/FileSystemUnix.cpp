@@ -46,70 +46,161 @@ int32 FileSystemUnix::fsync(Inode* inode)
       ret_val = 0;
   }
 
+  // barrier: the written data has to leave the drive's write cache
+  if(volume_manager_ != NULL && !volume_manager_->flushDeviceCache())
+    ret_val = -1;
+
   return ret_val;
 }
 
-void FileSystemUnix::resolveIndirectDataBlocks(Inode* inode, sector_addr_t indirect_block, uint16 degree_of_indirection, uint16 sector_addr_len)
+sector_addr_t FileSystemUnix::readIndirectBlockEntry(const char* sector, uint32 entry,
+    uint16 sector_addr_len)
 {
-  if(indirect_block == UNUSED_DATA_BLOCK)
-  {
-    debug(FS_UNIX, "resolveIndirectDataBlocks - indirect_block is not in use - quit\n");
-    return;
-  }
+  sector_addr_t address = 0;
 
-  if(degree_of_indirection == 0)
+  // reading the sector entry in a very flexible way
+  for(uint16 j = 0; j < sector_addr_len; j++)
   {
-    debug(FS_UNIX, "resolveIndirectDataBlocks - sorry this method only works for indirect blocks - quit\n");
-    return;
+    address |= ((uint8)(sector[entry * sector_addr_len + j])) << (8*j);
   }
 
-  debug(FS_UNIX, "resolveIndirectDataBlocks - indirect_block %x deg_of_indirection=%d\n", indirect_block, degree_of_indirection);
+  return address;
+}
+
+void FileSystemUnix::loadIndirectDataBlocks(Inode* inode, uint32 number, uint32 num_direct_blocks,
+    uint16 max_degree_of_indirection, uint16 sector_addr_len)
+{
   FileSystem* fs = inode->getFileSystem();
   assert(fs != NULL);
-  FsVolumeManager* volume_manager = fs->getVolumeManager();
+
+  // number of addresses per indirect block
+  const uint32 entries_per_block = fs->getDataBlockSize() / sector_addr_len;
+
+  while(!inode->areAllSectorsLoaded() && inode->getNumLoadedSectors() <= number)
+  {
+    uint32 loaded = inode->getNumLoadedSectors();
+
+    // a direct data-block is missing, so the list is complete
+    if(loaded < num_direct_blocks)
+    {
+      inode->setAllSectorsLoaded(true);
+      break;
+    }
+
+    // find the indirection tree holding the next data block and the
+    // index of the data block within the tree
+    uint32 index = loaded - num_direct_blocks;
+    uint32 tree_size = entries_per_block;
+    uint16 degree = 1;
+
+    while(degree <= max_degree_of_indirection && index >= tree_size)
+    {
+      index -= tree_size;
+      tree_size *= entries_per_block;
+      degree++;
+    }
+
+    if(degree > max_degree_of_indirection ||
+       !loadIndirectBlock(inode, inode->getIndirectBlock(degree), degree, index, number,
+                          entries_per_block, sector_addr_len))
+    {
+      // from here on there are no more indirect blocks to resolve
+      debug(FS_UNIX, "loadIndirectDataBlocks - all data blocks of the i-node are loaded\n");
+      inode->setAllSectorsLoaded(true);
+    }
+  }
+}
+
+bool FileSystemUnix::loadIndirectBlock(Inode* inode, sector_addr_t indirect_block,
+    uint16 degree_of_indirection, uint32 index, uint32 number,
+    uint32 entries_per_block, uint16 sector_addr_len)
+{
+  if(indirect_block == UNUSED_DATA_BLOCK)
+    return false;
+
+  debug(FS_UNIX, "loadIndirectBlock - indirect_block %x deg_of_indirection=%d\n", indirect_block, degree_of_indirection);
+  FsVolumeManager* volume_manager = inode->getFileSystem()->getVolumeManager();
   assert(volume_manager != NULL);
 
-  // lock sector for reading
+  // lock sector for reading and readout sector data
   volume_manager->acquireDataBlockForReading(indirect_block);
-
-  // readout sector data
   char* sector = volume_manager->readDataBlockUnprotected(indirect_block);
+  volume_manager->releaseReadDataBlock(indirect_block);
 
-  // scan the current block for more indirect blocks
-  for(sector_len_t i = 0; i < fs->getDataBlockSize(); i+= sector_addr_len)
+  if(sector == NULL)
   {
-    sector_addr_t new_sector = 0;
+    debug(FS_UNIX, "loadIndirectBlock - ERROR failed to read block %x!\n", indirect_block);
+    return false;
+  }
 
-    // reading the current sector entry in a very flexible way
-    for(uint16 j = 0; j < sector_addr_len; j++)
+  // number of data blocks addressed by each entry of this block
+  uint32 subtree_size = 1;
+  for(uint16 i = 1; i < degree_of_indirection; i++)
+    subtree_size *= entries_per_block;
+
+  bool more_blocks = true;
+
+  // single-indirect block means that the gained (resolved) sector-addresses
+  // point to data-blocks of the i_node, a single-indirect block is always
+  // loaded completely, runs of contiguous data-blocks are added at once
+  if(degree_of_indirection == 1)
+  {
+    sector_addr_t run_start = UNUSED_DATA_BLOCK;
+    uint32 run_length = 0;
+
+    for(uint32 entry = index; entry < entries_per_block; entry++)
     {
-      //debug(FS_UNIX, "resolveIndirectDataBlocks - sector[%d + %d]=%x\n", i, j, (uint8)sector[i + j]);
-      new_sector |= ((uint8)(sector[i + j])) << (8*j);
+      sector_addr_t new_sector = readIndirectBlockEntry(sector, entry, sector_addr_len);
+
+      if(new_sector == UNUSED_DATA_BLOCK)
+      {
+        more_blocks = false;
+        break;
+      }
+
+      if(run_length > 0 && run_start + run_length == new_sector)
+      {
+        run_length++;
+        continue;
+      }
+
+      inode->addLoadedSectors(run_start, run_length);
+      run_start = new_sector;
+      run_length = 1;
     }
 
+    inode->addLoadedSectors(run_start, run_length);
+
+    delete[] sector;
+    return more_blocks;
+  }
+
+  for(uint32 entry = index / subtree_size; entry < entries_per_block; entry++)
+  {
+    sector_addr_t new_sector = readIndirectBlockEntry(sector, entry, sector_addr_len);
+
     if(new_sector == UNUSED_DATA_BLOCK)
     {
-      // from here on there are no more indirect blocks to resolve, we can quit
-      debug(FS_UNIX, "resolveIndirectDataBlocks - quit search for indirect blocks\n");
+      more_blocks = false;
       break;
     }
 
-    debug(FS_UNIX, "resolveIndirectDataBlocks - new_sector=%x\n", new_sector);
+    // the requested data block is loaded already
+    if(inode->getNumLoadedSectors() > number)
+      break;
 
-    // single-indirect block means that the gained (resolved) sector-address
-    // points to a data-block of the i_node
-    if(degree_of_indirection == 1)
-    {
-      inode->addSector(new_sector);
-    }
-    else
+    uint32 sub_index = (entry == index / subtree_size) ? index % subtree_size : 0;
+
+    if(!loadIndirectBlock(inode, new_sector, degree_of_indirection - 1, sub_index, number,
+                          entries_per_block, sector_addr_len))
     {
-      resolveIndirectDataBlocks(inode, new_sector, degree_of_indirection-1, sector_addr_len);
+      more_blocks = false;
+      break;
     }
   }
 
-  volume_manager->releaseReadDataBlock(indirect_block);
   delete[] sector;
+  return more_blocks;
 }
 
 sector_addr_t FileSystemUnix::storeIndirectDataBlocks(Inode* inode, sector_addr_t inode_sector_to_store,
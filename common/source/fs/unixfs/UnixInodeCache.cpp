@@ -38,6 +38,11 @@ bool UnixInodeIdent::operator==(const Cache::ItemIdentity& cmp)
   return (p_cmp->getInodeID() == this->getInodeID());
 }
 
+uint32 UnixInodeIdent::hash(void) const
+{
+  return inode_id_;
+}
+
 Cache::ItemIdentity* UnixInodeIdent::clone(void) const
 {
   return new UnixInodeIdent(getInodeID());
@@ -11,16 +11,26 @@
 #include "ArchInterrupts.h"
 #include "Syscall.h"
 #include "fs/VfsSyscall.h"
+#include "fs/FsWorkingDirectory.h"
+#include "MemoryMapping.h"
 #include <ustl/uvector.h>
 
 
 Loader::Loader ( ssize_t fd, Thread *thread ) : fd_ ( fd ),
-    thread_ ( thread ), hdr_(0), phdrs_(), load_lock_("Loader::load_lock_")
+    thread_ ( thread ), hdr_(0), phdrs_(), load_lock_("Loader::load_lock_"),
+    mappings_()
 {
 }
 
 Loader::~Loader()
 {
+  // the changes of shared mappings are not lost when the process exits,
+  // the pages themselves are freed together with the address space
+  for (size_t i = 0; i < mappings_.size(); ++i)
+  {
+    mappings_[i]->sync(arch_memory_, mappings_[i]->getFirstPage(), mappings_[i]->getNumPages(), false);
+    delete mappings_[i];
+  }
   delete hdr_;
 }
 
@@ -39,8 +49,8 @@ bool Loader::readHeaders()
 
   hdr_ = new Elf::Ehdr;
 
-  VfsSyscall::instance()->lseek(currentThread->getWorkingDirInfo(), fd_, 0, SEEK_SET);
-  if(!hdr_ || VfsSyscall::instance()->read(currentThread->getWorkingDirInfo(), fd_, reinterpret_cast<char*>(hdr_),
+  VfsSyscall::instance()->lseek(thread_->getWorkingDirInfo(), fd_, 0, SEEK_SET);
+  if(!hdr_ || VfsSyscall::instance()->read(thread_->getWorkingDirInfo(), fd_, reinterpret_cast<char*>(hdr_),
               sizeof(Elf::Ehdr)) != sizeof(Elf::Ehdr))
   {
     return false;
@@ -59,9 +69,9 @@ bool Loader::readHeaders()
 
   phdrs_.resize(hdr_->e_phnum, true);
 
-  VfsSyscall::instance()->lseek(currentThread->getWorkingDirInfo(), fd_, hdr_->e_phoff, SEEK_SET);
+  VfsSyscall::instance()->lseek(thread_->getWorkingDirInfo(), fd_, hdr_->e_phoff, SEEK_SET);
 
-  if(VfsSyscall::instance()->read(currentThread->getWorkingDirInfo(), fd_, reinterpret_cast<char*>(&phdrs_[0]), hdr_->e_phnum*sizeof(Elf::Phdr))
+  if(VfsSyscall::instance()->read(thread_->getWorkingDirInfo(), fd_, reinterpret_cast<char*>(&phdrs_[0]), hdr_->e_phnum*sizeof(Elf::Phdr))
       != static_cast<ssize_t>(sizeof(Elf::Phdr)*hdr_->e_phnum))
   {
     return false;
@@ -117,6 +127,18 @@ void Loader::loadOnePageSafeButSlow ( pointer virtual_address )
     return;
   }
 
+  size_t mapping = findMapping(virtual_page);
+  if (mapping < mappings_.size())
+  {
+    if (!mappings_[mapping]->loadPage(arch_memory_, virtual_page))
+    {
+      kprintfd ( "Loader::loadOnePageSafeButSlow: ERROR cannot read mapped page: v_adddr=%x, v_page=%d\n", virtual_address, virtual_page);
+      load_lock_.release();
+      Syscall::exit ( 9995 );
+    }
+    return;
+  }
+
   debug ( LOADER,"loadOnePageSafeButSlow: going to load virtual page %d (virtual_address=%d) for %d:%s\n",virtual_page,virtual_address,currentThread->getPID(),currentThread->getName() );
 
   debug ( LOADER,"loadOnePage: Num ents: %d\n",hdr_->e_phnum );
@@ -236,14 +258,14 @@ void Loader::loadOnePageSafeButSlow ( pointer virtual_address )
   }
 
 
-  VfsSyscall::instance()->lseek(currentThread->getWorkingDirInfo(), fd_, min_value, SEEK_SET);
-  ssize_t bytes_read = VfsSyscall::instance()->read(currentThread->getWorkingDirInfo(), fd_, (char*)buffer, max_value - min_value);
+  VfsSyscall::instance()->lseek(thread_->getWorkingDirInfo(), fd_, min_value, SEEK_SET);
+  ssize_t bytes_read = VfsSyscall::instance()->read(thread_->getWorkingDirInfo(), fd_, (char*)buffer, max_value - min_value);
 
   if(bytes_read != static_cast<ssize_t>(max_value - min_value))
   {
     if (bytes_read == -1)
     {
-      if (FileDescriptor::getFileDescriptor(fd_) == NULL)
+      if (thread_->getWorkingDirInfo()->getFileDescriptorTable()->get(fd_) == NULL)
       {
         kprintfd("Loader::loadOnePageSafeButSlow: ERROR cannot read from a closed file descriptor\n");
         assert(false);
@@ -282,3 +304,94 @@ void Loader::loadOnePageSafeButSlow ( pointer virtual_address )
   debug ( PM,"loadOnePageSafeButSlow: wrote a total of %d bytes\n",written );
 
 }
+
+size_t Loader::findMapping ( size_t virtual_page ) const
+{
+  for (size_t i = 0; i < mappings_.size(); ++i)
+  {
+    if (mappings_[i]->contains(virtual_page))
+      return i;
+  }
+  return mappings_.size();
+}
+
+size_t Loader::mapMemory ( size_t num_pages, bool writeable, bool shared, FileDescriptor* file, size_t offset )
+{
+  MutexLock loadlock(load_lock_);
+
+  // first fit between the existing mappings
+  size_t first_page = MAPPING_START_PAGE;
+  size_t index = 0;
+  for (; index < mappings_.size(); ++index)
+  {
+    if (mappings_[index]->getFirstPage() - first_page >= num_pages)
+      break;
+    first_page = mappings_[index]->getFirstPage() + mappings_[index]->getNumPages();
+  }
+
+  if (num_pages > MAPPING_END_PAGE - first_page)
+  {
+    debug ( LOADER,"mapMemory: no room for %d pages\n", num_pages );
+    delete file;
+    return 0;
+  }
+
+  mappings_.insert(mappings_.begin() + index,
+                   new MemoryMapping(first_page, num_pages, writeable, shared, file, offset));
+  debug ( LOADER,"mapMemory: mapped %d pages at page %x\n", num_pages, first_page );
+  return first_page;
+}
+
+int32 Loader::unmapMemory ( size_t first_page, size_t num_pages )
+{
+  MutexLock loadlock(load_lock_);
+  size_t end_page = first_page + num_pages;
+  int32 result = 0;
+
+  for (size_t i = 0; i < mappings_.size(); )
+  {
+    MemoryMapping* mapping = mappings_[i];
+    size_t mapping_end = mapping->getFirstPage() + mapping->getNumPages();
+    if (mapping_end <= first_page || mapping->getFirstPage() >= end_page)
+    {
+      ++i;
+      continue;
+    }
+
+    // the parts outside of the range stay mapped
+    if (mapping->getFirstPage() < first_page)
+    {
+      mappings_.insert(mappings_.begin() + i + 1, mapping->split(first_page));
+      ++i;
+      continue;
+    }
+    if (mapping_end > end_page)
+      mappings_.insert(mappings_.begin() + i + 1, mapping->split(end_page));
+
+    if (mapping->sync(arch_memory_, mapping->getFirstPage(), mapping->getNumPages(), false) != 0)
+      result = -1;
+    mapping->unmap(arch_memory_);
+
+    mappings_.erase(mappings_.begin() + i);
+    delete mapping;
+  }
+  return result;
+}
+
+int32 Loader::syncMemory ( size_t first_page, size_t num_pages, bool synchronous )
+{
+  MutexLock loadlock(load_lock_);
+  size_t end_page = first_page + num_pages;
+  int32 result = 0;
+
+  for (size_t i = 0; i < mappings_.size(); ++i)
+  {
+    MemoryMapping* mapping = mappings_[i];
+    if (mapping->getFirstPage() + mapping->getNumPages() <= first_page || mapping->getFirstPage() >= end_page)
+      continue;
+
+    if (mapping->sync(arch_memory_, first_page, num_pages, synchronous) != 0)
+      result = -1;
+  }
+  return result;
+}
@@ -0,0 +1,155 @@
+/**
+ * Filename: MemoryMapping.cpp
+ * Description:
+ *
+ * Created on: 18.10.2026
+ */
+
+#include "MemoryMapping.h"
+#include "ArchMemory.h"
+#include "ArchCommon.h"
+#include "mm/PageManager.h"
+#include "fs/FileDescriptor.h"
+#include "fs/FileSystem.h"
+#include "fs/inodes/File.h"
+#include "console/kprintf.h"
+#include "assert.h"
+
+MemoryMapping::MemoryMapping(size_t first_page, size_t num_pages, bool writeable, bool shared,
+                             FileDescriptor* file, size_t offset) :
+    first_page_(first_page), writeable_(writeable), shared_(shared), file_(file),
+    offset_(offset), pages_()
+{
+  pages_.resize(num_pages, 0);
+}
+
+MemoryMapping::~MemoryMapping()
+{
+  delete file_;
+}
+
+size_t MemoryMapping::getFirstPage(void) const
+{
+  return first_page_;
+}
+
+size_t MemoryMapping::getNumPages(void) const
+{
+  return pages_.size();
+}
+
+bool MemoryMapping::contains(size_t virtual_page) const
+{
+  return virtual_page >= first_page_ && virtual_page < first_page_ + pages_.size();
+}
+
+bool MemoryMapping::loadPage(ArchMemory& arch_memory, size_t virtual_page)
+{
+  assert(contains(virtual_page));
+  size_t index = virtual_page - first_page_;
+
+  size_t page = PageManager::instance()->getFreePhysicalPage();
+  char* data = reinterpret_cast<char*>(ArchMemory::getIdentAddressOfPPN(page));
+
+  // the part behind the end of the file stays zero
+  ArchCommon::bzero((pointer) data, PAGE_SIZE, false);
+
+  if(file_ != NULL)
+  {
+    int32 read = file_->getFile()->pread(file_, data, PAGE_SIZE, offset_ + index * PAGE_SIZE);
+    if(read < 0)
+    {
+      debug(LOADER, "MemoryMapping::loadPage: reading page %d failed (%d)\n", virtual_page, read);
+      PageManager::instance()->freePage(page);
+      return false;
+    }
+  }
+
+  arch_memory.mapPage(virtual_page, page, 1);
+
+  // the page table entry might still carry the flag of a previous mapping
+  arch_memory.checkAndClearDirty(virtual_page);
+
+  if(!writeable_)
+    arch_memory.setPageWriteable(virtual_page, 0);
+
+  pages_[index] = page;
+  return true;
+}
+
+int32 MemoryMapping::sync(ArchMemory& arch_memory, size_t first_page, size_t num_pages, bool synchronous)
+{
+  if(!shared_ || !writeable_ || file_ == NULL || first_page + num_pages <= first_page_)
+    return 0;
+
+  File* file = file_->getFile();
+
+  // the intersection of the range with the mapping
+  size_t begin = first_page > first_page_ ? first_page - first_page_ : 0;
+  size_t end = first_page + num_pages - first_page_;
+  if(end > pages_.size())
+    end = pages_.size();
+
+  int32 result = 0;
+  bool written = false;
+
+  for(size_t index = begin; index < end; ++index)
+  {
+    // the flag is cleared before writing, so writes during the write back
+    // mark the page dirty again
+    if(pages_[index] == 0 || !arch_memory.checkAndClearDirty(first_page_ + index))
+      continue;
+
+    // the file is not extended, the part of a page behind EOF is dropped
+    file_size_t pos = offset_ + index * PAGE_SIZE;
+    file_size_t file_size = file->getFileSize();
+    if(pos >= file_size)
+      continue;
+
+    uint32 length = PAGE_SIZE;
+    if(file_size - pos < length)
+      length = file_size - pos;
+
+    const char* data = reinterpret_cast<const char*>(ArchMemory::getIdentAddressOfPPN(pages_[index]));
+    if(file->pwrite(file_, data, length, pos) != static_cast<int32>(length))
+    {
+      debug(LOADER, "MemoryMapping::sync: writing page %d failed\n", first_page_ + index);
+      result = -1;
+    }
+
+    written = true;
+  }
+
+  if(written && synchronous)
+    file->getFileSystem()->fsync(file);
+
+  return result;
+}
+
+void MemoryMapping::unmap(ArchMemory& arch_memory)
+{
+  for(size_t index = 0; index < pages_.size(); ++index)
+  {
+    // frees the physical page as well
+    if(pages_[index] != 0)
+      arch_memory.unmapPage(first_page_ + index);
+
+    pages_[index] = 0;
+  }
+}
+
+MemoryMapping* MemoryMapping::split(size_t virtual_page)
+{
+  assert(contains(virtual_page) && virtual_page > first_page_);
+  size_t index = virtual_page - first_page_;
+
+  FileDescriptor* file = file_ != NULL ? new FileDescriptor(*file_) : NULL;
+  MemoryMapping* tail = new MemoryMapping(virtual_page, pages_.size() - index, writeable_,
+                                          shared_, file, offset_ + index * PAGE_SIZE);
+
+  for(size_t i = index; i < pages_.size(); ++i)
+    tail->pages_[i - index] = pages_[i];
+
+  pages_.resize(index);
+  return tail;
+}
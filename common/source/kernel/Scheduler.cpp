@@ -9,6 +9,7 @@
 #include "ArchCommon.h"
 #include "console/kprintf.h"
 #include "ArchInterrupts.h"
+#include "util/string.h"
 #include "mm/KernelMemoryManager.h"
 #include <ustl/ulist.h>
 #include "backtrace.h"
@@ -80,6 +81,7 @@ void Scheduler::createScheduler()
   // create idle thread, this one really does not do too much
 
   Thread *idle = new IdleThread();
+  instance_->idle_thread_ = idle;
   instance_->addNewThread ( idle );
 }
 
@@ -87,6 +89,11 @@ Scheduler::Scheduler()
 {
   block_scheduling_=0;
   ticks_=0;
+  memset(run_queues_, 0, sizeof(run_queues_));
+  active_ = &run_queues_[0];
+  expired_ = &run_queues_[1];
+  timeout_head_ = 0;
+  idle_thread_ = 0;
 }
 
 void Scheduler::addNewThread ( Thread *thread )
@@ -95,6 +102,14 @@ void Scheduler::addNewThread ( Thread *thread )
   lockScheduling();
   waitForFreeSpinLock(KernelMemoryManager::instance()->getKMMLock());
   threads_.push_back ( thread );
+  if ( thread != idle_thread_ )
+  {
+    bool interrupts = ArchInterrupts::disableInterrupts();
+    thread->time_slice_ = timeSlice ( thread->priority_ );
+    enqueue ( thread );
+    if ( interrupts )
+      ArchInterrupts::enableInterrupts();
+  }
   unlockScheduling();
 }
 
@@ -106,6 +121,10 @@ void Scheduler::removeCurrentThread()
   if ( threads_.size() > 1 )
   {
     threads_.remove(currentThread);
+    bool interrupts = ArchInterrupts::disableInterrupts();
+    dequeue ( currentThread );
+    if ( interrupts )
+      ArchInterrupts::enableInterrupts();
   }
   unlockScheduling();
 }
@@ -150,9 +169,146 @@ void Scheduler::sleepAndRestoreInterrupts ( bool interrupts )
   }
 }
 
+void Scheduler::sleepAndRestoreInterrupts ( bool interrupts, uint32 timeout_ticks )
+{
+  // 0 is reserved for "no timeout"
+  currentThread->wakeup_tick_ = (ticks_ + timeout_ticks) ? (ticks_ + timeout_ticks) : 1;
+  sleepAndRestoreInterrupts ( interrupts );
+}
+
 void Scheduler::wake ( Thread* thread_to_wake )
 {
+  // a killed thread must not come back, it might be deleted already
+  if ( thread_to_wake->state_ == ToBeDestroyed )
+    return;
+
+  // also called from interrupt handlers, the queues are protected by
+  // disabling interrupts
+  bool interrupts = ArchInterrupts::disableInterrupts();
+  thread_to_wake->wakeup_tick_=0;
   thread_to_wake->state_=Running;
+  if ( thread_to_wake->sched_queue_ == TIMEOUT_QUEUE )
+    dequeue ( thread_to_wake );
+  if ( thread_to_wake->sched_queue_ == NOT_QUEUED && thread_to_wake != idle_thread_ )
+    enqueue ( thread_to_wake );
+  if ( interrupts )
+    ArchInterrupts::enableInterrupts();
+}
+
+uint32 Scheduler::timeSlice ( uint32 priority )
+{
+  return 1 + ( NUM_PRIORITIES - 1 - priority ) / 8;
+}
+
+Thread* Scheduler::firstThread ( RunQueue* queue )
+{
+  for ( uint32 word = 0; word < sizeof(queue->bitmap_) / sizeof(queue->bitmap_[0]); ++word )
+  {
+    if ( queue->bitmap_[word] )
+      return queue->heads_[word * 32 + __builtin_ctz ( queue->bitmap_[word] )];
+  }
+  return 0;
+}
+
+void Scheduler::enqueue ( Thread* thread )
+{
+  assert ( thread->sched_queue_ == NOT_QUEUED );
+
+  RunQueue* queue = active_;
+  if ( thread->time_slice_ == 0 )
+  {
+    thread->time_slice_ = timeSlice ( thread->priority_ );
+    queue = expired_;
+  }
+
+  uint32 priority = thread->priority_;
+  thread->queue_next_ = 0;
+  thread->queue_prev_ = queue->tails_[priority];
+  if ( queue->tails_[priority] )
+    queue->tails_[priority]->queue_next_ = thread;
+  else
+    queue->heads_[priority] = thread;
+  queue->tails_[priority] = thread;
+
+  queue->bitmap_[priority / 32] |= 1U << ( priority % 32 );
+  queue->num_threads_++;
+  thread->sched_queue_ = ( queue == &run_queues_[0] ) ? RUN_QUEUE_0 : RUN_QUEUE_1;
+}
+
+void Scheduler::dequeue ( Thread* thread )
+{
+  if ( thread->sched_queue_ == NOT_QUEUED )
+    return;
+
+  if ( thread->sched_queue_ == TIMEOUT_QUEUE )
+  {
+    if ( thread->queue_prev_ )
+      thread->queue_prev_->queue_next_ = thread->queue_next_;
+    else
+      timeout_head_ = thread->queue_next_;
+    if ( thread->queue_next_ )
+      thread->queue_next_->queue_prev_ = thread->queue_prev_;
+  }
+  else
+  {
+    RunQueue* queue = &run_queues_[thread->sched_queue_ - RUN_QUEUE_0];
+    uint32 priority = thread->priority_;
+
+    if ( thread->queue_prev_ )
+      thread->queue_prev_->queue_next_ = thread->queue_next_;
+    else
+      queue->heads_[priority] = thread->queue_next_;
+    if ( thread->queue_next_ )
+      thread->queue_next_->queue_prev_ = thread->queue_prev_;
+    else
+      queue->tails_[priority] = thread->queue_prev_;
+
+    if ( !queue->heads_[priority] )
+      queue->bitmap_[priority / 32] &= ~( 1U << ( priority % 32 ) );
+    queue->num_threads_--;
+  }
+
+  thread->queue_next_ = 0;
+  thread->queue_prev_ = 0;
+  thread->sched_queue_ = NOT_QUEUED;
+}
+
+void Scheduler::enqueueTimeout ( Thread* thread )
+{
+  assert ( thread->sched_queue_ == NOT_QUEUED && thread->wakeup_tick_ != 0 );
+
+  Thread* prev = 0;
+  Thread* next = timeout_head_;
+  while ( next && (int32)( next->wakeup_tick_ - thread->wakeup_tick_ ) <= 0 )
+  {
+    prev = next;
+    next = next->queue_next_;
+  }
+
+  thread->queue_prev_ = prev;
+  thread->queue_next_ = next;
+  if ( prev )
+    prev->queue_next_ = thread;
+  else
+    timeout_head_ = thread;
+  if ( next )
+    next->queue_prev_ = thread;
+  thread->sched_queue_ = TIMEOUT_QUEUE;
+}
+
+void Scheduler::wakeTimedOutThreads()
+{
+  while ( timeout_head_ && (int32)( ticks_ - timeout_head_->wakeup_tick_ ) >= 0 )
+  {
+    Thread* thread = timeout_head_;
+    dequeue ( thread );
+    thread->wakeup_tick_ = 0;
+    if ( thread->state_ == Sleeping )
+    {
+      thread->state_ = Running;
+      enqueue ( thread );
+    }
+  }
 }
 
 uint32 Scheduler::schedule()
@@ -166,21 +322,50 @@ uint32 Scheduler::schedule()
     return 0;
   }
 
+  //none of the queue operations allocates or deletes any kernel memory (important because Interrupts are disabled in this method)
+  wakeTimedOutThreads();
+
+  // WARNING: currentThread is 0 the first time the scheduler is called
   Thread* previousThread = currentThread;
-  do
+  if (previousThread && previousThread->sched_queue_ != NOT_QUEUED)
   {
-    // WARNING: do not read currentThread before is has been set here
-    //          the first time scheduler is called.
-    //          before this, currentThread may be 0 !!
-    currentThread = threads_.front();
+    // a running thread goes to the tail of its priority, a thread that has
+    // gone to sleep (or was killed) leaves the run queue
+    dequeue(previousThread);
+    if (previousThread->state_ == Running)
+      enqueue(previousThread);
+    else if (previousThread->state_ == Sleeping && previousThread->wakeup_tick_ != 0)
+      enqueueTimeout(previousThread);
+  }
 
-    //this operation doesn't allocate or delete any kernel memory (important because Interrupts are disabled in this method)
-    ustl::rotate(threads_.begin(),threads_.begin()+1, threads_.end());
+  do
+  {
+    if (active_->num_threads_ == 0 && expired_->num_threads_ != 0)
+    {
+      // a new epoch, the IdleThread gets the chance to clean up dead threads
+      RunQueue* tmp = active_;
+      active_ = expired_;
+      expired_ = tmp;
+      currentThread = idle_thread_;
+    }
+    else
+    {
+      currentThread = firstThread(active_);
+      if (!currentThread)
+        currentThread = idle_thread_;
+    }
 
-    if ((currentThread == previousThread) && (currentThread->state_ != Running))
+    // threads that have been killed while waiting on the run queue
+    if (currentThread->state_ != Running)
     {
-      debug(SCHEDULER, "Scheduler::schedule: ERROR: currentThread == previousThread! Either no thread is in state Running or you added the same thread more than once.");
-      assert(false);
+      if (currentThread == idle_thread_)
+      {
+        debug(SCHEDULER, "Scheduler::schedule: ERROR: the IdleThread is not in state Running!\n");
+        assert(false);
+      }
+      dequeue(currentThread);
+      if (currentThread->state_ == Sleeping && currentThread->wakeup_tick_ != 0)
+        enqueueTimeout(currentThread);
     }
   }
   while (currentThread->state_ != Running);
@@ -239,6 +424,10 @@ void Scheduler::cleanupDeadThreads()
     Thread* tmp = threads_[i];
     if(tmp->state_ == ToBeDestroyed)
     {
+      bool interrupts = ArchInterrupts::disableInterrupts();
+      dequeue(tmp);
+      if (interrupts)
+        ArchInterrupts::enableInterrupts();
       destroy_list[thread_count++] = tmp;
       threads_.erase(threads_.begin() + i); // Note: erase will not realloc!
       --i;
@@ -263,7 +452,7 @@ void Scheduler::printThreadList()
   lockScheduling();
   debug ( SCHEDULER, "Scheduler::printThreadList: %d Threads in List\n",threads_.size() );
   for ( c=0; c<threads_.size();++c )
-    debug ( SCHEDULER, "Scheduler::printThreadList: threads_[%d]: %x  %d:%s     [%s]\n",c,threads_[c],threads_[c]->getPID(),threads_[c]->getName(),Thread::threadStatePrintable[threads_[c]->state_] );
+    debug ( SCHEDULER, "Scheduler::printThreadList: threads_[%d]: %x  %d:%s     [%s] nice %d\n",c,threads_[c],threads_[c]->getPID(),threads_[c]->getName(),Thread::threadStatePrintable[threads_[c]->state_],getNice(threads_[c]) );
   unlockScheduling();
 }
 
@@ -317,6 +506,42 @@ uint32 Scheduler::getTicks()
 void Scheduler::incTicks()
 {
   ++ticks_;
+  // the time slice is charged to the thread that has been interrupted
+  if (currentThread && currentThread->time_slice_ > 0)
+    --currentThread->time_slice_;
+}
+
+int32 Scheduler::setNice ( Thread* thread, int32 nice )
+{
+  if ( nice < NICE_MIN )
+    nice = NICE_MIN;
+  if ( nice > NICE_MAX )
+    nice = NICE_MAX;
+
+  debug ( SCHEDULER, "setNice: %x %d:%s nice %d\n", thread, thread->getPID(), thread->getName(), nice );
+
+  bool interrupts = ArchInterrupts::disableInterrupts();
+  uint32 queue = thread->sched_queue_;
+  bool queued = ( queue == RUN_QUEUE_0 || queue == RUN_QUEUE_1 );
+  if ( queued )
+  {
+    dequeue ( thread );
+    // a thread on the expired queue stays there (with a new time slice)
+    if ( &run_queues_[queue - RUN_QUEUE_0] == expired_ )
+      thread->time_slice_ = 0;
+  }
+  thread->priority_ = nice - NICE_MIN;
+  if ( queued )
+    enqueue ( thread );
+  if ( interrupts )
+    ArchInterrupts::enableInterrupts();
+
+  return nice;
+}
+
+int32 Scheduler::getNice ( Thread* thread )
+{
+  return (int32) thread->priority_ + NICE_MIN;
 }
 
 void Scheduler::printStackTraces()
@@ -39,7 +39,12 @@ void SpinLock::acquire(const char* debug_info)
     while (ArchThreads::testSetLock(nosleep_mutex_, 1))
     {
       //SpinLock: Simplest of Locks, do the next best thing to busy wating
-      Scheduler::instance()->yield();
+      //only retry the (bus locking) testSetLock once the lock looks free
+      do
+      {
+        Scheduler::instance()->yield();
+      }
+      while (*((volatile size_t*) &nosleep_mutex_) != 0);
     }
     assert(held_by_ == 0);
     held_by_ = currentThread;
@@ -65,7 +70,9 @@ void SpinLock::release(const char* debug_info)
       assert(false);
     }
     held_by_ = 0;
-    nosleep_mutex_ = 0;
+    // the stores of the critical section must not be moved behind the release
+    __asm__ __volatile__("" : : : "memory");
+    *((volatile size_t*) &nosleep_mutex_) = 0;
   }
 }
 
@@ -0,0 +1,19 @@
+/**
+ * @file StressTestThread.cpp
+ */
+
+#include "StressTestThread.h"
+#include "kprintf.h"
+
+StressTestThread::StressTestThread ( const char* name, StressTestFunction test ) :
+  Thread ( name ),
+  test_(test)
+{
+}
+
+void StressTestThread::Run()
+{
+  debug ( THREAD, "StressTestThread: running %s\n", getName() );
+  test_();
+  kprintf ( "%s: done\n", getName() );
+}
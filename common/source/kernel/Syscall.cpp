@@ -11,6 +11,11 @@
 #include "console/Terminal.h"
 #include "console/debug.h"
 #include "fs/VfsSyscall.h"
+#include "fs/IoVector.h"
+#include "fs/FileDescriptor.h"
+#include "Loader.h"
+#include "MemoryMapping.h"
+#include "util/string.h"
 #include "UserProcess.h"
 #include "MountMinix.h"
 
@@ -38,6 +43,30 @@ size_t Syscall::syscallException(size_t syscall_number, size_t arg1, size_t arg2
     case sc_read:
       return_value = read(arg1,arg2,arg3);
       break;
+    case sc_pwrite:
+      return_value = pwrite(arg1,arg2,arg3,arg4);
+      break;
+    case sc_pread:
+      return_value = pread(arg1,arg2,arg3,arg4);
+      break;
+    case sc_writev:
+      return_value = writev(arg1,arg2,arg3);
+      break;
+    case sc_readv:
+      return_value = readv(arg1,arg2,arg3);
+      break;
+    case sc_mmap:
+      return_value = mmap(arg1);
+      break;
+    case sc_munmap:
+      return_value = munmap(arg1,arg2);
+      break;
+    case sc_msync:
+      return_value = msync(arg1,arg2,arg3);
+      break;
+    case sc_lseek:
+      return_value = lseek(arg1,arg2,arg3);
+      break;
     case sc_open:
       return_value = open(arg1,arg2,arg3);
       break;
@@ -47,6 +76,9 @@ size_t Syscall::syscallException(size_t syscall_number, size_t arg1, size_t arg2
     case sc_outline:
       outline(arg1,arg2);
       break;
+    case sc_nice:
+      return_value = nice(arg1);
+      break;
     default:
       kprintf("Syscall::syscall_exception: Unimplemented Syscall Number %d\n",syscall_number);
   }
@@ -104,6 +136,145 @@ size_t Syscall::read(size_t fd, pointer buffer, size_t count)
   return num_read;
 }
 
+size_t Syscall::pwrite(size_t fd, pointer buffer, size_t size, size_t offset)
+{
+  if ((buffer >= 2U*1024U*1024U*1024U) || (buffer+size > 2U*1024U*1024U*1024U))
+  {
+    return -1U;
+  }
+  return VfsSyscall::instance()->pwrite(currentThread->getWorkingDirInfo(), fd, (char*) buffer, size, offset);
+}
+
+size_t Syscall::pread(size_t fd, pointer buffer, size_t count, size_t offset)
+{
+  if ((buffer >= 2U*1024U*1024U*1024U) || (buffer+count > 2U*1024U*1024U*1024U))
+  {
+    return -1U;
+  }
+  return VfsSyscall::instance()->pread(currentThread->getWorkingDirInfo(), fd, (char*) buffer, count, offset);
+}
+
+iovec_s* Syscall::copyIoVector(pointer iov, size_t iov_count)
+{
+  if (iov_count == 0 || iov_count > IOV_MAX || iov >= 2U*1024U*1024U*1024U ||
+      iov + iov_count * sizeof(iovec_s) > 2U*1024U*1024U*1024U)
+  {
+    return 0;
+  }
+
+  // copied, so the buffers cannot be changed behind our back after checking them
+  iovec_s* kernel_iov = new iovec_s[iov_count];
+  memcpy(kernel_iov, (void*) iov, iov_count * sizeof(iovec_s));
+
+  for (size_t i = 0; i < iov_count; ++i)
+  {
+    pointer base = (pointer) kernel_iov[i].iov_base;
+    if ((base >= 2U*1024U*1024U*1024U) || (base+kernel_iov[i].iov_len > 2U*1024U*1024U*1024U))
+    {
+      delete[] kernel_iov;
+      return 0;
+    }
+  }
+  return kernel_iov;
+}
+
+size_t Syscall::writev(size_t fd, pointer iov, size_t iov_count)
+{
+  iovec_s* kernel_iov = copyIoVector(iov, iov_count);
+  if (kernel_iov == 0)
+  {
+    return -1U;
+  }
+  size_t num_written = VfsSyscall::instance()->writev(currentThread->getWorkingDirInfo(), fd, kernel_iov, iov_count);
+  delete[] kernel_iov;
+  return num_written;
+}
+
+size_t Syscall::readv(size_t fd, pointer iov, size_t iov_count)
+{
+  iovec_s* kernel_iov = copyIoVector(iov, iov_count);
+  if (kernel_iov == 0)
+  {
+    return -1U;
+  }
+  size_t num_read = VfsSyscall::instance()->readv(currentThread->getWorkingDirInfo(), fd, kernel_iov, iov_count);
+  delete[] kernel_iov;
+  return num_read;
+}
+
+size_t Syscall::nice(size_t increment)
+{
+  int32 nice = Scheduler::instance()->getNice(currentThread) + (int32) increment;
+  return (size_t) Scheduler::instance()->setNice(currentThread, nice);
+}
+
+size_t Syscall::lseek(size_t fd, size_t offset, size_t origin)
+{
+  return VfsSyscall::instance()->lseek(currentThread->getWorkingDirInfo(), fd, offset, origin);
+}
+
+size_t Syscall::mmap(pointer args)
+{
+  if ((args >= 2U*1024U*1024U*1024U) || (args+6*sizeof(size_t) > 2U*1024U*1024U*1024U) || !currentThread->loader_)
+  {
+    return -1U;
+  }
+
+  // start (only a hint, ignored), length, prot, flags, fd, offset
+  size_t* mmap_args = (size_t*) args;
+  size_t length = mmap_args[1];
+  size_t prot = mmap_args[2];
+  size_t flags = mmap_args[3];
+  size_t fd = mmap_args[4];
+  size_t offset = mmap_args[5];
+
+  if (length == 0 || length >= 2U*1024U*1024U*1024U || (offset % PAGE_SIZE) != 0 ||
+      !(prot & PROT_READ) || (prot & ~(PROT_READ | PROT_WRITE)))
+  {
+    return -1U;
+  }
+
+  bool writeable = prot & PROT_WRITE;
+  bool shared = flags & MAP_SHARED;
+
+  FileDescriptor* file = 0;
+  if (!(flags & MAP_ANONYMOUS))
+  {
+    file = VfsSyscall::instance()->getFileDescriptorForMapping(currentThread->getWorkingDirInfo(), fd, writeable && shared);
+    if (file == 0)
+    {
+      return -1U;
+    }
+  }
+
+  size_t first_page = currentThread->loader_->mapMemory((length + PAGE_SIZE - 1) / PAGE_SIZE, writeable, shared, file, offset);
+  if (first_page == 0)
+  {
+    return -1U;
+  }
+  return first_page * PAGE_SIZE;
+}
+
+size_t Syscall::munmap(pointer start, size_t length)
+{
+  if ((start % PAGE_SIZE) != 0 || (start >= 2U*1024U*1024U*1024U) || (length > 2U*1024U*1024U*1024U - start) || !currentThread->loader_)
+  {
+    return -1U;
+  }
+  return currentThread->loader_->unmapMemory(start / PAGE_SIZE, (length + PAGE_SIZE - 1) / PAGE_SIZE);
+}
+
+size_t Syscall::msync(pointer start, size_t length, size_t flags)
+{
+  if ((start % PAGE_SIZE) != 0 || (start >= 2U*1024U*1024U*1024U) || (length > 2U*1024U*1024U*1024U - start) ||
+      ((flags & MS_SYNC) && (flags & MS_ASYNC)) || !currentThread->loader_)
+  {
+    return -1U;
+  }
+  // there is no background write back, MS_ASYNC writes to the cache right away
+  return currentThread->loader_->syncMemory(start / PAGE_SIZE, (length + PAGE_SIZE - 1) / PAGE_SIZE, flags & MS_SYNC);
+}
+
 size_t Syscall::close(size_t fd)
 {
   return VfsSyscall::instance()->close(currentThread->getWorkingDirInfo(), fd);
@@ -34,8 +34,14 @@ Thread::Thread(const char *name) :
   loader_(0),
   state_(Running),
   sleeping_on_mutex_(0),
+  wakeup_tick_(0),
   pid_(0),
   my_terminal_(0),
+  priority_(Scheduler::DEFAULT_PRIORITY),
+  time_slice_(0),
+  sched_queue_(0),
+  queue_next_(0),
+  queue_prev_(0),
   working_dir_(0),
   name_(name)
 {
@@ -51,8 +57,14 @@ Thread::Thread ( FsWorkingDirectory *working_dir, const char *name ) :
   loader_(0),
   state_(Running),
   sleeping_on_mutex_(0),
+  wakeup_tick_(0),
   pid_(0),
   my_terminal_(0),
+  priority_(Scheduler::DEFAULT_PRIORITY),
+  time_slice_(0),
+  sched_queue_(0),
+  queue_next_(0),
+  queue_prev_(0),
   working_dir_(working_dir),
   name_(name)
 {
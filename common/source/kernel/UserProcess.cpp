@@ -7,9 +7,10 @@
 #include "console/Console.h"
 #include "Loader.h"
 #include "MountMinix.h"
-#include "fs/fs_global.h"
 #include "fs/VfsSyscall.h"
 
+OBJECT_CACHE_DEFINITIONS(UserProcess)
+
 UserProcess::UserProcess ( const char *minixfs_filename, FsWorkingDirectory *fs_info,
                            MountMinixAndStartUserProgramsThread *process_registry, uint32 terminal_number ) :
   Thread ( fs_info, minixfs_filename ),
@@ -40,7 +40,7 @@
 #include "console/FrameBufferConsole.h"
 #include "console/Terminal.h"
 
-#include "fs/fs_global.h"
+#include "cache/WriteBackDaemon.h"
 
 #include "UserProcess.h"
 #include "MountMinix.h"
@@ -126,11 +126,6 @@ void startup()
   ustl::coutclass::init();
   VfsSyscall::createVfsSyscall();
 
-  extern ustl::list<FileDescriptor*> global_fd;
-  new (&global_fd) ustl::list<FileDescriptor*>();
-  extern Mutex global_fd_lock;
-  new (&global_fd_lock) Mutex("global_fd_lock");
-
   // the default working directory info
   debug ( MAIN, "creating a default working Directory\n" );
   new (&default_working_dir) FsWorkingDirectory();
@@ -155,6 +150,9 @@ void startup()
 
   Scheduler::instance()->addNewThread ( main_console );
 
+  // writes back the dirty data of the file system caches in the background
+  Scheduler::instance()->addNewThread ( Cache::WriteBackDaemon::instance() );
+
   Scheduler::instance()->addNewThread (
        new MountMinixAndStartUserProgramsThread ( new FsWorkingDirectory(default_working_dir), user_progs ) // see user_progs.h
    );
@@ -3,7 +3,9 @@
  */
 
 #include "mm/KernelMemoryManager.h"
+#include "mm/PageManager.h"
 #include "ArchCommon.h"
+#include "ArchMemory.h"
 #include "assert.h"
 #include "debug_bochs.h"
 #include "console/kprintf.h"
@@ -15,6 +17,12 @@ extern uint32 boot_completed;
 
 KernelMemoryManager * KernelMemoryManager::instance_ = 0;
 
+// every size class fills a page with as little waste as possible
+const size_t KernelMemoryManager::SIZE_CLASSES[KernelMemoryManager::NUM_SIZE_CLASSES] =
+{
+  16, 32, 48, 64, 96, 128, 192, 256, 384, 512, 672, 1008, 1344, 2032
+};
+
 uint32 KernelMemoryManager::createMemoryManager ( pointer start_address, pointer end_address )
 {
   //start_address will propably be &kernel_end_address defined in linker script
@@ -23,8 +31,23 @@ uint32 KernelMemoryManager::createMemoryManager ( pointer start_address, pointer
   return 0;
 }
 
-KernelMemoryManager::KernelMemoryManager ( pointer start_address, pointer end_address ) : lock_("KMM::lock_"), segments_used_(0), segments_free_(0), approx_memory_free_(0)
+KernelMemoryManager::KernelMemoryManager ( pointer start_address, pointer end_address ) : lock_("KMM::lock_"), segments_used_(0), segments_free_(0), approx_memory_free_(0), slabs_enabled_(true), slab_fallbacks_(0)
 {
+  prenew_assert ( sizeof ( SlabPage ) <= SLAB_HEADER_SIZE );
+  prenew_assert ( SIZE_CLASSES[NUM_SIZE_CLASSES - 1] == SLAB_MAX_OBJECT_SIZE );
+  for ( uint32 c = 0, size = 0; size <= SLAB_MAX_OBJECT_SIZE; size += 16 )
+  {
+    if ( size > SIZE_CLASSES[c] )
+      ++c;
+    size_class_of_[size / 16] = c;
+  }
+  for ( uint32 c = 0; c < NUM_SIZE_CLASSES; ++c )
+  {
+    ArchCommon::bzero ( ( pointer ) &size_classes_[c], sizeof ( SlabSizeClass ), 0 );
+    size_classes_[c].object_size_ = SIZE_CLASSES[c];
+    size_classes_[c].objects_per_slab_ = ( PAGE_SIZE - SLAB_HEADER_SIZE ) / SIZE_CLASSES[c];
+  }
+
   malloc_end_=end_address;
   prenew_assert ( ( ( end_address-start_address-sizeof ( MallocSegment ) ) & 0xFFFFFFFF80000000 ) == 0 );
   first_=new ( ( void* ) start_address ) MallocSegment ( 0,0,end_address-start_address-sizeof ( MallocSegment ),false );
@@ -40,6 +63,17 @@ pointer KernelMemoryManager::allocateMemory ( size_t requested_size )
   prenew_assert ( ( requested_size & 0x80000000 ) == 0 );
   if ((requested_size & 0xF) != 0)
     requested_size += 0x10 - (requested_size & 0xF); // 16 byte alignment
+
+  if ( requested_size <= SLAB_MAX_OBJECT_SIZE && slabs_enabled_ )
+  {
+    pointer ptr = allocateSlabObject ( requested_size );
+    if ( ptr )
+    {
+      debug ( KMM,"allocateMemory returns slab address: %x \n", ptr );
+      return ptr;
+    }
+  }
+
   lockKMM();
   pointer ptr = private_AllocateMemory ( requested_size );
   if(ptr)
@@ -69,9 +103,12 @@ pointer KernelMemoryManager::private_AllocateMemory ( size_t requested_size )
 
 bool KernelMemoryManager::freeMemory ( pointer virtual_address )
 {
-  if ( virtual_address == 0 || virtual_address < ( ( pointer ) first_ ) || virtual_address >= malloc_end_ )
+  if ( virtual_address == 0 )
     return false;
 
+  if ( virtual_address < ( ( pointer ) first_ ) || virtual_address >= malloc_end_ )
+    return freeSlabObject ( virtual_address );
+
   lockKMM();
 
   MallocSegment *m_segment = getSegmentFromAddress ( virtual_address );
@@ -99,6 +136,18 @@ pointer KernelMemoryManager::reallocateMemory ( pointer virtual_address, size_t
   if(virtual_address == 0)
     return allocateMemory(new_size);
 
+  SlabPage *slab = getSlabFromAddress ( virtual_address );
+  if ( slab != 0 )
+  {
+    size_t object_size = size_classes_[slab->size_class_].object_size_;
+    if ( new_size <= object_size )
+      return virtual_address;
+
+    pointer new_address = allocateMemory ( new_size );
+    ArchCommon::memcpy ( new_address, virtual_address, object_size );
+    freeSlabObject ( virtual_address );
+    return new_address;
+  }
 
   lockKMM();
 
@@ -329,6 +378,216 @@ bool KernelMemoryManager::mergeWithFollowingFreeSegment ( MallocSegment *this_on
   return false;
 }
 
+pointer KernelMemoryManager::allocateSlabObject ( size_t requested_size )
+{
+  uint32 c = size_class_of_[requested_size / 16];
+  SlabSizeClass &size_class = size_classes_[c];
+
+  lockKMM();
+  if ( size_class.partial_ == 0 && !addSlab ( c ) )
+  {
+    slab_fallbacks_++;
+    unlockKMM();
+    return 0;
+  }
+
+  SlabPage *slab = size_class.partial_;
+  prenew_assert ( slab->marker_ == SLAB_MARKER && slab->free_ != 0 );
+
+  pointer object = slab->free_;
+  slab->free_ = * ( pointer* ) object;
+  * ( pointer* ) object = 0; // the rest of the object was cleared by freeSlabObject()
+
+  if ( slab->used_++ == 0 )
+    size_class.empty_slabs_--;
+  if ( slab->free_ == 0 )
+    unlinkSlab ( size_class, slab );
+
+  size_class.objects_used_++;
+  size_class.allocations_++;
+  unlockKMM();
+  return object;
+}
+
+bool KernelMemoryManager::freeSlabObject ( pointer virtual_address )
+{
+  SlabPage *slab = getSlabFromAddress ( virtual_address );
+  if ( slab == 0 )
+    return false;
+
+  SlabSizeClass &size_class = size_classes_[slab->size_class_];
+  if ( ( virtual_address - ( pointer ) slab - SLAB_HEADER_SIZE ) % size_class.object_size_ != 0 )
+  {
+    kprintfd ( "KernelMemoryManager::freeSlabObject: %x is not the start of an object\n", virtual_address );
+    prenew_assert ( false );
+  }
+
+  lockKMM();
+  prenew_assert ( slab->used_ > 0 );
+
+  //same as freeSegment: ease debugging and hand out zeroed memory
+  ArchCommon::bzero ( virtual_address, size_class.object_size_, 0 );
+  * ( pointer* ) virtual_address = slab->free_;
+  if ( slab->free_ == 0 )
+    linkSlab ( size_class, slab );
+  slab->free_ = virtual_address;
+
+  size_class.objects_used_--;
+  size_class.frees_++;
+
+  //one empty slab is kept per size class, further ones go back to the PageManager
+  bool release = false;
+  if ( --slab->used_ == 0 )
+  {
+    if ( size_class.empty_slabs_ > 0 && mayUsePageManager() )
+    {
+      unlinkSlab ( size_class, slab );
+      slab->marker_ = 0;
+      size_class.slabs_--;
+      release = true;
+    }
+    else
+      size_class.empty_slabs_++;
+  }
+  unlockKMM();
+
+  if ( release )
+    PageManager::instance()->freePage ( ( ( pointer ) slab - ArchMemory::getIdentAddressOfPPN ( 0 ) ) / PAGE_SIZE );
+
+  return true;
+}
+
+SlabPage *KernelMemoryManager::getSlabFromAddress ( pointer virtual_address )
+{
+  //slab pages are only reachable through the identity mapping of the physical memory
+  if ( PageManager::instance() == 0 || virtual_address < ArchMemory::getIdentAddressOfPPN ( 0 ) ||
+       virtual_address >= ArchMemory::getIdentAddressOfPPN ( PageManager::instance()->getTotalNumPages() ) )
+    return 0;
+
+  SlabPage *slab = ( SlabPage* ) ( virtual_address & ~ ( ( pointer ) PAGE_SIZE - 1 ) );
+  if ( slab->marker_ != SLAB_MARKER || virtual_address < ( pointer ) slab + SLAB_HEADER_SIZE )
+    return 0;
+
+  prenew_assert ( slab->size_class_ < NUM_SIZE_CLASSES );
+  return slab;
+}
+
+bool KernelMemoryManager::addSlab ( uint32 c )
+{
+  if ( !mayUsePageManager() )
+    return false;
+
+  unlockKMM();
+  uint32 page = PageManager::instance()->getFreePhysicalPage ( PAGE_KERNEL );
+  SlabPage *slab = ( SlabPage* ) ArchMemory::getIdentAddressOfPPN ( page );
+  ArchCommon::bzero ( ( pointer ) slab, PAGE_SIZE, 0 );
+  lockKMM();
+
+  SlabSizeClass &size_class = size_classes_[c];
+  slab->marker_ = SLAB_MARKER;
+  slab->size_class_ = c;
+  slab->used_ = 0;
+
+  //the free list starts with the lowest object
+  pointer objects = ( pointer ) slab + SLAB_HEADER_SIZE;
+  for ( uint32 i = size_class.objects_per_slab_; i > 0; --i )
+  {
+    pointer object = objects + ( i - 1 ) * size_class.object_size_;
+    * ( pointer* ) object = slab->free_;
+    slab->free_ = object;
+  }
+
+  linkSlab ( size_class, slab );
+  size_class.slabs_++;
+  size_class.empty_slabs_++;
+  return true;
+}
+
+bool KernelMemoryManager::mayUsePageManager()
+{
+  if ( PageManager::instance() == 0 || PageManager::instance()->isBusy() )
+    return false;
+
+  //before the boot is completed Mutexes are not used at all
+  if ( !boot_completed )
+    return true;
+
+  return ArchInterrupts::testIFSet() && Scheduler::instance()->isSchedulingEnabled();
+}
+
+void KernelMemoryManager::linkSlab ( SlabSizeClass &size_class, SlabPage *slab )
+{
+  slab->prev_ = 0;
+  slab->next_ = size_class.partial_;
+  if ( size_class.partial_ != 0 )
+    size_class.partial_->prev_ = slab;
+  size_class.partial_ = slab;
+}
+
+void KernelMemoryManager::unlinkSlab ( SlabSizeClass &size_class, SlabPage *slab )
+{
+  if ( slab->prev_ != 0 )
+    slab->prev_->next_ = slab->next_;
+  else
+    size_class.partial_ = slab->next_;
+  if ( slab->next_ != 0 )
+    slab->next_->prev_ = slab->prev_;
+  slab->next_ = 0;
+  slab->prev_ = 0;
+}
+
+void KernelMemoryManager::setSlabsEnabled ( bool enabled )
+{
+  slabs_enabled_ = enabled;
+}
+
+void KernelMemoryManager::printStatistics()
+{
+  SlabSizeClass classes[NUM_SIZE_CLASSES];
+  size_t used_segments = 0, used_bytes = 0, free_segments = 0, free_bytes = 0, largest_free = 0;
+
+  //kprintf needs the KMM itself, so everything is copied first
+  lockKMM();
+  ArchCommon::memcpy ( ( pointer ) classes, ( pointer ) size_classes_, sizeof ( classes ) );
+  uint32 fallbacks = slab_fallbacks_;
+  for ( MallocSegment *current = first_; current != 0; current = current->next_ )
+  {
+    if ( current->getUsed() )
+    {
+      used_segments++;
+      used_bytes += current->getSize();
+    }
+    else
+    {
+      free_segments++;
+      free_bytes += current->getSize();
+      largest_free = Max ( largest_free, current->getSize() );
+    }
+  }
+  segments_used_ = used_segments;
+  segments_free_ = free_segments;
+  approx_memory_free_ = free_bytes;
+  unlockKMM();
+
+  kprintf ( "KMM: size  slabs empty   used capacity    allocs     frees\n" );
+  size_t slab_pages = 0;
+  for ( uint32 c = 0; c < NUM_SIZE_CLASSES; ++c )
+  {
+    if ( classes[c].slabs_ == 0 && classes[c].allocations_ == 0 )
+      continue;
+    kprintf ( "KMM: %4d %6d %5d %6d %8d %9d %9d\n", classes[c].object_size_, classes[c].slabs_, classes[c].empty_slabs_,
+              classes[c].objects_used_, classes[c].slabs_ * classes[c].objects_per_slab_, classes[c].allocations_,
+              classes[c].frees_ );
+    slab_pages += classes[c].slabs_;
+  }
+  kprintf ( "KMM: %d slab pages, %d small allocations fell back to the segment list\n", slab_pages, fallbacks );
+
+  //external fragmentation: how much of the free memory is not part of the largest free segment
+  kprintf ( "KMM: segments: %d used (%d bytes), %d free (%d bytes, largest %d, fragmentation %d%%)\n",
+            used_segments, used_bytes, free_segments, free_bytes, largest_free,
+            free_bytes ? 100 - ( largest_free * 100 ) / free_bytes : 0 );
+}
+
 Thread* KernelMemoryManager::KMMLockHeldBy()
 {
   return lock_.heldBy();
@@ -0,0 +1,129 @@
+/**
+ * Filename: ObjectCache.cpp
+ * Description:
+ *
+ * Created on: 18.10.2026
+ */
+
+#include "mm/ObjectCache.h"
+#include "ArchCommon.h"
+#include "ArchThreads.h"
+#include "util/string.h"
+#include "kernel/Scheduler.h"
+#include "console/kprintf.h"
+#include "console/debug.h"
+#include "assert.h"
+
+ObjectCache* ObjectCache::first_cache_ = 0;
+size_t ObjectCache::create_lock_ = 0;
+
+ObjectCache* ObjectCache::getCache(ObjectCache*& cache, const char* name, size_t object_size)
+{
+  if(cache != 0)
+    return cache;
+
+  while(ArchThreads::testSetLock(create_lock_, 1))
+    Scheduler::instance()->yield();
+
+  if(cache == 0)
+  {
+    ObjectCache* new_cache = new ObjectCache(name, object_size, isDebugEnabled(OBJECT_CACHE));
+    new_cache->next_cache_ = first_cache_;
+    first_cache_ = new_cache;
+    cache = new_cache;
+  }
+
+  create_lock_ = 0;
+  return cache;
+}
+
+ObjectCache::ObjectCache(const char* name, size_t object_size, bool poison) :
+    name_(name), object_size_(object_size), poison_(poison),
+    max_cached_(Max(MIN_CACHED_OBJECTS, MAX_CACHED_BYTES / object_size)),
+    free_list_(0), num_cached_(0), lock_("ObjectCache::lock_"), hits_(0), misses_(0),
+    uncached_(0), poison_errors_(0), next_cache_(0)
+{
+  assert(object_size >= sizeof(void*));
+}
+
+void* ObjectCache::allocate(size_t size)
+{
+  if(size != object_size_)
+  {
+    uncached_++;
+    return ::operator new(size);
+  }
+
+  lock_.acquire();
+  void* object = free_list_;
+  if(object == 0)
+  {
+    misses_++;
+    lock_.release();
+    return ::operator new(size);
+  }
+
+  free_list_ = *(void**) object;
+  num_cached_--;
+  hits_++;
+
+  if(poison_ && !checkPoison(object))
+  {
+    poison_errors_++;
+    debug(OBJECT_CACHE, "allocate: %s object %x was written to after delete\n", name_, object);
+  }
+  lock_.release();
+
+  ArchCommon::bzero((pointer) object, object_size_, 0);
+  return object;
+}
+
+void ObjectCache::free(void* object, size_t size)
+{
+  if(object == 0)
+    return;
+
+  if(size != object_size_)
+  {
+    ::operator delete(object);
+    return;
+  }
+
+  if(poison_)
+    memset(object, POISON, object_size_);
+
+  lock_.acquire();
+  if(num_cached_ >= max_cached_)
+  {
+    lock_.release();
+    ::operator delete(object);
+    return;
+  }
+
+  *(void**) object = free_list_;
+  free_list_ = object;
+  num_cached_++;
+  lock_.release();
+}
+
+bool ObjectCache::checkPoison(void* object) const
+{
+  // the first word is the link of the free list
+  for(size_t i = sizeof(void*); i < object_size_; i++)
+  {
+    if(((uint8*) object)[i] != POISON)
+      return false;
+  }
+  return true;
+}
+
+void ObjectCache::printStatistics()
+{
+  kprintf("ObjectCache: name size cached/max hits misses uncached poisoned\n");
+  for(ObjectCache* cache = first_cache_; cache != 0; cache = cache->next_cache_)
+  {
+    kprintf("ObjectCache: %s %5d %4d/%4d %8d %8d %8d %8d\n", cache->name_, cache->object_size_,
+            cache->num_cached_, cache->max_cached_, cache->hits_, cache->misses_, cache->uncached_,
+            cache->poison_errors_);
+  }
+}
@@ -11,6 +11,7 @@
 #include "console/kprintf.h"
 #include "kernel/Scheduler.h"
 #include "ArchInterrupts.h"
+#include "ArchThreads.h"
 #include "assert.h"
 #include "panic.h"
 
@@ -27,7 +28,7 @@ void PageManager::createPageManager()
   instance_ = new PageManager();
 }
 
-PageManager::PageManager() : lock_("PageManager::lock_")
+PageManager::PageManager() : lock_("PageManager::lock_"), busy_(0)
 {
   number_of_pages_ = 0;
   lowest_unreserved_page_ = 256; //physical memory <1MiB is reserved
@@ -159,6 +160,46 @@ PageManager::PageManager() : lock_("PageManager::lock_")
   debug(PM,"Ctor: lowest_unreserved_page_=%d\n",lowest_unreserved_page_);
   prenew_assert(lowest_unreserved_page_ >= 512);
   prenew_assert(lowest_unreserved_page_ < number_of_pages_);
+
+  for (i=0;i<=MAX_ORDER;++i)
+  {
+    free_lists_[i] = 0;
+    num_free_blocks_[i] = 0;
+  }
+  num_free_pages_ = 0;
+
+  //the pages below were never given out, keep it that way
+  for (uint32 p=0; p<lowest_unreserved_page_; ++p)
+    if (page_usage_table_[p] == PAGE_FREE)
+      page_usage_table_[p] = PAGE_RESERVED;
+
+  //put every free range into the free lists as the largest aligned blocks possible
+  debug(PM,"Ctor: building the free lists\n");
+  for (uint32 p=lowest_unreserved_page_; p<number_of_pages_; )
+  {
+    if (page_usage_table_[p] != PAGE_FREE)
+    {
+      ++p;
+      continue;
+    }
+
+    uint32 order = 0;
+    while (order < MAX_ORDER && (p & ((2U << order) - 1)) == 0 && p + (2U << order) <= number_of_pages_)
+    {
+      //the block doubles, if its upper half is free as well
+      uint32 k;
+      for (k = p + (1U << order); k < p + (2U << order) && page_usage_table_[k] == PAGE_FREE; ++k);
+      if (k < p + (2U << order))
+        break;
+      ++order;
+    }
+
+    pushFreeBlock(p, order);
+    num_free_pages_ += 1U << order;
+    p += 1U << order;
+  }
+
+  debug(PM,"Ctor: %d free pages\n",num_free_pages_);
   debug(PM,"Ctor done\n");
 }
 
@@ -173,60 +214,136 @@ uint32 PageManager::getFreePhysicalPage(uint32 type)
   if (type == PAGE_FREE || type == PAGE_RESERVED)  //what a stupid thing that would be to do
     return 0;
 
+  ArchThreads::atomic_add(busy_, 1);
   lock_.acquire();
 
-  //first 1024 pages are the 4MiB for Kernel Space
-  for (uint32 p=lowest_unreserved_page_; p<number_of_pages_; ++p)
+  //the 16k aligned pages are a block of order 2
+  uint32 page = allocateBlock(type == PAGE_4_PAGES_16K_ALIGNED ? 2 : 0, type);
+
+  lock_.release();
+  ArchThreads::atomic_add(busy_, -1);
+
+  if (page == 0)
+    kpanict((uint8*) "PageManager: Sorry, no more Pages Free !!!");
+  return page;
+}
+
+uint32 PageManager::getFreePhysicalPages(uint32 order, uint32 type)
+{
+  if (type == PAGE_FREE || type == PAGE_RESERVED || order > MAX_ORDER)
+    return 0;
+
+  ArchThreads::atomic_add(busy_, 1);
+  lock_.acquire();
+  uint32 page = allocateBlock(order, type);
+  lock_.release();
+  ArchThreads::atomic_add(busy_, -1);
+
+  return page;
+}
+
+uint32 PageManager::allocateBlock(uint32 order, uint32 type)
+{
+  uint32 current = order;
+  while (current <= MAX_ORDER && free_lists_[current] == 0)
+    ++current;
+
+  if (current > MAX_ORDER)
+    return 0;
+
+  uint32 page = free_lists_[current];
+  removeFreeBlock(page, current);
+
+  //the upper halves go back to the free lists
+  while (current > order)
   {
-    if (page_usage_table_[p] == PAGE_FREE)
-    {
-      if (type == PAGE_4_PAGES_16K_ALIGNED)
-      {
-        if ((p & 0x3) != 0)
-          continue;
-        if (page_usage_table_[p+1] == PAGE_FREE && page_usage_table_[p+2] == PAGE_FREE && page_usage_table_[p+3] == PAGE_FREE)
-        {
-          page_usage_table_[p] = type;
-          page_usage_table_[p+1] = type;
-          page_usage_table_[p+2] = type;
-          page_usage_table_[p+3] = type;
-          lowest_unreserved_page_ = p+4;
-        }
-        lock_.release();
-        return p;
-      }
-      else
-      {
-        page_usage_table_[p] = type;
-        lowest_unreserved_page_ = p+1;
-        lock_.release();
-        return p;
-      }
-    }
+    --current;
+    pushFreeBlock(page + (1U << current), current);
   }
-  lock_.release();
-  kpanict((uint8*) "PageManager: Sorry, no more Pages Free !!!");
-  return 0;
+
+  page_usage_table_[page] = blockHead(type, order);
+  for (uint32 p = page + 1; p < page + (1U << order); ++p)
+    page_usage_table_[p] = type;
+
+  num_free_pages_ -= 1U << order;
+  return page;
 }
 
 void PageManager::freePage(uint32 page_number)
 {
+  ArchThreads::atomic_add(busy_, 1);
   lock_.acquire();
-  if ( page_number < number_of_pages_ && page_usage_table_[page_number] != PAGE_RESERVED )
+  puttype type = page_number < number_of_pages_ ? page_usage_table_[page_number] & PAGE_TYPE_MASK : PAGE_RESERVED;
+  if ( type != PAGE_RESERVED && type != PAGE_FREE )
   {
-    if ((page_number & 0x3) == 0 && page_usage_table_[page_number] == PAGE_4_PAGES_16K_ALIGNED
-                                 && page_usage_table_[page_number + 1] == PAGE_4_PAGES_16K_ALIGNED
-                                 && page_usage_table_[page_number + 2] == PAGE_4_PAGES_16K_ALIGNED
-                                 && page_usage_table_[page_number + 3] == PAGE_4_PAGES_16K_ALIGNED)
+    if ((page_usage_table_[page_number] >> 4) == 0)
+    {
+      debug(PM,"freePage: page %d is not the first page of a block, not freed\n", page_number);
+    }
+    else
     {
-      page_usage_table_[page_number] = PAGE_FREE;
-      page_usage_table_[page_number + 1] = PAGE_FREE;
-      page_usage_table_[page_number + 2] = PAGE_FREE;
-      page_usage_table_[page_number + 3] = PAGE_FREE;
+      uint32 order = (page_usage_table_[page_number] >> 4) - 1;
+      for (uint32 p = page_number; p < page_number + (1U << order); ++p)
+        page_usage_table_[p] = PAGE_FREE;
+      num_free_pages_ += 1U << order;
+
+      //merge with the buddy as long as it is a free block of the same order
+      while (order < MAX_ORDER)
+      {
+        uint32 buddy = page_number ^ (1U << order);
+        if (buddy >= number_of_pages_ || page_usage_table_[buddy] != blockHead(PAGE_FREE, order))
+          break;
+
+        removeFreeBlock(buddy, order);
+        page_usage_table_[buddy] = PAGE_FREE;
+        page_number = Min(page_number, buddy);
+        ++order;
+      }
+
+      pushFreeBlock(page_number, order);
     }
-    page_usage_table_[page_number] = PAGE_FREE;
-    if (page_number < lowest_unreserved_page_)
-      lowest_unreserved_page_ = page_number;
   }
   lock_.release();
+  ArchThreads::atomic_add(busy_, -1);
+}
+
+uint32 PageManager::getNumFreePages() const
+{
+  return num_free_pages_;
+}
+
+void PageManager::pushFreeBlock(uint32 page_number, uint32 order)
+{
+  FreeBlockLinks *links = getLinks(page_number);
+  links->next_ = free_lists_[order];
+  links->prev_ = 0;
+  if (free_lists_[order] != 0)
+    getLinks(free_lists_[order])->prev_ = page_number;
+  free_lists_[order] = page_number;
+  num_free_blocks_[order]++;
+
+  page_usage_table_[page_number] = blockHead(PAGE_FREE, order);
+}
+
+void PageManager::removeFreeBlock(uint32 page_number, uint32 order)
+{
+  assert(page_usage_table_[page_number] == blockHead(PAGE_FREE, order));
+  FreeBlockLinks *links = getLinks(page_number);
+  if (links->prev_ != 0)
+    getLinks(links->prev_)->next_ = links->next_;
+  else
+    free_lists_[order] = links->next_;
+  if (links->next_ != 0)
+    getLinks(links->next_)->prev_ = links->prev_;
+  num_free_blocks_[order]--;
+}
+
+PageManager::FreeBlockLinks *PageManager::getLinks(uint32 page_number)
+{
+  return (FreeBlockLinks*) ArchMemory::getIdentAddressOfPPN(page_number);
+}
+
+bool PageManager::isBusy() const
+{
+  return *((volatile const uint32*) &busy_) != 0;
 }
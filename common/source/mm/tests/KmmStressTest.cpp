@@ -0,0 +1,84 @@
+/**
+ * Filename: KmmStressTest.cpp
+ * Description:
+ *
+ * Created on: 18.10.2026
+ */
+
+#include "mm/tests/KmmStressTest.h"
+
+#include "Scheduler.h"
+#include "kprintf.h"
+#include "mm/KernelMemoryManager.h"
+#include "mm/ObjectCache.h"
+
+namespace
+{
+
+// typical small allocations of the file system code
+const size_t SIZES[] = { 16, 24, 40, 12, 64, 512, 32, 100, 20, 1024, 48, 200 };
+const uint32 NUM_SIZES = sizeof(SIZES) / sizeof(SIZES[0]);
+
+}
+
+KmmStressTest::KmmStressTest() : objects_(NULL)
+{
+}
+
+KmmStressTest::~KmmStressTest()
+{
+}
+
+void KmmStressTest::start()
+{
+  KmmStressTest* test = new KmmStressTest();
+  test->run();
+  delete test;
+}
+
+void KmmStressTest::run()
+{
+  kprintf("KmmStressTest: %d objects alive, %d delete/new pairs per run\n", LIVE_OBJECTS, OPS);
+  KernelMemoryManager* kmm = KernelMemoryManager::instance();
+
+  for(uint32 slabs = 0; slabs <= 1; slabs++)
+  {
+    kmm->setSlabsEnabled(slabs);
+    uint32 ticks = runAllocations();
+
+    kprintf("KmmStressTest: %s ops=%d ticks=%d ops/tick=%d\n", slabs ? "slabs" : "segment list",
+            OPS, ticks, ticks > 0 ? OPS / ticks : OPS);
+    kmm->printStatistics();
+  }
+
+  kmm->setSlabsEnabled(true);
+  ObjectCache::printStatistics();
+}
+
+uint32 KmmStressTest::runAllocations()
+{
+  objects_ = new char*[LIVE_OBJECTS];
+  for(uint32 i = 0; i < LIVE_OBJECTS; i++)
+    objects_[i] = new char[SIZES[i % NUM_SIZES]];
+
+  uint32 random = 12345;
+  uint32 start_ticks = Scheduler::instance()->getTicks();
+
+  for(uint32 i = 0; i < OPS; i++)
+  {
+    random = random * 1103515245 + 12345;
+    uint32 index = (random >> 16) % LIVE_OBJECTS;
+
+    delete[] objects_[index];
+    objects_[index] = new char[SIZES[(random >> 8) % NUM_SIZES]];
+  }
+
+  uint32 ticks = Scheduler::instance()->getTicks() - start_ticks;
+
+  for(uint32 i = 0; i < LIVE_OBJECTS; i++)
+    delete[] objects_[i];
+  delete[] objects_;
+  objects_ = NULL;
+
+  return ticks;
+}
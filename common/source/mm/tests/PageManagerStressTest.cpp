@@ -0,0 +1,152 @@
+/**
+ * Filename: PageManagerStressTest.cpp
+ * Description:
+ *
+ * Created on: 18.10.2026
+ */
+
+#include "mm/tests/PageManagerStressTest.h"
+
+#include "Scheduler.h"
+#include "kprintf.h"
+#include "ArchMemory.h"
+#include "mm/PageManager.h"
+
+PageManagerStressTest::PageManagerStressTest() : errors_(0)
+{
+}
+
+PageManagerStressTest::~PageManagerStressTest()
+{
+}
+
+void PageManagerStressTest::start()
+{
+  PageManagerStressTest* test = new PageManagerStressTest();
+  test->run();
+  delete test;
+}
+
+void PageManagerStressTest::run()
+{
+  PageManager* pm = PageManager::instance();
+  uint32 free_pages = pm->getNumFreePages();
+  kprintf("PageManagerStressTest: %d of %d pages free, %d allocations per run\n",
+          free_pages, pm->getTotalNumPages(), OPS);
+
+  uint32 ticks = runSinglePages();
+  kprintf("PageManagerStressTest: single pages ops=%d ticks=%d ops/tick=%d\n",
+          OPS, ticks, ticks > 0 ? OPS / ticks : OPS);
+
+  ticks = runMixedOrders();
+  kprintf("PageManagerStressTest: orders 0..%d ops=%d ticks=%d ops/tick=%d\n",
+          MAX_MIXED_ORDER, OPS, ticks, ticks > 0 ? OPS / ticks : OPS);
+
+  // 2 MiB pages of x86/64 and 4 MiB pages of x86/32
+  uint32 blocks_2m = runLargeBlocks(9);
+  uint32 blocks_4m = runLargeBlocks(PageManager::MAX_ORDER);
+  kprintf("PageManagerStressTest: %d blocks of order 9, %d blocks of order %d\n",
+          blocks_2m, blocks_4m, PageManager::MAX_ORDER);
+
+  // other threads might have allocated pages in the meantime
+  kprintf("PageManagerStressTest: %d errors, %d pages free (%d before)\n", errors_,
+          pm->getNumFreePages(), free_pages);
+}
+
+uint32 PageManagerStressTest::runSinglePages()
+{
+  uint32 pages[MAX_BLOCKS];
+  uint32 start_ticks = Scheduler::instance()->getTicks();
+
+  for(uint32 i = 0; i < OPS / MAX_BLOCKS; i++)
+  {
+    for(uint32 j = 0; j < MAX_BLOCKS; j++)
+      pages[j] = PageManager::instance()->getFreePhysicalPage(PAGE_KERNEL);
+
+    for(uint32 j = 0; j < MAX_BLOCKS; j++)
+      PageManager::instance()->freePage(pages[j]);
+  }
+
+  return Scheduler::instance()->getTicks() - start_ticks;
+}
+
+uint32 PageManagerStressTest::runMixedOrders()
+{
+  uint32 pages[MAX_BLOCKS];
+  uint32 orders[MAX_BLOCKS];
+  for(uint32 i = 0; i < MAX_BLOCKS; i++)
+  {
+    orders[i] = i % (MAX_MIXED_ORDER + 1);
+    pages[i] = allocateBlock(orders[i]);
+  }
+
+  uint32 random = 12345;
+  uint32 start_ticks = Scheduler::instance()->getTicks();
+
+  for(uint32 i = 0; i < OPS; i++)
+  {
+    random = random * 1103515245 + 12345;
+    uint32 index = (random >> 16) % MAX_BLOCKS;
+
+    freeBlock(pages[index], orders[index]);
+    orders[index] = (random >> 8) % (MAX_MIXED_ORDER + 1);
+    pages[index] = allocateBlock(orders[index]);
+  }
+
+  uint32 ticks = Scheduler::instance()->getTicks() - start_ticks;
+
+  for(uint32 i = 0; i < MAX_BLOCKS; i++)
+    freeBlock(pages[i], orders[i]);
+
+  return ticks;
+}
+
+uint32 PageManagerStressTest::runLargeBlocks(uint32 order)
+{
+  uint32 pages[MAX_LARGE_BLOCKS];
+  uint32 num_blocks = 0;
+
+  while(num_blocks < MAX_LARGE_BLOCKS && (pages[num_blocks] = allocateBlock(order)) != 0)
+    num_blocks++;
+
+  for(uint32 i = 0; i < num_blocks; i++)
+    freeBlock(pages[i], order);
+
+  return num_blocks;
+}
+
+uint32 PageManagerStressTest::allocateBlock(uint32 order)
+{
+  uint32 page = PageManager::instance()->getFreePhysicalPages(order);
+  if(page == 0)
+    return 0;
+
+  if(page % (1U << order) != 0)
+  {
+    kprintf("PageManagerStressTest: block %d of order %d is not aligned\n", page, order);
+    errors_++;
+  }
+
+  for(uint32 p = page; p < page + (1U << order); p++)
+    *((uint32*) ArchMemory::getIdentAddressOfPPN(p)) = page;
+
+  return page;
+}
+
+void PageManagerStressTest::freeBlock(uint32 page, uint32 order)
+{
+  if(page == 0)
+    return;
+
+  for(uint32 p = page; p < page + (1U << order); p++)
+  {
+    if(*((uint32*) ArchMemory::getIdentAddressOfPPN(p)) != page)
+    {
+      kprintf("PageManagerStressTest: page %d of block %d was given out twice\n", p, page);
+      errors_++;
+      break;
+    }
+  }
+
+  PageManager::instance()->freePage(page);
+}
@@ -11,6 +11,12 @@
 #define MAP_SHARED    0x40000000  // 0100..
 #define MAP_ANONYMOUS 0x80000000  // 1000..
 
+#define MAP_FAILED    ((void*) -1)
+
+#define MS_ASYNC      0x00000001
+#define MS_INVALIDATE 0x00000002
+#define MS_SYNC       0x00000004
+
 /**
  * posix function signature
  * do not change the signature!
@@ -23,6 +29,12 @@ extern void* mmap(void* start, size_t length, int prot, int flags, int fd, off_t
  */
 extern int munmap(void* start, size_t length);
 
+/**
+ * posix function signature
+ * do not change the signature!
+ */
+extern int msync(void* start, size_t length, int flags);
+
 /**
  * posix function signature
  * do not change the signature!
@@ -0,0 +1,44 @@
+#ifndef uio_h___
+#define uio_h___
+
+#include "types.h"
+
+/**
+ * the maximal number of buffers of a single readv() / writev() call
+ */
+#define IOV_MAX 1024
+
+/**
+ * a buffer of a vectored I/O operation
+ */
+struct iovec
+{
+  void* iov_base;
+  size_t iov_len;
+};
+
+/**
+ * Reads from a file descriptor into several buffers.
+ * Works like a single read() filling the buffers in array order, each
+ * buffer is filled completely before the next one is used.
+ *
+ * @param file_descriptor file descriptor referencing the file to read
+ * @param iov the array of buffers
+ * @param iovcnt the number of buffers (at most IOV_MAX)
+ * @return the number of bytes read on success, and -1 if an error occured
+ */
+extern ssize_t readv(int file_descriptor, const struct iovec* iov, int iovcnt);
+
+/**
+ * Writes several buffers to a file descriptor.
+ * Works like a single write() of the concatenated buffers, the data of a
+ * writev() is not interleaved with the data of other writes to the file.
+ *
+ * @param file_descriptor file descriptor referencing the file to write
+ * @param iov the array of buffers
+ * @param iovcnt the number of buffers (at most IOV_MAX)
+ * @return the number of bytes written on success, and -1 if an error occured
+ */
+extern ssize_t writev(int file_descriptor, const struct iovec* iov, int iovcnt);
+
+#endif // uio_h___
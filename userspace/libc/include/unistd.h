@@ -300,6 +300,36 @@ extern ssize_t read(int file_descriptor, void *buffer, size_t count);
  */
 extern ssize_t write(int file_descriptor, const void *buffer, size_t count);
 
+/**
+ * Reads from a file descriptor at the given offset.
+ * Works like read(), but the read starts at the given offset and the file
+ * position associated with the descriptor is not used and not changed.
+ *
+ * @param file_descriptor file descriptor referencing the file to read
+ * @param buffer the buffer where the read data will be placed
+ * @param count the number of bytes to read
+ * @param offset the absolute offset where the read operation starts
+ * @return the number of bytes read on success, 0 if count is zero or the \
+ offset is after the end-of-file, and -1 if an error occured
+ *
+ */
+extern ssize_t pread(int file_descriptor, void *buffer, size_t count, off_t offset);
+
+/**
+ * Writes to a file descriptor at the given offset.
+ * Works like write(), but the write starts at the given offset and the file
+ * position associated with the descriptor is not used and not changed.
+ *
+ * @param file_descriptor file descriptor referencing the file to write
+ * @param buffer the buffer where the write data will be placed
+ * @param count the number of bytes to write
+ * @param offset the absolute offset where the write operation starts
+ * @return the number of bytes written on success, 0 if count is zero or\
+ nothing was written, and -1 if an error occured
+ *
+ */
+extern ssize_t pwrite(int file_descriptor, const void *buffer, size_t count, off_t offset);
+
 /**
  * posix function signature
  * do not change the signature!
@@ -318,6 +348,12 @@ extern void* sbrk(intptr_t increment);
  */
 extern unsigned int sleep(unsigned int seconds);
 
+/**
+ * posix function signature
+ * do not change the signature!
+ */
+extern int nice(int increment);
+
 //----------------------------------------------------------------------
 /**
  * Replaces the current process image with a new one.
@@ -1,22 +1,33 @@
 #include "sys/mman.h"
+#include "sys/syscall.h"
+#include "../../../common/include/kernel/syscall-definitions.h"
 
 /**
- * function stub
  * posix compatible signature - do not change the signature!
+ * the arguments do not fit into the syscall registers, so the kernel gets
+ * a pointer to them
  */
 void* mmap(void* start, size_t length, int prot, int flags, int fd,
            off_t offset)
 {
-  return 0;
+  size_t args[6] = { (size_t) start, length, prot, flags, fd, offset };
+  return (void*) __syscall(sc_mmap, (long) args, 0x00, 0x00, 0x00, 0x00);
 }
 
 /**
- * function stub
  * posix compatible signature - do not change the signature!
  */
 int munmap(void* start, size_t length)
 {
-  return -1;
+  return __syscall(sc_munmap, (long) start, length, 0x00, 0x00, 0x00);
+}
+
+/**
+ * posix compatible signature - do not change the signature!
+ */
+int msync(void* start, size_t length, int flags)
+{
+  return __syscall(sc_msync, (long) start, length, flags, 0x00, 0x00);
 }
 
 /**
@@ -0,0 +1,19 @@
+#include "sys/uio.h"
+#include "sys/syscall.h"
+#include "../../../common/include/kernel/syscall-definitions.h"
+
+/**
+ * posix compatible signature - do not change the signature!
+ */
+ssize_t readv(int file_descriptor, const struct iovec* iov, int iovcnt)
+{
+  return __syscall(sc_readv, file_descriptor, (long) iov, iovcnt, 0x00, 0x00);
+}
+
+/**
+ * posix compatible signature - do not change the signature!
+ */
+ssize_t writev(int file_descriptor, const struct iovec* iov, int iovcnt)
+{
+  return __syscall(sc_writev, file_descriptor, (long) iov, iovcnt, 0x00, 0x00);
+}
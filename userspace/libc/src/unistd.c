@@ -1,4 +1,6 @@
 #include "unistd.h"
+#include "sys/syscall.h"
+#include "../../../common/include/kernel/syscall-definitions.h"
 
 
 /**
@@ -29,5 +31,10 @@ unsigned int sleep(unsigned int seconds)
   return -1U;
 }
 
-
-
+/**
+ * posix compatible signature - do not change the signature!
+ */
+int nice(int increment)
+{
+  return __syscall(sc_nice, increment, 0x00, 0x00, 0x00, 0x00);
+}
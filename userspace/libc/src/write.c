@@ -63,3 +63,26 @@ ssize_t write(int file_descriptor, const void *buffer, size_t count)
   return __syscall(sc_write, file_descriptor, (long) buffer, count, 0x00,
                    0x00);
 }
+
+
+
+//----------------------------------------------------------------------
+/**
+ * Writes to a file descriptor at the given offset.
+ * Works like write(), but the write starts at the given offset and the file
+ * position associated with the descriptor is not used and not changed.
+ *
+ * @param file_descriptor file descriptor referencing the file to write
+ * @param buffer the buffer where the write data will be placed
+ * @param count the number of bytes to write
+ * @param offset the absolute offset where the write operation starts
+ * @return the number of bytes written on success, 0 if count is zero or\
+ nothing was written, and -1 if an error occured
+ *
+ */
+ssize_t pwrite(int file_descriptor, const void *buffer, size_t count,
+               off_t offset)
+{
+  return __syscall(sc_pwrite, file_descriptor, (long) buffer, count, offset,
+                   0x00);
+}
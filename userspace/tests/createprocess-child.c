@@ -0,0 +1,15 @@
+#include "fcntl.h"
+#include "unistd.h"
+
+/* started by createprocess-test.sweb, leaves the marker it checks */
+
+int main()
+{
+  int fd = open("/createprocess-test.out", O_WRONLY);
+  if (fd < 0)
+    return 1;
+
+  write(fd, "started", 7);
+  close(fd);
+  return 0;
+}
@@ -0,0 +1,47 @@
+#include "stdio.h"
+#include "string.h"
+#include "fcntl.h"
+#include "unistd.h"
+#include "nonstd.h"
+
+/* starts createprocess-child.sweb and checks that it actually ran, the
+   child writes a marker to MARKER_FILE */
+
+#define MARKER_FILE "/createprocess-test.out"
+#define MARKER "started"
+
+int main()
+{
+  char buffer[sizeof(MARKER)];
+  int fd;
+  int num_read;
+
+  /* empties the marker file of an earlier run */
+  fd = open(MARKER_FILE, O_CREAT | O_WRONLY | O_TRUNC);
+  if (fd < 0)
+  {
+    printf("createprocess-test: FAILED, can not create %s\n", MARKER_FILE);
+    return 1;
+  }
+  close(fd);
+
+  if (createprocess("/createprocess-child.sweb", 1) != 0)
+  {
+    printf("createprocess-test: FAILED, can not start the child\n");
+    return 1;
+  }
+
+  fd = open(MARKER_FILE, O_RDONLY);
+  num_read = (fd < 0) ? -1 : read(fd, buffer, sizeof(buffer) - 1);
+  if (fd >= 0)
+    close(fd);
+
+  if (num_read != sizeof(MARKER) - 1 || memcmp(buffer, MARKER, sizeof(MARKER) - 1) != 0)
+  {
+    printf("createprocess-test: FAILED, the child did not run\n");
+    return 1;
+  }
+
+  printf("createprocess-test: ok\n");
+  return 0;
+}
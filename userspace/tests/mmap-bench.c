@@ -0,0 +1,153 @@
+#include "stdio.h"
+#include "fcntl.h"
+#include "unistd.h"
+#include "sys/mman.h"
+
+/* compares scanning a file through mmap() with scanning it through read() */
+
+#define FILE_NAME "/mmap-bench.dat"
+#define FILE_SIZE (256 * 1024)
+#define CHUNK_SIZE 4096
+#define RUNS 3
+
+typedef unsigned int uint32;
+typedef unsigned long long uint64;
+
+char chunk[CHUNK_SIZE];
+
+uint64 cycles()
+{
+#if defined(__i386__) || defined(__x86_64__)
+  uint32 low, high;
+  asm volatile("rdtsc" : "=a"(low), "=d"(high));
+  return ((uint64) high << 32) | low;
+#else
+  return 0;
+#endif
+}
+
+int createFile()
+{
+  int fd = open(FILE_NAME, O_RDWR | O_CREAT);
+  int i, j;
+
+  if (fd < 0)
+    return -1;
+
+  for (i = 0; i < FILE_SIZE / CHUNK_SIZE; ++i)
+  {
+    for (j = 0; j < CHUNK_SIZE; ++j)
+      chunk[j] = (char) (i * CHUNK_SIZE + j);
+
+    if (write(fd, chunk, CHUNK_SIZE) != CHUNK_SIZE)
+    {
+      close(fd);
+      return -1;
+    }
+  }
+  close(fd);
+  return 0;
+}
+
+uint32 scanRead(int fd)
+{
+  uint32 sum = 0;
+  int i, j;
+
+  lseek(fd, 0, SEEK_SET);
+  for (i = 0; i < FILE_SIZE / CHUNK_SIZE; ++i)
+  {
+    if (read(fd, chunk, CHUNK_SIZE) != CHUNK_SIZE)
+      return 0;
+
+    for (j = 0; j < CHUNK_SIZE; ++j)
+      sum += (unsigned char) chunk[j];
+  }
+  return sum;
+}
+
+uint32 scanMapped(int fd)
+{
+  uint32 sum = 0;
+  unsigned char* data = mmap(0, FILE_SIZE, PROT_READ, MAP_SHARED, fd, 0);
+  int i;
+
+  if (data == MAP_FAILED)
+    return 0;
+
+  for (i = 0; i < FILE_SIZE; ++i)
+    sum += data[i];
+
+  munmap(data, FILE_SIZE);
+  return sum;
+}
+
+/* changes a byte of every page through a shared mapping, checks it with read() */
+int checkWriteBack(int fd)
+{
+  char* data = mmap(0, FILE_SIZE, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+  char c;
+  int i;
+
+  if (data == MAP_FAILED)
+    return -1;
+
+  for (i = 0; i < FILE_SIZE; i += CHUNK_SIZE)
+    data[i + 7] = 'M';
+
+  if (msync(data, FILE_SIZE, MS_SYNC) != 0)
+    return -1;
+
+  for (i = 0; i < FILE_SIZE; i += CHUNK_SIZE)
+  {
+    lseek(fd, i + 7, SEEK_SET);
+    if (read(fd, &c, 1) != 1 || c != 'M')
+      return -1;
+  }
+
+  /* restore the original content, munmap() writes it back */
+  for (i = 0; i < FILE_SIZE; i += CHUNK_SIZE)
+    data[i + 7] = (char) (i + 7);
+
+  return munmap(data, FILE_SIZE);
+}
+
+int main()
+{
+  uint64 start, read_cycles, mapped_cycles;
+  uint32 read_sum, mapped_sum;
+  int fd, run;
+
+  if (createFile() != 0)
+  {
+    printf("mmap-bench: cannot create %s\n", FILE_NAME);
+    return -1;
+  }
+
+  fd = open(FILE_NAME, O_RDWR);
+  if (fd < 0)
+  {
+    printf("mmap-bench: cannot open %s\n", FILE_NAME);
+    return -1;
+  }
+
+  for (run = 0; run < RUNS; ++run)
+  {
+    start = cycles();
+    read_sum = scanRead(fd);
+    read_cycles = cycles() - start;
+
+    start = cycles();
+    mapped_sum = scanMapped(fd);
+    mapped_cycles = cycles() - start;
+
+    printf("mmap-bench: run %d: read() %d kcycles, mmap() %d kcycles, sums %s\n", run,
+           (uint32) (read_cycles / 1000), (uint32) (mapped_cycles / 1000),
+           read_sum == mapped_sum && read_sum != 0 ? "equal" : "DIFFERENT");
+  }
+
+  printf("mmap-bench: shared write back %s\n", checkWriteBack(fd) == 0 ? "ok" : "FAILED");
+
+  close(fd);
+  return 0;
+}
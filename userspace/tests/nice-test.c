@@ -0,0 +1,35 @@
+#include "stdio.h"
+#include "unistd.h"
+#include "sched.h"
+
+/* checks that nice() changes and clamps the priority of the process */
+
+int check(int increment, int expected)
+{
+  int result = nice(increment);
+
+  if (result != expected)
+  {
+    printf("nice-test: nice(%d) returned %d, expected %d\n", increment, result, expected);
+    return 1;
+  }
+  return 0;
+}
+
+int main()
+{
+  int errors = 0;
+
+  errors += check(0, 0);
+  errors += check(5, 5);
+  errors += check(100, 19);
+  errors += check(-100, -20);
+
+  /* the highest priority must not keep the process from yielding */
+  sched_yield();
+
+  errors += check(20, 0);
+
+  printf("nice-test: %s\n", errors == 0 ? "ok" : "FAILED");
+  return errors;
+}
@@ -19,6 +19,14 @@
 #include "TaskSetupRootPartition.h"
 #include "TaskCopyFiles.h"
 #include "TaskInstallOnFlashDrive.h"
+#include "TaskBenchmarkCache.h"
+#include "TaskBenchmarkPath.h"
+#include "TaskBenchmarkDir.h"
+#include "TaskBenchmarkFd.h"
+#include "TaskBenchmarkBlockMap.h"
+#include "TaskBenchmarkAlloc.h"
+#include "TaskBenchmarkFrag.h"
+#include "TaskBenchmarkSlotLock.h"
 #include "ImageInfo.h"
 
 //#include "TaskTestFs.h"
@@ -100,6 +108,14 @@ void Program::createTasks(void)
   tasks_.push_back( new TaskSetupRootPartition(*this) );
   tasks_.push_back( new TaskCopyFiles(*this) );
   tasks_.push_back( new TaskInstallOnFlashDrive(*this) );
+  tasks_.push_back( new TaskBenchmarkCache(*this) );
+  tasks_.push_back( new TaskBenchmarkPath(*this) );
+  tasks_.push_back( new TaskBenchmarkDir(*this) );
+  tasks_.push_back( new TaskBenchmarkFd(*this) );
+  tasks_.push_back( new TaskBenchmarkBlockMap(*this) );
+  tasks_.push_back( new TaskBenchmarkAlloc(*this) );
+  tasks_.push_back( new TaskBenchmarkFrag(*this) );
+  tasks_.push_back( new TaskBenchmarkSlotLock(*this) );
 
   // TODO add here more tasks
 }
@@ -28,6 +28,7 @@ const uint32 FS_BITMAP          = 0x00800008;// | OUTPUT_ENABLED;
 const uint32 FS_INODE           = 0x00800010;// | OUTPUT_ENABLED;
 const uint32 FS_UTIL            = 0x00800020;
 const uint32 FS_TESTCASE        = 0x00800040 | OUTPUT_ENABLED;
+const uint32 DENTRY_CACHE       = 0x00800080;// | OUTPUT_ENABLED;
 
 // group: Unix style FileSystems
 const uint32 FS_UNIX            = 0x00804000;// | OUTPUT_ENABLED;
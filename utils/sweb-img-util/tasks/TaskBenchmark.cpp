@@ -0,0 +1,94 @@
+/**
+ * Filename: TaskBenchmark.cpp
+ * Description:
+ *
+ * Created on: 18.10.2026
+ */
+
+#include "TaskBenchmark.h"
+
+#include <iostream>
+#include <string.h>
+#include <time.h>
+#include <stdlib.h>
+#include <unistd.h>
+
+#include "fs/VfsSyscall.h"
+#include "fs/device/FsDeviceFile.h"
+#include "fs/minix/FormatMinixPartition.h"
+#include "Program.h"
+
+namespace
+{
+
+const uint8 MINIX_PARTITION_IDENTIFIER = 0x81;
+
+}
+
+TaskBenchmark::TaskBenchmark(Program& image_util, const char* name, uint32_t image_size) :
+    UtilTask(image_util), name_(name), image_size_(image_size)
+{
+  image_name_[0] = '\0';
+}
+
+TaskBenchmark::~TaskBenchmark()
+{
+}
+
+void TaskBenchmark::execute(void)
+{
+  if(image_size_ == 0)
+  {
+    run();
+    return;
+  }
+
+  // the file-system lives in a temporary image-file
+  strcpy(image_name_, "/tmp/sweb-bench-XXXXXX");
+  int image_fd = mkstemp(image_name_);
+
+  if(image_fd < 0 || ftruncate(image_fd, image_size_) != 0)
+  {
+    printError("failed to create a temporary image-file");
+    if(image_fd >= 0)
+    {
+      close(image_fd);
+      unlink(image_name_);
+    }
+    return;
+  }
+  close(image_fd);
+
+  if(formatImage())
+    run();
+  else
+    printError("failed to format the image");
+
+  unlink(image_name_);
+}
+
+bool TaskBenchmark::formatImage(void)
+{
+  FsDevice* format_device = new FsDeviceFile(image_name_, 0, image_size_);
+  bool formatted = FormatMinixPartition::format(format_device, 1024);
+  delete format_device;
+
+  return formatted;
+}
+
+VfsSyscall* TaskBenchmark::mountImage(void)
+{
+  return new VfsSyscall(new FsDeviceFile(image_name_, 0, image_size_), MINIX_PARTITION_IDENTIFIER);
+}
+
+void TaskBenchmark::printError(const char* message) const
+{
+  std::cout << name_ << " benchmark - ERROR " << message << std::endl;
+}
+
+double TaskBenchmark::getTimeNs(void)
+{
+  struct timespec ts;
+  clock_gettime(CLOCK_MONOTONIC, &ts);
+  return ts.tv_sec * 1e9 + ts.tv_nsec;
+}
@@ -0,0 +1,78 @@
+/**
+ * Filename: TaskBenchmark.h
+ * Description:
+ *
+ * Created on: 18.10.2026
+ */
+
+#ifndef TASKBENCHMARK_H_
+#define TASKBENCHMARK_H_
+
+#include "UtilTask.h"
+
+/**
+ * @class TaskBenchmark base class of the benchmarks, it provides the
+ * temporary image-file holding a freshly formatted Minix file-system,
+ * the derived classes only implement their measurements in run()
+ */
+class TaskBenchmark : public UtilTask
+{
+public:
+  /**
+   * constructor
+   *
+   * @param image_util the Program Manager class
+   * @param name the name of the benchmark (for the output)
+   * @param image_size the size of the temporary image-file in bytes, 0 if
+   * the benchmark does not need a file-system
+   */
+  TaskBenchmark(Program& image_util, const char* name, uint32_t image_size);
+  virtual ~TaskBenchmark();
+
+  /**
+   * creates and formats the temporary image-file, runs the benchmark and
+   * removes the image-file again
+   */
+  virtual void execute(void);
+
+protected:
+
+  /**
+   * the measurements of the benchmark, the image-file is formatted
+   */
+  virtual void run(void) = 0;
+
+  /**
+   * formats the image-file again, e.g. for a fresh file-system per run
+   *
+   * @return true on success
+   */
+  bool formatImage(void);
+
+  /**
+   * mounts the file-system of the image-file
+   *
+   * @return the new VfsSyscall instance, deleting it unmounts the image
+   */
+  VfsSyscall* mountImage(void);
+
+  /**
+   * prints an error message, prefixed by the name of the benchmark
+   */
+  void printError(const char* message) const;
+
+  /**
+   * @return the monotonic time in ns
+   */
+  static double getTimeNs(void);
+
+private:
+
+  const char* name_;
+  const uint32_t image_size_;
+
+  // the name of the temporary image-file (mkstemp() template)
+  char image_name_[32];
+};
+
+#endif /* TASKBENCHMARK_H_ */
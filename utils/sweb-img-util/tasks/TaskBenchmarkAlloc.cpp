@@ -0,0 +1,140 @@
+/**
+ * Filename: TaskBenchmarkAlloc.cpp
+ * Description:
+ *
+ * Created on: 18.10.2026
+ */
+
+#include "TaskBenchmarkAlloc.h"
+
+#include <iostream>
+#include <iomanip>
+
+#include "fs/VfsSyscall.h"
+#include "fs/Statfs.h"
+#include "fs/FsWorkingDirectory.h"
+#include "Program.h"
+
+TaskBenchmarkAlloc::TaskBenchmarkAlloc(Program& image_util) :
+    TaskBenchmark(image_util, "alloc", 48 * 1024 * 1024)
+{
+}
+
+TaskBenchmarkAlloc::~TaskBenchmarkAlloc()
+{
+}
+
+void TaskBenchmarkAlloc::run(void)
+{
+  const uint32_t FILL_PERCENT[] = { 0, 50, 90, 97 };
+  const uint32_t NUM_FILLS = sizeof(FILL_PERCENT) / sizeof(FILL_PERCENT[0]);
+
+  VfsSyscall* vfs = mountImage();
+  FsWorkingDirectory* wd_info = new FsWorkingDirectory();
+
+  statfs_s* info = vfs->statfs(wd_info, "/");
+  const uint32_t num_blocks = info->num_blocks;
+  const uint32_t block_size = info->block_size;
+  delete info;
+
+  std::cout << "alloc benchmark - appending " << APPEND_SIZE / 1024 << " KiB in "
+            << BUFFER_SIZE << " byte writes, " << num_blocks << " data blocks" << std::endl;
+  std::cout << std::setw(10) << "used (%)" << std::setw(14) << "free blocks"
+            << std::setw(18) << "append (ns/blk)" << std::setw(14) << "statfs (ns)" << std::endl;
+
+  for(uint32_t i = 0; i < NUM_FILLS; i++)
+  {
+    // growing the filler file up to the fill level
+    info = vfs->statfs(wd_info, "/");
+    uint32_t used = num_blocks - info->num_free_blocks;
+    uint32_t target = (uint64_t)num_blocks * FILL_PERCENT[i] / 100;
+    delete info;
+
+    // the indirect blocks of the filler also need some space
+    if(target > used &&
+       !appendToFile(vfs, wd_info, "/filler", (target - used) / 520 * 512 * block_size))
+    {
+      printError("failed to fill the volume");
+      break;
+    }
+
+    info = vfs->statfs(wd_info, "/");
+    uint32_t num_free = info->num_free_blocks;
+    delete info;
+
+    double append = measureAppend(vfs, wd_info);
+    double statfs = measureStatfs(vfs, wd_info);
+
+    if(append < 0)
+    {
+      printError("failed to append to the file");
+      break;
+    }
+
+    std::cout << std::setw(10) << (num_blocks - num_free) * 100 / num_blocks << std::setw(14) << num_free
+              << std::fixed << std::setprecision(0)
+              << std::setw(18) << append << std::setw(14) << statfs << std::endl;
+  }
+
+  delete wd_info;
+  delete vfs;
+}
+
+bool TaskBenchmarkAlloc::appendToFile(VfsSyscall* vfs, FsWorkingDirectory* wd_info, const char* path,
+                                      uint32_t size)
+{
+  char buffer[BUFFER_SIZE];
+  for(uint32_t i = 0; i < BUFFER_SIZE; i++)
+    buffer[i] = 'a' + i % 26;
+
+  int32 fd = vfs->open(wd_info, path, O_WRONLY | O_CREAT | O_APPEND);
+  if(fd < 0)
+    return false;
+
+  vfs->lseek(wd_info, fd, 0, SEEK_END);
+
+  bool success = true;
+  for(uint32_t written = 0; written < size && success; written += BUFFER_SIZE)
+    success = (vfs->write(wd_info, fd, buffer, BUFFER_SIZE) == (int32)BUFFER_SIZE);
+
+  vfs->close(wd_info, fd);
+  return success;
+}
+
+double TaskBenchmarkAlloc::measureAppend(VfsSyscall* vfs, FsWorkingDirectory* wd_info)
+{
+  statfs_s* info = vfs->statfs(wd_info, "/");
+  uint32_t block_size = info->block_size;
+  delete info;
+
+  double start = getTimeNs();
+  bool success = appendToFile(vfs, wd_info, "/append", APPEND_SIZE);
+  double duration = getTimeNs() - start;
+
+  vfs->unlink(wd_info, "/append");
+
+  if(!success)
+    return -1.0;
+
+  return duration / (APPEND_SIZE / block_size);
+}
+
+double TaskBenchmarkAlloc::measureStatfs(VfsSyscall* vfs, FsWorkingDirectory* wd_info)
+{
+  double start = getTimeNs();
+
+  for(uint32_t i = 0; i < NUM_STATFS; i++)
+    delete vfs->statfs(wd_info, "/");
+
+  return (getTimeNs() - start) / NUM_STATFS;
+}
+
+char TaskBenchmarkAlloc::getOptionName(void) const
+{
+  return 'a';
+}
+
+const char* TaskBenchmarkAlloc::getDescription(void) const
+{
+  return "runs the block allocation benchmark (appending and statfs on a 0..97% full volume), no image-file required. call with : -a";
+}
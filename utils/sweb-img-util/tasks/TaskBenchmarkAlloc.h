@@ -0,0 +1,68 @@
+/**
+ * Filename: TaskBenchmarkAlloc.h
+ * Description:
+ *
+ * Created on: 18.10.2026
+ */
+
+#ifndef TASKBENCHMARKALLOC_H_
+#define TASKBENCHMARKALLOC_H_
+
+#include "TaskBenchmark.h"
+
+class FsWorkingDirectory;
+
+/**
+ * @class TaskBenchmarkAlloc measures the allocation of data blocks
+ * (appending to a file) and statfs() on an increasingly full volume, the
+ * file-system is created in a temporary image-file
+ */
+class TaskBenchmarkAlloc : public TaskBenchmark
+{
+public:
+  TaskBenchmarkAlloc(Program& image_util);
+  virtual ~TaskBenchmarkAlloc();
+
+  /**
+   * returns the char identifying this option (e.g. h for help)
+   */
+  virtual char getOptionName(void) const;
+
+  virtual const char* getDescription(void) const;
+
+protected:
+
+  /**
+   * runs the measurements
+   */
+  virtual void run(void);
+
+private:
+
+  // the number of bytes per write()
+  static const uint32_t BUFFER_SIZE = 4096;
+
+  // the size of the file appended to during a measurement
+  static const uint32_t APPEND_SIZE = 1024 * 1024;
+
+  // the number of statfs() calls per measurement
+  static const uint32_t NUM_STATFS = 100;
+
+  /**
+   * appends size bytes to a file
+   */
+  static bool appendToFile(VfsSyscall* vfs, FsWorkingDirectory* wd_info, const char* path,
+                           uint32_t size);
+
+  /**
+   * @return ns per appended data block or a negative value on errors
+   */
+  static double measureAppend(VfsSyscall* vfs, FsWorkingDirectory* wd_info);
+
+  /**
+   * @return ns per statfs()
+   */
+  static double measureStatfs(VfsSyscall* vfs, FsWorkingDirectory* wd_info);
+};
+
+#endif /* TASKBENCHMARKALLOC_H_ */
@@ -0,0 +1,175 @@
+/**
+ * Filename: TaskBenchmarkBlockMap.cpp
+ * Description:
+ *
+ * Created on: 18.10.2026
+ */
+
+#include "TaskBenchmarkBlockMap.h"
+
+#include <iostream>
+#include <iomanip>
+#include <sstream>
+#include <string>
+
+#include "fs/VfsSyscall.h"
+#include "fs/FsWorkingDirectory.h"
+#include "fs/FileDescriptor.h"
+#include "fs/FileDescriptorTable.h"
+#include "fs/inodes/File.h"
+#include "Program.h"
+
+const uint32_t TaskBenchmarkBlockMap::FILE_SIZES_MB[] = { 1, 8, 32 };
+
+namespace
+{
+
+std::string getFilePath(uint32_t index)
+{
+  std::ostringstream path;
+  path << "/f" << index;
+  return path.str();
+}
+
+}
+
+TaskBenchmarkBlockMap::TaskBenchmarkBlockMap(Program& image_util) :
+    TaskBenchmark(image_util, "block-map", 48 * 1024 * 1024)
+{
+}
+
+TaskBenchmarkBlockMap::~TaskBenchmarkBlockMap()
+{
+}
+
+void TaskBenchmarkBlockMap::run(void)
+{
+  if(!createFiles())
+  {
+    printError("failed to create the files");
+    return;
+  }
+
+  std::cout << "block-map benchmark - " << NUM_OPENS << " cold open() per file (fresh mount)" << std::endl;
+  std::cout << std::setw(10) << "size (MB)" << std::setw(10) << "blocks" << std::setw(10) << "extents"
+            << std::setw(16) << "list (bytes)" << std::setw(16) << "flat (bytes)"
+            << std::setw(12) << "open (ns)" << std::setw(22) << "read last block (ns)" << std::endl;
+
+  for(uint32_t file = 0; file < NUM_FILES; file++)
+  {
+    double sum_open = 0.0;
+    double sum_read = 0.0;
+    uint32_t num_sectors = 0;
+    uint32_t num_extents = 0;
+    bool failed = false;
+
+    for(uint32_t i = 0; i < NUM_OPENS && !failed; i++)
+    {
+      double ns_open = 0.0;
+      double ns_read = 0.0;
+
+      failed = !measureOpen(file, ns_open, ns_read, num_sectors, num_extents);
+
+      sum_open += ns_open;
+      sum_read += ns_read;
+    }
+
+    if(failed)
+    {
+      printError(("failed to read " + getFilePath(file)).c_str());
+      break;
+    }
+
+    std::cout << std::setw(10) << FILE_SIZES_MB[file] << std::setw(10) << num_sectors
+              << std::setw(10) << num_extents
+              << std::setw(16) << num_extents * sizeof(SectorExtentMap::SectorExtent)
+              << std::setw(16) << num_sectors * sizeof(sector_addr_t)
+              << std::fixed << std::setprecision(0)
+              << std::setw(12) << sum_open / NUM_OPENS << std::setw(22) << sum_read / NUM_OPENS << std::endl;
+  }
+}
+
+bool TaskBenchmarkBlockMap::createFiles(void)
+{
+  VfsSyscall* vfs = mountImage();
+  FsWorkingDirectory* wd_info = new FsWorkingDirectory();
+
+  char* buffer = new char[BUFFER_SIZE];
+  for(uint32_t i = 0; i < BUFFER_SIZE; i++)
+    buffer[i] = 'a' + i % 26;
+
+  bool success = true;
+
+  for(uint32_t i = 0; i < NUM_FILES && success; i++)
+  {
+    int32 fd = vfs->creat(wd_info, getFilePath(i).c_str());
+    if(fd < 0)
+    {
+      success = false;
+      break;
+    }
+
+    for(uint32_t written = 0; written < FILE_SIZES_MB[i] * 1024 * 1024; written += BUFFER_SIZE)
+    {
+      if(vfs->write(wd_info, fd, buffer, BUFFER_SIZE) != (int32)BUFFER_SIZE)
+      {
+        success = false;
+        break;
+      }
+    }
+
+    vfs->close(wd_info, fd);
+  }
+
+  delete[] buffer;
+
+  // the working directory has to go before the vfs
+  delete wd_info;
+  delete vfs;
+
+  return success;
+}
+
+bool TaskBenchmarkBlockMap::measureOpen(uint32_t file, double& ns_open, double& ns_read,
+                                        uint32_t& num_sectors, uint32_t& num_extents)
+{
+  // a fresh mount, so the I-Node is not cached
+  VfsSyscall* vfs = mountImage();
+  FsWorkingDirectory* wd_info = new FsWorkingDirectory();
+
+  char buffer[1024];
+  bool success = false;
+
+  double start = getTimeNs();
+  int32 fd = vfs->open(wd_info, getFilePath(file).c_str(), O_RDONLY);
+  ns_open = getTimeNs() - start;
+
+  if(fd >= 0)
+  {
+    start = getTimeNs();
+    success = vfs->lseek(wd_info, fd, FILE_SIZES_MB[file] * 1024 * 1024 - sizeof(buffer), SEEK_SET) >= 0 &&
+              vfs->read(wd_info, fd, buffer, sizeof(buffer)) == (int32)sizeof(buffer);
+    ns_read = getTimeNs() - start;
+
+    File* inode = wd_info->getFileDescriptorTable()->get(fd)->getFile();
+    num_sectors = inode->getNumSectors();
+    num_extents = inode->getNumSectorExtents();
+
+    vfs->close(wd_info, fd);
+  }
+
+  delete wd_info;
+  delete vfs;
+
+  return success;
+}
+
+char TaskBenchmarkBlockMap::getOptionName(void) const
+{
+  return 'e';
+}
+
+const char* TaskBenchmarkBlockMap::getDescription(void) const
+{
+  return "runs the block-map benchmark (cold open of 1, 8 and 32 MB files, size of the block-list), no image-file required. call with : -e";
+}
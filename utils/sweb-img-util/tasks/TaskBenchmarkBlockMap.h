@@ -0,0 +1,69 @@
+/**
+ * Filename: TaskBenchmarkBlockMap.h
+ * Description:
+ *
+ * Created on: 18.10.2026
+ */
+
+#ifndef TASKBENCHMARKBLOCKMAP_H_
+#define TASKBENCHMARKBLOCKMAP_H_
+
+#include "TaskBenchmark.h"
+
+/**
+ * @class TaskBenchmarkBlockMap measures the (cold) open() latency of large
+ * files and the memory used by the I-Node's list of data blocks, the
+ * file-system is created in a temporary image-file
+ */
+class TaskBenchmarkBlockMap : public TaskBenchmark
+{
+public:
+  TaskBenchmarkBlockMap(Program& image_util);
+  virtual ~TaskBenchmarkBlockMap();
+
+  /**
+   * returns the char identifying this option (e.g. h for help)
+   */
+  virtual char getOptionName(void) const;
+
+  virtual const char* getDescription(void) const;
+
+protected:
+
+  /**
+   * runs the measurements
+   */
+  virtual void run(void);
+
+private:
+
+  // the number of test files ("/f0", "/f1", ...)
+  static const uint32_t NUM_FILES = 3;
+
+  // the size of the test files in MiB
+  static const uint32_t FILE_SIZES_MB[NUM_FILES];
+
+  // the number of bytes per write() / read()
+  static const uint32_t BUFFER_SIZE = 64 * 1024;
+
+  // the number of cold open() calls per file
+  static const uint32_t NUM_OPENS = 20;
+
+  /**
+   * creates the test files
+   */
+  bool createFiles(void);
+
+  /**
+   * mounts the image and opens the file, optionally reads it's last block
+   * @param ns_open [out] ns of the open()
+   * @param ns_read [out] ns of the read() of the last block
+   * @param num_sectors [out] number of data blocks of the file
+   * @param num_extents [out] number of extents of the block-list after the read
+   * @return false in case of errors
+   */
+  bool measureOpen(uint32_t file, double& ns_open, double& ns_read,
+                   uint32_t& num_sectors, uint32_t& num_extents);
+};
+
+#endif /* TASKBENCHMARKBLOCKMAP_H_ */
@@ -0,0 +1,213 @@
+/**
+ * Filename: TaskBenchmarkCache.cpp
+ * Description:
+ *
+ * Created on: 18.10.2026
+ */
+
+#include "TaskBenchmarkCache.h"
+
+#include <iostream>
+#include <iomanip>
+
+#include "cache/GeneralCache.h"
+#include "cache/FifoReadCache.h"
+#include "cache/HashedFifoReadCache.h"
+#include "cache/TwoQueueReadCache.h"
+#include "fs/DeviceCache.h"
+#include "Program.h"
+
+namespace
+{
+
+/**
+ * @class a memory-only device handing out zeroed sectors
+ */
+class BenchmarkDevice : public Cache::DeviceAdapter
+{
+public:
+  virtual Cache::Item* read(const Cache::ItemIdentity& ident __attribute__((unused)))
+  {
+    return new SectorCacheItem(new char[SECTOR_SIZE]());
+  }
+
+  virtual bool write(const Cache::ItemIdentity& ident __attribute__((unused)),
+                     Cache::Item* data __attribute__((unused)))
+  {
+    return true;
+  }
+
+  virtual bool remove(const Cache::ItemIdentity& ident __attribute__((unused)),
+                      Cache::Item* item __attribute__((unused)))
+  {
+    return true;
+  }
+
+  static const uint32_t SECTOR_SIZE = 512;
+};
+
+Cache::CacheReadStrategy* createFifoReadCache(Cache::GeneralCache* cache)
+{
+  return new Cache::FifoReadCache(cache);
+}
+
+Cache::CacheReadStrategy* createHashedFifoReadCache(Cache::GeneralCache* cache)
+{
+  return new Cache::HashedFifoReadCache(cache);
+}
+
+Cache::CacheReadStrategy* createTwoQueueReadCache(Cache::GeneralCache* cache)
+{
+  return new Cache::TwoQueueReadCache(cache);
+}
+
+}
+
+TaskBenchmarkCache::TaskBenchmarkCache(Program& image_util) :
+    TaskBenchmark(image_util, "cache", 0)
+{
+}
+
+TaskBenchmarkCache::~TaskBenchmarkCache()
+{
+}
+
+void TaskBenchmarkCache::run(void)
+{
+  std::cout << "cache benchmark - hit latency per getItem()/releaseItem()" << std::endl;
+
+  // filling the linear FIFO is quadratic, so it is only measured up to 4k
+  benchmarkHitLatency("FifoReadCache", createFifoReadCache, 4 * 1024);
+  benchmarkHitLatency("HashedFifoReadCache", createHashedFifoReadCache, 64 * 1024);
+  benchmarkHitLatency("TwoQueueReadCache", createTwoQueueReadCache, 64 * 1024);
+
+  // the traces are generated deterministically, so every policy
+  // replays exactly the same sequence of requests
+  const uint32_t NUM_CACHED_SECTORS = 256; // FileSystem's default
+  std::vector<uint32_t> meta_data_trace = createMetaDataScanTrace();
+  std::vector<uint32_t> random_trace = createRandomTrace(NUM_CACHED_SECTORS * 2);
+
+  std::cout << std::endl << "cache benchmark - hit ratio, " << NUM_CACHED_SECTORS
+            << " cached sectors, trace: meta-data + sequential scans" << std::endl;
+  replayTrace("HashedFifoReadCache", createHashedFifoReadCache, meta_data_trace, NUM_CACHED_SECTORS);
+  replayTrace("TwoQueueReadCache", createTwoQueueReadCache, meta_data_trace, NUM_CACHED_SECTORS);
+
+  std::cout << std::endl << "cache benchmark - hit ratio, " << NUM_CACHED_SECTORS
+            << " cached sectors, trace: random, working set " << NUM_CACHED_SECTORS * 2 << std::endl;
+  replayTrace("HashedFifoReadCache", createHashedFifoReadCache, random_trace, NUM_CACHED_SECTORS);
+  replayTrace("TwoQueueReadCache", createTwoQueueReadCache, random_trace, NUM_CACHED_SECTORS);
+}
+
+std::vector<uint32_t> TaskBenchmarkCache::createMetaDataScanTrace(void)
+{
+  const uint32_t NUM_META_DATA_SECTORS = 64;
+  const uint32_t SCAN_LENGTH = 1024;
+  const uint32_t NUM_ROUNDS = 32;
+
+  std::vector<uint32_t> trace;
+  uint32_t next_file_sector = 10000;
+
+  for(uint32_t round = 0; round < NUM_ROUNDS; round++)
+  {
+    // some file system operations touching the meta-data
+    for(uint32_t pass = 0; pass < 4; pass++)
+    {
+      for(uint32_t i = 0; i < NUM_META_DATA_SECTORS; i++)
+        trace.push_back(i);
+    }
+
+    // reading a large file once
+    for(uint32_t i = 0; i < SCAN_LENGTH; i++)
+      trace.push_back(next_file_sector++);
+  }
+
+  return trace;
+}
+
+std::vector<uint32_t> TaskBenchmarkCache::createRandomTrace(uint32_t working_set)
+{
+  const uint32_t NUM_REQUESTS = 100000;
+
+  std::vector<uint32_t> trace;
+  uint32_t seed = 42;
+
+  for(uint32_t i = 0; i < NUM_REQUESTS; i++)
+  {
+    seed = seed * 1103515245 + 12345;
+    trace.push_back((seed >> 16) % working_set);
+  }
+
+  return trace;
+}
+
+void TaskBenchmarkCache::replayTrace(const char* name, ReadStrategyCreator creator,
+    const std::vector<uint32_t>& trace, uint32_t num_cached_sectors)
+{
+  BenchmarkDevice device;
+  Cache::GeneralCache cache(&device, 0, num_cached_sectors);
+  cache.setReadStrategy(creator(&cache));
+
+  for(uint32_t i = 0; i < trace.size(); i++)
+  {
+    SectorCacheIdent ident(trace[i], BenchmarkDevice::SECTOR_SIZE);
+    cache.getItem(ident);
+    cache.releaseItem(ident);
+  }
+
+  Cache::CacheStat stats;
+  cache.getStats(stats);
+
+  std::cout << std::setw(20) << name << ": " << stats.num_requests << " requests, "
+            << stats.num_cache_hits << " hits, " << stats.evicted_items
+            << " evictions, hit ratio " << std::fixed << std::setprecision(1)
+            << 100.0 * stats.num_cache_hits / stats.num_requests << "%" << std::endl;
+}
+
+void TaskBenchmarkCache::benchmarkHitLatency(const char* name,
+    ReadStrategyCreator creator, uint32_t max_sectors)
+{
+  const uint32_t NUM_LOOKUPS = 100000;
+  BenchmarkDevice device;
+
+  for(uint32_t num_sectors = 64; num_sectors <= max_sectors; num_sectors *= 4)
+  {
+    Cache::GeneralCache cache(&device, 0, num_sectors);
+    cache.setReadStrategy(creator(&cache));
+
+    // warm up: load every sector once
+    for(uint32_t i = 0; i < num_sectors; i++)
+    {
+      SectorCacheIdent ident(i, BenchmarkDevice::SECTOR_SIZE);
+      cache.getItem(ident);
+      cache.releaseItem(ident);
+    }
+
+    // hit the cached sectors in a scattered order
+    double start = getTimeNs();
+    for(uint32_t i = 0; i < NUM_LOOKUPS; i++)
+    {
+      SectorCacheIdent ident((i * 7919) % num_sectors, BenchmarkDevice::SECTOR_SIZE);
+      cache.getItem(ident);
+      cache.releaseItem(ident);
+    }
+    double elapsed = getTimeNs() - start;
+
+    Cache::CacheStat stats;
+    cache.getStats(stats);
+
+    std::cout << std::setw(20) << name << " " << std::setw(6) << num_sectors
+              << " sectors: " << std::fixed << std::setprecision(1)
+              << elapsed / NUM_LOOKUPS << " ns/hit (" << stats.num_misses
+              << " misses)" << std::endl;
+  }
+}
+
+char TaskBenchmarkCache::getOptionName(void) const
+{
+  return 'b';
+}
+
+const char* TaskBenchmarkCache::getDescription(void) const
+{
+  return "runs the cache micro-benchmarks, no image-file required. call with : -b";
+}
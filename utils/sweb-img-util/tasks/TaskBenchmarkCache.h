@@ -0,0 +1,89 @@
+/**
+ * Filename: TaskBenchmarkCache.h
+ * Description:
+ *
+ * Created on: 18.10.2026
+ */
+
+#ifndef TASKBENCHMARKCACHE_H_
+#define TASKBENCHMARKCACHE_H_
+
+#include "TaskBenchmark.h"
+
+#include <vector>
+
+namespace Cache
+{
+class CacheReadStrategy;
+class GeneralCache;
+}
+
+/**
+ * @class TaskBenchmarkCache runs micro-benchmarks of the GeneralCache and
+ * it's read strategies on the host, no image-file is required
+ */
+class TaskBenchmarkCache : public TaskBenchmark
+{
+public:
+  TaskBenchmarkCache(Program& image_util);
+  virtual ~TaskBenchmarkCache();
+
+  /**
+   * returns the char identifying this option (e.g. h for help)
+   */
+  virtual char getOptionName(void) const;
+
+  virtual const char* getDescription(void) const;
+
+protected:
+
+  /**
+   * runs the measurements
+   */
+  virtual void run(void);
+
+private:
+
+  /**
+   * factory method type creating a read strategy for the given cache
+   */
+  typedef Cache::CacheReadStrategy* (*ReadStrategyCreator)(Cache::GeneralCache* cache);
+
+  /**
+   * fills a cache of the given size and measures the average latency
+   * of a cache-hit (getItem() + releaseItem())
+   *
+   * @param name the name of the strategy (for the output)
+   * @param creator creates the read strategy to measure
+   * @param max_sectors the largest number of cached sectors to measure
+   */
+  void benchmarkHitLatency(const char* name, ReadStrategyCreator creator,
+                           uint32_t max_sectors);
+
+  /**
+   * replays the given trace of sector numbers on a cache using the
+   * given read strategy and prints the resulting hit ratio (CacheStat)
+   *
+   * @param name the name of the strategy (for the output)
+   * @param creator creates the read strategy to measure
+   * @param trace the sector numbers to request in the given order
+   * @param num_cached_sectors the size of the cache
+   */
+  void replayTrace(const char* name, ReadStrategyCreator creator,
+                   const std::vector<uint32_t>& trace, uint32_t num_cached_sectors);
+
+  /**
+   * creates a trace of hot meta-data sectors (bitmaps, i-node table,
+   * root directory) that are accessed again and again, interrupted
+   * by large sequential file reads
+   */
+  static std::vector<uint32_t> createMetaDataScanTrace(void);
+
+  /**
+   * creates a trace of (pseudo) random accesses to a working set
+   * of the given size
+   */
+  static std::vector<uint32_t> createRandomTrace(uint32_t working_set);
+};
+
+#endif /* TASKBENCHMARKCACHE_H_ */
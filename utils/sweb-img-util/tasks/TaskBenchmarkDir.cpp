@@ -0,0 +1,166 @@
+/**
+ * Filename: TaskBenchmarkDir.cpp
+ * Description:
+ *
+ * Created on: 18.10.2026
+ */
+
+#include "TaskBenchmarkDir.h"
+
+#include <iostream>
+#include <iomanip>
+#include <sstream>
+#include <string>
+#include <stdlib.h>
+
+#include "fs/VfsSyscall.h"
+#include "fs/FsWorkingDirectory.h"
+#include "fs/Dirent.h"
+#include "fs/DIR.h"
+#include "Program.h"
+
+namespace
+{
+
+std::string getEntryPath(uint32_t index)
+{
+  std::ostringstream path;
+  path << "/big/entry" << index;
+  return path.str();
+}
+
+}
+
+TaskBenchmarkDir::TaskBenchmarkDir(Program& image_util) :
+    TaskBenchmark(image_util, "directory", 16 * 1024 * 1024)
+{
+}
+
+TaskBenchmarkDir::~TaskBenchmarkDir()
+{
+}
+
+void TaskBenchmarkDir::run(void)
+{
+  VfsSyscall* vfs = mountImage();
+
+  {
+    FsWorkingDirectory wd_info;
+
+    double start = getTimeNs();
+    bool created = createDirectory(vfs, &wd_info);
+    double create_time = getTimeNs() - start;
+
+    if(created)
+    {
+      double lookup = measureLookup(vfs, &wd_info);
+      double listing = measureListing(vfs, &wd_info);
+
+      std::cout << "directory benchmark - " << NUM_ENTRIES << " entries" << std::endl;
+      std::cout << std::fixed << std::setprecision(0);
+      std::cout << std::setw(24) << "create (ms)" << std::setw(12) << create_time / 1e6 << std::endl;
+      std::cout << std::setw(24) << "open() random (ns)" << std::setw(12) << lookup << std::endl;
+      std::cout << std::setw(24) << "full listing (us)" << std::setw(12) << listing / 1e3 << std::endl;
+    }
+    else
+    {
+      printError("failed to create the directory");
+    }
+  }
+
+  delete vfs;
+}
+
+bool TaskBenchmarkDir::createDirectory(VfsSyscall* vfs, FsWorkingDirectory* wd_info)
+{
+  if(vfs->mkdir(wd_info, "/big", 0755) != 0)
+    return false;
+
+  for(uint32_t i = 0; i < NUM_ENTRIES; i++)
+  {
+    // every LINKS_PER_FILE-th entry is a new file, the others are links
+    if(i % LINKS_PER_FILE == 0)
+    {
+      int32 fd = vfs->creat(wd_info, getEntryPath(i).c_str());
+      if(fd < 0)
+        return false;
+
+      vfs->close(wd_info, fd);
+    }
+    else if(vfs->link(wd_info, getEntryPath(i - i % LINKS_PER_FILE).c_str(), getEntryPath(i).c_str()) != 0)
+    {
+      return false;
+    }
+  }
+
+  return true;
+}
+
+double TaskBenchmarkDir::measureLookup(VfsSyscall* vfs, FsWorkingDirectory* wd_info)
+{
+  // the paths are built in advance, just the open() is measured
+  std::string* paths = new std::string[NUM_OPENS];
+
+  srand(42);
+  for(uint32_t i = 0; i < NUM_OPENS; i++)
+    paths[i] = getEntryPath(rand() % NUM_ENTRIES);
+
+  double start = getTimeNs();
+
+  for(uint32_t i = 0; i < NUM_OPENS; i++)
+  {
+    int32 fd = vfs->open(wd_info, paths[i].c_str(), O_RDONLY);
+
+    if(fd < 0)
+    {
+      delete[] paths;
+      return -1.0;
+    }
+
+    vfs->close(wd_info, fd);
+  }
+
+  double time = getTimeNs() - start;
+  delete[] paths;
+
+  return time / NUM_OPENS;
+}
+
+double TaskBenchmarkDir::measureListing(VfsSyscall* vfs, FsWorkingDirectory* wd_info)
+{
+  double start = getTimeNs();
+
+  for(uint32_t i = 0; i < NUM_LISTINGS; i++)
+  {
+    DIR* dir = vfs->opendir(wd_info, "/big");
+    if(dir == NULL)
+      return -1.0;
+
+    uint32_t num_entries = 0;
+    Dirent* dirent;
+
+    while((dirent = vfs->readdir(wd_info, dir)) != NULL)
+    {
+      num_entries++;
+      delete dirent;
+    }
+
+    vfs->closedir(wd_info, dir);
+
+    // the entries "." and ".." are listed, too
+    if(num_entries != NUM_ENTRIES + 2)
+      return -1.0;
+  }
+
+  return (getTimeNs() - start) / NUM_LISTINGS;
+}
+
+char TaskBenchmarkDir::getOptionName(void) const
+{
+  return 'd';
+}
+
+const char* TaskBenchmarkDir::getDescription(void) const
+{
+  return "runs the directory benchmark (lookup and listing of 10000 entries), no image-file required. call with : -d";
+}
@@ -0,0 +1,73 @@
+/**
+ * Filename: TaskBenchmarkDir.h
+ * Description:
+ *
+ * Created on: 18.10.2026
+ */
+
+#ifndef TASKBENCHMARKDIR_H_
+#define TASKBENCHMARKDIR_H_
+
+#include "TaskBenchmark.h"
+
+class FsWorkingDirectory;
+
+/**
+ * @class TaskBenchmarkDir measures the name lookup and the listing of a
+ * Directory with NUM_ENTRIES children, the file-system is created in a
+ * temporary image-file
+ */
+class TaskBenchmarkDir : public TaskBenchmark
+{
+public:
+  TaskBenchmarkDir(Program& image_util);
+  virtual ~TaskBenchmarkDir();
+
+  /**
+   * returns the char identifying this option (e.g. h for help)
+   */
+  virtual char getOptionName(void) const;
+
+  virtual const char* getDescription(void) const;
+
+protected:
+
+  /**
+   * runs the measurements
+   */
+  virtual void run(void);
+
+private:
+
+  // the number of children of the big Directory
+  static const uint32_t NUM_ENTRIES = 10000;
+
+  // number of names per file, a Minix I-Node has at most 256 links
+  static const uint32_t LINKS_PER_FILE = 250;
+
+  // number of open() calls for the lookup measurement
+  static const uint32_t NUM_OPENS = 50000;
+
+  // number of complete listings
+  static const uint32_t NUM_LISTINGS = 20;
+
+  /**
+   * creates the Directory "/big" with NUM_ENTRIES children, most of them
+   * are hard-links (a Minix partition has not enough I-Nodes for a file each)
+   */
+  static bool createDirectory(VfsSyscall* vfs, FsWorkingDirectory* wd_info);
+
+  /**
+   * measures the average time of opening (and closing) random children
+   * @return ns per open() or a negative value if an open() failed
+   */
+  static double measureLookup(VfsSyscall* vfs, FsWorkingDirectory* wd_info);
+
+  /**
+   * measures the average time of listing the whole Directory
+   * @return ns per listing or a negative value if the listing is incomplete
+   */
+  static double measureListing(VfsSyscall* vfs, FsWorkingDirectory* wd_info);
+};
+
+#endif /* TASKBENCHMARKDIR_H_ */
@@ -0,0 +1,174 @@
+/**
+ * Filename: TaskBenchmarkFd.cpp
+ * Description:
+ *
+ * Created on: 18.10.2026
+ */
+
+#include "TaskBenchmarkFd.h"
+
+#include <iostream>
+#include <iomanip>
+#include <sstream>
+#include <string>
+
+#include "fs/VfsSyscall.h"
+#include "fs/FsWorkingDirectory.h"
+#include "Program.h"
+
+namespace
+{
+
+std::string getFilePath(uint32_t index)
+{
+  std::ostringstream path;
+  path << "/f" << index;
+  return path.str();
+}
+
+}
+
+TaskBenchmarkFd::TaskBenchmarkFd(Program& image_util) :
+    TaskBenchmark(image_util, "fd", 4 * 1024 * 1024)
+{
+}
+
+TaskBenchmarkFd::~TaskBenchmarkFd()
+{
+}
+
+void TaskBenchmarkFd::run(void)
+{
+  VfsSyscall* vfs = mountImage();
+  FsWorkingDirectory** processes = new FsWorkingDirectory*[MAX_PROCESSES];
+  int32_t** fds = new int32_t*[MAX_PROCESSES];
+
+  for(uint32_t i = 0; i < MAX_PROCESSES; i++)
+  {
+    processes[i] = new FsWorkingDirectory();
+    fds[i] = new int32_t[FDS_PER_PROCESS];
+  }
+
+  if(createFiles(vfs, processes[0]))
+  {
+    std::cout << "fd benchmark - " << FDS_PER_PROCESS << " open files per process, "
+              << NUM_OPERATIONS << " operations each" << std::endl;
+    std::cout << std::setw(10) << "processes" << std::setw(10) << "open fds"
+              << std::setw(22) << "open/read/close (ns)" << std::setw(18) << "lseek/read (ns)" << std::endl;
+
+    uint32_t num_open = 0;
+
+    for(uint32_t num_processes = 1; num_processes <= MAX_PROCESSES; num_processes *= 4)
+    {
+      // every process keeps FDS_PER_PROCESS files open
+      for(; num_open < num_processes; num_open++)
+      {
+        for(uint32_t j = 0; j < FDS_PER_PROCESS; j++)
+          fds[num_open][j] = vfs->open(processes[num_open], getFilePath(j % NUM_FILES).c_str(), O_RDONLY);
+      }
+
+      double open_read_close = measureOpenReadClose(vfs, processes, num_processes);
+      double read = measureRead(vfs, processes, num_processes, fds);
+
+      std::cout << std::setw(10) << num_processes << std::setw(10) << num_processes * FDS_PER_PROCESS
+                << std::fixed << std::setprecision(0)
+                << std::setw(22) << open_read_close << std::setw(18) << read << std::endl;
+    }
+
+    for(uint32_t i = 0; i < num_open; i++)
+    {
+      for(uint32_t j = 0; j < FDS_PER_PROCESS; j++)
+        vfs->close(processes[i], fds[i][j]);
+    }
+  }
+  else
+  {
+    printError("failed to create the files");
+  }
+
+  // the processes have to go before the vfs
+  for(uint32_t i = 0; i < MAX_PROCESSES; i++)
+  {
+    delete processes[i];
+    delete[] fds[i];
+  }
+  delete[] processes;
+  delete[] fds;
+
+  delete vfs;
+}
+
+bool TaskBenchmarkFd::createFiles(VfsSyscall* vfs, FsWorkingDirectory* wd_info)
+{
+  char buffer[FILE_SIZE];
+  for(uint32_t i = 0; i < FILE_SIZE; i++)
+    buffer[i] = 'a' + i % 26;
+
+  for(uint32_t i = 0; i < NUM_FILES; i++)
+  {
+    int32 fd = vfs->creat(wd_info, getFilePath(i).c_str());
+    if(fd < 0)
+      return false;
+
+    int32 written = vfs->write(wd_info, fd, buffer, FILE_SIZE);
+    vfs->close(wd_info, fd);
+
+    if(written != (int32)FILE_SIZE)
+      return false;
+  }
+
+  return true;
+}
+
+double TaskBenchmarkFd::measureOpenReadClose(VfsSyscall* vfs, FsWorkingDirectory** processes,
+                                             uint32_t num_processes)
+{
+  char buffer[READ_SIZE];
+  double start = getTimeNs();
+
+  for(uint32_t i = 0; i < NUM_OPERATIONS; i++)
+  {
+    FsWorkingDirectory* process = processes[i % num_processes];
+
+    int32 fd = vfs->open(process, getFilePath(i % NUM_FILES).c_str(), O_RDONLY);
+    if(fd < 0)
+      return -1.0;
+
+    int32 num_read = vfs->read(process, fd, buffer, READ_SIZE);
+    vfs->close(process, fd);
+
+    if(num_read != (int32)READ_SIZE)
+      return -1.0;
+  }
+
+  return (getTimeNs() - start) / NUM_OPERATIONS;
+}
+
+double TaskBenchmarkFd::measureRead(VfsSyscall* vfs, FsWorkingDirectory** processes,
+                                    uint32_t num_processes, int32_t** fds)
+{
+  char buffer[READ_SIZE];
+  double start = getTimeNs();
+
+  for(uint32_t i = 0; i < NUM_OPERATIONS; i++)
+  {
+    uint32_t process = i % num_processes;
+    int32 fd = fds[process][(i / num_processes) % FDS_PER_PROCESS];
+
+    if(vfs->lseek(processes[process], fd, (i * READ_SIZE) % FILE_SIZE, SEEK_SET) < 0 ||
+       vfs->read(processes[process], fd, buffer, READ_SIZE) != (int32)READ_SIZE)
+      return -1.0;
+  }
+
+  return (getTimeNs() - start) / NUM_OPERATIONS;
+}
+
+char TaskBenchmarkFd::getOptionName(void) const
+{
+  return 'o';
+}
+
+const char* TaskBenchmarkFd::getDescription(void) const
+{
+  return "runs the file descriptor benchmark (open/read/close of 1..256 processes), no image-file required. call with : -o";
+}
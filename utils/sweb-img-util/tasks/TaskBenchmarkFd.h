@@ -0,0 +1,81 @@
+/**
+ * Filename: TaskBenchmarkFd.h
+ * Description:
+ *
+ * Created on: 18.10.2026
+ */
+
+#ifndef TASKBENCHMARKFD_H_
+#define TASKBENCHMARKFD_H_
+
+#include "TaskBenchmark.h"
+
+class FsWorkingDirectory;
+
+/**
+ * @class TaskBenchmarkFd stresses the file descriptor handling with many
+ * processes (each one a FsWorkingDirectory with it's own open files)
+ * doing open() / read() / close(), the file-system is created in a
+ * temporary image-file
+ */
+class TaskBenchmarkFd : public TaskBenchmark
+{
+public:
+  TaskBenchmarkFd(Program& image_util);
+  virtual ~TaskBenchmarkFd();
+
+  /**
+   * returns the char identifying this option (e.g. h for help)
+   */
+  virtual char getOptionName(void) const;
+
+  virtual const char* getDescription(void) const;
+
+protected:
+
+  /**
+   * runs the measurements
+   */
+  virtual void run(void);
+
+private:
+
+  // the number of files the processes open
+  static const uint32_t NUM_FILES = 8;
+
+  // the size of each file
+  static const uint32_t FILE_SIZE = 4096;
+
+  // the number of bytes per read()
+  static const uint32_t READ_SIZE = 64;
+
+  // the number of files each process keeps open during the measurement
+  static const uint32_t FDS_PER_PROCESS = 32;
+
+  // the maximal number of processes
+  static const uint32_t MAX_PROCESSES = 256;
+
+  // the number of operations per measurement
+  static const uint32_t NUM_OPERATIONS = 50000;
+
+  /**
+   * creates the files "/f0" ... "/f<NUM_FILES - 1>"
+   */
+  static bool createFiles(VfsSyscall* vfs, FsWorkingDirectory* wd_info);
+
+  /**
+   * the processes take turns in open(), read() and close() of a file
+   * @return ns per open() / read() / close() or a negative value on errors
+   */
+  static double measureOpenReadClose(VfsSyscall* vfs, FsWorkingDirectory** processes,
+                                     uint32_t num_processes);
+
+  /**
+   * the processes take turns in lseek() and read() of their open files
+   * @return ns per lseek() / read() or a negative value on errors
+   */
+  static double measureRead(VfsSyscall* vfs, FsWorkingDirectory** processes,
+                            uint32_t num_processes, int32_t** fds);
+};
+
+#endif /* TASKBENCHMARKFD_H_ */
@@ -0,0 +1,162 @@
+/**
+ * Filename: TaskBenchmarkFrag.cpp
+ * Description:
+ *
+ * Created on: 18.10.2026
+ */
+
+#include "TaskBenchmarkFrag.h"
+
+#include <iostream>
+#include <iomanip>
+#include <sstream>
+#include <string>
+
+#include "fs/VfsSyscall.h"
+#include "fs/FsWorkingDirectory.h"
+#include "fs/FileDescriptor.h"
+#include "fs/FileDescriptorTable.h"
+#include "fs/inodes/File.h"
+#include "Program.h"
+
+namespace
+{
+
+std::string getFilePath(uint32_t index)
+{
+  std::ostringstream path;
+  path << "/f" << index;
+  return path.str();
+}
+
+}
+
+TaskBenchmarkFrag::TaskBenchmarkFrag(Program& image_util) :
+    TaskBenchmark(image_util, "fragmentation", 48 * 1024 * 1024)
+{
+}
+
+TaskBenchmarkFrag::~TaskBenchmarkFrag()
+{
+}
+
+void TaskBenchmarkFrag::run(void)
+{
+  std::cout << "fragmentation benchmark - " << FILE_SIZE / 1024 << " KiB per writer in "
+            << WRITE_SIZE << " byte writes, taking turns" << std::endl;
+  std::cout << std::setw(10) << "writers" << std::setw(10) << "extents" << std::setw(22) << "blocks per extent"
+            << std::setw(16) << "read (MB/s)" << std::endl;
+
+  for(uint32_t num_writers = 1; num_writers <= MAX_WRITERS; num_writers *= 2)
+  {
+    // a fresh file-system for every run
+    if(!formatImage() || !writeFiles(num_writers))
+    {
+      printError("failed to write the files");
+      break;
+    }
+
+    uint32_t num_extents = 0;
+    uint32_t num_blocks = 0;
+    double duration = readFiles(num_writers, num_extents, num_blocks);
+
+    if(duration < 0)
+    {
+      printError("failed to read the files");
+      break;
+    }
+
+    std::cout << std::setw(10) << num_writers << std::setw(10) << num_extents
+              << std::fixed << std::setprecision(1)
+              << std::setw(22) << (double)num_blocks / num_extents
+              << std::setw(16) << (double)num_writers * FILE_SIZE / duration * 1e9 / (1024 * 1024) << std::endl;
+  }
+}
+
+bool TaskBenchmarkFrag::writeFiles(uint32_t num_writers)
+{
+  VfsSyscall* vfs = mountImage();
+  FsWorkingDirectory* wd_info = new FsWorkingDirectory();
+
+  char buffer[WRITE_SIZE];
+  for(uint32_t i = 0; i < WRITE_SIZE; i++)
+    buffer[i] = 'a' + i % 26;
+
+  int32 fds[MAX_WRITERS];
+  bool success = true;
+
+  for(uint32_t i = 0; i < num_writers; i++)
+  {
+    fds[i] = vfs->open(wd_info, getFilePath(i).c_str(), O_WRONLY | O_CREAT);
+    success = success && (fds[i] >= 0);
+  }
+
+  for(uint32_t written = 0; written < FILE_SIZE && success; written += WRITE_SIZE)
+  {
+    for(uint32_t i = 0; i < num_writers && success; i++)
+      success = (vfs->write(wd_info, fds[i], buffer, WRITE_SIZE) == (int32)WRITE_SIZE);
+  }
+
+  for(uint32_t i = 0; i < num_writers; i++)
+  {
+    if(fds[i] >= 0)
+      vfs->close(wd_info, fds[i]);
+  }
+
+  // the working directory has to go before the vfs
+  delete wd_info;
+  delete vfs;
+
+  return success;
+}
+
+double TaskBenchmarkFrag::readFiles(uint32_t num_writers, uint32_t& num_extents, uint32_t& num_blocks)
+{
+  VfsSyscall* vfs = mountImage();
+  FsWorkingDirectory* wd_info = new FsWorkingDirectory();
+
+  char* buffer = new char[READ_SIZE];
+  bool success = true;
+
+  num_extents = 0;
+  num_blocks = 0;
+
+  double start = getTimeNs();
+
+  for(uint32_t i = 0; i < num_writers && success; i++)
+  {
+    int32 fd = vfs->open(wd_info, getFilePath(i).c_str(), O_RDONLY);
+    if(fd < 0)
+    {
+      success = false;
+      break;
+    }
+
+    for(uint32_t read = 0; read < FILE_SIZE && success; read += READ_SIZE)
+      success = (vfs->read(wd_info, fd, buffer, READ_SIZE) == (int32)READ_SIZE);
+
+    File* file = wd_info->getFileDescriptorTable()->get(fd)->getFile();
+    num_blocks += file->getNumSectors();
+    num_extents += file->getNumSectorExtents();
+
+    vfs->close(wd_info, fd);
+  }
+
+  double duration = getTimeNs() - start;
+
+  delete[] buffer;
+  delete wd_info;
+  delete vfs;
+
+  return success ? duration : -1.0;
+}
+
+char TaskBenchmarkFrag::getOptionName(void) const
+{
+  return 'g';
+}
+
+const char* TaskBenchmarkFrag::getDescription(void) const
+{
+  return "runs the fragmentation benchmark (1..8 concurrent writers, extents and sequential read), no image-file required. call with : -g";
+}
@@ -0,0 +1,66 @@
+/**
+ * Filename: TaskBenchmarkFrag.h
+ * Description:
+ *
+ * Created on: 18.10.2026
+ */
+
+#ifndef TASKBENCHMARKFRAG_H_
+#define TASKBENCHMARKFRAG_H_
+
+#include "TaskBenchmark.h"
+
+/**
+ * @class TaskBenchmarkFrag measures the fragmentation of files written by
+ * concurrent (interleaved) writers and the sequential read throughput of
+ * these files, the file-system is created in a temporary image-file
+ */
+class TaskBenchmarkFrag : public TaskBenchmark
+{
+public:
+  TaskBenchmarkFrag(Program& image_util);
+  virtual ~TaskBenchmarkFrag();
+
+  /**
+   * returns the char identifying this option (e.g. h for help)
+   */
+  virtual char getOptionName(void) const;
+
+  virtual const char* getDescription(void) const;
+
+protected:
+
+  /**
+   * runs the measurements
+   */
+  virtual void run(void);
+
+private:
+
+  // the maximal number of concurrent writers (one file each)
+  static const uint32_t MAX_WRITERS = 8;
+
+  // the size of each file
+  static const uint32_t FILE_SIZE = 4 * 1024 * 1024;
+
+  // the number of bytes per write()
+  static const uint32_t WRITE_SIZE = 4096;
+
+  // the number of bytes per read()
+  static const uint32_t READ_SIZE = 64 * 1024;
+
+  /**
+   * the writers take turns in appending to their files
+   */
+  bool writeFiles(uint32_t num_writers);
+
+  /**
+   * reads the files sequentially (after a fresh mount)
+   * @param num_extents [out] the number of runs of contiguous blocks of all files
+   * @param num_blocks [out] the number of data blocks of all files
+   * @return ns for reading all files or a negative value on errors
+   */
+  double readFiles(uint32_t num_writers, uint32_t& num_extents, uint32_t& num_blocks);
+};
+
+#endif /* TASKBENCHMARKFRAG_H_ */
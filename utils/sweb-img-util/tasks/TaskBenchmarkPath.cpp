@@ -0,0 +1,128 @@
+/**
+ * Filename: TaskBenchmarkPath.cpp
+ * Description:
+ *
+ * Created on: 18.10.2026
+ */
+
+#include "TaskBenchmarkPath.h"
+
+#include <iostream>
+#include <iomanip>
+#include <string>
+
+#include "fs/VfsSyscall.h"
+#include "fs/FsWorkingDirectory.h"
+#include "Program.h"
+
+namespace
+{
+
+std::string getDirPath(uint32_t depth)
+{
+  std::string path;
+  for(uint32_t i = 0; i < depth; i++)
+    path += "/d";
+
+  return path;
+}
+
+}
+
+TaskBenchmarkPath::TaskBenchmarkPath(Program& image_util) :
+    TaskBenchmark(image_util, "path", 4 * 1024 * 1024)
+{
+}
+
+TaskBenchmarkPath::~TaskBenchmarkPath()
+{
+}
+
+void TaskBenchmarkPath::run(void)
+{
+  VfsSyscall* vfs = mountImage();
+
+  {
+    // the working directory pins it's Directory, so it has to go before the vfs
+    FsWorkingDirectory wd_info;
+
+    if(createTree(vfs, &wd_info))
+    {
+      std::cout << "path benchmark - ns per open()/close(), " << NUM_OPENS
+                << " calls each" << std::endl;
+      std::cout << std::setw(6) << "depth" << std::setw(12) << "existing"
+                << std::setw(12) << "missing" << std::setw(12) << "relative" << std::endl;
+
+      for(uint32_t depth = 1; depth <= MAX_DEPTH; depth++)
+      {
+        std::string dir = getDirPath(depth);
+
+        double existing = measureOpen(vfs, &wd_info, (dir + "/f").c_str(), true);
+        double missing = measureOpen(vfs, &wd_info, (dir + "/none").c_str(), false);
+
+        // the same file relative to the working directory
+        vfs->chdir(&wd_info, dir.c_str());
+        double relative = measureOpen(vfs, &wd_info, "f", true);
+        vfs->chdir(&wd_info, "/");
+
+        std::cout << std::setw(6) << depth << std::fixed << std::setprecision(0)
+                  << std::setw(12) << existing << std::setw(12) << missing
+                  << std::setw(12) << relative << std::endl;
+      }
+    }
+    else
+    {
+      printError("failed to create the directory tree");
+    }
+  }
+
+  delete vfs;
+}
+
+bool TaskBenchmarkPath::createTree(VfsSyscall* vfs, FsWorkingDirectory* wd_info)
+{
+  for(uint32_t depth = 1; depth <= MAX_DEPTH; depth++)
+  {
+    std::string dir = getDirPath(depth);
+
+    if(vfs->mkdir(wd_info, dir.c_str(), 0755) != 0)
+      return false;
+
+    int32 fd = vfs->creat(wd_info, (dir + "/f").c_str());
+    if(fd < 0)
+      return false;
+
+    vfs->close(wd_info, fd);
+  }
+
+  return true;
+}
+
+double TaskBenchmarkPath::measureOpen(VfsSyscall* vfs, FsWorkingDirectory* wd_info,
+    const char* path, bool expect_success)
+{
+  double start = getTimeNs();
+
+  for(uint32_t i = 0; i < NUM_OPENS; i++)
+  {
+    int32 fd = vfs->open(wd_info, path, O_RDONLY);
+
+    if((fd >= 0) != expect_success)
+      return -1.0;
+
+    if(fd >= 0)
+      vfs->close(wd_info, fd);
+  }
+
+  return (getTimeNs() - start) / NUM_OPENS;
+}
+
+char TaskBenchmarkPath::getOptionName(void) const
+{
+  return 'r';
+}
+
+const char* TaskBenchmarkPath::getDescription(void) const
+{
+  return "runs the path resolution benchmark (open() at depth 1..16), no image-file required. call with : -r";
+}
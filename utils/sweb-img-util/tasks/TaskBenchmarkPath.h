@@ -0,0 +1,63 @@
+/**
+ * Filename: TaskBenchmarkPath.h
+ * Description:
+ *
+ * Created on: 18.10.2026
+ */
+
+#ifndef TASKBENCHMARKPATH_H_
+#define TASKBENCHMARKPATH_H_
+
+#include "TaskBenchmark.h"
+
+class FsWorkingDirectory;
+
+/**
+ * @class TaskBenchmarkPath measures the path resolution of the VfsSyscall
+ * by opening files in directories of the depth 1 to MAX_DEPTH, the
+ * file-system is created in a temporary image-file
+ */
+class TaskBenchmarkPath : public TaskBenchmark
+{
+public:
+  TaskBenchmarkPath(Program& image_util);
+  virtual ~TaskBenchmarkPath();
+
+  /**
+   * returns the char identifying this option (e.g. h for help)
+   */
+  virtual char getOptionName(void) const;
+
+  virtual const char* getDescription(void) const;
+
+protected:
+
+  /**
+   * runs the measurements
+   */
+  virtual void run(void);
+
+private:
+
+  // the depth of the deepest directory
+  static const uint32_t MAX_DEPTH = 16;
+
+  // number of open() calls per measurement
+  static const uint32_t NUM_OPENS = 20000;
+
+  /**
+   * creates the directories "/d/d/..." up to MAX_DEPTH, each of them
+   * holding a file "f"
+   */
+  static bool createTree(VfsSyscall* vfs, FsWorkingDirectory* wd_info);
+
+  /**
+   * measures the average time of opening (and closing) the given path
+   * @return ns per open() or a negative value if the open() failed
+   * unexpectedly
+   */
+  static double measureOpen(VfsSyscall* vfs, FsWorkingDirectory* wd_info,
+                            const char* path, bool expect_success);
+};
+
+#endif /* TASKBENCHMARKPATH_H_ */
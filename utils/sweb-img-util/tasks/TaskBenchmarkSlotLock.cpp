@@ -0,0 +1,118 @@
+/**
+ * Filename: TaskBenchmarkSlotLock.cpp
+ * Description:
+ *
+ * Created on: 18.10.2026
+ */
+
+#include "TaskBenchmarkSlotLock.h"
+
+#include <iostream>
+#include <iomanip>
+
+#include "fs/VfsSyscall.h"
+#include "fs/FileSystem.h"
+#include "fs/FsVolumeManager.h"
+#include "fs/FsWorkingDirectory.h"
+#include "fs/FileDescriptor.h"
+#include "fs/FileDescriptorTable.h"
+#include "fs/inodes/File.h"
+#include "util/SlotLockManager.h"
+#include "Program.h"
+
+TaskBenchmarkSlotLock::TaskBenchmarkSlotLock(Program& image_util) :
+    TaskBenchmark(image_util, "slot-lock", 8 * 1024 * 1024)
+{
+}
+
+TaskBenchmarkSlotLock::~TaskBenchmarkSlotLock()
+{
+}
+
+void TaskBenchmarkSlotLock::run(void)
+{
+  const uint32_t HELD_SLOTS[] = { 0, 16, 256 };
+  const uint32_t NUM_HELD = sizeof(HELD_SLOTS) / sizeof(HELD_SLOTS[0]);
+
+  std::cout << "slot-lock benchmark - " << NUM_OPS << " acquire/release pairs on "
+            << NUM_SECTORS << " sectors" << std::endl;
+
+  for(uint32_t i = 0; i < NUM_HELD; i++)
+  {
+    std::cout << "  lock manager, " << std::setw(4) << HELD_SLOTS[i] << " other sectors held: "
+              << std::fixed << std::setprecision(1) << benchmarkLockManager(HELD_SLOTS[i])
+              << " ns per sector" << std::endl;
+  }
+
+  // a cached sector read through the FsVolumeManager, for comparison
+  VfsSyscall* vfs = mountImage();
+  FsWorkingDirectory* wd_info = new FsWorkingDirectory();
+  int32 fd = vfs->open(wd_info, "/bench", O_RDWR | O_CREAT);
+
+  if(fd < 0)
+  {
+    printError("failed to create the file");
+  }
+  else
+  {
+    FsVolumeManager* volume_manager = wd_info->getFileDescriptorTable()->get(fd)->getFile()
+                                      ->getFileSystem()->getVolumeManager();
+
+    double start = getTimeNs();
+
+    for(uint32_t i = 0; i < NUM_OPS; i++)
+    {
+      sector_addr_t sector = i % NUM_SECTORS;
+
+      volume_manager->acquireSectorForReading(sector);
+      volume_manager->readSectorUnprotected(sector);
+      volume_manager->releaseReadSector(sector);
+    }
+
+    std::cout << "  cached sector read (acquire, read, release): " << std::fixed << std::setprecision(1)
+              << (getTimeNs() - start) / NUM_OPS << " ns per sector" << std::endl;
+
+    vfs->close(wd_info, fd);
+  }
+
+  delete wd_info;
+  delete vfs;
+}
+
+double TaskBenchmarkSlotLock::benchmarkLockManager(uint32_t num_held_slots)
+{
+  SlotLockManager<sector_addr_t, uint32> lock_manager;
+
+  // sectors used by others, far away from the measured ones
+  const sector_addr_t FIRST_HELD_SLOT = 1000000;
+
+  for(uint32_t i = 0; i < num_held_slots; i++)
+    lock_manager.acquireWriteBlocking(FIRST_HELD_SLOT + i);
+
+  double start = getTimeNs();
+
+  for(uint32_t i = 0; i < NUM_OPS; i++)
+  {
+    sector_addr_t sector = i % NUM_SECTORS;
+
+    lock_manager.acquireReadBlocking(sector);
+    lock_manager.releaseRead(sector);
+  }
+
+  double duration = getTimeNs() - start;
+
+  for(uint32_t i = 0; i < num_held_slots; i++)
+    lock_manager.releaseWrite(FIRST_HELD_SLOT + i);
+
+  return duration / NUM_OPS;
+}
+
+char TaskBenchmarkSlotLock::getOptionName(void) const
+{
+  return 'k';
+}
+
+const char* TaskBenchmarkSlotLock::getDescription(void) const
+{
+  return "runs the sector-lock benchmark (SlotLockManager overhead per sector), no image-file required. call with : -k";
+}
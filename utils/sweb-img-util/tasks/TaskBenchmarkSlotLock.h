@@ -0,0 +1,55 @@
+/**
+ * Filename: TaskBenchmarkSlotLock.h
+ * Description:
+ *
+ * Created on: 18.10.2026
+ */
+
+#ifndef TASKBENCHMARKSLOTLOCK_H_
+#define TASKBENCHMARKSLOTLOCK_H_
+
+#include "TaskBenchmark.h"
+
+/**
+ * @class TaskBenchmarkSlotLock measures the overhead of the sector locks
+ * (SlotLockManager) per sector, alone and as part of a cached sector read
+ * of the FsVolumeManager, the file-system is created in a temporary
+ * image-file
+ */
+class TaskBenchmarkSlotLock : public TaskBenchmark
+{
+public:
+  TaskBenchmarkSlotLock(Program& image_util);
+  virtual ~TaskBenchmarkSlotLock();
+
+  /**
+   * returns the char identifying this option (e.g. h for help)
+   */
+  virtual char getOptionName(void) const;
+
+  virtual const char* getDescription(void) const;
+
+protected:
+
+  /**
+   * runs the measurements
+   */
+  virtual void run(void);
+
+private:
+
+  // number of acquire / release pairs per measurement
+  static const uint32_t NUM_OPS = 200000;
+
+  // the sectors are acquired round-robin out of this range
+  static const uint32_t NUM_SECTORS = 64;
+
+  /**
+   * measures acquire / release pairs of the SlotLockManager while the
+   * given number of other slots are held
+   * @return ns per pair
+   */
+  static double benchmarkLockManager(uint32_t num_held_slots);
+};
+
+#endif /* TASKBENCHMARKSLOTLOCK_H_ */